@@ -117,6 +117,8 @@ namespace RC::DotNetLibrary
         auto fire_program_start() -> void;
         auto fire_unreal_init() -> void;
         auto fire_update() -> void;
+        // Whether a managed mod handles Update or a callback was added with 'add_update_callback'
+        auto has_update_listeners() const -> bool;
     };
 
     namespace Shared
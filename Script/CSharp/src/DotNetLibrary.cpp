@@ -303,6 +303,11 @@ namespace RC::DotNetLibrary
 			callback();
 	}
 
+	auto Runtime::has_update_listeners() const -> bool
+	{
+		return Shared::Events[Update] || !update_callbacks.empty();
+	}
+
 	namespace Framework
 	{
 #define CLR_GET_PROPERTY_VALUE(PropertyType, Type, Object, Name, Value)                                                                                 \
@@ -325,6 +330,10 @@ namespace RC::DotNetLibrary
 
 			if (csharp_data.callback_ref == 0) return;
 
+			// Traces are cheap enough to leave in a hook that can run thousands of times per frame
+			// The UFunction address matches the one in the "[RegisterHook] Registered native hook" message
+			RC_OUTPUT_TRACE(STR("[C#] Pre hook for UFunction {}\n"), static_cast<void*>(csharp_data.unreal_function));
+
 			// Attempt at dynamically fetching the params
 			uint16_t return_value_offset = context.TheStack.CurrentNativeFunction()->GetReturnValueOffset();
 
@@ -390,6 +399,8 @@ namespace RC::DotNetLibrary
 
 			if (csharp_data.post_callback_ref == 0) return;
 
+			RC_OUTPUT_TRACE(STR("[C#] Post hook for UFunction {}\n"), static_cast<void*>(csharp_data.unreal_function));
+
 			// Attempt at dynamically fetching the params
 			uint16_t return_value_offset = context.TheStack.CurrentNativeFunction()->GetReturnValueOffset();
 
@@ -451,23 +462,33 @@ namespace RC::DotNetLibrary
 
 		intptr_t Hooking::SigScan(const char* Signature)
 		{
-			intptr_t address = 0;
-			SignatureContainer signature_container{
-					{{Signature}},
-					[&](const SignatureContainer& self) {
-						address = reinterpret_cast<intptr_t>(self.get_match_address());
-						return true;
-					},
-					[](SignatureContainer& self) {},
-			};
-
-			SinglePassScanner::SignatureContainerMap signature_containers = {
-					{ScanTarget::MainExe, {signature_container}},
-			};
-
-			SinglePassScanner::start_scan(signature_containers);
-
-			return address;
+			// The signature comes from managed code, an exception must not cross back into it
+			// A malformed signature throws as soon as the container compiles it
+			try
+			{
+				intptr_t address = 0;
+				SignatureContainer signature_container{
+						{{Signature}},
+						[&](const SignatureContainer& self) {
+							address = reinterpret_cast<intptr_t>(self.get_match_address());
+							return true;
+						},
+						[](SignatureContainer& self) {},
+				};
+
+				SinglePassScanner::SignatureContainerMap signature_containers = {
+						{ScanTarget::MainExe, {signature_container}},
+				};
+
+				SinglePassScanner::start_scan(signature_containers);
+
+				return address;
+			}
+			catch (std::exception& e)
+			{
+				Output::send<LogLevel::Error>(STR("[Hooking::SigScan] Failed to scan for '{}': {}\n"), to_wstring(Signature), to_wstring(e.what()));
+				return 0;
+			}
 		}
 
 		PLH::x64Detour* Hooking::Hook(const uint64_t fnAddress, const uint64_t fnCallback, uint64_t* userTrampVar)
@@ -505,10 +526,13 @@ namespace RC::DotNetLibrary
 				generic_pre_id = m_last_generic_hook_id;
 				m_generic_hook_id_to_native_hook_id.emplace(++m_last_generic_hook_id, post_id);
 				generic_post_id = m_last_generic_hook_id;
-				Output::send<LogLevel::Verbose>(STR("[RegisterHook] Registered native hook ({}, {}) for {}\n"),
+				// GetFullName is expensive, so it's only called if verbose messages are logged
+				RC_OUTPUT_SEND_IF_ENABLED(LogLevel::Verbose,
+					STR("[RegisterHook] Registered native hook ({}, {}) for {} ({})\n"),
 					generic_pre_id,
 					generic_post_id,
-					function->GetFullName());
+					function->GetFullName(),
+					static_cast<void*>(function));
 			}
 			else if (func_ptr && func_ptr == Unreal::UObject::ProcessInternalInternal.get_function_address() &&
 				!function->HasAnyFunctionFlags(FUNC_Native))
@@ -519,7 +543,8 @@ namespace RC::DotNetLibrary
 
 				generic_pre_id = m_last_generic_hook_id;
 				generic_post_id = m_last_generic_hook_id;
-				Output::send<LogLevel::Verbose>(STR("[RegisterHook] Registered script hook ({}, {}) for {}\n"),
+				RC_OUTPUT_SEND_IF_ENABLED(LogLevel::Verbose,
+					STR("[RegisterHook] Registered script hook ({}, {}) for {}\n"),
 					generic_pre_id,
 					generic_post_id,
 					function->GetFullName());
@@ -559,7 +584,7 @@ namespace RC::DotNetLibrary
 			}
 			else if (Level == LogLevel::Verbose)
 			{
-				Output::send<LogLevel::Verbose>(to_wstring(Message) + L"\n");
+				RC_OUTPUT_SEND_IF_ENABLED(LogLevel::Verbose, to_wstring(Message) + L"\n");
 			}
 			else if (Level == LogLevel::Warning)
 			{
@@ -1,3 +1,6 @@
+#include <chrono>
+#include <optional>
+
 #include <Mod/CppUserModBase.hpp>
 #include <UE4SSProgram.hpp>
 #include <DotNetLibrary.hpp>
@@ -32,6 +35,7 @@ public:
         std::filesystem::path runtime_path(path);
         m_runtime = new DotNetLibrary::Runtime(runtime_path.parent_path() / "ue4ss");
         m_runtime->initialize();
+        update_interval_from_listeners();
     }
 
     ~CSharpLoaderProxy() override
@@ -43,16 +47,32 @@ public:
     auto on_program_start() -> void override
     {
         m_runtime->fire_program_start();
+        update_interval_from_listeners();
     }
 
     auto on_unreal_init() -> void override
     {
         m_runtime->fire_unreal_init();
+        update_interval_from_listeners();
     }
 
     auto on_update() -> void override
     {
         m_runtime->fire_update();
+        update_interval_from_listeners();
+    }
+
+private:
+    // Managed mods get their Update about once per frame, and without anything listening for it the event loop doesn't wake up for this mod at all
+    // Listeners are added while managed mods start and when they handle the other events, so it's checked again after each of them
+    auto update_interval_from_listeners() -> void
+    {
+        std::optional<std::chrono::milliseconds> interval{};
+        if (m_runtime->has_update_listeners())
+        {
+            interval = std::chrono::milliseconds{16};
+        }
+        UE4SSProgram::get_program().set_mod_update_interval(this, interval);
     }
 };
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <chrono>
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -147,6 +149,9 @@ namespace RC::JSScript
         std::vector<PendingHookCallback> m_pending_hook_callbacks;
         std::mutex m_pending_hook_callbacks_mutex;
         
+        // Called from any thread after a key bind or hook callback is queued, so that 'tick' runs soon instead of at the next timer
+        std::function<void()> m_on_work_queued;
+
         // Module cache (public for access from module loader)
         std::unordered_map<std::string, bool> m_loaded_modules;
 
@@ -177,6 +182,12 @@ namespace RC::JSScript
         auto add_timer(JSContext* ctx, JSValue callback, double delay_ms, bool is_interval) -> int32_t;
         auto cancel_timer(int32_t id) -> bool;
         auto process_timers() -> void;
+        // How long until the earliest timer fires, an empty optional if there are no timers
+        auto get_time_until_next_timer() -> std::optional<std::chrono::milliseconds>;
+
+        // Work queued from other threads is executed by the next 'tick'
+        auto set_on_work_queued(std::function<void()> on_work_queued) -> void;
+        auto notify_work_queued() -> void;
         
         // UFunction hook management
         auto register_ufunction_hook(JSContext* ctx, Unreal::UFunction* function, 
@@ -1,9 +1,11 @@
 #include "JSMod.hpp"
 #include "JSType/JSUObject.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <chrono>
+#include <cmath>
 
 #define NOMINMAX
 #include <Windows.h>
@@ -448,6 +450,36 @@ namespace RC::JSScript
         return false;
     }
     
+    auto JSMod::get_time_until_next_timer() -> std::optional<std::chrono::milliseconds>
+    {
+        std::lock_guard<std::mutex> lock(m_timers_mutex);
+        
+        std::optional<double> next_trigger_time;
+        for (const auto& timer : m_timers)
+        {
+            if (timer.cancelled) continue;
+            next_trigger_time = next_trigger_time ? std::min(*next_trigger_time, timer.trigger_time) : timer.trigger_time;
+        }
+        if (!next_trigger_time) return std::nullopt;
+        
+        // Rounded up, waking up before the timer is due would only mean waking up again
+        const double seconds_left = std::max(0.0, *next_trigger_time - get_current_time());
+        return std::chrono::milliseconds{static_cast<int64_t>(std::ceil(seconds_left * 1000.0))};
+    }
+    
+    auto JSMod::set_on_work_queued(std::function<void()> on_work_queued) -> void
+    {
+        m_on_work_queued = std::move(on_work_queued);
+    }
+    
+    auto JSMod::notify_work_queued() -> void
+    {
+        if (m_on_work_queued)
+        {
+            m_on_work_queued();
+        }
+    }
+    
     auto JSMod::process_timers() -> void
     {
         if (!m_main_ctx) return;
@@ -1886,8 +1918,11 @@ namespace RC::JSScript
             if (!key_bind || !key_bind->ctx) return;
             
             // Add to pending queue (thread-safe)
-            std::lock_guard<std::mutex> lock(m_pending_keybind_mutex);
-            m_pending_keybind_callbacks.push_back(key_bind);
+            {
+                std::lock_guard<std::mutex> lock(m_pending_keybind_mutex);
+                m_pending_keybind_callbacks.push_back(key_bind);
+            }
+            notify_work_queued();
         };
 
         if (with_ctrl || with_shift || with_alt)
@@ -2151,6 +2186,7 @@ namespace RC::JSScript
                 std::lock_guard<std::mutex> lock(hook_data->owner->m_pending_hook_callbacks_mutex);
                 hook_data->owner->m_pending_hook_callbacks.push_back(std::move(pending));
             }
+            hook_data->owner->notify_work_queued();
             return;
         }
 
@@ -2343,6 +2379,7 @@ namespace RC::JSScript
                 std::lock_guard<std::mutex> lock(hook_data->owner->m_pending_hook_callbacks_mutex);
                 hook_data->owner->m_pending_hook_callbacks.push_back(std::move(pending));
             }
+            hook_data->owner->notify_work_queued();
             return;
         }
 
@@ -35,6 +35,11 @@ public:
         // Create JSMod instance but don't initialize yet
         // All JS operations will happen on the event loop thread for thread safety
         m_js_mod = std::make_unique<JSScript::JSMod>();
+
+        // Key binds and hooks queue their callbacks for the event loop thread, this makes sure they run without waiting for a timer
+        m_js_mod->set_on_work_queued([this]() {
+            UE4SSProgram::get_program().request_mod_update(this);
+        });
     }
 
     ~JSScriptMod() override
@@ -53,10 +58,12 @@ public:
     {
         Output::send<LogLevel::Normal>(STR("[UE4SSL.JavaScript] on_unreal_init called - Unreal is ready\n"));
         m_unreal_ready = true;
+        UE4SSProgram::get_program().request_mod_update(this);
     }
 
     /**
-     * Called every frame on the event loop thread
+     * Called on the event loop thread when a timer is due or when work was queued
+     * Until the engine is initialized this runs every 5 ms
      * All JS operations happen here for thread safety
      */
     auto on_update() -> void override
@@ -92,6 +99,9 @@ public:
         {
             m_js_mod->tick();
         }
+
+        // Nothing else needs the event loop until the next timer fires, queued callbacks and on_unreal_init request an update themselves
+        UE4SSProgram::get_program().set_mod_update_interval(this, m_js_mod->get_time_until_next_timer());
     }
 
     /**
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace RC
+{
+    // Lets the event loop sleep until it has something to do instead of waking up on a fixed interval
+    // Anything that hands the event loop work calls 'notify', the event loop waits for that or for its next deadline, whichever comes first
+    // A notification that arrives while the event loop is busy isn't lost, the next wait returns immediately
+    class EventScheduler
+    {
+      public:
+        using Clock = std::chrono::steady_clock;
+
+      private:
+        std::mutex m_mutex{};
+        std::condition_variable m_condition{};
+        bool m_is_notified{};
+        std::atomic<bool> m_is_paused{};
+        std::atomic<uint64_t> m_num_wakeups{};
+
+      public:
+        auto notify() -> void;
+
+        // Returns true if woken up by 'notify' and false if the deadline passed
+        // Clock::time_point::max() waits until notified
+        auto wait_until(Clock::time_point deadline) -> bool;
+
+        // A paused event loop only waits and doesn't process anything, resuming it also wakes it up
+        // Both are safe to call from any thread
+        auto pause() -> void;
+        auto resume() -> void;
+        [[nodiscard]] auto is_paused() const -> bool
+        {
+            return m_is_paused.load(std::memory_order_acquire);
+        }
+
+        // When a task that repeats every 'interval' is due again if it ran at 'now', 'throttle_factor' stretches the interval
+        // An interval of zero would keep the event loop from ever sleeping, so intervals are at least 1 ms
+        auto static get_next_due_time(Clock::time_point now, std::chrono::milliseconds interval, uint32_t throttle_factor = 1) -> Clock::time_point;
+
+        // The number of times 'wait_until' has returned, used to tell how often an idle event loop wakes up
+        [[nodiscard]] auto get_num_wakeups() const -> uint64_t
+        {
+            return m_num_wakeups.load(std::memory_order_relaxed);
+        }
+    };
+} // namespace RC
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <chrono>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include <Unreal/Core/Windows/MinimalWindowsApi.hpp>
 
 #include <Mod/CppUserModBase.hpp>
+#include <Mod/ModLoadPipeline.hpp>
 #include <Mod/Mod.hpp>
 
 #include <String/StringType.hpp>
@@ -19,6 +23,7 @@ namespace RC
 
       private:
         std::filesystem::path m_dlls_path;
+        std::filesystem::path m_dll_path;
 
         Unreal::Windows::HMODULE m_main_dll_module = NULL;
         void* m_dlls_path_cookie = NULL;
@@ -27,7 +32,14 @@ namespace RC
 
         CppUserModBase* m_mod = nullptr;
 
+        // Lives here and not in CppUserModBase so that mods built against older headers keep working, 5 ms is how often every mod used to be updated
+        std::optional<std::chrono::milliseconds> m_update_interval{std::chrono::milliseconds{5}};
+
+        std::chrono::microseconds m_prefetch_time{};
+        std::chrono::microseconds m_load_time{};
+
       public:
+        // The DLL isn't loaded until 'load_all' is called
         CppMod(UE4SSProgram&, StringType&& mod_name, StringType&& mod_path);
         CppMod(UE4SSProgram&, StringType&& mod_name, StringType&& mod_path, StringType&& dll_name);
         CppMod(CppMod&) = delete;
@@ -41,6 +53,23 @@ namespace RC
         auto fire_ui_init() -> void override;
         auto fire_program_start() -> void override;
         auto fire_update() -> void override;
+        auto get_update_interval() const -> std::optional<std::chrono::milliseconds> override;
+        auto set_update_interval(std::optional<std::chrono::milliseconds> interval) -> void;
+        [[nodiscard]] auto get_user_mod() const -> const CppUserModBase*
+        {
+            return m_mod;
+        }
         auto fire_dll_load(StringViewType dll_name) -> void;
+
+        // Loads the DLLs of 'mods', on up to 'max_threads' threads, and logs how long each mod took
+        // The DLL files are read first, which brings them into the file cache, and their imports tell which mods use DLLs from other mods
+        // Mods that don't are loaded concurrently, the others are loaded one at a time afterwards in the order of 'mods'
+        // Only the DLLs are loaded, the mods are still started one at a time and in order by 'start_mod'
+        static auto load_all(std::span<CppMod* const> mods, size_t max_threads) -> void;
+
+      private:
+        // Safe to call concurrently for different mods
+        auto prefetch() -> ModLoadPipeline::ModDlls;
+        auto load_dll() -> void;
     };
 } // namespace RC
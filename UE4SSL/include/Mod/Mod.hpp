@@ -1,7 +1,9 @@
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -19,6 +21,22 @@ namespace RC
         class UClass;
     }
 
+    // Timing of the most recent calls to a mod's 'fire_update'
+    struct ModUpdateStats
+    {
+        uint64_t num_updates{};
+
+        // Updates that were pushed to a later iteration of the event loop because other mods had used up the update budget
+        uint64_t num_deferred{};
+
+        uint64_t p50_microseconds{};
+        uint64_t p99_microseconds{};
+        uint64_t max_microseconds{};
+
+        // How many times longer than requested the interval between updates currently is, 1 if the mod isn't being throttled
+        uint32_t throttle_factor{1};
+    };
+
     class RC_UE4SS_API Mod
     {
       public:
@@ -36,6 +54,20 @@ namespace RC
         bool m_installed{false};
         mutable bool m_is_started{false};
 
+      private:
+        std::chrono::steady_clock::time_point m_next_update_time{};
+        bool m_is_update_requested{};
+
+        // The percentiles are taken from a rolling window of the most recent update times
+        static constexpr size_t num_update_time_samples = 128;
+        static constexpr uint32_t max_throttle_factor = 16;
+        std::array<uint32_t, num_update_time_samples> m_update_time_samples{};
+        uint64_t m_num_updates{};
+        uint64_t m_num_deferred_updates{};
+        uint64_t m_max_update_time{};
+        uint32_t m_throttle_factor{1};
+        mutable std::mutex m_update_stats_mutex{};
+
       public:
         enum class IsTrueMod
         {
@@ -63,6 +95,25 @@ namespace RC
         // Main update from the program
         virtual auto fire_update() -> void;
 
+        // How often the mod wants 'fire_update' to be called, an empty optional means that it doesn't need to be called at all
+        virtual auto get_update_interval() const -> std::optional<std::chrono::milliseconds>
+        {
+            return std::nullopt;
+        }
+
+        // Makes the mod due for an update at the next iteration of the event loop, even if its interval hasn't passed or it has none
+        // Must be called from the event loop
+        auto request_update() -> void;
+
+        // Calls 'fire_update' if the mod is due for an update and returns when the next one is due
+        // A mod that's due while 'is_budget_used_up' is true is deferred to the next iteration of the event loop instead
+        // A mod whose update alone takes longer than 'update_budget' is updated less often until its updates are fast again, zero disables this
+        auto fire_update_if_due(std::chrono::steady_clock::time_point now, std::chrono::microseconds update_budget, bool is_budget_used_up)
+                -> std::chrono::steady_clock::time_point;
+
+        // Safe to call from any thread
+        auto get_update_stats() const -> ModUpdateStats;
+
         virtual auto fire_unreal_init() -> void{};
 
         virtual auto fire_ui_init() -> void{};
@@ -73,5 +124,8 @@ namespace RC
         // Async update
         // Used when the main update function would block other mods from executing their scripts
         virtual auto update_async() -> void;
+
+      private:
+        auto record_update_time(std::chrono::microseconds update_time, std::chrono::microseconds update_budget) -> void;
     };
 } // namespace RC
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace RC::ModLoadPipeline
+{
+    // The DLL files that a mod ships and the DLLs that any of them import, all names are lowercase file names
+    struct ModDlls
+    {
+        std::vector<std::string> own_dll_names{};
+        std::vector<std::string> imported_dll_names{};
+        // Set if one of the mod's own DLLs couldn't be read, it may import anything
+        bool has_unknown_imports{};
+    };
+
+    // Reads the names of the DLLs in the import directory of a PE file as it's stored on disk, lowercase
+    // Delay-loaded DLLs aren't included, they aren't loaded until they're used
+    // Returns nullopt if 'pe_file' isn't a PE file or is truncated, and an empty vector if it imports nothing
+    auto read_imported_dll_names(std::span<const uint8_t> pe_file) -> std::optional<std::vector<std::string>>;
+
+    // For every mod, whether one of its DLLs imports a DLL that another mod ships and that the mod doesn't ship itself
+    // Such a mod can only be loaded once the other mod's directory is a DLL directory, so it's loaded after the mods without dependencies
+    // A mod with unknown imports is treated the same, since there's no telling what it depends on
+    auto find_mods_with_dependencies(std::span<const ModDlls> mods) -> std::vector<bool>;
+
+    // Calls 'callable' once with every index below 'count', on up to 'max_threads' threads including the calling thread
+    // Returns once every call has returned, the first exception thrown by 'callable' is rethrown after that
+    auto for_each_in_parallel(size_t count, size_t max_threads, const std::function<void(size_t)>& callable) -> void;
+} // namespace RC::ModLoadPipeline
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <Mod/Mod.hpp>
+
+namespace RC
+{
+    class CppMod;
+
+    // Owns the mods in the order that they were set up in, and keeps an index by name and a list of the mods of each type next to them
+    // Looking a mod up by name doesn't scan every mod, and calling into every C++ mod doesn't cast every mod
+    class RC_UE4SS_API ModRegistry
+    {
+      public:
+        using Container = std::vector<std::unique_ptr<Mod>>;
+
+      private:
+        struct NameHash
+        {
+            using is_transparent = void;
+
+            auto operator()(StringViewType name) const -> size_t
+            {
+                return std::hash<StringViewType>{}(name);
+            }
+        };
+
+      private:
+        Container m_mods{};
+        // The first mod that was added with each name, mods that are added later with a name that's taken are duplicates
+        std::unordered_map<StringType, Mod*, NameHash, std::equal_to<>> m_mods_by_name{};
+        // In the same order as 'm_mods'
+        std::vector<CppMod*> m_cpp_mods{};
+
+      public:
+        // Adds 'mod' after every other mod
+        auto add(std::unique_ptr<Mod> mod) -> Mod&;
+        // Adds 'mod' before the mod at 'index', or after every other mod if 'index' is past the end
+        auto insert(size_t index, std::unique_ptr<Mod> mod) -> Mod&;
+        // Destroys 'mod' and returns where it was, so that another mod can take its place
+        // Returns an empty optional if 'mod' isn't in the registry
+        auto remove(const Mod* mod) -> std::optional<size_t>;
+        auto clear() -> void;
+
+        // The first mod that was added with 'name', nullptr if there's none
+        [[nodiscard]] auto find(StringViewType name) const -> Mod*;
+        // Whether another mod with the same name was added before 'mod'
+        [[nodiscard]] auto is_duplicate(const Mod& mod) const -> bool;
+
+        [[nodiscard]] auto get_cpp_mods() const -> std::span<CppMod* const>
+        {
+            return m_cpp_mods;
+        }
+
+        [[nodiscard]] auto size() const -> size_t
+        {
+            return m_mods.size();
+        }
+        [[nodiscard]] auto empty() const -> bool
+        {
+            return m_mods.empty();
+        }
+        auto operator[](size_t index) const -> const std::unique_ptr<Mod>&
+        {
+            return m_mods[index];
+        }
+        auto begin() const -> Container::const_iterator
+        {
+            return m_mods.begin();
+        }
+        auto end() const -> Container::const_iterator
+        {
+            return m_mods.end();
+        }
+
+      private:
+        auto rebuild_type_lists() -> void;
+    };
+} // namespace RC
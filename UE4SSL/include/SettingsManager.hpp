@@ -20,11 +20,15 @@ namespace RC
         struct SectionGeneral
         {
             bool EnableHotReloadSystem{};
+            bool ReloadModsOnFileChange{true};
+            int64_t ModFileSettleTimeMs{500};
             bool UseCache{true};
             bool InvalidateCacheIfDLLDiffers{true};
             bool EnableDebugKeyBindings{false};
             int64_t SecondsToScanBeforeGivingUp{30};
             bool UseUObjectArrayCache{true};
+            int64_t ModUpdateBudgetMs{8};
+            int64_t ModLoadingThreads{0};
         } General;
 
         struct SectionEngineVersionOverride
@@ -64,6 +68,22 @@ namespace RC
             //GUI::GfxBackend GraphicsAPI{GUI::GfxBackend::GLFW3_OpenGL3};
         } Debug;
 
+        struct SectionLogging
+        {
+            bool AsyncLogging{true};
+            bool DropLogMessagesWhenQueueIsFull{false};
+            int64_t LogQueueCapacity{8192};
+            File::StringType MinimumLogLevel{STR("Verbose")};
+            File::StringType FileMinimumLogLevel{STR("Verbose")};
+            File::StringType ConsoleMinimumLogLevel{STR("Verbose")};
+            int64_t LogFileBufferSize{65536};
+            int64_t LogFileFlushIntervalMs{1000};
+            int64_t MaxLogFileSizeMB{32};
+            int64_t NumOldLogFilesToKeep{4};
+            bool EnableTraceLog{false};
+            bool LogLayoutEntries{false};
+        } Logging;
+
         struct SectionCrashDump
         {
             bool EnableDumping{true};
@@ -73,7 +93,7 @@ namespace RC
         struct SectionThreads
         {
             int64_t SigScannerNumThreads{8};
-            int64_t SigScannerMultithreadingModuleSizeThreshold{16777216};
+            int64_t SigScannerMultithreadingModuleSizeThreshold{2097152};
         } Threads;
 
         struct SectionMemory
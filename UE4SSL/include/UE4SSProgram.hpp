@@ -1,18 +1,26 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
 
 #include <Common.hpp>
+#include <Constructs/MpscQueue.hpp>
 #include <CrashDumper.hpp>
 #include <DynamicOutput/DynamicOutput.hpp>
+#include <EventScheduler.hpp>
+#include <File/FileWatcher.hpp>
+#include <IniParser/CompiledIni.hpp>
 #include <Input/Handler.hpp>
 #include <MProgram.hpp>
 #include <Mod/CppMod.hpp>
 #include <Mod/Mod.hpp>
+#include <Mod/ModRegistry.hpp>
 #include <SettingsManager.hpp>
 #include <Unreal/Core/Containers/Array.hpp>
 #include <Unreal/UnrealVersion.hpp>
@@ -74,11 +82,12 @@ namespace RC
     class UE4SSProgram : public MProgram
     {
       public:
-        friend class CppUserModBase; // m_input_handler
+        friend class CppUserModBase; // m_input_handler, discard_mod_update_requests
 
       public:
         constexpr static CharType m_settings_file_name[] = STR("UE4SS-settings.ini");
         constexpr static CharType m_log_file_name[] = STR("UE4SS.log");
+        constexpr static CharType m_trace_file_name[] = STR("UE4SS.trace");
         //constexpr static CharType m_object_dumper_file_name[] = STR("UE4SS_ObjectDump.txt");
 
       public:
@@ -112,6 +121,7 @@ namespace RC
         std::filesystem::path m_legacy_root_directory;
         Output::DebugConsoleDevice* m_debug_console_device{};
         Output::ConsoleDevice* m_console_device{};
+        std::unique_ptr<Output::BinaryLogDevice> m_trace_device{};
         //GUI::DebuggingGUI m_debugging_gui{};
 
         using EventCallable = void (*)(void* data);
@@ -120,8 +130,36 @@ namespace RC
             EventCallable callable{};
             void* data{};
         };
-        std::vector<Event> m_queued_events{};
-        std::mutex m_event_queue_mutex{};
+        // Game thread hooks and mods push events from any thread, the event loop is the only thread that pops them
+        static constexpr size_t max_queued_events = 4096;
+        BoundedMpscQueue<Event> m_queued_events{max_queued_events};
+        std::atomic<uint64_t> m_num_event_queue_full_waits{};
+        std::thread::id m_event_loop_thread_id{};
+        EventScheduler m_event_scheduler{};
+
+        // Mods can make requests from any thread and from their constructor, before the CppMod they belong to knows about them
+        // The event loop applies them to the CppMod whose mod made the request
+        struct ModUpdateRequest
+        {
+            enum class Type
+            {
+                SetInterval,
+                Update,
+            };
+            const CppUserModBase* mod{};
+            Type type{};
+            std::optional<std::chrono::milliseconds> interval{};
+        };
+        std::vector<ModUpdateRequest> m_mod_update_requests{};
+        std::mutex m_mod_update_requests_mutex{};
+
+        // Where the next iteration of the event loop starts updating mods, so that the same mods aren't always the ones that get deferred
+        size_t m_first_mod_to_update{};
+
+        // Only exists while hot reload on file changes is enabled
+        std::unique_ptr<File::FileWatcher> m_mod_file_watcher{};
+        size_t m_mods_directory_watch_id{};
+        size_t m_working_directory_watch_id{};
 
       private:
         std::unique_ptr<PLH::IatHook> m_load_library_a_hook;
@@ -137,7 +175,7 @@ namespace RC
         uint64_t m_hook_trampoline_load_library_ex_w;
 
       public:
-        std::vector<std::unique_ptr<Mod>> m_mods;
+        ModRegistry m_mods;
 
         RecognizableStruct m_shared_functions{};
 
@@ -145,7 +183,6 @@ namespace RC
 
         bool m_has_game_specific_config{};
         bool m_processing_events{};
-        bool m_pause_events_processing{};
 
       public:
         enum class IsInstalled
@@ -177,12 +214,17 @@ namespace RC
         auto setup_mod_directory_path() -> void;
         auto create_simple_console() -> void;
         auto setup_unreal() -> void;
+        // Loads the compiled form of 'ini_file_path' from the cache directory, or parses and compiles the INI file if it changed since it was compiled
+        // The compiled layout is only valid while 'callable' runs
+        auto load_compiled_layout(const std::filesystem::path& ini_file_path, const std::function<void(const Ini::CompiledIni&)>& callable) -> void;
         auto load_unreal_offsets_from_file() -> void;
         auto on_program_start() -> void;
         auto setup_unreal_properties() -> void;
 
       protected:
         auto update() -> void;
+        auto process_queued_events() -> void;
+        auto apply_mod_update_requests() -> void;
         auto setup_cpp_mods() -> void;
         enum class IsInitialStartup
         {
@@ -192,6 +234,9 @@ namespace RC
         auto start_cpp_mods(IsInitialStartup = IsInitialStartup::No) -> void;
         auto setup_mods() -> void;
         auto uninstall_mods() -> void;
+        auto start_mod_file_watcher() -> void;
+        // Uninstalls the mods whose files changed, and sets up and starts them again if they still exist
+        auto reinstall_changed_mods(const std::vector<File::FileChange>& changes) -> void;
         auto fire_unreal_init_for_cpp_mods() -> void;
         auto fire_ui_init_for_cpp_mods() -> void;
         auto fire_program_start_for_cpp_mods() -> void;
@@ -201,6 +246,9 @@ namespace RC
         auto init() -> void;
         auto is_program_started() -> bool;
         auto reinstall_mods() -> void;
+        // Removes every key bind whose callback is code in 'module', which must be done before 'module' is unloaded
+        // Must be called from the event loop, or while it isn't running
+        auto remove_key_binds_from_module(void* module) -> void;
         auto get_object_dumper_output_directory() -> const File::StringType;
         RC_UE4SS_API auto get_module_directory() -> File::StringType;
         RC_UE4SS_API auto get_game_executable_directory() -> File::StringType;
@@ -209,10 +257,24 @@ namespace RC
         RC_UE4SS_API auto get_legacy_root_directory() -> File::StringType;
         RC_UE4SS_API auto queue_event(EventCallable callable, void* data) -> void;
         RC_UE4SS_API auto is_queue_empty() -> bool;
+        struct EventQueueStats
+        {
+            MpscQueueStats queue{};
+            // The number of 'queue_event' calls that had to wait for the event loop to make room
+            uint64_t num_full_waits{};
+        };
+        RC_UE4SS_API auto get_event_queue_stats() -> EventQueueStats;
+        // 'mod_name' is the name of the mod's folder, returns an empty optional if there's no mod with that name
+        RC_UE4SS_API auto get_mod_update_stats(StringViewType mod_name) -> std::optional<ModUpdateStats>;
+        RC_UE4SS_API auto dump_mod_update_stats() -> void;
         RC_UE4SS_API auto can_process_events() -> bool
         {
             return m_processing_events;
         }
+        auto get_event_scheduler() -> EventScheduler&
+        {
+            return m_event_scheduler;
+        }
 
       public:
         // API pass-through for use outside the private scope of UE4SSProgram
@@ -225,14 +287,22 @@ namespace RC
         RC_UE4SS_API auto is_keydown_event_registered(Input::Key) -> bool;
         RC_UE4SS_API auto is_keydown_event_registered(Input::Key, const Input::Handler::ModifierKeyArray&) -> bool;
 
+        // How often the 'on_update' of 'mod' is called, 5 ms unless the mod changes it, an empty optional stops the calls
+        // Safe to call from any thread, including from the mod's constructor, and takes effect from the mod's next update
+        RC_UE4SS_API auto set_mod_update_interval(CppUserModBase* mod, std::optional<std::chrono::milliseconds> interval) -> void;
+        // Makes 'mod' due for an update and wakes the event loop up, even if the mod's interval hasn't passed or the mod stopped its updates
+        // For mods that queue work for their 'on_update' from other threads or from key binds, safe to call from any thread
+        RC_UE4SS_API auto request_mod_update(CppUserModBase* mod) -> void;
+
       private:
         static auto install_cpp_mods() -> void;
+        // Returns false if no started mod made the request
+        auto queue_mod_update_request(const ModUpdateRequest& request) -> void;
+        auto apply_mod_update_request(const ModUpdateRequest& request) -> bool;
+        auto discard_mod_update_requests(const CppUserModBase* mod) -> void;
 
-        using FMBNI_ExtraPredicate = std::function<bool(Mod*)>;
-        static auto find_mod_by_name_internal(StringViewType mod_name,
-                                              IsInstalled = IsInstalled::No,
-                                              IsStarted = IsStarted::No,
-                                              FMBNI_ExtraPredicate extra_predicate = {}) -> Mod*;
+        // Looks the name up in the mod registry, names that are taken by more than one mod refer to the first of them
+        static auto find_mod_by_name_internal(StringViewType mod_name, IsInstalled = IsInstalled::No, IsStarted = IsStarted::No) -> Mod*;
 
       public:
         RC_UE4SS_API static auto dump_uobject(Unreal::UObject* object, std::unordered_set<Unreal::FField*>* dumped_fields, StringType& out_line, bool is_below_425)
@@ -253,9 +323,7 @@ namespace RC
         template <>
         auto find_mod_by_name<CppMod>(StringViewType mod_name, IsInstalled is_installed, IsStarted is_started) -> CppMod*
         {
-            return static_cast<CppMod*>(find_mod_by_name_internal(mod_name, is_installed, is_started, [](auto elem) -> bool {
-                return dynamic_cast<CppMod*>(elem);
-            }));
+            return dynamic_cast<CppMod*>(find_mod_by_name_internal(mod_name, is_installed, is_started));
         }
         template <>
         auto find_mod_by_name<CppMod>(std::string_view mod_name, IsInstalled is_installed, IsStarted is_started) -> CppMod*
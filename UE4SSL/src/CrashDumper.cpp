@@ -3,6 +3,7 @@
 #include <format>
 #include <bit>
 #include <fmt/chrono.h>
+#include <DynamicOutput/AsyncOutput.hpp>
 #include <UE4SSProgram.hpp>
 #include <Unreal/Core/Windows/WindowsHWrapper.hpp>
 
@@ -26,6 +27,9 @@ namespace RC
 
     LONG WINAPI ExceptionHandler(_EXCEPTION_POINTERS* exception_pointers)
     {
+        // Log messages that are still waiting for the output thread would otherwise be lost
+        Output::flush_on_crash();
+
         const auto now = time_point_cast<seconds>(system_clock::now());
         const StringType dump_path = fmt::format(STR("{}\\crash_{:%Y_%m_%d_%H_%M_%S}.dmp"), StringType{UE4SSProgram::get_program().get_working_directory()}, now);
 
@@ -0,0 +1,53 @@
+#include <algorithm>
+
+#include <EventScheduler.hpp>
+
+namespace RC
+{
+    auto EventScheduler::notify() -> void
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_is_notified = true;
+        }
+        m_condition.notify_one();
+    }
+
+    auto EventScheduler::wait_until(Clock::time_point deadline) -> bool
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (deadline == Clock::time_point::max())
+        {
+            m_condition.wait(lock, [&] {
+                return m_is_notified;
+            });
+        }
+        else
+        {
+            m_condition.wait_until(lock, deadline, [&] {
+                return m_is_notified;
+            });
+        }
+
+        const bool was_notified = m_is_notified;
+        m_is_notified = false;
+        m_num_wakeups.fetch_add(1, std::memory_order_relaxed);
+        return was_notified;
+    }
+
+    auto EventScheduler::pause() -> void
+    {
+        m_is_paused.store(true, std::memory_order_release);
+    }
+
+    auto EventScheduler::resume() -> void
+    {
+        m_is_paused.store(false, std::memory_order_release);
+        notify();
+    }
+
+    auto EventScheduler::get_next_due_time(Clock::time_point now, std::chrono::milliseconds interval, uint32_t throttle_factor) -> Clock::time_point
+    {
+        return now + std::max(interval, std::chrono::milliseconds{1}) * std::max(throttle_factor, uint32_t{1});
+    }
+} // namespace RC
@@ -1,19 +1,30 @@
 #define NOMINMAX
 
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 
 #include <DynamicOutput/DynamicOutput.hpp>
 #include <Helpers/String.hpp>
 #include <Mod/CppMod.hpp>
+#include <UE4SSProgram.hpp>
 
 #include <Windows.h>
 
 namespace RC
 {
     CppMod::CppMod(UE4SSProgram& program, StringType&& mod_name, StringType&& mod_path)
+        : CppMod(program, std::move(mod_name), std::move(mod_path), STR("main.dll"))
+    {
+    }
+
+    CppMod::CppMod(UE4SSProgram& program, StringType&& mod_name, StringType&& mod_path, StringType&& dll_name)
         : Mod(program, std::move(mod_name), std::move(mod_path))
     {
         m_dlls_path = m_mod_path;
+        m_dll_path = m_dlls_path / dll_name;
 
         if (!std::filesystem::exists(m_dlls_path))
         {
@@ -21,16 +32,75 @@ namespace RC
             set_installable(false);
             return;
         }
+    }
+
+    auto CppMod::prefetch() -> ModLoadPipeline::ModDlls
+    {
+        const auto start_time = std::chrono::steady_clock::now();
+        ModLoadPipeline::ModDlls dlls{};
+
+        std::error_code ec{};
+        for (const auto& entry : std::filesystem::directory_iterator(m_dlls_path, ec))
+        {
+            if (auto extension = entry.path().extension().string(); !entry.is_regular_file(ec) || _stricmp(extension.c_str(), ".dll") != 0)
+            {
+                continue;
+            }
+
+            auto file_name = entry.path().filename().string();
+            std::transform(file_name.begin(), file_name.end(), file_name.begin(), [](char c) {
+                return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            });
+            dlls.own_dll_names.emplace_back(std::move(file_name));
+
+            // The mod's other DLLs are loaded when the main DLL is, so their imports count as the mod's imports
+            // Reading the whole file also leaves it in the file cache, so that mapping it later doesn't wait for the disk
+            std::optional<std::vector<std::string>> imported_dll_names{};
+            if (std::ifstream file{entry.path(), std::ios::binary | std::ios::ate}; file)
+            {
+                std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+                file.seekg(0);
+                if (file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))
+                {
+                    imported_dll_names = ModLoadPipeline::read_imported_dll_names(data);
+                }
+            }
+
+            if (!imported_dll_names)
+            {
+                dlls.has_unknown_imports = true;
+                continue;
+            }
+            dlls.imported_dll_names.insert(dlls.imported_dll_names.end(), imported_dll_names->begin(), imported_dll_names->end());
+        }
+
+        // Failing to list the directory leaves the mod's DLLs unknown
+        if (ec)
+        {
+            dlls.has_unknown_imports = true;
+        }
 
-       auto dll_path = m_dlls_path / STR("main.dll");
+        // DLLs that are already loaded, like UE4SS.dll, are never searched for, so they don't make one mod depend on another
+        std::erase_if(dlls.imported_dll_names, [](const std::string& dll_name) {
+            return GetModuleHandleA(dll_name.c_str()) != NULL;
+        });
+
+        m_prefetch_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time);
+        return dlls;
+    }
+
+    auto CppMod::load_dll() -> void
+    {
+        const auto start_time = std::chrono::steady_clock::now();
 
         // Add mods dlls directory to search path for dynamic/shared linked libraries in mods
         m_dlls_path_cookie = AddDllDirectory(m_dlls_path.c_str());
-        m_main_dll_module = LoadLibraryExW(dll_path.c_str(), NULL, LOAD_LIBRARY_SEARCH_DLL_LOAD_DIR | LOAD_LIBRARY_SEARCH_DEFAULT_DIRS);
+        m_main_dll_module = LoadLibraryExW(m_dll_path.c_str(), NULL, LOAD_LIBRARY_SEARCH_DLL_LOAD_DIR | LOAD_LIBRARY_SEARCH_DEFAULT_DIRS);
+        m_load_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time);
 
         if (!m_main_dll_module)
         {
-            Output::send<LogLevel::Warning>(STR("Failed to load dll <{}> for mod {}, error code: 0x{:x}\n"), ensure_str(dll_path), m_mod_name, GetLastError());
+            Output::send<LogLevel::Warning>(STR("Failed to load dll <{}> for mod {}, error code: 0x{:x}\n"), ensure_str(m_dll_path), m_mod_name, GetLastError());
             set_installable(false);
             return;
         }
@@ -50,44 +120,55 @@ namespace RC
         }
     }
 
-    CppMod::CppMod(UE4SSProgram& program, StringType&& mod_name, StringType&& mod_path, StringType&& dll_name) 
-        : Mod(program, std::move(mod_name), std::move(mod_path))
+    auto CppMod::load_all(std::span<CppMod* const> mods, size_t max_threads) -> void
     {
-        m_dlls_path = m_mod_path;
-
-        if (!std::filesystem::exists(m_dlls_path))
+        std::vector<CppMod*> mods_to_load{};
+        std::copy_if(mods.begin(), mods.end(), std::back_inserter(mods_to_load), [](CppMod* mod) {
+            return mod->is_installable() && !mod->m_main_dll_module;
+        });
+        if (mods_to_load.empty())
         {
-            Output::send<LogLevel::Warning>(STR("Could not find the dlls folder for mod {}\n"), m_mod_name);
-            set_installable(false);
             return;
         }
 
-        auto dll_path = m_dlls_path / dll_name;
+        const auto start_time = std::chrono::steady_clock::now();
 
-        // Add mods dlls directory to search path for dynamic/shared linked libraries in mods
-        m_dlls_path_cookie = AddDllDirectory(m_dlls_path.c_str());
-        m_main_dll_module = LoadLibraryExW(dll_path.c_str(), NULL, LOAD_LIBRARY_SEARCH_DLL_LOAD_DIR | LOAD_LIBRARY_SEARCH_DEFAULT_DIRS);
+        std::vector<ModLoadPipeline::ModDlls> mod_dlls(mods_to_load.size());
+        ModLoadPipeline::for_each_in_parallel(mods_to_load.size(), max_threads, [&](size_t index) {
+            mod_dlls[index] = mods_to_load[index]->prefetch();
+        });
 
-        if (!m_main_dll_module)
+        const auto has_dependencies = ModLoadPipeline::find_mods_with_dependencies(mod_dlls);
+        std::vector<CppMod*> independent_mods{};
+        std::vector<CppMod*> dependent_mods{};
+        for (size_t i = 0; i < mods_to_load.size(); ++i)
         {
-            Output::send<LogLevel::Warning>(STR("Failed to load dll <{}> for mod {}, error code: 0x{:x}\n"), ensure_str(dll_path), m_mod_name, GetLastError());
-            set_installable(false);
-            return;
+            (has_dependencies[i] ? dependent_mods : independent_mods).emplace_back(mods_to_load[i]);
         }
 
-        m_start_mod_func = reinterpret_cast<start_type>(GetProcAddress(m_main_dll_module, "start_mod"));
-        m_uninstall_mod_func = reinterpret_cast<uninstall_type>(GetProcAddress(m_main_dll_module, "uninstall_mod"));
-
-        if (!m_start_mod_func || !m_uninstall_mod_func)
+        ModLoadPipeline::for_each_in_parallel(independent_mods.size(), max_threads, [&](size_t index) {
+            independent_mods[index]->load_dll();
+        });
+        for (auto mod : dependent_mods)
         {
-            Output::send<LogLevel::Warning>(STR("Failed to find exported mod lifecycle functions for mod {}\n"), m_mod_name);
-
-            FreeLibrary(m_main_dll_module);
-            m_main_dll_module = NULL;
+            mod->load_dll();
+        }
 
-            set_installable(false);
-            return;
+        const auto total_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time);
+        for (size_t i = 0; i < mods_to_load.size(); ++i)
+        {
+            const auto mod = mods_to_load[i];
+            Output::send(STR("C++ mod '{}': read in {:.2f} ms, loaded in {:.2f} ms{}\n"),
+                         mod->m_mod_name,
+                         std::chrono::duration<double, std::milli>(mod->m_prefetch_time).count(),
+                         std::chrono::duration<double, std::milli>(mod->m_load_time).count(),
+                         has_dependencies[i] ? STR(", after the other mods because it may use DLLs from another mod") : STR(""));
         }
+        Output::send(STR("Loaded {} C++ mods in {:.2f} ms on up to {} threads, {} of them one at a time\n"),
+                     mods_to_load.size(),
+                     total_time.count(),
+                     std::max<size_t>(std::min(max_threads, mods_to_load.size()), 1),
+                     dependent_mods.size());
     }
 
     auto CppMod::start_mod() -> void
@@ -102,7 +183,7 @@ namespace RC
             if (!Output::has_internal_error())
             {
                 Output::send<LogLevel::Warning>(STR("Failed to load dll <{}> for mod {}, because: {}\n"),
-                                                ensure_str((m_dlls_path / STR("main.dll"))),
+                                                ensure_str(m_dll_path),
                                                 m_mod_name,
                                                 ensure_str(e.what()));
             }
@@ -154,6 +235,20 @@ namespace RC
         }
     }
 
+    auto CppMod::get_update_interval() const -> std::optional<std::chrono::milliseconds>
+    {
+        if (!m_mod)
+        {
+            return std::nullopt;
+        }
+        return m_update_interval;
+    }
+
+    auto CppMod::set_update_interval(std::optional<std::chrono::milliseconds> interval) -> void
+    {
+        m_update_interval = interval;
+    }
+
     auto CppMod::fire_dll_load(StringViewType dll_name) -> void
     {
         if (m_mod)
@@ -166,6 +261,9 @@ namespace RC
     {
         if (m_main_dll_module)
         {
+            // Binds that the mod registered without going through CppUserModBase, like the ones from the scripts of the JavaScript host, outlive it
+            // The next key press would call into the unloaded DLL
+            m_program.remove_key_binds_from_module(m_main_dll_module);
             FreeLibrary(m_main_dll_module);
             RemoveDllDirectory(m_dlls_path_cookie);
         }
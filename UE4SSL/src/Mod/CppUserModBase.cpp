@@ -15,6 +15,7 @@ namespace RC
 
     CppUserModBase::~CppUserModBase()
     {
+        UE4SSProgram::get_program().discard_mod_update_requests(this);
 
         auto& key_events = UE4SSProgram::get_program().m_input_handler.get_events();
         std::erase_if(key_events, [&](Input::KeySet& input_event) -> bool {
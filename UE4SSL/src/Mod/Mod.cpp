@@ -1,5 +1,7 @@
 #define NOMINMAX
 
+#include <algorithm>
+#include <cstdint>
 #include <filesystem>
 #include <format>
 #include <limits>
@@ -8,6 +10,7 @@
 #include <string>
 
 #include <DynamicOutput/DynamicOutput.hpp>
+#include <EventScheduler.hpp>
 #include <ExceptionHandling.hpp>
 #include <Helpers/Format.hpp>
 #include <Helpers/String.hpp>
@@ -88,6 +91,115 @@ namespace RC
     {
     }
 
+    auto Mod::request_update() -> void
+    {
+        m_is_update_requested = true;
+    }
+
+    auto Mod::fire_update_if_due(std::chrono::steady_clock::time_point now, std::chrono::microseconds update_budget, bool is_budget_used_up)
+            -> std::chrono::steady_clock::time_point
+    {
+        if (!m_is_update_requested)
+        {
+            if (!get_update_interval())
+            {
+                return std::chrono::steady_clock::time_point::max();
+            }
+
+            if (now < m_next_update_time)
+            {
+                return m_next_update_time;
+            }
+        }
+
+        if (is_budget_used_up)
+        {
+            std::lock_guard<std::mutex> guard(m_update_stats_mutex);
+            ++m_num_deferred_updates;
+            return now;
+        }
+
+        // Cleared first so that a request made during the update gets an update of its own
+        m_is_update_requested = false;
+        const auto update_start = std::chrono::steady_clock::now();
+        fire_update();
+        record_update_time(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - update_start), update_budget);
+
+        // The mod may have changed its interval during the update, a mod that stopped its updates is due as soon as it starts them again
+        const auto update_interval = get_update_interval();
+        m_next_update_time = update_interval ? EventScheduler::get_next_due_time(now, *update_interval, m_throttle_factor) : now;
+        if (m_is_update_requested)
+        {
+            return now;
+        }
+        return update_interval ? m_next_update_time : std::chrono::steady_clock::time_point::max();
+    }
+
+    auto Mod::record_update_time(std::chrono::microseconds update_time, std::chrono::microseconds update_budget) -> void
+    {
+        std::lock_guard<std::mutex> guard(m_update_stats_mutex);
+
+        const auto update_time_count = static_cast<uint64_t>(update_time.count());
+        m_update_time_samples[m_num_updates % num_update_time_samples] = static_cast<uint32_t>(std::min<uint64_t>(update_time_count, UINT32_MAX));
+        m_max_update_time = std::max(m_max_update_time, update_time_count);
+        ++m_num_updates;
+
+        if (update_budget.count() <= 0)
+        {
+            m_throttle_factor = 1;
+            return;
+        }
+
+        // The interval doubles every time an update goes over budget and halves every time an update takes less than half of it
+        if (update_time > update_budget && m_throttle_factor < max_throttle_factor)
+        {
+            if (m_throttle_factor == 1)
+            {
+                Output::send<LogLevel::Warning>(STR("Mod '{}' took {} ms to update, which is more than the {} ms budget, it will be updated less often\n"),
+                                                m_mod_name,
+                                                update_time.count() / 1000.0,
+                                                update_budget.count() / 1000.0);
+            }
+            m_throttle_factor *= 2;
+        }
+        else if (update_time < update_budget / 2 && m_throttle_factor > 1)
+        {
+            m_throttle_factor /= 2;
+            if (m_throttle_factor == 1)
+            {
+                Output::send(STR("Mod '{}' is within the update budget again\n"), m_mod_name);
+            }
+        }
+    }
+
+    auto Mod::get_update_stats() const -> ModUpdateStats
+    {
+        std::lock_guard<std::mutex> guard(m_update_stats_mutex);
+
+        ModUpdateStats stats{
+                .num_updates = m_num_updates,
+                .num_deferred = m_num_deferred_updates,
+                .max_microseconds = m_max_update_time,
+                .throttle_factor = m_throttle_factor,
+        };
+
+        const auto num_samples = static_cast<size_t>(std::min<uint64_t>(m_num_updates, num_update_time_samples));
+        if (num_samples == 0)
+        {
+            return stats;
+        }
+
+        std::array<uint32_t, num_update_time_samples> samples = m_update_time_samples;
+        auto percentile = [&](size_t percent) -> uint64_t {
+            auto nth = samples.begin() + (num_samples - 1) * percent / 100;
+            std::nth_element(samples.begin(), nth, samples.begin() + num_samples);
+            return *nth;
+        };
+        stats.p50_microseconds = percentile(50);
+        stats.p99_microseconds = percentile(99);
+        return stats;
+    }
+
     auto Mod::update_async() -> void
     {
     }
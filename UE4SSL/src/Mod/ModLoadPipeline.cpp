@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+
+#include <Mod/ModLoadPipeline.hpp>
+
+namespace RC::ModLoadPipeline
+{
+    namespace
+    {
+        // Reads little-endian integers at absolute offsets, every read past the end returns 0 and marks the reader as failed
+        class PeReader
+        {
+          private:
+            std::span<const uint8_t> m_data;
+            bool m_has_failed{};
+
+          public:
+            explicit PeReader(std::span<const uint8_t> data) : m_data(data)
+            {
+            }
+
+            template <typename IntType>
+            auto read(size_t offset) -> IntType
+            {
+                if (offset > m_data.size() || m_data.size() - offset < sizeof(IntType))
+                {
+                    m_has_failed = true;
+                    return {};
+                }
+
+                uint64_t value{};
+                for (size_t i = 0; i < sizeof(IntType); ++i)
+                {
+                    value |= static_cast<uint64_t>(m_data[offset + i]) << (i * 8);
+                }
+                return static_cast<IntType>(value);
+            }
+
+            // NUL-terminated, fails if there's no NUL within 'max_length' characters
+            auto read_string(size_t offset, size_t max_length) -> std::string
+            {
+                std::string string{};
+                for (size_t i = 0; i < max_length && offset + i < m_data.size(); ++i)
+                {
+                    const auto character = static_cast<char>(m_data[offset + i]);
+                    if (character == '\0')
+                    {
+                        return string;
+                    }
+                    string.push_back(character >= 'A' && character <= 'Z' ? static_cast<char>(character - 'A' + 'a') : character);
+                }
+
+                m_has_failed = true;
+                return {};
+            }
+
+            [[nodiscard]] auto has_failed() const -> bool
+            {
+                return m_has_failed;
+            }
+        };
+    } // namespace
+
+    auto read_imported_dll_names(std::span<const uint8_t> pe_file) -> std::optional<std::vector<std::string>>
+    {
+        static constexpr uint16_t pe32_magic = 0x10b;
+        static constexpr uint16_t pe32_plus_magic = 0x20b;
+        static constexpr uint32_t import_directory_index = 1;
+        static constexpr size_t section_header_size = 40;
+        static constexpr size_t import_descriptor_size = 20;
+        // Guards against import directories that don't end, no real DLL imports from this many DLLs
+        static constexpr size_t max_imported_dlls = 4096;
+        static constexpr size_t max_dll_name_length = 260;
+
+        PeReader reader{pe_file};
+        if (reader.read<uint16_t>(0) != 0x5A4D)
+        {
+            return std::nullopt;
+        }
+
+        const size_t nt_headers_offset = reader.read<uint32_t>(0x3C);
+        if (reader.read<uint32_t>(nt_headers_offset) != 0x00004550)
+        {
+            return std::nullopt;
+        }
+
+        const size_t file_header_offset = nt_headers_offset + 4;
+        const size_t num_sections = reader.read<uint16_t>(file_header_offset + 2);
+        const size_t optional_header_size = reader.read<uint16_t>(file_header_offset + 16);
+        const size_t optional_header_offset = file_header_offset + 20;
+
+        const auto optional_header_magic = reader.read<uint16_t>(optional_header_offset);
+        if (optional_header_magic != pe32_magic && optional_header_magic != pe32_plus_magic)
+        {
+            return std::nullopt;
+        }
+        const bool is_pe32_plus = optional_header_magic == pe32_plus_magic;
+        const size_t num_data_directories = reader.read<uint32_t>(optional_header_offset + (is_pe32_plus ? 108 : 92));
+        if (reader.has_failed())
+        {
+            return std::nullopt;
+        }
+        if (num_data_directories <= import_directory_index)
+        {
+            return std::vector<std::string>{};
+        }
+
+        const size_t data_directories_offset = optional_header_offset + (is_pe32_plus ? 112 : 96);
+        const uint32_t import_directory_rva = reader.read<uint32_t>(data_directories_offset + import_directory_index * 8);
+        if (reader.has_failed())
+        {
+            return std::nullopt;
+        }
+        if (import_directory_rva == 0)
+        {
+            return std::vector<std::string>{};
+        }
+
+        // Addresses in the headers are relative to where the DLL is loaded, the sections say where each range is in the file
+        const size_t section_table_offset = optional_header_offset + optional_header_size;
+        auto rva_to_file_offset = [&](uint32_t rva) -> std::optional<size_t> {
+            for (size_t i = 0; i < num_sections; ++i)
+            {
+                const size_t section_offset = section_table_offset + i * section_header_size;
+                const uint32_t virtual_size = reader.read<uint32_t>(section_offset + 8);
+                const uint32_t virtual_address = reader.read<uint32_t>(section_offset + 12);
+                const uint32_t raw_size = reader.read<uint32_t>(section_offset + 16);
+                const uint32_t raw_offset = reader.read<uint32_t>(section_offset + 20);
+                if (reader.has_failed())
+                {
+                    return std::nullopt;
+                }
+
+                if (rva >= virtual_address && rva - virtual_address < std::max(virtual_size, raw_size))
+                {
+                    if (rva - virtual_address >= raw_size)
+                    {
+                        return std::nullopt;
+                    }
+                    return static_cast<size_t>(raw_offset) + (rva - virtual_address);
+                }
+            }
+            return std::nullopt;
+        };
+
+        const auto import_directory_offset = rva_to_file_offset(import_directory_rva);
+        if (!import_directory_offset)
+        {
+            return std::nullopt;
+        }
+
+        std::vector<std::string> imported_dll_names{};
+        for (size_t i = 0; i < max_imported_dlls; ++i)
+        {
+            const size_t descriptor_offset = *import_directory_offset + i * import_descriptor_size;
+            const uint32_t name_rva = reader.read<uint32_t>(descriptor_offset + 12);
+            const uint32_t first_thunk_rva = reader.read<uint32_t>(descriptor_offset + 16);
+            if (reader.has_failed())
+            {
+                return std::nullopt;
+            }
+            if (name_rva == 0 && first_thunk_rva == 0)
+            {
+                break;
+            }
+
+            const auto name_offset = rva_to_file_offset(name_rva);
+            if (!name_offset)
+            {
+                return std::nullopt;
+            }
+            auto name = reader.read_string(*name_offset, max_dll_name_length);
+            if (reader.has_failed())
+            {
+                return std::nullopt;
+            }
+            imported_dll_names.emplace_back(std::move(name));
+        }
+
+        return imported_dll_names;
+    }
+
+    auto find_mods_with_dependencies(std::span<const ModDlls> mods) -> std::vector<bool>
+    {
+        std::unordered_set<std::string_view> shipped_dll_names{};
+        for (const auto& mod : mods)
+        {
+            shipped_dll_names.insert(mod.own_dll_names.begin(), mod.own_dll_names.end());
+        }
+
+        std::vector<bool> has_dependencies(mods.size());
+        for (size_t mod_index = 0; mod_index < mods.size(); ++mod_index)
+        {
+            if (mods[mod_index].has_unknown_imports)
+            {
+                has_dependencies[mod_index] = true;
+                continue;
+            }
+
+            const auto& own_dll_names = mods[mod_index].own_dll_names;
+            for (const auto& imported_dll_name : mods[mod_index].imported_dll_names)
+            {
+                if (std::find(own_dll_names.begin(), own_dll_names.end(), imported_dll_name) != own_dll_names.end())
+                {
+                    continue;
+                }
+
+                if (shipped_dll_names.contains(imported_dll_name))
+                {
+                    has_dependencies[mod_index] = true;
+                    break;
+                }
+            }
+        }
+
+        return has_dependencies;
+    }
+
+    auto for_each_in_parallel(size_t count, size_t max_threads, const std::function<void(size_t)>& callable) -> void
+    {
+        std::atomic<size_t> next_index{};
+        std::exception_ptr first_exception{};
+        std::mutex exception_mutex{};
+
+        // Every thread takes the next index until there are none left, so slow items don't hold up the ones behind them
+        auto work = [&] {
+            for (size_t index = next_index.fetch_add(1); index < count; index = next_index.fetch_add(1))
+            {
+                try
+                {
+                    callable(index);
+                }
+                catch (...)
+                {
+                    std::lock_guard lock{exception_mutex};
+                    if (!first_exception)
+                    {
+                        first_exception = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        const size_t num_threads = std::min(count, std::max<size_t>(max_threads, 1));
+        {
+            std::vector<std::jthread> threads{};
+            for (size_t i = 1; i < num_threads; ++i)
+            {
+                threads.emplace_back(work);
+            }
+            work();
+        }
+
+        if (first_exception)
+        {
+            std::rethrow_exception(first_exception);
+        }
+    }
+} // namespace RC::ModLoadPipeline
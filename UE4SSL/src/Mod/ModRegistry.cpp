@@ -0,0 +1,113 @@
+#include <algorithm>
+
+#include <Mod/CppMod.hpp>
+#include <Mod/ModRegistry.hpp>
+
+namespace RC
+{
+    auto ModRegistry::add(std::unique_ptr<Mod> mod) -> Mod&
+    {
+        auto& added_mod = *m_mods.emplace_back(std::move(mod));
+        m_mods_by_name.try_emplace(StringType{added_mod.get_name()}, &added_mod);
+        if (auto cpp_mod = dynamic_cast<CppMod*>(&added_mod); cpp_mod)
+        {
+            m_cpp_mods.emplace_back(cpp_mod);
+        }
+        return added_mod;
+    }
+
+    auto ModRegistry::insert(size_t index, std::unique_ptr<Mod> mod) -> Mod&
+    {
+        if (index >= m_mods.size())
+        {
+            return add(std::move(mod));
+        }
+
+        auto& inserted_mod = **m_mods.emplace(m_mods.begin() + static_cast<ptrdiff_t>(index), std::move(mod));
+
+        // A duplicate that was added earlier but comes after the inserted mod would stay the mod that the name refers to
+        // Mods are only inserted when they're re-installed, so finding the first mod with the name again is cheap enough
+        const auto name = inserted_mod.get_name();
+        auto first_mod_with_name = std::find_if(m_mods.begin(), m_mods.end(), [&](const std::unique_ptr<Mod>& other_mod) {
+            return other_mod->get_name() == name;
+        });
+        m_mods_by_name.insert_or_assign(StringType{name}, first_mod_with_name->get());
+
+        rebuild_type_lists();
+        return inserted_mod;
+    }
+
+    auto ModRegistry::remove(const Mod* mod) -> std::optional<size_t>
+    {
+        auto removed_mod = std::find_if(m_mods.begin(), m_mods.end(), [&](const std::unique_ptr<Mod>& other_mod) {
+            return other_mod.get() == mod;
+        });
+        if (removed_mod == m_mods.end())
+        {
+            return std::nullopt;
+        }
+
+        // The mod is destroyed last, so that nothing that it does while it's destroyed finds it in the registry
+        const auto index = static_cast<size_t>(std::distance(m_mods.begin(), removed_mod));
+        auto owned_mod = std::move(*removed_mod);
+        const StringType name{owned_mod->get_name()};
+        m_mods.erase(removed_mod);
+
+        // The name goes to the next mod with the same name, if there is one
+        if (auto name_entry = m_mods_by_name.find(name); name_entry != m_mods_by_name.end() && name_entry->second == mod)
+        {
+            auto next_mod_with_name = std::find_if(m_mods.begin(), m_mods.end(), [&](const std::unique_ptr<Mod>& other_mod) {
+                return other_mod->get_name() == name;
+            });
+            if (next_mod_with_name != m_mods.end())
+            {
+                name_entry->second = next_mod_with_name->get();
+            }
+            else
+            {
+                m_mods_by_name.erase(name_entry);
+            }
+        }
+
+        rebuild_type_lists();
+        owned_mod.reset();
+        return index;
+    }
+
+    auto ModRegistry::clear() -> void
+    {
+        // The registry is empty before the first mod is destroyed, for the same reason as in 'remove'
+        auto mods = std::move(m_mods);
+        m_mods.clear();
+        m_mods_by_name.clear();
+        m_cpp_mods.clear();
+        mods.clear();
+    }
+
+    auto ModRegistry::find(StringViewType name) const -> Mod*
+    {
+        if (auto name_entry = m_mods_by_name.find(name); name_entry != m_mods_by_name.end())
+        {
+            return name_entry->second;
+        }
+        return nullptr;
+    }
+
+    auto ModRegistry::is_duplicate(const Mod& mod) const -> bool
+    {
+        const auto first_mod_with_name = find(mod.get_name());
+        return first_mod_with_name && first_mod_with_name != &mod;
+    }
+
+    auto ModRegistry::rebuild_type_lists() -> void
+    {
+        m_cpp_mods.clear();
+        for (const auto& mod : m_mods)
+        {
+            if (auto cpp_mod = dynamic_cast<CppMod*>(mod.get()); cpp_mod)
+            {
+                m_cpp_mods.emplace_back(cpp_mod);
+            }
+        }
+    }
+} // namespace RC
@@ -5,17 +5,27 @@
 auto default_setting = LR""""(
 [General]
 EnableHotReloadSystem = 1
+ReloadModsOnFileChange = 1
+ModFileSettleTimeMs = 500
 UseCache = 1
 InvalidateCacheIfDLLDiffers = 1
 SecondsToScanBeforeGivingUp = 30
 bUseUObjectArrayCache = true
+ModUpdateBudgetMs = 8
+ModLoadingThreads = 0
 
 [Debug]
 ConsoleEnabled = 0
 
+[Logging]
+AsyncLogging = 1
+DropLogMessagesWhenQueueIsFull = 0
+LogQueueCapacity = 8192
+MinimumLogLevel = Verbose
+
 [Threads]
 SigScannerNumThreads = 8
-SigScannerMultithreadingModuleSizeThreshold = 16777216
+SigScannerMultithreadingModuleSizeThreshold = 2097152
 
 [Memory]
 MaxMemoryUsageDuringAssetLoading = 80
@@ -96,11 +106,15 @@ namespace RC
 
         constexpr static File::CharType section_general[] = STR("General");
         REGISTER_BOOL_SETTING(General.EnableHotReloadSystem, section_general, EnableHotReloadSystem)
+        REGISTER_BOOL_SETTING(General.ReloadModsOnFileChange, section_general, ReloadModsOnFileChange)
+        REGISTER_INT64_SETTING(General.ModFileSettleTimeMs, section_general, ModFileSettleTimeMs)
         REGISTER_BOOL_SETTING(General.UseCache, section_general, UseCache)
         REGISTER_BOOL_SETTING(General.InvalidateCacheIfDLLDiffers, section_general, InvalidateCacheIfDLLDiffers)
         REGISTER_BOOL_SETTING(General.EnableDebugKeyBindings, section_general, EnableDebugKeyBindings)
         REGISTER_INT64_SETTING(General.SecondsToScanBeforeGivingUp, section_general, SecondsToScanBeforeGivingUp)
         REGISTER_BOOL_SETTING(General.UseUObjectArrayCache, section_general, bUseUObjectArrayCache)
+        REGISTER_INT64_SETTING(General.ModUpdateBudgetMs, section_general, ModUpdateBudgetMs)
+        REGISTER_INT64_SETTING(General.ModLoadingThreads, section_general, ModLoadingThreads)
 
         // constexpr static File::CharType section_engine_version_override[] = STR("EngineVersionOverride");
         // REGISTER_INT64_SETTING(EngineVersionOverride.MajorVersion, section_engine_version_override, MajorVersion)
@@ -131,6 +145,20 @@ namespace RC
         StringType graphics_api_string{};
         REGISTER_STRING_SETTING(graphics_api_string, section_debug, GraphicsAPI)
 
+        constexpr static File::CharType section_logging[] = STR("Logging");
+        REGISTER_BOOL_SETTING(Logging.AsyncLogging, section_logging, AsyncLogging)
+        REGISTER_BOOL_SETTING(Logging.DropLogMessagesWhenQueueIsFull, section_logging, DropLogMessagesWhenQueueIsFull)
+        REGISTER_INT64_SETTING(Logging.LogQueueCapacity, section_logging, LogQueueCapacity)
+        REGISTER_STRING_SETTING(Logging.MinimumLogLevel, section_logging, MinimumLogLevel)
+        REGISTER_STRING_SETTING(Logging.FileMinimumLogLevel, section_logging, FileMinimumLogLevel)
+        REGISTER_STRING_SETTING(Logging.ConsoleMinimumLogLevel, section_logging, ConsoleMinimumLogLevel)
+        REGISTER_INT64_SETTING(Logging.LogFileBufferSize, section_logging, LogFileBufferSize)
+        REGISTER_INT64_SETTING(Logging.LogFileFlushIntervalMs, section_logging, LogFileFlushIntervalMs)
+        REGISTER_INT64_SETTING(Logging.MaxLogFileSizeMB, section_logging, MaxLogFileSizeMB)
+        REGISTER_INT64_SETTING(Logging.NumOldLogFilesToKeep, section_logging, NumOldLogFilesToKeep)
+        REGISTER_BOOL_SETTING(Logging.EnableTraceLog, section_logging, EnableTraceLog)
+        REGISTER_BOOL_SETTING(Logging.LogLayoutEntries, section_logging, LogLayoutEntries)
+
         constexpr static File::CharType section_crash_dump[] = STR("CrashDump");
         REGISTER_BOOL_SETTING(CrashDump.EnableDumping, section_crash_dump, EnableDumping);
         REGISTER_BOOL_SETTING(CrashDump.FullMemoryDump, section_crash_dump, FullMemoryDump);
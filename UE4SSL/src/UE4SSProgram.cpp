@@ -11,6 +11,7 @@
 #include <format>
 #include <fstream>
 #include <limits>
+#include <thread>
 #include <unordered_set>
 #include <fmt/chrono.h>
 #include <DynamicOutput/DynamicOutput.hpp>
@@ -19,6 +20,7 @@
 #include <Helpers/Format.hpp>
 #include <Helpers/Integer.hpp>
 #include <Helpers/String.hpp>
+#include <IniParser/CompiledIni.hpp>
 #include <IniParser/Ini.hpp>
 #include <Mod/CppMod.hpp>
 #include <Mod/Mod.hpp>
@@ -156,9 +158,35 @@ namespace RC
             // Setup the log file
             auto& file_device = Output::set_default_devices<Output::NewFileDevice>();
             file_device.set_file_name_and_path(ensure_str((m_log_directory / m_log_file_name)));
+            file_device.set_minimum_log_level(LogLevel::from_string(settings_manager.Logging.FileMinimumLogLevel).value_or(LogLevel::Verbose));
+            file_device.set_buffer_options({
+                    .flush_threshold = static_cast<size_t>(std::max(settings_manager.Logging.LogFileBufferSize, int64_t{0})),
+                    .max_delay = std::chrono::milliseconds{std::max(settings_manager.Logging.LogFileFlushIntervalMs, int64_t{0})},
+            });
+            file_device.set_rotation_options({
+                    .max_file_size = static_cast<uint64_t>(std::max(settings_manager.Logging.MaxLogFileSizeMB, int64_t{0})) * 1024 * 1024,
+                    .max_num_segments = static_cast<uint32_t>(std::clamp(settings_manager.Logging.NumOldLogFilesToKeep, int64_t{0}, int64_t{1000})),
+            });
+            Output::set_minimum_log_level(LogLevel::from_string(settings_manager.Logging.MinimumLogLevel).value_or(LogLevel::Verbose));
+
+            if (settings_manager.Logging.EnableTraceLog)
+            {
+                m_trace_device = std::make_unique<Output::BinaryLogDevice>();
+                m_trace_device->set_file_name_and_path(m_log_directory / m_trace_file_name);
+                Output::set_trace_device(m_trace_device.get());
+            }
 
             create_simple_console();
 
+            if (settings_manager.Logging.AsyncLogging)
+            {
+                Output::enable_async_output({
+                        .queue_capacity = static_cast<size_t>(std::max(settings_manager.Logging.LogQueueCapacity, int64_t{2})),
+                        .overflow_policy = settings_manager.Logging.DropLogMessagesWhenQueueIsFull ? Output::AsyncOverflowPolicy::Drop
+                                                                                                   : Output::AsyncOverflowPolicy::Block,
+                });
+            }
+
             Output::send(STR("Console created\n"));
             Output::send(STR("UE4SS - v{}.{}.{}{}{} - Git SHA #{}\n"),
                          UE4SS_LIB_VERSION_MAJOR,
@@ -247,12 +275,18 @@ namespace RC
     UE4SSProgram::~UE4SSProgram()
     {
         // Shut down the event loop
+        // The input source notifies the event scheduler, which is destroyed before the input handler
+        m_input_handler.stop();
+        m_mod_file_watcher.reset();
         m_processing_events = false;
+        m_event_scheduler.notify();
 
         // It's possible that main() will destroy the default devices (they are static)
         // However it's also possible that this program object is constructed in a context where main() is not gonna immediately exit
         // Because of that and because the default devices are created in the constructor, it's preferred to explicitly close all default devices in the destructor
         Output::close_all_default_devices();
+        Output::set_trace_device(nullptr);
+        m_trace_device.reset();
     }
 
     auto UE4SSProgram::init() -> void
@@ -399,8 +433,9 @@ namespace RC
         {
             m_debug_console_device = &Output::set_default_devices<Output::DebugConsoleDevice>();
             Output::set_default_log_level<LogLevel::Normal>();
+            m_debug_console_device->set_minimum_log_level(LogLevel::from_string(settings_manager.Logging.ConsoleMinimumLogLevel).value_or(LogLevel::Verbose));
             m_debug_console_device->set_formatter([](File::StringViewType string) -> File::StringType {
-                return fmt::format(STR("[{}] {}"), fmt::format(STR("{:%X}"), std::chrono::system_clock::now()), string);
+                return fmt::format(STR("[{}] {}"), fmt::format(STR("{:%X}"), Output::OutputDevice::get_message_time()), string);
             });
 
             if (AllocConsole())
@@ -415,22 +450,65 @@ namespace RC
         }
     }
 
-    auto UE4SSProgram::load_unreal_offsets_from_file() -> void
+    auto UE4SSProgram::load_compiled_layout(const std::filesystem::path& ini_file_path, const std::function<void(const Ini::CompiledIni&)>& callable) -> void
     {
-        std::filesystem::path file_path = m_working_directory / "MemberVariableLayout.ini";
-        if (std::filesystem::exists(file_path))
+        if (!std::filesystem::exists(ini_file_path))
+        {
+            return;
+        }
+
+        auto ini_file = File::open(ini_file_path);
+        auto ini_contents = ini_file.read_all();
+        ini_file.close();
+        if (ini_contents.empty())
+        {
+            return;
+        }
+
+        // The compiled file is only used if it was compiled from the exact same text, so any edit to the INI file makes it compile again
+        auto compiled_file_path = m_root_directory / "cache" / ini_file_path.filename();
+        compiled_file_path.replace_extension(".bin");
+
+        // The strings in 'compiled_ini' point into the memory map, so the file must stay open until 'callable' returns
+        File::Handle compiled_file{};
+        std::span<uint8_t> compiled_data{};
+        if (settings_manager.General.UseCache && std::filesystem::exists(compiled_file_path))
         {
-            auto file = File::open(file_path);
-            if (auto file_contents = file.read_all(); !file_contents.empty())
+            try
             {
-                Ini::Parser parser;
-                parser.parse(file_contents);
-                file.close();
+                compiled_file = File::open(compiled_file_path);
+                compiled_data = compiled_file.memory_map();
+            }
+            catch (std::exception& e)
+            {
+                Output::send<LogLevel::Warning>(STR("Could not map {}, compiling it again: {}\n"), ensure_str(compiled_file_path), ensure_str(e.what()));
+            }
+        }
 
-                // The following code is auto-generated.
-#include <MacroSetter.hpp>
+        Ini::CompiledIni compiled_ini{};
+        if (!compiled_ini.load_or_compile(compiled_data, ini_contents) && settings_manager.General.UseCache)
+        {
+            // The stale file is no longer used, and Windows can't replace a file that is still mapped
+            compiled_file.close();
+            if (!Ini::CompiledIni::write_file(compiled_file_path, compiled_ini.get_owned_data()))
+            {
+                Output::send<LogLevel::Warning>(STR("Could not write {}, {} will be parsed again on the next start\n"),
+                                                ensure_str(compiled_file_path),
+                                                ensure_str(ini_file_path.filename()));
             }
         }
+        callable(compiled_ini);
+    }
+
+    auto UE4SSProgram::load_unreal_offsets_from_file() -> void
+    {
+        // The generated code reads the offsets from a variable called 'parser'
+        load_compiled_layout(m_working_directory / "MemberVariableLayout.ini", [&](const Ini::CompiledIni& parser) {
+            // The following code is auto-generated.
+#include <MacroSetter.hpp>
+
+            Output::send(STR("Loaded {} member variable offsets from MemberVariableLayout.ini\n"), parser.get_num_int64_values());
+        });
     }
 
     auto UE4SSProgram::setup_unreal() -> void
@@ -448,6 +526,21 @@ namespace RC
         config.SecondsToScanBeforeGivingUp = settings_manager.General.SecondsToScanBeforeGivingUp;
         config.bUseUObjectArrayCache = settings_manager.General.UseUObjectArrayCache;
 
+        // The results of AOB scans are cached next to the other caches so that a warm start doesn't scan unchanged game binaries again
+        if (settings_manager.General.UseCache)
+        {
+            uint64_t aob_cache_owner_tag{};
+            if (settings_manager.General.InvalidateCacheIfDLLDiffers)
+            {
+                // A different build of UE4SS may come with different signatures so everything is discarded when the DLL changes
+                std::error_code ec{};
+                const auto dll_size = static_cast<uint64_t>(std::filesystem::file_size(m_module_file_path, ec));
+                const auto dll_write_time = static_cast<uint64_t>(std::filesystem::last_write_time(m_module_file_path, ec).time_since_epoch().count());
+                aob_cache_owner_tag = dll_size ^ (dll_write_time * 0x9E3779B97F4A7C15);
+            }
+            SinglePassScanner::enable_result_cache(config.CachePath / "aob_scan_results.bin", aob_cache_owner_tag);
+        }
+
         // Retrieve from the config file the number of threads to be used for aob scanning
         {
             // The config system only directly supports signed 64-bit integers
@@ -502,79 +595,88 @@ namespace RC
         // Virtual function offset overrides
         TRY([&]() {
             // ProfilerScope();Named("loading virtual function offset overrides");
-            static File::StringType virtual_function_offset_override_file{ensure_str((m_working_directory / STR("VTableLayout.ini")))};
-            if (std::filesystem::exists(virtual_function_offset_override_file))
-            {
-                auto file =
-                        File::open(virtual_function_offset_override_file, File::OpenFor::Reading, File::OverwriteExistingFile::No, File::CreateIfNonExistent::No);
-                Ini::Parser parser;
-                parser.parse(file);
-
-                Output::send<Color::Blue>(STR("Getting ordered lists from ini file\n"));
+            load_compiled_layout(m_working_directory / STR("VTableLayout.ini"), [&](const Ini::CompiledIni& parser) {
+                // Every offset is only logged if asked for, there are hundreds of them
+                const bool log_entries = settings_manager.Logging.LogLayoutEntries;
 
                 auto calculate_virtual_function_offset = []<typename... BaseSizes>(uint32_t current_index, BaseSizes... base_sizes) -> uint32_t {
                     return current_index == 0 ? 0 : (current_index + (base_sizes + ...)) * 8;
                 };
 
-                auto retrieve_vtable_layout_from_ini = [&](const File::StringType& section_name, auto callable) -> uint32_t {
+                auto retrieve_vtable_layout_from_ini = [&](File::StringViewType section_name, auto callable) -> uint32_t {
                     auto list = parser.get_ordered_list(section_name);
                     uint32_t vtable_size = list.size() - 1;
-                    list.for_each([&](uint32_t index, File::StringType& item) {
+                    for (uint32_t index = 0; index < list.size(); ++index)
+                    {
+                        File::StringType item{list[index]};
                         callable(index, item);
-                    });
+                    }
                     return vtable_size;
                 };
 
-                Output::send<Color::Blue>(STR("UObjectBase\n"));
                 uint32_t uobjectbase_size = retrieve_vtable_layout_from_ini(STR("UObjectBase"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, 0);
-                    Output::send(STR("UObjectBase::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("UObjectBase::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::UObjectBase::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("UObjectBaseUtility\n"));
                 uint32_t uobjectbaseutility_size = retrieve_vtable_layout_from_ini(STR("UObjectBaseUtility"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, uobjectbase_size);
-                    Output::send(STR("UObjectBaseUtility::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("UObjectBaseUtility::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::UObjectBaseUtility::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("UObject\n"));
                 uint32_t uobject_size = retrieve_vtable_layout_from_ini(STR("UObject"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, uobjectbase_size, uobjectbaseutility_size);
-                    Output::send(STR("UObject::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("UObject::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::UObject::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("UField\n"));
                 uint32_t ufield_size = retrieve_vtable_layout_from_ini(STR("UField"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, uobjectbase_size, uobjectbaseutility_size, uobject_size);
-                    Output::send(STR("UField::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("UField::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::UField::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("UEngine\n"));
                 uint32_t uengine_size = retrieve_vtable_layout_from_ini(STR("UEngine"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, uobjectbase_size, uobjectbaseutility_size, uobject_size);
-                    Output::send(STR("UEngine::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("UEngine::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::UEngine::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("UScriptStruct::ICppStructOps\n"));
                 retrieve_vtable_layout_from_ini(STR("UScriptStruct::ICppStructOps"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, 0);
-                    Output::send(STR("UScriptStruct::ICppStructOps::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("UScriptStruct::ICppStructOps::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::UScriptStruct::ICppStructOps::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("FField\n"));
                 uint32_t ffield_size = retrieve_vtable_layout_from_ini(STR("FField"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, 0);
-                    Output::send(STR("FField::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("FField::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::FField::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("FProperty\n"));
                 uint32_t fproperty_size = retrieve_vtable_layout_from_ini(STR("FProperty"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset{};
                     if (Unreal::Version::IsBelow(4, 25))
@@ -585,7 +687,10 @@ namespace RC
                     {
                         offset = calculate_virtual_function_offset(index, ffield_size);
                     }
-                    Output::send(STR("FProperty::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("FProperty::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::FProperty::VTableLayoutMap.emplace(item, offset);
                 });
 
@@ -599,65 +704,80 @@ namespace RC
                     fproperty_size = ffield_size + fproperty_size;
                 }
 
-                Output::send<Color::Blue>(STR("FNumericProperty\n"));
                 retrieve_vtable_layout_from_ini(STR("FNumericProperty"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, fproperty_size);
-                    Output::send(STR("FNumericProperty::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("FNumericProperty::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::FNumericProperty::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("FMulticastDelegateProperty\n"));
                 retrieve_vtable_layout_from_ini(STR("FMulticastDelegateProperty"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, fproperty_size);
-                    Output::send(STR("FMulticastDelegateProperty::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("FMulticastDelegateProperty::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::FMulticastDelegateProperty::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("FObjectPropertyBase\n"));
                 retrieve_vtable_layout_from_ini(STR("FObjectPropertyBase"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, fproperty_size);
-                    Output::send(STR("FObjectPropertyBase::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("FObjectPropertyBase::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::FObjectPropertyBase::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("UStruct\n"));
                 retrieve_vtable_layout_from_ini(STR("UStruct"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, uobjectbase_size, uobjectbaseutility_size, uobject_size, ufield_size);
-                    Output::send(STR("UStruct::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("UStruct::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::UStruct::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("FOutputDevice\n"));
                 retrieve_vtable_layout_from_ini(STR("FOutputDevice"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, 0);
-                    Output::send(STR("FOutputDevice::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("FOutputDevice::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::FOutputDevice::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("FMalloc\n"));
                 retrieve_vtable_layout_from_ini(STR("FMalloc"), [&](uint32_t index, File::StringType& item) {
                     // We don't support FExec, so we're manually telling it the size.
                     static constexpr uint32_t fexec_size = 1;
                     uint32_t offset = calculate_virtual_function_offset(index, fexec_size);
-                    Output::send(STR("FMalloc::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("FMalloc::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::FMalloc::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("AActor\n"));
                 uint32_t aactor_size = retrieve_vtable_layout_from_ini(STR("AActor"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, uobjectbase_size, uobjectbaseutility_size, uobject_size);
-                    Output::send(STR("AActor::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("AActor::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::AActor::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("AGameModeBase\n"));
                 uint32_t agamemodebase_size = retrieve_vtable_layout_from_ini(STR("AGameModeBase"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, uobjectbase_size, uobjectbaseutility_size, uobject_size, aactor_size);
-                    Output::send(STR("AGameModeBase::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("AGameModeBase::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::AGameModeBase::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("AGameMode\n"));
                 retrieve_vtable_layout_from_ini(STR("AGameMode"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index,
                                                                         Unreal::Version::IsAtLeast(4, 14)
@@ -670,26 +790,35 @@ namespace RC
                                                                         uobjectbaseutility_size,
                                                                         uobject_size,
                                                                         aactor_size);
-                    Output::send(STR("AGameMode::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("AGameMode::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::AGameMode::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("UPlayer\n"));
                 uint32_t uplayer_size = retrieve_vtable_layout_from_ini(STR("UPlayer"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, uobjectbase_size, uobjectbaseutility_size, uobject_size);
-                    Output::send(STR("UPlayer::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("UPlayer::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::UPlayer::VTableLayoutMap.emplace(item, offset);
                 });
 
-                Output::send<Color::Blue>(STR("ULocalPlayer\n"));
                 retrieve_vtable_layout_from_ini(STR("ULocalPlayer"), [&](uint32_t index, File::StringType& item) {
                     uint32_t offset = calculate_virtual_function_offset(index, uobjectbase_size, uobjectbaseutility_size, uobject_size, uplayer_size);
-                    Output::send(STR("ULocalPlayer::{} = 0x{:X}\n"), item, offset);
+                    if (log_entries)
+                    {
+                        Output::send(STR("ULocalPlayer::{} = 0x{:X}\n"), item, offset);
+                    }
                     Unreal::ULocalPlayer::VTableLayoutMap.emplace(item, offset);
                 });
 
-                file.close();
-            }
+                Output::send(STR("Loaded {} virtual function offsets in {} classes from VTableLayout.ini\n"),
+                             parser.get_num_ordered_list_items(),
+                             parser.get_num_sections());
+            });
         });
 
         config.bHookProcessInternal = settings_manager.Hooks.HookProcessInternal;
@@ -743,6 +872,13 @@ namespace RC
 
         TRY([&] {
 
+            if (settings_manager.General.EnableDebugKeyBindings)
+            {
+                m_input_handler.register_keydown_event(Input::Key::U, {Input::ModifierKey::CONTROL}, [&]() {
+                    dump_mod_update_stats();
+                });
+            }
+
             if (settings_manager.General.EnableHotReloadSystem)
             {
                 m_input_handler.register_keydown_event(Input::Key::R, {Input::ModifierKey::CONTROL}, [&]() {
@@ -768,55 +904,188 @@ namespace RC
     {
         on_program_start();
 
+        // Nothing wakes the event loop up when the engine starts shutting down
+        static constexpr auto paused_poll_interval = std::chrono::milliseconds{100};
+
+        // Key presses wake the event loop up, so key binds cost nothing while no key is pressed
+        m_input_handler.set_event_notifier([this] {
+            m_event_scheduler.notify();
+        });
+        if (!m_input_handler.start(Input::make_platform_input_source(m_input_handler.get_window_classes())))
+        {
+            Output::send<LogLevel::Warning>(STR("Could not start the input source, key binds will not work\n"));
+        }
+        start_mod_file_watcher();
+
         Output::send(STR("Event loop start\n"));
+        m_event_loop_thread_id = std::this_thread::get_id();
         for (m_processing_events = true; m_processing_events;)
         {
-            if (m_pause_events_processing || UE4SSProgram::unreal_is_shutting_down)
+            if (m_event_scheduler.is_paused() || UE4SSProgram::unreal_is_shutting_down)
             {
+                // Resuming event processing notifies the scheduler, the timeout only matters for the shutdown case
+                m_event_scheduler.wait_until(EventScheduler::Clock::now() + paused_poll_interval);
                 continue;
             }
 
-            if (!is_queue_empty())
+            process_queued_events();
+
+            m_input_handler.process_event();
+
+            if (m_mod_file_watcher)
             {
-                static constexpr size_t max_events_executed_per_frame = 5;
-                size_t num_events_executed{};
-                std::lock_guard<std::mutex> guard(m_event_queue_mutex);
-                m_queued_events.erase(std::remove_if(m_queued_events.begin(),
-                                                     m_queued_events.end(),
-                                                     [&](Event& event) -> bool {
-                                                         if (num_events_executed >= max_events_executed_per_frame)
-                                                         {
-                                                             return false;
-                                                         }
-                                                         ++num_events_executed;
-                                                         event.callable(event.data);
-                                                         return true;
-                                                     }),
-                                      m_queued_events.end());
+                if (auto changes = m_mod_file_watcher->take_settled_changes(File::FileWatcher::Clock::now()); !changes.empty())
+                {
+                    reinstall_changed_mods(changes);
+                }
             }
 
-            m_input_handler.process_event();
+            apply_mod_update_requests();
+
+            // The loop sleeps until the earliest of: the next queued event, the next key press or the next mod that's due for an update
+            auto now = EventScheduler::Clock::now();
+            auto next_wakeup_time = EventScheduler::Clock::time_point::max();
 
+            // Mods that are due once the budget is used up are deferred, and the next iteration starts with the first of them
+            const auto update_budget = std::chrono::microseconds{std::max<int64_t>(settings_manager.General.ModUpdateBudgetMs, 0) * 1000};
+            const auto update_budget_end_time = now + update_budget;
+            const size_t num_mods = m_mods.size();
+            std::optional<size_t> first_deferred_mod{};
+            for (size_t i = 0; i < num_mods; ++i)
             {
-             
-                for (auto& mod : m_mods)
+                const size_t mod_index = (m_first_mod_to_update + i) % num_mods;
+                auto& mod = m_mods[mod_index];
+                if (!mod->is_started())
                 {
-                    if (mod->is_started())
-                    {
-                        mod->fire_update();
-                    }
+                    continue;
                 }
+
+                const bool is_budget_used_up = update_budget.count() > 0 && EventScheduler::Clock::now() >= update_budget_end_time;
+                const auto next_update_time = mod->fire_update_if_due(now, update_budget, is_budget_used_up);
+                if (is_budget_used_up && next_update_time <= now && !first_deferred_mod)
+                {
+                    first_deferred_mod = mod_index;
+                }
+                next_wakeup_time = std::min(next_wakeup_time, next_update_time);
+            }
+            m_first_mod_to_update = first_deferred_mod.value_or(0);
+
+            if (auto next_settle_time = m_mod_file_watcher ? m_mod_file_watcher->get_next_settle_time() : std::nullopt; next_settle_time)
+            {
+                next_wakeup_time = std::min(next_wakeup_time, *next_settle_time);
+            }
+
+            m_event_scheduler.wait_until(next_wakeup_time);
+        }
+
+        const auto event_queue_stats = get_event_queue_stats();
+        Output::send(STR("Event loop end, {} events queued, {} rejected while full, {} waits for room, at most {} queued at once\n"),
+                     event_queue_stats.queue.num_pushed,
+                     event_queue_stats.queue.num_rejected,
+                     event_queue_stats.num_full_waits,
+                     event_queue_stats.queue.high_water_mark);
+    }
+
+    auto UE4SSProgram::process_queued_events() -> void
+    {
+        // Every event that was queued up to this point is executed, events queued by these events are executed in the next iteration
+        m_queued_events.drain(
+                [](Event&& event) {
+                    event.callable(event.data);
+                },
+                m_queued_events.size());
+    }
+
+    auto UE4SSProgram::set_mod_update_interval(CppUserModBase* mod, std::optional<std::chrono::milliseconds> interval) -> void
+    {
+        queue_mod_update_request({mod, ModUpdateRequest::Type::SetInterval, interval});
+    }
+
+    auto UE4SSProgram::request_mod_update(CppUserModBase* mod) -> void
+    {
+        queue_mod_update_request({mod, ModUpdateRequest::Type::Update});
+    }
+
+    auto UE4SSProgram::queue_mod_update_request(const ModUpdateRequest& request) -> void
+    {
+        // The event loop applies its own requests right away
+        // An update it requested while updating mods may be for a mod it already went past, the notification makes it go around once more
+        if (std::this_thread::get_id() != m_event_loop_thread_id || !apply_mod_update_request(request))
+        {
+            std::lock_guard<std::mutex> guard(m_mod_update_requests_mutex);
+            m_mod_update_requests.emplace_back(request);
+        }
+        else if (request.type == ModUpdateRequest::Type::SetInterval)
+        {
+            return;
+        }
+        m_event_scheduler.notify();
+    }
+
+    auto UE4SSProgram::apply_mod_update_request(const ModUpdateRequest& request) -> bool
+    {
+        for (auto cpp_mod : m_mods.get_cpp_mods())
+        {
+            if (cpp_mod->get_user_mod() != request.mod)
+            {
+                continue;
+            }
+
+            switch (request.type)
+            {
+            case ModUpdateRequest::Type::SetInterval:
+                cpp_mod->set_update_interval(request.interval);
+                break;
+            case ModUpdateRequest::Type::Update:
+                cpp_mod->request_update();
+                break;
             }
+            return true;
+        }
+        return false;
+    }
+
+    auto UE4SSProgram::apply_mod_update_requests() -> void
+    {
+        std::vector<ModUpdateRequest> requests{};
+        {
+            std::lock_guard<std::mutex> guard(m_mod_update_requests_mutex);
+            requests.swap(m_mod_update_requests);
+        }
+        if (requests.empty())
+        {
+            return;
+        }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        // Requests from mods that are still being constructed are kept until the mod has started, the mod's destructor discards them if it never does
+        std::erase_if(requests, [&](const ModUpdateRequest& request) {
+            return apply_mod_update_request(request);
+        });
+        if (!requests.empty())
+        {
+            std::lock_guard<std::mutex> guard(m_mod_update_requests_mutex);
+            m_mod_update_requests.insert(m_mod_update_requests.begin(), requests.begin(), requests.end());
         }
-        Output::send(STR("Event loop end\n"));
+    }
+
+    auto UE4SSProgram::discard_mod_update_requests(const CppUserModBase* mod) -> void
+    {
+        std::lock_guard<std::mutex> guard(m_mod_update_requests_mutex);
+        std::erase_if(m_mod_update_requests, [&](const ModUpdateRequest& request) {
+            return request.mod == mod;
+        });
     }
 
     auto UE4SSProgram::setup_unreal_properties() -> void
     {
     }
 
+    static auto get_mod_loading_threads() -> size_t
+    {
+        const auto configured_threads = UE4SSProgram::settings_manager.General.ModLoadingThreads;
+        return configured_threads > 0 ? static_cast<size_t>(configured_threads) : std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 8);
+    }
+
     auto UE4SSProgram::setup_mods() -> void
     {
         Output::send(STR("Setting up mods...\n"));
@@ -828,11 +1097,11 @@ namespace RC
 
         // Setup UE4SSL.CSharp.dll (only if file exists)
         if (std::filesystem::exists(m_working_directory / STR("UE4SSL.CSharp.dll")))
-            m_mods.emplace_back(std::make_unique<CppMod>(*this, STR("UE4SSL.CSharp"), ensure_str(m_working_directory), STR("UE4SSL.CSharp.dll")));
+            m_mods.add(std::make_unique<CppMod>(*this, STR("UE4SSL.CSharp"), ensure_str(m_working_directory), STR("UE4SSL.CSharp.dll")));
 
         // Setup UE4SSL.JavaScript.dll (only if file exists)
         if (std::filesystem::exists(m_working_directory / STR("UE4SSL.JavaScript.dll")))
-            m_mods.emplace_back(std::make_unique<CppMod>(*this, STR("UE4SSL.JavaScript"), ensure_str(m_working_directory), STR("UE4SSL.JavaScript.dll")));
+            m_mods.add(std::make_unique<CppMod>(*this, STR("UE4SSL.JavaScript"), ensure_str(m_working_directory), STR("UE4SSL.JavaScript.dll")));
 
         for (const auto& sub_directory : std::filesystem::directory_iterator(m_mods_directory))
         {
@@ -859,13 +1128,16 @@ namespace RC
             {
                 // Create the mod but don't install it yet
                 if (std::filesystem::exists(sub_directory.path() / "main.dll"))
-                    m_mods.emplace_back(std::make_unique<CppMod>(*this, ensure_str(sub_directory.path().stem()), ensure_str(sub_directory.path())));
+                    m_mods.add(std::make_unique<CppMod>(*this, ensure_str(sub_directory.path().stem()), ensure_str(sub_directory.path())));
             }
         }
+
+        // The DLLs are loaded here instead of by each constructor so that mods that don't depend on each other can be loaded at the same time
+        CppMod::load_all(m_mods.get_cpp_mods(), get_mod_loading_threads());
     }
 
     template <typename ModType>
-    auto install_mods(std::vector<std::unique_ptr<Mod>>& mods) -> void
+    auto install_mods(ModRegistry& mods) -> void
     {
         
         for (auto& mod : mods)
@@ -875,11 +1147,8 @@ namespace RC
                 continue;
             }
 
-            bool mod_name_is_taken = std::find_if(mods.begin(), mods.end(), [&](auto& elem) {
-                                         return elem->get_name() == mod->get_name();
-                                     }) == mods.end();
-
-            if (mod_name_is_taken)
+            // The first mod with a name keeps it, the mods after it with the same name aren't installed
+            if (mods.is_duplicate(*mod))
             {
                 mod->set_installable(false);
                 Output::send(STR("Mod name '{}' is already in use.\n"), mod->get_name());
@@ -910,51 +1179,34 @@ namespace RC
 
     auto UE4SSProgram::fire_unreal_init_for_cpp_mods() -> void
     {
-        
-        for (const auto& mod : m_mods)
+        for (auto mod : m_mods.get_cpp_mods())
         {
-            if (!dynamic_cast<CppMod*>(mod.get()))
-            {
-                continue;
-            }
             mod->fire_unreal_init();
         }
     }
 
     auto UE4SSProgram::fire_ui_init_for_cpp_mods() -> void
     {
-        
-        for (const auto& mod : m_mods)
+        for (auto mod : m_mods.get_cpp_mods())
         {
-            if (!dynamic_cast<CppMod*>(mod.get()))
-            {
-                continue;
-            }
             mod->fire_ui_init();
         }
     }
 
     auto UE4SSProgram::fire_program_start_for_cpp_mods() -> void
     {
-        
-        for (const auto& mod : m_mods)
+        for (auto mod : m_mods.get_cpp_mods())
         {
-            if (!dynamic_cast<CppMod*>(mod.get()))
-            {
-                continue;
-            }
             mod->fire_program_start();
         }
     }
 
     auto UE4SSProgram::fire_dll_load_for_cpp_mods(StringViewType dll_name) -> void
     {
-        for (const auto& mod : m_mods)
+        // Called by the LoadLibrary hooks, which can be hit many times while the game is loading
+        for (auto mod : m_mods.get_cpp_mods())
         {
-            if (auto cpp_mod = dynamic_cast<CppMod*>(mod.get()); cpp_mod)
-            {
-                cpp_mod->fire_dll_load(dll_name);
-            }
+            mod->fire_dll_load(dll_name);
         }
     }
 
@@ -1061,21 +1313,140 @@ namespace RC
 
     auto UE4SSProgram::uninstall_mods() -> void
     {
-        std::vector<CppMod*> cpp_mods{};
-        for (auto& mod : m_mods)
+        for (auto mod : m_mods.get_cpp_mods())
+        {
+            mod->uninstall();
+        }
+
+        m_mods.clear();
+    }
+
+    auto UE4SSProgram::start_mod_file_watcher() -> void
+    {
+        if (!settings_manager.General.EnableHotReloadSystem || !settings_manager.General.ReloadModsOnFileChange)
         {
-            if (auto cpp_mod = dynamic_cast<CppMod*>(mod.get()); cpp_mod)
+            return;
+        }
+
+        const auto settle_time = std::chrono::milliseconds{std::max<int64_t>(settings_manager.General.ModFileSettleTimeMs, 0)};
+        auto watcher = std::make_unique<File::FileWatcher>(File::make_platform_file_watcher_backend(), settle_time);
+
+        // Only the DLLs of the mods in the working directory are watched, the log files next to them change all the time
+        // Mods write logs and configs into their own folders while they run, only the DLLs and scripts that make up a mod are watched there
+        const auto mods_directory_watch_id = watcher->watch_directory(m_mods_directory, {}, {STR(".dll"), STR(".js"), STR(".mjs")});
+        const auto working_directory_watch_id = watcher->watch_directory(m_working_directory, {STR("UE4SSL.CSharp.dll"), STR("UE4SSL.JavaScript.dll")});
+        watcher->set_change_notifier([this] {
+            m_event_scheduler.notify();
+        });
+        if (!mods_directory_watch_id || !working_directory_watch_id || !watcher->start())
+        {
+            Output::send<LogLevel::Warning>(STR("Could not watch the mod files, mods will only be re-installed with CTRL + R\n"));
+            return;
+        }
+
+        m_mods_directory_watch_id = *mods_directory_watch_id;
+        m_working_directory_watch_id = *working_directory_watch_id;
+        m_mod_file_watcher = std::move(watcher);
+        Output::send(STR("Watching mod files, mods are re-installed {} ms after their files stop changing\n"), settle_time.count());
+    }
+
+    auto UE4SSProgram::reinstall_changed_mods(const std::vector<File::FileChange>& changes) -> void
+    {
+        // Changes that were lost can't be traced back to a mod
+        if (std::any_of(changes.begin(), changes.end(), [](const File::FileChange& change) {
+                return change.entry_name.empty();
+            }))
+        {
+            Output::send(STR("Lost track of which mod files changed\n"));
+            reinstall_mods();
+            return;
+        }
+
+        // A folder without a C++ mod may hold a script, which is run by the JavaScript host mod together with every other script
+        // The host is re-installed instead, once no matter how many scripts changed
+        static constexpr CharType javascript_host_dll_name[] = STR("UE4SSL.JavaScript.dll");
+        std::vector<File::FileChange> mod_changes{};
+        for (const auto& change : changes)
+        {
+            auto mod_change = change;
+            if (change.directory_id == m_mods_directory_watch_id)
             {
-                cpp_mods.emplace_back(cpp_mod);
+                StringType entry_name_lowercase = ensure_str(change.entry_name);
+                std::transform(entry_name_lowercase.begin(), entry_name_lowercase.end(), entry_name_lowercase.begin(), std::towlower);
+                if (entry_name_lowercase == STR("shared"))
+                {
+                    continue;
+                }
+
+                const auto mod_path = m_mods_directory / change.entry_name;
+                const bool is_script_mod = !std::filesystem::exists(mod_path / STR("main.dll")) &&
+                                           (std::filesystem::exists(mod_path / STR("js")) ||
+                                            !find_mod_by_name<CppMod>(StringViewType{ensure_str(change.entry_name)}));
+                if (is_script_mod)
+                {
+                    if (!std::filesystem::exists(m_working_directory / javascript_host_dll_name))
+                    {
+                        continue;
+                    }
+                    mod_change = File::FileChange{m_working_directory_watch_id, javascript_host_dll_name};
+                }
+            }
+
+            if (std::find(mod_changes.begin(), mod_changes.end(), mod_change) == mod_changes.end())
+            {
+                mod_changes.emplace_back(std::move(mod_change));
             }
         }
 
-        for (auto& mod : cpp_mods)
+        std::vector<CppMod*> new_mods{};
+        for (const auto& change : mod_changes)
         {
-            mod->uninstall();
+            // Mods in the working directory are named after their DLL, mods in the mods directory are named after their folder
+            const bool is_working_directory_mod = change.directory_id == m_working_directory_watch_id;
+            auto mod_name = ensure_str(change.entry_name.stem());
+            auto mod_path = is_working_directory_mod ? m_working_directory : m_mods_directory / change.entry_name;
+            auto dll_name = is_working_directory_mod ? change.entry_name : std::filesystem::path{STR("main.dll")};
+
+            // The mod takes the place of its old version, so that the order that mods are updated in doesn't change
+            auto mod_index = m_mods.size();
+            if (auto old_mod = find_mod_by_name<CppMod>(StringViewType{mod_name}); old_mod)
+            {
+                old_mod->uninstall();
+                mod_index = m_mods.remove(old_mod).value_or(mod_index);
+            }
+
+            if (!std::filesystem::exists(mod_path / dll_name))
+            {
+                Output::send(STR("Mod '{}' was removed\n"), mod_name);
+                continue;
+            }
+
+            auto& new_mod = m_mods.insert(mod_index, std::make_unique<CppMod>(*this, std::move(mod_name), ensure_str(mod_path), ensure_str(dll_name)));
+            new_mods.emplace_back(static_cast<CppMod*>(&new_mod));
         }
 
-        m_mods.clear();
+        CppMod::load_all(new_mods, get_mod_loading_threads());
+        for (auto mod : new_mods)
+        {
+            if (!mod->is_installable())
+            {
+                Output::send(STR("Was unable to install mod '{}' for unknown reasons. Mod is not installable.\n"), mod->get_name());
+                continue;
+            }
+
+            Output::send(STR("Starting mod '{}' because its files changed\n"), mod->get_name());
+            mod->set_installed(true);
+            mod->start_mod();
+
+            if (Unreal::UnrealInitializer::StaticStorage::bIsInitialized)
+            {
+                mod->fire_unreal_init();
+            }
+            if (is_program_started())
+            {
+                mod->fire_program_start();
+            }
+        }
     }
 
     auto UE4SSProgram::is_program_started() -> bool
@@ -1088,8 +1459,14 @@ namespace RC
         
         Output::send(STR("Re-installing all mods\n"));
 
+        // Every mod is re-installed, so the changes that haven't settled yet are already covered
+        if (m_mod_file_watcher)
+        {
+            m_mod_file_watcher->take_settled_changes(File::FileWatcher::Clock::time_point::max());
+        }
+
         // Stop processing events while stuff isn't properly setup
-        m_pause_events_processing = true;
+        m_event_scheduler.pause();
 
         uninstall_mods();
 
@@ -1119,7 +1496,7 @@ namespace RC
 
         // Start processing events again as everything is now properly setup
         // Do this before mods are started or else you won't be able to use the hot-reload key bind if there's an error from Lua
-        m_pause_events_processing = false;
+        m_event_scheduler.resume();
 
         setup_mods();
         start_cpp_mods();
@@ -1168,14 +1545,76 @@ namespace RC
         {
             return;
         }
-        std::lock_guard<std::mutex> guard(m_event_queue_mutex);
-        m_queued_events.emplace_back(Event{callable, data});
+
+        const Event event{callable, data};
+        for (bool has_waited{}; !m_queued_events.try_push(event);)
+        {
+            if (std::this_thread::get_id() == m_event_loop_thread_id)
+            {
+                // Waiting would never end since this is the thread that empties the queue, the events in front of this one are executed right away instead
+                process_queued_events();
+                continue;
+            }
+
+            // The event loop stopped while this thread was waiting for room, the event would never be executed
+            if (!can_process_events())
+            {
+                return;
+            }
+
+            if (!has_waited)
+            {
+                m_num_event_queue_full_waits.fetch_add(1, std::memory_order_relaxed);
+                has_waited = true;
+            }
+            m_event_scheduler.notify();
+            std::this_thread::yield();
+        }
+        m_event_scheduler.notify();
     }
 
     auto UE4SSProgram::is_queue_empty() -> bool
     {
-        // Not locking here because if the worst that could happen as far as I know is that the event loop processes the event slightly late.
-        return m_queued_events.empty();
+        return m_queued_events.is_empty();
+    }
+
+    auto UE4SSProgram::get_mod_update_stats(StringViewType mod_name) -> std::optional<ModUpdateStats>
+    {
+        if (auto mod = m_mods.find(mod_name); mod)
+        {
+            return mod->get_update_stats();
+        }
+        return std::nullopt;
+    }
+
+    auto UE4SSProgram::dump_mod_update_stats() -> void
+    {
+        Output::send(STR("Mod update stats (budget: {} ms):\n"), settings_manager.General.ModUpdateBudgetMs);
+        for (const auto& mod : m_mods)
+        {
+            if (!mod->is_started())
+            {
+                continue;
+            }
+
+            const auto stats = mod->get_update_stats();
+            Output::send(STR("  {}: {} updates, p50 {} us, p99 {} us, max {} us, {} deferred, throttle factor {}\n"),
+                         mod->get_name(),
+                         stats.num_updates,
+                         stats.p50_microseconds,
+                         stats.p99_microseconds,
+                         stats.max_microseconds,
+                         stats.num_deferred,
+                         stats.throttle_factor);
+        }
+    }
+
+    auto UE4SSProgram::get_event_queue_stats() -> EventQueueStats
+    {
+        return EventQueueStats{
+                .queue = m_queued_events.get_stats(),
+                .num_full_waits = m_num_event_queue_full_waits.load(std::memory_order_relaxed),
+        };
     }
 
     auto UE4SSProgram::register_keydown_event(Input::Key key, const Input::EventCallbackCallable& callback, uint8_t custom_data, void* custom_data2) -> void
@@ -1192,6 +1631,37 @@ namespace RC
         m_input_handler.register_keydown_event(key, modifier_keys, callback, custom_data, custom_data2);
     }
 
+    auto UE4SSProgram::remove_key_binds_from_module(void* module) -> void
+    {
+        // Binds don't record who registered them, so the owner is found through the callback
+        // The type of the callable that a std::function holds is described by an object in the DLL that the callable was defined in
+        auto is_callback_from_module = [module](const Input::EventCallbackCallable& callback) {
+            HMODULE callback_module{};
+            return callback && GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                                                  reinterpret_cast<LPCWSTR>(&callback.target_type()),
+                                                  &callback_module) &&
+                   callback_module == static_cast<HMODULE>(module);
+        };
+
+        const auto num_removed = m_input_handler.remove_keydown_events_if([&](Input::KeyData& key_data) {
+            if (std::none_of(key_data.callbacks.begin(), key_data.callbacks.end(), is_callback_from_module))
+            {
+                return false;
+            }
+
+            // custom_data == 2: Bind came from C++, and custom_data2 is a pointer to KeyDownEventData. Must free it.
+            if (key_data.custom_data == 2)
+            {
+                delete static_cast<KeyDownEventData*>(key_data.custom_data2);
+            }
+            return true;
+        });
+        if (num_removed > 0)
+        {
+            Output::send(STR("Removed {} key binds that the mod didn't remove itself\n"), num_removed);
+        }
+    }
+
     auto UE4SSProgram::is_keydown_event_registered(Input::Key key) -> bool
     {
         return m_input_handler.is_keydown_event_registered(key);
@@ -1202,42 +1672,14 @@ namespace RC
         return m_input_handler.is_keydown_event_registered(key, modifier_keys);
     }
 
-    auto UE4SSProgram::find_mod_by_name_internal(StringViewType mod_name, IsInstalled is_installed, IsStarted is_started, FMBNI_ExtraPredicate extra_predicate)
-            -> Mod*
+    auto UE4SSProgram::find_mod_by_name_internal(StringViewType mod_name, IsInstalled is_installed, IsStarted is_started) -> Mod*
     {
-        auto mod_exists_with_name = std::find_if(get_program().m_mods.begin(), get_program().m_mods.end(), [&](auto& elem) -> bool {
-            bool found = true;
-
-            if (!extra_predicate(elem.get()))
-            {
-                found = false;
-            }
-            if (mod_name != elem->get_name())
-            {
-                found = false;
-            }
-            if (is_installed == IsInstalled::Yes && !elem->is_installable())
-            {
-                found = false;
-            }
-            if (is_started == IsStarted::Yes && !elem->is_started())
-            {
-                found = false;
-            }
-
-            return found;
-        });
-
-        // clang-format off
-        if (mod_exists_with_name == get_program().m_mods.end())
+        auto mod = get_program().m_mods.find(mod_name);
+        if (!mod || (is_installed == IsInstalled::Yes && !mod->is_installable()) || (is_started == IsStarted::Yes && !mod->is_started()))
         {
             return nullptr;
         }
-        // clang-format on
-        else
-        {
-            return mod_exists_with_name->get();
-        }
+        return mod;
     }
 
     auto UE4SSProgram::get_object_dumper_output_directory() -> const File::StringType
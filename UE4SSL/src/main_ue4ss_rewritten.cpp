@@ -30,6 +30,7 @@ auto thread_dll_start(UE4SSProgram* program) -> unsigned long
         if (!Output::has_internal_error())
         {
             Output::send<LogLevel::Error>(STR("Fatal Error: {}\n"), ensure_str(e->get_message()));
+            Output::flush();
         }
         else
         {
@@ -0,0 +1,334 @@
+// Tests for the scheduler that the event loop sleeps on
+// A notification must never be lost, no matter how close to the wait it arrives, and a sleeping loop must wake up soon after it's notified or due
+// How often an idle loop wakes up and how long events wait while the loop is busy are printed as well
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <EventScheduler.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+using namespace std::chrono_literals;
+
+using Clock = EventScheduler::Clock;
+
+// Generous, the machines that run this are often busy, what matters is that nobody waits for a timeout that is far longer than this
+static constexpr auto s_max_wakeup_latency = 250ms;
+// Long enough that a wait which ends by timing out instead of by a notification is obvious
+static constexpr auto s_long_timeout = 10s;
+
+static auto test_notify_before_wait() -> void
+{
+    EventScheduler scheduler{};
+
+    // The notification arrives before the event loop goes to sleep, which happens whenever work is queued while the loop is busy
+    scheduler.notify();
+    const auto start = Clock::now();
+    CHECK(scheduler.wait_until(Clock::time_point::max()));
+    CHECK(Clock::now() - start < s_max_wakeup_latency);
+
+    // It's consumed by that wait, the next one sleeps until its deadline
+    CHECK(!scheduler.wait_until(Clock::now() + 10ms));
+
+    // Several notifications before a wait only wake it up once
+    scheduler.notify();
+    scheduler.notify();
+    CHECK(scheduler.wait_until(Clock::now() + s_long_timeout));
+    CHECK(!scheduler.wait_until(Clock::now() + 10ms));
+    CHECK(scheduler.get_num_wakeups() == 4);
+}
+
+static auto test_no_missed_wakeups() -> void
+{
+    // The consumer works like the event loop, it drains everything and then sleeps, while the producer pushes and notifies as fast as it can
+    // A push that lands between the drain and the wait must still wake the consumer up, it would otherwise sleep until the long timeout
+    static constexpr uint64_t num_pushes = 100'000;
+    EventScheduler scheduler{};
+    std::atomic<uint64_t> num_pushed{};
+    uint64_t num_drained{};
+    uint64_t num_missed_wakeups{};
+
+    std::jthread producer{[&] {
+        for (uint64_t i = 0; i < num_pushes; ++i)
+        {
+            num_pushed.fetch_add(1, std::memory_order_release);
+            scheduler.notify();
+            if (i % 64 == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    while (num_drained < num_pushes)
+    {
+        num_drained = num_pushed.load(std::memory_order_acquire);
+        if (num_drained == num_pushes)
+        {
+            break;
+        }
+        if (!scheduler.wait_until(Clock::now() + s_long_timeout) && num_pushed.load(std::memory_order_acquire) != num_drained)
+        {
+            ++num_missed_wakeups;
+        }
+    }
+
+    CHECK(num_drained == num_pushes);
+    CHECK(num_missed_wakeups == 0);
+}
+
+static auto test_wakeup_latency() -> void
+{
+    // The event loop sleeps without a deadline and is woken up by another thread
+    static constexpr int num_rounds = 50;
+    EventScheduler scheduler{};
+    std::atomic<Clock::time_point> notify_time{};
+    std::vector<Clock::duration> latencies{};
+
+    std::jthread event_loop{[&] {
+        for (int round = 0; round < num_rounds; ++round)
+        {
+            scheduler.wait_until(Clock::time_point::max());
+            latencies.emplace_back(Clock::now() - notify_time.load());
+        }
+    }};
+
+    for (int round = 0; round < num_rounds; ++round)
+    {
+        std::this_thread::sleep_for(1ms);
+        notify_time = Clock::now();
+        scheduler.notify();
+
+        // Waits until the event loop has handled the notification before sending the next one, they would otherwise be merged
+        while (scheduler.get_num_wakeups() == static_cast<uint64_t>(round))
+        {
+            std::this_thread::yield();
+        }
+    }
+    event_loop.join();
+
+    std::ranges::sort(latencies);
+    const auto median_latency = latencies[latencies.size() / 2];
+    CHECK(median_latency < s_max_wakeup_latency);
+    std::printf("Wakeup latency, median: %lld us, max: %lld us\n",
+                static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(median_latency).count()),
+                static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(latencies.back()).count()));
+}
+
+// Runs a loop like the event loop for a second, the only deadline it has is an update every 'update_interval' if there is one
+static auto measure_idle_wakeups_per_second(std::optional<std::chrono::milliseconds> update_interval) -> double
+{
+    static constexpr auto duration = 1s;
+    EventScheduler scheduler{};
+    const auto start = Clock::now();
+    const auto end = start + duration;
+    auto next_update_time = start;
+    while (Clock::now() < end)
+    {
+        const auto now = Clock::now();
+        auto next_wakeup_time = Clock::time_point::max();
+        if (update_interval)
+        {
+            if (now >= next_update_time)
+            {
+                next_update_time = EventScheduler::get_next_due_time(now, *update_interval);
+            }
+            next_wakeup_time = next_update_time;
+        }
+        scheduler.wait_until(std::min(next_wakeup_time, end));
+    }
+
+    // The wait that ends the measurement isn't a wakeup that the event loop would have had
+    return static_cast<double>(scheduler.get_num_wakeups() - 1) / std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static auto test_idle_wakeups() -> void
+{
+    // Without deadlines nothing wakes the loop up
+    const auto wakeups_without_deadlines = measure_idle_wakeups_per_second(std::nullopt);
+    CHECK(wakeups_without_deadlines == 0.0);
+
+    // An update every 5 ms can't wake the loop up more than 200 times a second, a busy machine only makes it fewer
+    const auto wakeups_with_deadline = measure_idle_wakeups_per_second(5ms);
+    CHECK(wakeups_with_deadline <= 201.0);
+    CHECK(wakeups_with_deadline > 20.0);
+
+    std::printf("Idle wakeups per second, without deadlines: %.1f, with a 5 ms deadline: %.1f\n", wakeups_without_deadlines, wakeups_with_deadline);
+}
+
+static auto test_latency_under_load() -> void
+{
+    // A producer queues bursts of events that keep the loop busy for most of the time between them, like a game thread that fires many hooks per frame
+    // The latency is the time from queueing an event until the loop handles it, including the time it waits behind the events before it
+    static constexpr auto duration = 1s;
+    static constexpr auto work_per_event = 20us;
+    static constexpr int events_per_burst = 4;
+    static constexpr auto time_between_bursts = 100us;
+    EventScheduler scheduler{};
+    std::mutex queue_mutex{};
+    std::vector<Clock::time_point> queued_events{};
+    std::atomic<bool> is_done{};
+    std::vector<Clock::duration> latencies{};
+
+    std::jthread producer{[&] {
+        while (!is_done.load(std::memory_order_relaxed))
+        {
+            for (int event = 0; event < events_per_burst; ++event)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(queue_mutex);
+                    queued_events.emplace_back(Clock::now());
+                }
+                scheduler.notify();
+            }
+            std::this_thread::sleep_for(time_between_bursts);
+        }
+    }};
+
+    const auto end = Clock::now() + duration;
+    std::vector<Clock::time_point> events{};
+    while (Clock::now() < end)
+    {
+        {
+            std::lock_guard<std::mutex> guard(queue_mutex);
+            events.swap(queued_events);
+        }
+        for (const auto queue_time : events)
+        {
+            latencies.emplace_back(Clock::now() - queue_time);
+            for (const auto work_end = Clock::now() + work_per_event; Clock::now() < work_end;)
+            {
+            }
+        }
+        events.clear();
+        scheduler.wait_until(end);
+    }
+    is_done = true;
+    producer.join();
+
+    CHECK(!latencies.empty());
+    if (latencies.empty())
+    {
+        return;
+    }
+
+    std::ranges::sort(latencies);
+    const auto to_microseconds = [](Clock::duration latency) {
+        return static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+    };
+    const auto median_latency = latencies[latencies.size() / 2];
+    CHECK(median_latency < s_max_wakeup_latency);
+    std::printf("Event latency under load, %zu events, %llu wakeups, median: %lld us, p99: %lld us, max: %lld us\n",
+                latencies.size(),
+                static_cast<unsigned long long>(scheduler.get_num_wakeups()),
+                to_microseconds(median_latency),
+                to_microseconds(latencies[latencies.size() * 99 / 100]),
+                to_microseconds(latencies.back()));
+}
+
+static auto test_deadline() -> void
+{
+    EventScheduler scheduler{};
+
+    const auto deadline = Clock::now() + 20ms;
+    CHECK(!scheduler.wait_until(deadline));
+    const auto wakeup_time = Clock::now();
+    CHECK(wakeup_time >= deadline);
+    CHECK(wakeup_time - deadline < s_max_wakeup_latency);
+
+    // A deadline that has already passed doesn't wait at all
+    const auto start = Clock::now();
+    CHECK(!scheduler.wait_until(start - 1s));
+    CHECK(Clock::now() - start < s_max_wakeup_latency);
+
+    // A notification ends the wait long before the deadline
+    std::jthread notifier{[&] {
+        std::this_thread::sleep_for(5ms);
+        scheduler.notify();
+    }};
+    const auto notified_wait_start = Clock::now();
+    CHECK(scheduler.wait_until(notified_wait_start + s_long_timeout));
+    CHECK(Clock::now() - notified_wait_start < s_max_wakeup_latency);
+}
+
+static auto test_pause_and_resume() -> void
+{
+    EventScheduler scheduler{};
+    CHECK(!scheduler.is_paused());
+
+    // Pausing doesn't wake the event loop up, it only changes what it does the next time it's awake
+    scheduler.pause();
+    CHECK(scheduler.is_paused());
+    CHECK(!scheduler.wait_until(Clock::now() + 10ms));
+
+    // Resuming before the paused loop goes to sleep isn't lost either
+    scheduler.resume();
+    CHECK(!scheduler.is_paused());
+    const auto start = Clock::now();
+    CHECK(scheduler.wait_until(Clock::now() + s_long_timeout));
+    CHECK(Clock::now() - start < s_max_wakeup_latency);
+
+    // The paused event loop sleeps with a long timeout and is woken up by resuming from another thread
+    scheduler.pause();
+    std::atomic<bool> is_loop_done{};
+    std::jthread event_loop{[&] {
+        while (scheduler.is_paused())
+        {
+            scheduler.wait_until(Clock::now() + s_long_timeout);
+        }
+        is_loop_done = true;
+    }};
+    std::this_thread::sleep_for(20ms);
+    CHECK(!is_loop_done);
+
+    const auto resume_time = Clock::now();
+    scheduler.resume();
+    event_loop.join();
+    CHECK(is_loop_done);
+    CHECK(Clock::now() - resume_time < s_max_wakeup_latency);
+}
+
+static auto test_next_due_time() -> void
+{
+    const auto now = Clock::now();
+    CHECK(EventScheduler::get_next_due_time(now, 5ms) == now + 5ms);
+    CHECK(EventScheduler::get_next_due_time(now, 16ms, 4) == now + 64ms);
+
+    // The event loop would spin if a task were due again immediately
+    CHECK(EventScheduler::get_next_due_time(now, 0ms) == now + 1ms);
+    CHECK(EventScheduler::get_next_due_time(now, -5ms) == now + 1ms);
+    CHECK(EventScheduler::get_next_due_time(now, 0ms, 8) == now + 8ms);
+    CHECK(EventScheduler::get_next_due_time(now, 5ms, 0) == now + 5ms);
+
+    // Waiting until the earliest due time of several tasks wakes up for that one and not for the others
+    EventScheduler scheduler{};
+    const auto start = Clock::now();
+    const auto next_wakeup_time = std::min({EventScheduler::get_next_due_time(start, 200ms),
+                                            EventScheduler::get_next_due_time(start, 15ms),
+                                            EventScheduler::get_next_due_time(start, 50ms, 2)});
+    CHECK(next_wakeup_time == start + 15ms);
+    CHECK(!scheduler.wait_until(next_wakeup_time));
+    CHECK(Clock::now() >= start + 15ms);
+    CHECK(Clock::now() < start + 15ms + s_max_wakeup_latency);
+}
+
+auto main() -> int
+{
+    test_notify_before_wait();
+    test_no_missed_wakeups();
+    test_wakeup_latency();
+    test_idle_wakeups();
+    test_latency_under_load();
+    test_deadline();
+    test_pause_and_resume();
+    test_next_due_time();
+
+    return Test::report_results();
+}
@@ -0,0 +1,163 @@
+// Tests for deciding which C++ mods can be loaded in parallel, and for reading the DLL imports that the decision is based on
+
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Mod/ModLoadPipeline.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+
+using Names = std::vector<std::string>;
+
+static auto write_u16(std::vector<uint8_t>& data, size_t offset, uint16_t value) -> void
+{
+    data[offset] = static_cast<uint8_t>(value);
+    data[offset + 1] = static_cast<uint8_t>(value >> 8);
+}
+
+static auto write_u32(std::vector<uint8_t>& data, size_t offset, uint32_t value) -> void
+{
+    write_u16(data, offset, static_cast<uint16_t>(value));
+    write_u16(data, offset + 2, static_cast<uint16_t>(value >> 16));
+}
+
+// A 64-bit DLL with one section that holds the import directory and the names of the imported DLLs
+static auto make_pe_file(const Names& imported_dll_names) -> std::vector<uint8_t>
+{
+    static constexpr size_t nt_headers_offset = 0x40;
+    static constexpr size_t optional_header_offset = nt_headers_offset + 4 + 20;
+    static constexpr size_t optional_header_size = 240;
+    static constexpr size_t section_table_offset = optional_header_offset + optional_header_size;
+    static constexpr uint32_t section_rva = 0x1000;
+    static constexpr uint32_t section_file_offset = 0x200;
+    static constexpr uint32_t section_size = 0x400;
+    static constexpr uint32_t names_offset_in_section = 0x200;
+
+    std::vector<uint8_t> data(section_file_offset + section_size);
+    write_u16(data, 0, 0x5A4D);
+    write_u32(data, 0x3C, nt_headers_offset);
+    write_u32(data, nt_headers_offset, 0x00004550);
+    write_u16(data, nt_headers_offset + 4 + 2, 1);
+    write_u16(data, nt_headers_offset + 4 + 16, optional_header_size);
+    write_u16(data, optional_header_offset, 0x20b);
+    write_u32(data, optional_header_offset + 108, 16);
+    write_u32(data, optional_header_offset + 112 + 8, section_rva);
+
+    write_u32(data, section_table_offset + 8, section_size);
+    write_u32(data, section_table_offset + 12, section_rva);
+    write_u32(data, section_table_offset + 16, section_size);
+    write_u32(data, section_table_offset + 20, section_file_offset);
+
+    uint32_t name_offset = names_offset_in_section;
+    for (size_t i = 0; i < imported_dll_names.size(); ++i)
+    {
+        const size_t descriptor_offset = section_file_offset + i * 20;
+        write_u32(data, descriptor_offset + 12, section_rva + name_offset);
+        write_u32(data, descriptor_offset + 16, section_rva + 0x180);
+        for (const auto character : imported_dll_names[i])
+        {
+            data[section_file_offset + name_offset++] = static_cast<uint8_t>(character);
+        }
+        data[section_file_offset + name_offset++] = 0;
+    }
+    return data;
+}
+
+static auto test_read_imported_dll_names() -> void
+{
+    const auto pe_file = make_pe_file({"KERNEL32.dll", "Helper.DLL"});
+    CHECK(ModLoadPipeline::read_imported_dll_names(pe_file) == Names{"kernel32.dll", "helper.dll"});
+
+    // Importing nothing is different from not being readable
+    CHECK(ModLoadPipeline::read_imported_dll_names(make_pe_file({})) == Names{});
+
+    auto without_import_directory = pe_file;
+    write_u32(without_import_directory, 0x40 + 24 + 112 + 8, 0);
+    CHECK(ModLoadPipeline::read_imported_dll_names(without_import_directory) == Names{});
+
+    // Every prefix that cuts off a header, a descriptor or a name fails
+    for (size_t size = 0; size < 0x200 + 2 * 20; size += 3)
+    {
+        CHECK(!ModLoadPipeline::read_imported_dll_names({pe_file.data(), size}));
+    }
+    CHECK(!ModLoadPipeline::read_imported_dll_names({pe_file.data(), 0x200 + 0x200 + 4}));
+
+    auto not_a_pe_file = pe_file;
+    not_a_pe_file[0] = 'X';
+    CHECK(!ModLoadPipeline::read_imported_dll_names(not_a_pe_file));
+
+    // A name that points outside of every section
+    auto bad_name = pe_file;
+    write_u32(bad_name, 0x200 + 12, 0x9000);
+    CHECK(!ModLoadPipeline::read_imported_dll_names(bad_name));
+}
+
+static auto test_find_mods_with_dependencies() -> void
+{
+    // The shared mod ships a DLL that the others import
+    const ModLoadPipeline::ModDlls shared{.own_dll_names = {"main.dll", "shared.dll"}, .imported_dll_names = {"kernel32.dll"}};
+    const ModLoadPipeline::ModDlls uses_shared{.own_dll_names = {"main.dll"}, .imported_dll_names = {"shared.dll"}};
+    // Ships its own copy, which is found in its own directory
+    const ModLoadPipeline::ModDlls ships_shared{.own_dll_names = {"main.dll", "shared.dll"}, .imported_dll_names = {"shared.dll"}};
+    // Only a helper DLL of the mod imports the other mod's DLL, the imports of every DLL of a mod are merged into one list
+    const ModLoadPipeline::ModDlls helper_uses_shared{.own_dll_names = {"main.dll", "helper.dll"}, .imported_dll_names = {"helper.dll", "shared.dll"}};
+    const ModLoadPipeline::ModDlls independent{.own_dll_names = {"main.dll"}, .imported_dll_names = {"kernel32.dll", "main.dll"}};
+    const ModLoadPipeline::ModDlls unknown{.own_dll_names = {"main.dll"}, .has_unknown_imports = true};
+
+    const std::vector<ModLoadPipeline::ModDlls> mods{shared, uses_shared, ships_shared, helper_uses_shared, independent, unknown};
+    CHECK((ModLoadPipeline::find_mods_with_dependencies(mods) == std::vector<bool>{false, true, false, true, false, true}));
+
+    // Every mod ships 'main.dll', importing it doesn't depend on another mod
+    CHECK((ModLoadPipeline::find_mods_with_dependencies(std::vector{independent, independent}) == std::vector<bool>{false, false}));
+    CHECK(ModLoadPipeline::find_mods_with_dependencies({}).empty());
+}
+
+static auto test_for_each_in_parallel() -> void
+{
+    for (size_t max_threads : {0, 1, 4, 64})
+    {
+        std::vector<std::atomic<int>> num_calls(100);
+        ModLoadPipeline::for_each_in_parallel(num_calls.size(), max_threads, [&](size_t index) {
+            ++num_calls[index];
+        });
+        bool is_every_index_called_once = true;
+        for (const auto& count : num_calls)
+        {
+            is_every_index_called_once &= count == 1;
+        }
+        CHECK(is_every_index_called_once);
+    }
+
+    // An exception doesn't stop the other calls, and is rethrown once they're done
+    std::atomic<int> num_calls{};
+    bool has_thrown{};
+    try
+    {
+        ModLoadPipeline::for_each_in_parallel(50, 4, [&](size_t index) {
+            ++num_calls;
+            if (index == 10)
+            {
+                throw std::runtime_error{"index 10"};
+            }
+        });
+    }
+    catch (std::runtime_error&)
+    {
+        has_thrown = true;
+    }
+    CHECK(has_thrown);
+    CHECK(num_calls == 50);
+}
+
+auto main() -> int
+{
+    test_read_imported_dll_names();
+    test_find_mods_with_dependencies();
+    test_for_each_in_parallel();
+
+    return Test::report_results();
+}
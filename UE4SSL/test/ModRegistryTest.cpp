@@ -0,0 +1,279 @@
+// Tests for the mod registry, that the name index and the list of C++ mods stay in step with the mods through every change
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <Mod/CppMod.hpp>
+#include <Mod/ModRegistry.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+
+// Mod.cpp pulls in the engine, these are the only parts of it that the registry needs
+namespace RC
+{
+    Mod::Mod(UE4SSProgram& program, StringType&& mod_name, std::filesystem::path&& mod_path)
+        : m_program(program), m_mod_name(mod_name), m_mod_path(mod_path)
+    {
+    }
+
+    auto Mod::get_name() const -> StringViewType
+    {
+        return m_mod_name;
+    }
+
+    auto Mod::fire_update() -> void
+    {
+    }
+
+    auto Mod::update_async() -> void
+    {
+    }
+} // namespace RC
+
+// The mods never touch the program
+alignas(std::max_align_t) static char s_program_storage[1]{};
+static auto& s_program = reinterpret_cast<UE4SSProgram&>(s_program_storage);
+
+// Stands in for the mods that aren't C++ mods, and tells the test when it's destroyed
+class OtherMod : public Mod
+{
+  public:
+    std::function<void()> on_destroyed{};
+
+  public:
+    OtherMod(StringType&& mod_name) : Mod(s_program, std::move(mod_name), {})
+    {
+    }
+    ~OtherMod() override
+    {
+        if (on_destroyed)
+        {
+            on_destroyed();
+        }
+    }
+
+  public:
+    auto start_mod() -> void override
+    {
+    }
+    auto uninstall() -> void override
+    {
+    }
+};
+
+static auto make_cpp_mod(StringType&& mod_name) -> std::unique_ptr<Mod>
+{
+    return std::make_unique<CppMod>(s_program, std::move(mod_name), std::filesystem::path{});
+}
+
+static auto make_other_mod(StringType&& mod_name) -> std::unique_ptr<Mod>
+{
+    return std::make_unique<OtherMod>(std::move(mod_name));
+}
+
+// Whether the C++ mods are exactly the ones in 'expected', in the same order
+static auto has_cpp_mods(const ModRegistry& registry, std::vector<const Mod*> expected) -> bool
+{
+    const auto cpp_mods = registry.get_cpp_mods();
+    return std::equal(cpp_mods.begin(), cpp_mods.end(), expected.begin(), expected.end());
+}
+
+// Whether every mod is in the name index, or is a duplicate of the mod that is, and the C++ mods are listed in the order of the mods
+static auto is_consistent(const ModRegistry& registry) -> bool
+{
+    std::vector<const Mod*> cpp_mods{};
+    for (const auto& mod : registry)
+    {
+        const auto first_mod_with_name = registry.find(mod->get_name());
+        if (!first_mod_with_name || first_mod_with_name->get_name() != mod->get_name() || registry.is_duplicate(*mod) == (first_mod_with_name == mod.get()))
+        {
+            return false;
+        }
+        if (auto cpp_mod = dynamic_cast<const CppMod*>(mod.get()); cpp_mod)
+        {
+            cpp_mods.emplace_back(cpp_mod);
+        }
+    }
+    return has_cpp_mods(registry, cpp_mods);
+}
+
+static auto test_add() -> void
+{
+    ModRegistry registry{};
+    CHECK(registry.empty());
+    CHECK(!registry.find(STR("ModA")));
+    CHECK(registry.get_cpp_mods().empty());
+
+    auto& mod_a = registry.add(make_cpp_mod(STR("ModA")));
+    auto& mod_b = registry.add(make_other_mod(STR("ModB")));
+    auto& mod_c = registry.add(make_cpp_mod(STR("ModC")));
+
+    CHECK(registry.size() == 3);
+    CHECK(registry[0].get() == &mod_a && registry[1].get() == &mod_b && registry[2].get() == &mod_c);
+    CHECK(registry.find(STR("ModA")) == &mod_a);
+    CHECK(registry.find(STR("ModB")) == &mod_b);
+    CHECK(registry.find(STR("ModC")) == &mod_c);
+    CHECK(!registry.find(STR("moda")));
+    CHECK(has_cpp_mods(registry, {&mod_a, &mod_c}));
+    CHECK(is_consistent(registry));
+}
+
+static auto test_duplicates() -> void
+{
+    // The first mod with a name keeps it, a later mod with the same name is a duplicate whatever its type
+    ModRegistry registry{};
+    auto& first = registry.add(make_cpp_mod(STR("ModA")));
+    auto& second = registry.add(make_other_mod(STR("ModA")));
+    auto& third = registry.add(make_cpp_mod(STR("ModA")));
+    CHECK(registry.find(STR("ModA")) == &first);
+    CHECK(!registry.is_duplicate(first));
+    CHECK(registry.is_duplicate(second));
+    CHECK(registry.is_duplicate(third));
+    CHECK(is_consistent(registry));
+
+    // A mod that isn't in the registry is a duplicate if its name is taken
+    OtherMod outside{STR("ModA")};
+    CHECK(registry.is_duplicate(outside));
+    OtherMod unknown{STR("ModB")};
+    CHECK(!registry.is_duplicate(unknown));
+
+    // Removing the first mod passes the name on to the next mod with it
+    CHECK(registry.remove(&first) == 0);
+    CHECK(registry.find(STR("ModA")) == &second);
+    CHECK(!registry.is_duplicate(second));
+    CHECK(registry.is_duplicate(third));
+    CHECK(has_cpp_mods(registry, {&third}));
+    CHECK(is_consistent(registry));
+
+    // Removing a duplicate leaves the name where it is
+    auto& fourth = registry.add(make_other_mod(STR("ModA")));
+    CHECK(registry.remove(&third) == 1);
+    CHECK(registry.find(STR("ModA")) == &second);
+    CHECK(registry.is_duplicate(fourth));
+    CHECK(registry.get_cpp_mods().empty());
+    CHECK(is_consistent(registry));
+
+    CHECK(registry.remove(&second) == 0);
+    CHECK(registry.remove(&fourth) == 0);
+    CHECK(!registry.find(STR("ModA")));
+    CHECK(registry.empty());
+}
+
+static auto test_insert() -> void
+{
+    ModRegistry registry{};
+    auto& mod_a = registry.add(make_cpp_mod(STR("ModA")));
+    auto& mod_b = registry.add(make_other_mod(STR("ModB")));
+
+    // Inserted C++ mods are listed where they are among the mods, not after the C++ mods that were there already
+    auto& mod_c = registry.insert(0, make_cpp_mod(STR("ModC")));
+    auto& mod_d = registry.insert(2, make_cpp_mod(STR("ModD")));
+    CHECK(registry.size() == 4);
+    CHECK(registry[0].get() == &mod_c && registry[1].get() == &mod_a && registry[2].get() == &mod_d && registry[3].get() == &mod_b);
+    CHECK(has_cpp_mods(registry, {&mod_c, &mod_a, &mod_d}));
+    CHECK(is_consistent(registry));
+
+    // An index past the end adds the mod after every other mod
+    auto& mod_e = registry.insert(100, make_cpp_mod(STR("ModE")));
+    CHECK(registry[4].get() == &mod_e);
+    CHECK(has_cpp_mods(registry, {&mod_c, &mod_a, &mod_d, &mod_e}));
+    CHECK(is_consistent(registry));
+
+    // A mod that's inserted before a mod with the same name takes the name from it, one that's inserted after it is a duplicate
+    auto& before_b = registry.insert(3, make_cpp_mod(STR("ModB")));
+    CHECK(registry.find(STR("ModB")) == &before_b);
+    CHECK(registry.is_duplicate(mod_b));
+    auto& after_a = registry.insert(2, make_other_mod(STR("ModA")));
+    CHECK(registry.find(STR("ModA")) == &mod_a);
+    CHECK(registry.is_duplicate(after_a));
+    CHECK(has_cpp_mods(registry, {&mod_c, &mod_a, &mod_d, &before_b, &mod_e}));
+    CHECK(is_consistent(registry));
+}
+
+static auto test_remove() -> void
+{
+    ModRegistry registry{};
+    auto& mod_a = registry.add(make_cpp_mod(STR("ModA")));
+    auto& mod_b = static_cast<OtherMod&>(registry.add(make_other_mod(STR("ModB"))));
+    auto& mod_c = registry.add(make_cpp_mod(STR("ModC")));
+
+    // A mod is destroyed after it's gone from the registry
+    bool is_destroyed{};
+    mod_b.on_destroyed = [&] {
+        is_destroyed = true;
+        CHECK(registry.size() == 2);
+        CHECK(!registry.find(STR("ModB")));
+        CHECK(is_consistent(registry));
+    };
+    CHECK(registry.remove(&mod_b) == 1);
+    CHECK(is_destroyed);
+    CHECK(!registry.find(STR("ModB")));
+    CHECK(has_cpp_mods(registry, {&mod_a, &mod_c}));
+
+    // Only mods that are in the registry can be removed
+    CHECK(!registry.remove(&mod_b).has_value());
+    CHECK(!registry.remove(nullptr).has_value());
+    OtherMod outside{STR("ModA")};
+    CHECK(!registry.remove(&outside).has_value());
+    CHECK(registry.find(STR("ModA")) == &mod_a);
+    CHECK(registry.size() == 2);
+
+    // A re-installed mod takes the place of its old version
+    const auto index = registry.remove(&mod_a);
+    CHECK(index == 0);
+    CHECK(has_cpp_mods(registry, {&mod_c}));
+    auto& new_mod_a = registry.insert(*index, make_cpp_mod(STR("ModA")));
+    CHECK(registry[0].get() == &new_mod_a && registry[1].get() == &mod_c);
+    CHECK(registry.find(STR("ModA")) == &new_mod_a);
+    CHECK(has_cpp_mods(registry, {&new_mod_a, &mod_c}));
+    CHECK(is_consistent(registry));
+
+    CHECK(registry.remove(&mod_c) == 1);
+    CHECK(registry.remove(&new_mod_a) == 0);
+    CHECK(registry.empty());
+    CHECK(registry.get_cpp_mods().empty());
+}
+
+static auto test_clear() -> void
+{
+    ModRegistry registry{};
+    registry.add(make_cpp_mod(STR("ModA")));
+    auto& mod_b = static_cast<OtherMod&>(registry.add(make_other_mod(STR("ModB"))));
+    registry.add(make_cpp_mod(STR("ModA")));
+
+    // Every mod is destroyed after the registry is empty
+    bool is_destroyed{};
+    mod_b.on_destroyed = [&] {
+        is_destroyed = true;
+        CHECK(registry.empty());
+        CHECK(!registry.find(STR("ModA")));
+        CHECK(!registry.find(STR("ModB")));
+        CHECK(registry.get_cpp_mods().empty());
+    };
+    registry.clear();
+    CHECK(is_destroyed);
+    CHECK(registry.empty());
+    CHECK(registry.get_cpp_mods().empty());
+
+    // The registry can be used again afterwards
+    auto& mod_c = registry.add(make_cpp_mod(STR("ModC")));
+    CHECK(registry.find(STR("ModC")) == &mod_c);
+    CHECK(has_cpp_mods(registry, {&mod_c}));
+    CHECK(is_consistent(registry));
+}
+
+auto main() -> int
+{
+    test_add();
+    test_duplicates();
+    test_insert();
+    test_remove();
+    test_clear();
+
+    return Test::report_results();
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// Stands in for the real Common.hpp, the tests build the UE4SS code that they test into the test itself instead of importing it from the DLL
+
+#define RC_UE4SS_API
@@ -0,0 +1,8 @@
+#pragma once
+
+// Stands in for the real File/File.hpp, which only builds on Windows
+// The mods only need the string types and std::filesystem from it
+
+#include <filesystem>
+
+#include <File/Macros.hpp>
@@ -0,0 +1,26 @@
+#pragma once
+
+// Stands in for the real Mod/CppMod.hpp, which loads a DLL and only builds on Windows
+// The registry only needs the type, to tell C++ mods apart from other mods
+
+#include <Mod/Mod.hpp>
+
+namespace RC
+{
+    class CppMod : public Mod
+    {
+      public:
+        CppMod(UE4SSProgram& program, StringType&& mod_name, std::filesystem::path&& mod_path)
+            : Mod(program, std::move(mod_name), std::move(mod_path))
+        {
+        }
+
+      public:
+        auto start_mod() -> void override
+        {
+        }
+        auto uninstall() -> void override
+        {
+        }
+    };
+} // namespace RC
@@ -0,0 +1,55 @@
+-- Standalone tests for the parts of UE4SS that don't depend on the engine or on Windows
+-- The headers in stubs stand in for the ones that do, for the code that only includes them
+-- They aren't part of the UE4SS build, which only targets Windows, and can be built and run on Linux with:
+--   cd UE4SSL/test && xmake && xmake test
+set_xmakever("2.9.3")
+set_project("UE4SSTest")
+
+add_rules("mode.debug", "mode.release")
+set_defaultmode("debug")
+
+target("EventSchedulerTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_includedirs("../include", "../../tools/test/include")
+
+    add_files("EventSchedulerTest.cpp")
+    add_files("../src/EventScheduler.cpp")
+
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
+    add_tests("default")
+
+target("ModLoadPipelineTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_includedirs("../include", "../../tools/test/include")
+
+    add_files("ModLoadPipelineTest.cpp")
+    add_files("../src/Mod/ModLoadPipeline.cpp")
+
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
+    add_tests("default")
+
+target("ModRegistryTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_FILE_BUILD_STATIC")
+    -- The stubs come first so that they replace the parts of UE4SS that only build on Windows
+    add_includedirs("stubs", "../include", "../../deps/first/File/include", "../../deps/first/String/include", "../../tools/test/include")
+
+    add_files("ModRegistryTest.cpp")
+    add_files("../src/Mod/ModRegistry.cpp")
+
+    add_tests("default")
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace RC
+{
+    /*
+     * @brief Counters that describe how a BoundedMpscQueue has been used
+     *
+     * The counters are updated with relaxed atomics, a snapshot taken while producers are pushing may be slightly inconsistent.
+     */
+    struct MpscQueueStats
+    {
+        uint64_t num_pushed{};
+        uint64_t num_popped{};
+
+        // Pushes that failed because the queue was full
+        uint64_t num_rejected{};
+
+        // The largest number of items that were in the queue at once
+        size_t high_water_mark{};
+    };
+
+    /*
+     * @brief A bounded lock-free queue for many producer threads and one consumer thread
+     *
+     * Every slot carries a sequence number that tells producers and the consumer whose turn it is, so neither side ever takes a lock.
+     * Items are popped in the order in which producers claimed their slots.
+     * A producer that claimed a slot but hasn't finished writing it holds up the consumer until it's done, items behind it aren't skipped.
+     * The queue never allocates after construction, a push into a full queue fails and is counted as rejected.
+     *
+     * @tparam T item type, moved in and out of the slots
+     *
+     * Example:
+     *
+     * @code{.cpp}
+     * BoundedMpscQueue<int> queue{1024};
+     * queue.try_push(1);
+     * queue.drain([](int value) { ... });
+     * @endcode
+     */
+    template <typename T>
+        requires std::is_default_constructible_v<T> && std::is_nothrow_move_assignable_v<T>
+    class BoundedMpscQueue
+    {
+      private:
+        // Producers and the consumer write to different cache lines
+        static constexpr size_t cache_line_size = 64;
+
+        struct Slot
+        {
+            std::atomic<size_t> sequence{};
+            T value{};
+        };
+
+      private:
+        std::unique_ptr<Slot[]> m_slots{};
+        size_t m_capacity{};
+        size_t m_mask{};
+
+        alignas(cache_line_size) std::atomic<size_t> m_enqueue_position{};
+        std::atomic<uint64_t> m_num_rejected{};
+        std::atomic<size_t> m_high_water_mark{};
+
+        alignas(cache_line_size) std::atomic<size_t> m_dequeue_position{};
+
+      public:
+        /*
+         * @param capacity the maximum number of items in the queue at once, rounded up to a power of two
+         */
+        explicit BoundedMpscQueue(size_t capacity)
+            : m_slots(std::make_unique<Slot[]>(std::bit_ceil(std::max<size_t>(capacity, 2)))),
+              m_capacity(std::bit_ceil(std::max<size_t>(capacity, 2))),
+              m_mask(m_capacity - 1)
+        {
+            for (size_t i = 0; i < m_capacity; ++i)
+            {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+        auto operator=(const BoundedMpscQueue&) -> BoundedMpscQueue& = delete;
+
+      public:
+        /*
+         * Safe to call from any thread
+         *
+         * @return false if the queue is full, 'value' is left untouched in that case
+         */
+        auto try_push(T&& value) -> bool
+        {
+            size_t position = m_enqueue_position.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Slot& slot = m_slots[position & m_mask];
+                const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+                if (difference == 0)
+                {
+                    // The slot is free, claim it by moving the enqueue position past it
+                    if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        slot.value = std::move(value);
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        update_high_water_mark(position + 1);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The slot still holds an item from one lap ago that the consumer hasn't popped yet
+                    m_num_rejected.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    // Another producer claimed the slot first
+                    position = m_enqueue_position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        auto try_push(const T& value) -> bool
+            requires std::is_copy_constructible_v<T>
+        {
+            T copy{value};
+            return try_push(std::move(copy));
+        }
+
+        /*
+         * Must only be called by the consumer thread
+         *
+         * @return false if the queue is empty, or if the next item is still being written by its producer
+         */
+        auto try_pop(T& out_value) -> bool
+        {
+            const size_t position = m_dequeue_position.load(std::memory_order_relaxed);
+            Slot& slot = m_slots[position & m_mask];
+            if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+            {
+                return false;
+            }
+
+            out_value = std::move(slot.value);
+
+            // Hands the slot back to the producers for the next lap
+            slot.sequence.store(position + m_capacity, std::memory_order_release);
+            m_dequeue_position.store(position + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /*
+         * Pops items in FIFO order and passes them to 'callable', must only be called by the consumer thread
+         * Each item is popped before 'callable' is called, so 'callable' may push to the queue or even drain it again
+         *
+         * @param max_items stops after this many items, items pushed while draining are included until then
+         * @return the number of items that were passed to 'callable'
+         */
+        template <typename Callable>
+        auto drain(Callable&& callable, size_t max_items = SIZE_MAX) -> size_t
+        {
+            size_t num_drained{};
+            T value{};
+            while (num_drained < max_items && try_pop(value))
+            {
+                ++num_drained;
+                callable(std::move(value));
+            }
+            return num_drained;
+        }
+
+        /*
+         * Safe to call from any thread, but the answer may be out of date by the time it's used
+         */
+        [[nodiscard]] auto is_empty() const -> bool
+        {
+            return size() == 0;
+        }
+
+        /*
+         * Safe to call from any thread, but the answer may be out of date by the time it's used
+         * Includes items whose producers have claimed a slot but haven't finished writing it
+         */
+        [[nodiscard]] auto size() const -> size_t
+        {
+            const size_t dequeue_position = m_dequeue_position.load(std::memory_order_relaxed);
+            const size_t enqueue_position = m_enqueue_position.load(std::memory_order_relaxed);
+            return enqueue_position > dequeue_position ? enqueue_position - dequeue_position : 0;
+        }
+
+        [[nodiscard]] auto capacity() const -> size_t
+        {
+            return m_capacity;
+        }
+
+        [[nodiscard]] auto get_stats() const -> MpscQueueStats
+        {
+            const size_t num_popped = m_dequeue_position.load(std::memory_order_relaxed);
+            const size_t num_pushed = m_enqueue_position.load(std::memory_order_relaxed);
+            return MpscQueueStats{
+                    .num_pushed = num_pushed,
+                    .num_popped = num_popped,
+                    .num_rejected = m_num_rejected.load(std::memory_order_relaxed),
+                    .high_water_mark = m_high_water_mark.load(std::memory_order_relaxed),
+            };
+        }
+
+      private:
+        auto update_high_water_mark(size_t enqueue_position) -> void
+        {
+            const size_t dequeue_position = m_dequeue_position.load(std::memory_order_relaxed);
+            // The dequeue position may be stale, which would overestimate the size
+            const size_t current_size = std::min(enqueue_position > dequeue_position ? enqueue_position - dequeue_position : 0, m_capacity);
+            size_t high_water_mark = m_high_water_mark.load(std::memory_order_relaxed);
+            while (current_size > high_water_mark &&
+                   !m_high_water_mark.compare_exchange_weak(high_water_mark, current_size, std::memory_order_relaxed))
+            {
+            }
+        }
+    };
+} // namespace RC
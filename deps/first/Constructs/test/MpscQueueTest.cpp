@@ -0,0 +1,185 @@
+// Tests for BoundedMpscQueue, single-threaded for the edge cases and with many producers against a small queue for the ordering and the counters
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <Constructs/MpscQueue.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+
+static auto test_capacity() -> void
+{
+    CHECK(BoundedMpscQueue<int>{0}.capacity() == 2);
+    CHECK(BoundedMpscQueue<int>{1}.capacity() == 2);
+    CHECK(BoundedMpscQueue<int>{3}.capacity() == 4);
+    CHECK(BoundedMpscQueue<int>{1024}.capacity() == 1024);
+    CHECK(BoundedMpscQueue<int>{1025}.capacity() == 2048);
+}
+
+static auto test_single_thread() -> void
+{
+    BoundedMpscQueue<int> queue{4};
+    int value{};
+    CHECK(queue.is_empty());
+    CHECK(!queue.try_pop(value));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(queue.try_push(i));
+    }
+    CHECK(queue.size() == 4);
+
+    // A full queue rejects the push and leaves the value alone
+    int rejected_value = 42;
+    CHECK(!queue.try_push(std::move(rejected_value)));
+    CHECK(rejected_value == 42);
+    CHECK(queue.get_stats().num_rejected == 1);
+    CHECK(queue.get_stats().high_water_mark == 4);
+
+    CHECK(queue.try_pop(value) && value == 0);
+    CHECK(queue.try_push(4));
+
+    // Items pushed while draining are drained too, up to 'max_items'
+    std::vector<int> drained{};
+    CHECK(queue.drain(
+                  [&](int item) {
+                      drained.emplace_back(item);
+                      if (item == 1)
+                      {
+                          queue.try_push(5);
+                      }
+                  },
+                  3) == 3);
+    CHECK((drained == std::vector<int>{1, 2, 3}));
+    CHECK(queue.drain([&](int item) {
+        drained.emplace_back(item);
+    }) == 2);
+    CHECK((drained == std::vector<int>{1, 2, 3, 4, 5}));
+    CHECK(queue.is_empty());
+
+    // Many laps around the slots
+    for (int i = 0; i < 1000; ++i)
+    {
+        CHECK(queue.try_push(i));
+        CHECK(queue.try_push(i + 1));
+        CHECK(queue.try_pop(value) && value == i);
+        CHECK(queue.try_pop(value) && value == i + 1);
+    }
+
+    const auto stats = queue.get_stats();
+    CHECK(stats.num_pushed == 2006);
+    CHECK(stats.num_popped == 2006);
+    CHECK(stats.num_rejected == 1);
+    CHECK(stats.high_water_mark == 4);
+}
+
+static auto test_move_only_items() -> void
+{
+    // Items that are still queued when the queue is destroyed are destroyed with it, the sanitizers report a leak otherwise
+    BoundedMpscQueue<std::unique_ptr<int>> queue{2};
+    CHECK(queue.try_push(std::make_unique<int>(1)));
+    CHECK(queue.try_push(std::make_unique<int>(2)));
+
+    auto rejected_item = std::make_unique<int>(3);
+    CHECK(!queue.try_push(std::move(rejected_item)));
+    CHECK(rejected_item && *rejected_item == 3);
+
+    std::unique_ptr<int> item{};
+    CHECK(queue.try_pop(item) && *item == 1);
+}
+
+struct ProducerItem
+{
+    uint32_t producer{};
+    uint32_t sequence{};
+};
+
+static auto test_many_producers(uint32_t num_producers, size_t capacity) -> void
+{
+    // Producers retry until their push goes through, so every item gets in eventually and the queue is full most of the time
+    static constexpr uint32_t num_items_per_producer = 50'000;
+    BoundedMpscQueue<ProducerItem> queue{capacity};
+    std::vector<uint64_t> num_rejected_per_producer(num_producers);
+    std::atomic<uint32_t> num_finished_producers{};
+
+    std::vector<std::jthread> producers{};
+    for (uint32_t producer = 0; producer < num_producers; ++producer)
+    {
+        producers.emplace_back([&, producer] {
+            for (uint32_t sequence = 0; sequence < num_items_per_producer; ++sequence)
+            {
+                while (!queue.try_push(ProducerItem{producer, sequence}))
+                {
+                    ++num_rejected_per_producer[producer];
+                    std::this_thread::yield();
+                }
+            }
+            num_finished_producers.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    // Items of one producer must come out in the order it pushed them, with nothing lost or duplicated in between
+    std::vector<uint32_t> next_sequence_per_producer(num_producers);
+    uint64_t num_out_of_order{};
+    uint64_t num_consumed{};
+    auto consume = [&](ProducerItem item) {
+        if (item.producer >= num_producers || item.sequence != next_sequence_per_producer[item.producer])
+        {
+            ++num_out_of_order;
+            return;
+        }
+        ++next_sequence_per_producer[item.producer];
+        ++num_consumed;
+    };
+    while (num_finished_producers.load(std::memory_order_acquire) < num_producers)
+    {
+        if (queue.drain(consume) == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    producers.clear();
+    queue.drain(consume);
+
+    const uint64_t num_items = uint64_t{num_producers} * num_items_per_producer;
+    CHECK(num_out_of_order == 0);
+    CHECK(num_consumed == num_items);
+    for (uint32_t producer = 0; producer < num_producers; ++producer)
+    {
+        CHECK(next_sequence_per_producer[producer] == num_items_per_producer);
+    }
+
+    uint64_t num_rejected{};
+    for (auto producer_num_rejected : num_rejected_per_producer)
+    {
+        num_rejected += producer_num_rejected;
+    }
+    const auto stats = queue.get_stats();
+    CHECK(stats.num_pushed == num_items);
+    CHECK(stats.num_popped == num_items);
+    CHECK(stats.num_rejected == num_rejected);
+    CHECK(stats.high_water_mark <= queue.capacity());
+    CHECK(queue.is_empty());
+
+    std::printf("%u producers, capacity %zu: %llu rejected pushes, high water mark %zu\n",
+                num_producers,
+                queue.capacity(),
+                static_cast<unsigned long long>(stats.num_rejected),
+                stats.high_water_mark);
+}
+
+auto main() -> int
+{
+    test_capacity();
+    test_single_thread();
+    test_move_only_items();
+    test_many_producers(2, 2);
+    test_many_producers(8, 4);
+    test_many_producers(16, 64);
+
+    return Test::report_results();
+}
@@ -0,0 +1,23 @@
+-- Standalone tests for the constructs
+-- They aren't part of the UE4SS build, which only targets Windows, and can be built and run on Linux with:
+--   cd deps/first/Constructs/test && xmake && xmake test
+set_xmakever("2.9.3")
+set_project("ConstructsTest")
+
+add_rules("mode.debug", "mode.release")
+set_defaultmode("debug")
+
+target("MpscQueueTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_includedirs("../include", "../../../../tools/test/include")
+
+    add_files("MpscQueueTest.cpp")
+
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
+    add_tests("default")
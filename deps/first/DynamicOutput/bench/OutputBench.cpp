@@ -0,0 +1,254 @@
+// Measures how long a call to Output::send takes on the sending thread, with and without async output
+// Also measures what a call costs when its log level is filtered out, what File::BufferedWriter saves over one write per message,
+// and what a trace costs compared to a formatted message
+// Usage: OutputBench [messages per thread]
+
+#include <algorithm>
+#include <barrier>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <DynamicOutput/AsyncOutput.hpp>
+#include <DynamicOutput/BinaryLogDevice.hpp>
+#include <DynamicOutput/Macros.hpp>
+#include <DynamicOutput/Output.hpp>
+#include <File/BufferedWriter.hpp>
+
+using namespace RC;
+
+// Stands in for FileDevice, formats every message with the default formatter and writes it with one call to the OS
+class BenchFileDevice : public Output::OutputDevice
+{
+  private:
+    std::FILE* m_file{};
+
+  public:
+    BenchFileDevice()
+    {
+        m_file = std::fopen((std::filesystem::temp_directory_path() / "OutputBench.log").string().c_str(), "wb");
+        std::setvbuf(m_file, nullptr, _IONBF, 0);
+    }
+
+    ~BenchFileDevice() override
+    {
+        std::fclose(m_file);
+    }
+
+    auto receive(File::StringViewType fmt) const -> void override
+    {
+        const auto formatted = m_formatter(fmt);
+        std::fwrite(formatted.data(), sizeof(File::CharType), formatted.size(), m_file);
+    }
+};
+
+struct LatencyResult
+{
+    double p50_nanoseconds{};
+    double p99_nanoseconds{};
+    double max_nanoseconds{};
+    double messages_per_second{};
+};
+
+static auto run(size_t num_threads, size_t num_messages_per_thread) -> LatencyResult
+{
+    std::vector<std::vector<double>> latencies(num_threads);
+    std::barrier start_barrier{static_cast<std::ptrdiff_t>(num_threads)};
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::jthread> threads{};
+    for (size_t thread_index = 0; thread_index < num_threads; ++thread_index)
+    {
+        threads.emplace_back([&, thread_index] {
+            auto& thread_latencies = latencies[thread_index];
+            thread_latencies.reserve(num_messages_per_thread);
+            start_barrier.arrive_and_wait();
+            for (size_t i = 0; i < num_messages_per_thread; ++i)
+            {
+                const auto call_start = std::chrono::steady_clock::now();
+                Output::send(STR("[Lua] Hook for /Script/Engine.Actor:ReceiveTick called, thread: {}, call: {}, delta: {}\n"), thread_index, i, 0.016f);
+                thread_latencies.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - call_start).count());
+            }
+        });
+    }
+    threads.clear();
+    Output::flush();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> all_latencies{};
+    for (const auto& thread_latencies : latencies)
+    {
+        all_latencies.insert(all_latencies.end(), thread_latencies.begin(), thread_latencies.end());
+    }
+    std::sort(all_latencies.begin(), all_latencies.end());
+
+    return LatencyResult{
+            .p50_nanoseconds = all_latencies[all_latencies.size() / 2],
+            .p99_nanoseconds = all_latencies[all_latencies.size() * 99 / 100],
+            .max_nanoseconds = all_latencies.back(),
+            .messages_per_second = static_cast<double>(all_latencies.size()) / seconds,
+    };
+}
+
+template <typename Callable>
+static auto measure_nanoseconds_per_call(size_t num_calls, Callable&& callable) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_calls; ++i)
+    {
+        callable(i);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(num_calls);
+}
+
+static auto run_filtered_out() -> void
+{
+    static constexpr size_t num_calls = 10'000'000;
+    static constexpr size_t num_unfiltered_calls = 100'000;
+
+    Output::set_minimum_log_level(LogLevel::Verbose);
+    const double unfiltered = measure_nanoseconds_per_call(num_unfiltered_calls, [](size_t i) {
+        Output::send<LogLevel::Verbose>(STR("[Lua] Hook for /Script/Engine.Actor:ReceiveTick called, call: {}, delta: {}\n"), i, 0.016f);
+    });
+
+    Output::set_minimum_log_level(LogLevel::Normal);
+    const double filtered = measure_nanoseconds_per_call(num_calls, [](size_t i) {
+        Output::send<LogLevel::Verbose>(STR("[Lua] Hook for /Script/Engine.Actor:ReceiveTick called, call: {}, delta: {}\n"), i, 0.016f);
+    });
+    const double filtered_runtime_level = measure_nanoseconds_per_call(num_calls, [](size_t i) {
+        Output::send(STR("[Lua] Hook for /Script/Engine.Actor:ReceiveTick called, call: {}, delta: {}\n"), LogLevel::Verbose, i, 0.016f);
+    });
+    const double filtered_eager_argument = measure_nanoseconds_per_call(num_calls / 10, [](size_t i) {
+        Output::send<LogLevel::Verbose>(STR("[Lua] Hook for {} called\n"), fmt::format(STR("/Script/Engine.Actor:ReceiveTick #{}"), i));
+    });
+    const double filtered_lazy_argument = measure_nanoseconds_per_call(num_calls, [](size_t i) {
+        RC_OUTPUT_SEND_IF_ENABLED(LogLevel::Verbose, STR("[Lua] Hook for {} called\n"), fmt::format(STR("/Script/Engine.Actor:ReceiveTick #{}"), i));
+    });
+    Output::set_minimum_log_level(LogLevel::Verbose);
+
+    std::printf("\n%-60s %10s\n", "call", "ns/call");
+    std::printf("%-60s %10.1f\n", "send<Verbose>, not filtered (formats and writes)", unfiltered);
+    std::printf("%-60s %10.1f\n", "send<Verbose>, filtered out", filtered);
+    std::printf("%-60s %10.1f\n", "send(LogLevel::Verbose), filtered out", filtered_runtime_level);
+    std::printf("%-60s %10.1f\n", "send<Verbose> with an fmt::format argument, filtered out", filtered_eager_argument);
+    std::printf("%-60s %10.1f\n", "RC_OUTPUT_SEND_IF_ENABLED with the same argument, filtered out", filtered_lazy_argument);
+}
+
+static auto run_file_writes() -> void
+{
+    static constexpr size_t num_calls = 1'000'000;
+    static constexpr File::StringViewType message = STR("[12:34:56.789] [Lua] Hook for /Script/Engine.Actor:ReceiveTick called, delta: 0.016\n");
+
+    const auto file_path = (std::filesystem::temp_directory_path() / "OutputBench.utf8.log").string();
+    std::FILE* file = std::fopen(file_path.c_str(), "wb");
+    std::setvbuf(file, nullptr, _IONBF, 0);
+
+    std::string utf8{};
+    const double unbuffered = measure_nanoseconds_per_call(num_calls, [&](size_t) {
+        utf8.clear();
+        File::append_as_utf8(utf8, message);
+        std::fwrite(utf8.data(), 1, utf8.size(), file);
+    });
+
+    uint64_t num_flushes{};
+    const double buffered = [&] {
+        File::BufferedWriter writer{[&](std::string_view block) {
+            std::fwrite(block.data(), 1, block.size(), file);
+        }};
+        const double result = measure_nanoseconds_per_call(num_calls, [&](size_t) {
+            writer.write(message);
+        });
+        writer.flush();
+        num_flushes = writer.get_num_flushes();
+        return result;
+    }();
+
+    std::fclose(file);
+    std::filesystem::remove(file_path);
+
+    std::printf("\n%-60s %10s\n", "file write", "ns/call");
+    std::printf("%-60s %10.1f\n", "convert to UTF-8 and write each message", unbuffered);
+    std::printf("%-60s %10.1f\n", "File::BufferedWriter::write", buffered);
+    std::printf("%-60s %10llu\n", "writes to the OS made by File::BufferedWriter", static_cast<unsigned long long>(num_flushes));
+}
+
+static auto run_trace() -> void
+{
+    static constexpr size_t num_calls = 1'000'000;
+
+    const auto file_path = std::filesystem::temp_directory_path() / "OutputBench.trace";
+    double traced{};
+    {
+        Output::BinaryLogDevice device{};
+        device.set_file_name_and_path(file_path);
+        Output::set_trace_device(&device);
+        traced = measure_nanoseconds_per_call(num_calls, [](size_t i) {
+            RC_OUTPUT_TRACE(STR("[Lua] Hook for {} called, call: {}, delta: {}\n"), STR("/Script/Engine.Actor:ReceiveTick"), i, 0.016f);
+        });
+    }
+    std::filesystem::remove(file_path);
+
+    const double disabled = measure_nanoseconds_per_call(num_calls * 10, [](size_t i) {
+        RC_OUTPUT_TRACE(STR("[Lua] Hook for {} called, call: {}, delta: {}\n"), STR("/Script/Engine.Actor:ReceiveTick"), i, 0.016f);
+    });
+
+    std::printf("\n%-60s %10s\n", "trace", "ns/call");
+    std::printf("%-60s %10.1f\n", "RC_OUTPUT_TRACE to a BinaryLogDevice", traced);
+    std::printf("%-60s %10.1f\n", "RC_OUTPUT_TRACE without a trace device", disabled);
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    const size_t num_messages_per_thread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+
+    Output::set_default_devices<BenchFileDevice>();
+
+    struct Mode
+    {
+        const char* name;
+        bool is_async;
+        Output::AsyncOverflowPolicy overflow_policy;
+    };
+    static constexpr Mode modes[] = {
+            {"sync", false, Output::AsyncOverflowPolicy::Block},
+            {"async (block)", true, Output::AsyncOverflowPolicy::Block},
+            {"async (drop)", true, Output::AsyncOverflowPolicy::Drop},
+    };
+
+    std::printf("%-14s %8s %10s %10s %12s %14s %10s %10s\n", "mode", "threads", "p50 ns", "p99 ns", "max ns", "messages/s", "dropped", "waits");
+    for (const auto& mode : modes)
+    {
+        for (size_t num_threads : {size_t{1}, size_t{16}})
+        {
+            if (mode.is_async)
+            {
+                Output::enable_async_output({.overflow_policy = mode.overflow_policy});
+            }
+
+            const auto result = run(num_threads, num_messages_per_thread);
+
+            Output::disable_async_output();
+            const auto stats = Output::get_async_output_stats();
+            std::printf("%-14s %8zu %10.0f %10.0f %12.0f %14.0f %10llu %10llu\n",
+                        mode.name,
+                        num_threads,
+                        result.p50_nanoseconds,
+                        result.p99_nanoseconds,
+                        result.max_nanoseconds,
+                        result.messages_per_second,
+                        mode.is_async ? static_cast<unsigned long long>(stats.num_dropped) : 0ull,
+                        mode.is_async ? static_cast<unsigned long long>(stats.num_full_waits) : 0ull);
+        }
+    }
+
+    run_filtered_out();
+    run_file_writes();
+    run_trace();
+
+    Output::close_all_default_devices();
+    return 0;
+}
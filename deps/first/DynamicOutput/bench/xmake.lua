@@ -0,0 +1,28 @@
+-- Standalone benchmarks for the portable parts of DynamicOutput
+-- They aren't part of the UE4SS build, which only targets Windows, and can be built on Linux with:
+--   cd deps/first/DynamicOutput/bench && xmake && xmake run OutputBench [messages per thread]
+set_xmakever("2.9.3")
+set_project("DynamicOutputBench")
+
+add_rules("mode.release", "mode.debug")
+set_defaultmode("release")
+
+add_requires("fmt")
+
+target("OutputBench")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_DYNAMIC_OUTPUT_BUILD_STATIC", "RC_FILE_BUILD_STATIC")
+    add_includedirs("../include", "../../File/include", "../../String/include", "../../Constructs/include")
+
+    add_files("OutputBench.cpp")
+    add_files("../src/Output.cpp", "../src/OutputDevice.cpp", "../src/AsyncOutput.cpp", "../src/BinaryLogDevice.cpp")
+    add_files("../../File/src/BufferedWriter.cpp")
+
+    add_packages("fmt")
+
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
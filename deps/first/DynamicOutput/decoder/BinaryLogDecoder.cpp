@@ -0,0 +1,549 @@
+// Turns a file written by Output::BinaryLogDevice back into text or JSON
+// Usage: BinaryLogDecoder [--json] <input file> [output file]
+//
+// Text output has one line per message: [2024-01-31 12:34:56.789012] [T3] message
+// JSON output has one object per line, with the format and the arguments next to the formatted message
+// Times are in UTC
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <fmt/args.h>
+#include <fmt/format.h>
+
+#include <DynamicOutput/BinaryLogFormat.hpp>
+
+using namespace RC::Output;
+
+struct Pointer
+{
+    uint64_t address{};
+};
+
+using Argument = std::variant<bool, int64_t, uint64_t, float, double, char32_t, Pointer, std::string>;
+
+struct DecodedRecord
+{
+    int64_t time{};
+    uint32_t thread_index{};
+    std::optional<int32_t> log_level{};
+    std::optional<uint32_t> format_id{};
+    std::string format{};
+    std::vector<Argument> arguments{};
+    std::string text{};
+};
+
+static auto append_code_point(std::string& out, char32_t code_point) -> void
+{
+    if (code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF))
+    {
+        code_point = 0xFFFD;
+    }
+
+    if (code_point < 0x80)
+    {
+        out.push_back(static_cast<char>(code_point));
+    }
+    else if (code_point < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else if (code_point < 0x10000)
+    {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else
+    {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+// The game writes strings with its own code unit size, which is 2 bytes on Windows
+static auto to_utf8(std::string_view bytes, uint8_t char_size) -> std::optional<std::string>
+{
+    if (char_size == 1)
+    {
+        return std::string{bytes};
+    }
+
+    if ((char_size != 2 && char_size != 4) || bytes.size() % char_size != 0)
+    {
+        return std::nullopt;
+    }
+
+    std::string out{};
+    out.reserve(bytes.size());
+    BinaryLog::Reader reader{bytes};
+    while (!reader.is_empty())
+    {
+        if (char_size == 4)
+        {
+            append_code_point(out, *reader.read<char32_t>());
+            continue;
+        }
+
+        const char32_t code_unit = *reader.read<char16_t>();
+        if (code_unit >= 0xD800 && code_unit <= 0xDBFF)
+        {
+            BinaryLog::Reader peek{reader.get_remaining()};
+            const auto next_code_unit = peek.read<char16_t>();
+            if (next_code_unit && *next_code_unit >= 0xDC00 && *next_code_unit <= 0xDFFF)
+            {
+                (void)reader.read<char16_t>();
+                append_code_point(out, 0x10000 + ((code_unit - 0xD800) << 10) + (*next_code_unit - 0xDC00));
+                continue;
+            }
+        }
+        append_code_point(out, code_unit);
+    }
+    return out;
+}
+
+static auto read_argument(BinaryLog::Reader& reader) -> std::optional<Argument>
+{
+    using ArgumentType = BinaryLog::ArgumentType;
+
+    const auto type = reader.read<ArgumentType>();
+    if (!type)
+    {
+        return std::nullopt;
+    }
+
+    switch (*type)
+    {
+    case ArgumentType::Bool:
+        if (auto value = reader.read<uint8_t>())
+        {
+            return Argument{*value != 0};
+        }
+        break;
+    case ArgumentType::Int:
+        if (auto value = reader.read<int64_t>())
+        {
+            return Argument{*value};
+        }
+        break;
+    case ArgumentType::UInt:
+        if (auto value = reader.read<uint64_t>())
+        {
+            return Argument{*value};
+        }
+        break;
+    case ArgumentType::Float:
+        if (auto value = reader.read<float>())
+        {
+            return Argument{*value};
+        }
+        break;
+    case ArgumentType::Double:
+        if (auto value = reader.read<double>())
+        {
+            return Argument{*value};
+        }
+        break;
+    case ArgumentType::Char:
+        if (auto value = reader.read<uint32_t>())
+        {
+            return Argument{static_cast<char32_t>(*value)};
+        }
+        break;
+    case ArgumentType::Pointer:
+        if (auto value = reader.read<uint64_t>())
+        {
+            return Argument{Pointer{*value}};
+        }
+        break;
+    case ArgumentType::String: {
+        const auto num_code_units = reader.read<uint32_t>();
+        const auto char_size = reader.read<uint8_t>();
+        if (!num_code_units || !char_size)
+        {
+            break;
+        }
+
+        const auto bytes = reader.read_bytes(static_cast<size_t>(*num_code_units) * *char_size);
+        if (!bytes)
+        {
+            break;
+        }
+
+        if (auto string = to_utf8(*bytes, *char_size))
+        {
+            return Argument{std::move(*string)};
+        }
+        break;
+    }
+    }
+    return std::nullopt;
+}
+
+// Removes the line break that most messages end with, every message gets exactly one in the output
+static auto trim_line_break(std::string& text) -> void
+{
+    while (!text.empty() && (text.back() == '\n' || text.back() == '\r'))
+    {
+        text.pop_back();
+    }
+}
+
+static auto format_message(const std::string& format, const std::vector<Argument>& arguments) -> std::string
+{
+    fmt::dynamic_format_arg_store<fmt::format_context> store{};
+    for (const auto& argument : arguments)
+    {
+        std::visit(
+                [&]<typename T>(const T& value) {
+                    if constexpr (std::is_same_v<T, Pointer>)
+                    {
+                        store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(value.address)));
+                    }
+                    else if constexpr (std::is_same_v<T, char32_t>)
+                    {
+                        if (value < 0x80)
+                        {
+                            store.push_back(static_cast<char>(value));
+                        }
+                        else
+                        {
+                            std::string utf8{};
+                            append_code_point(utf8, value);
+                            store.push_back(std::move(utf8));
+                        }
+                    }
+                    else
+                    {
+                        store.push_back(value);
+                    }
+                },
+                argument);
+    }
+
+    try
+    {
+        return fmt::vformat(format, store);
+    }
+    catch (const fmt::format_error& e)
+    {
+        // A format string that fmt rejects is still useful to look at
+        auto trimmed_format = format;
+        trim_line_break(trimmed_format);
+        return fmt::format("{} <format error: {}>", trimmed_format, e.what());
+    }
+}
+
+static auto format_time(int64_t nanoseconds_since_epoch) -> std::string
+{
+    auto seconds = nanoseconds_since_epoch / 1'000'000'000;
+    auto nanoseconds = nanoseconds_since_epoch % 1'000'000'000;
+    if (nanoseconds < 0)
+    {
+        --seconds;
+        nanoseconds += 1'000'000'000;
+    }
+
+    const auto time = static_cast<std::time_t>(seconds);
+    std::tm utc{};
+#ifdef _WIN32
+    gmtime_s(&utc, &time);
+#else
+    gmtime_r(&time, &utc);
+#endif
+
+    char date_and_time[32]{};
+    std::strftime(date_and_time, sizeof(date_and_time), "%Y-%m-%d %H:%M:%S", &utc);
+    return fmt::format("{}.{:06}", date_and_time, nanoseconds / 1000);
+}
+
+static auto append_json_string(std::string& out, std::string_view string) -> void
+{
+    out.push_back('"');
+    for (const char c : string)
+    {
+        switch (c)
+        {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out += fmt::format("\\u{:04x}", static_cast<unsigned char>(c));
+            }
+            else
+            {
+                out.push_back(c);
+            }
+        }
+    }
+    out.push_back('"');
+}
+
+static auto append_json_argument(std::string& out, const Argument& argument) -> void
+{
+    std::visit(
+            [&]<typename T>(const T& value) {
+                if constexpr (std::is_same_v<T, bool>)
+                {
+                    out += value ? "true" : "false";
+                }
+                else if constexpr (std::is_same_v<T, Pointer>)
+                {
+                    out += fmt::format("\"0x{:x}\"", value.address);
+                }
+                else if constexpr (std::is_same_v<T, char32_t>)
+                {
+                    std::string utf8{};
+                    append_code_point(utf8, value);
+                    append_json_string(out, utf8);
+                }
+                else if constexpr (std::is_same_v<T, std::string>)
+                {
+                    append_json_string(out, value);
+                }
+                else if constexpr (std::is_floating_point_v<T>)
+                {
+                    // JSON has no representation for these
+                    if (std::isfinite(value))
+                    {
+                        out += fmt::format("{}", value);
+                    }
+                    else
+                    {
+                        append_json_string(out, fmt::format("{}", value));
+                    }
+                }
+                else
+                {
+                    out += fmt::format("{}", value);
+                }
+            },
+            argument);
+}
+
+static auto write_text(std::FILE* output, const DecodedRecord& record) -> void
+{
+    std::fprintf(output, "[%s] [T%u] %s\n", format_time(record.time).c_str(), record.thread_index, record.text.c_str());
+}
+
+static auto write_json(std::FILE* output, const DecodedRecord& record) -> void
+{
+    std::string line{"{\"time\":"};
+    append_json_string(line, format_time(record.time));
+    line += fmt::format(",\"time_ns\":{},\"thread\":{}", record.time, record.thread_index);
+    if (record.log_level)
+    {
+        line += fmt::format(",\"log_level\":{}", *record.log_level);
+    }
+    if (record.format_id)
+    {
+        line += fmt::format(",\"format_id\":{},\"format\":", *record.format_id);
+        append_json_string(line, record.format);
+        line += ",\"args\":[";
+        for (size_t i = 0; i < record.arguments.size(); ++i)
+        {
+            if (i > 0)
+            {
+                line.push_back(',');
+            }
+            append_json_argument(line, record.arguments[i]);
+        }
+        line.push_back(']');
+    }
+    line += ",\"message\":";
+    append_json_string(line, record.text);
+    line += "}\n";
+    std::fputs(line.c_str(), output);
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    bool is_json{};
+    std::vector<std::string_view> paths{};
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg{argv[i]};
+        if (arg == "--json")
+        {
+            is_json = true;
+        }
+        else
+        {
+            paths.emplace_back(arg);
+        }
+    }
+
+    if (paths.empty() || paths.size() > 2)
+    {
+        std::fprintf(stderr, "Usage: BinaryLogDecoder [--json] <input file> [output file]\n");
+        return 2;
+    }
+
+    std::ifstream input_file{std::string{paths[0]}, std::ios::binary};
+    if (!input_file)
+    {
+        std::fprintf(stderr, "Could not open '%s'\n", std::string{paths[0]}.c_str());
+        return 1;
+    }
+    const std::string data{std::istreambuf_iterator<char>{input_file}, std::istreambuf_iterator<char>{}};
+
+    std::FILE* output = stdout;
+    if (paths.size() == 2)
+    {
+        output = std::fopen(std::string{paths[1]}.c_str(), "wb");
+        if (!output)
+        {
+            std::fprintf(stderr, "Could not open '%s' for writing\n", std::string{paths[1]}.c_str());
+            return 1;
+        }
+    }
+
+    BinaryLog::Reader reader{data};
+    const auto magic = reader.read_bytes(sizeof(BinaryLog::magic));
+    const auto version = reader.read<uint32_t>();
+    const auto start_time = reader.read<int64_t>();
+    if (!magic || *magic != std::string_view{BinaryLog::magic, sizeof(BinaryLog::magic)} || !version || !start_time)
+    {
+        std::fprintf(stderr, "'%s' is not a binary log\n", std::string{paths[0]}.c_str());
+        return 1;
+    }
+    if (*version > BinaryLog::version)
+    {
+        std::fprintf(stderr, "The file is version %u, this decoder only knows up to version %u\n", *version, BinaryLog::version);
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, std::string> formats{};
+    size_t num_records{};
+    while (!reader.is_empty())
+    {
+        const size_t offset = data.size() - reader.get_remaining().size();
+        const auto type = reader.read<BinaryLog::RecordType>();
+        const auto payload_size = reader.read<uint32_t>();
+        const auto payload = payload_size ? reader.read_bytes(*payload_size) : std::nullopt;
+        if (!type || !payload)
+        {
+            // Happens when the game crashed or was killed while the log was being written
+            std::fprintf(stderr, "The file ends with an incomplete record at offset %zu, everything before it was decoded\n", offset);
+            break;
+        }
+        ++num_records;
+
+        BinaryLog::Reader payload_reader{*payload};
+        bool is_valid{true};
+        DecodedRecord record{};
+        switch (*type)
+        {
+        case BinaryLog::RecordType::Format: {
+            const auto format_id = payload_reader.read<uint32_t>();
+            const auto char_size = payload_reader.read<uint8_t>();
+            auto format = format_id && char_size ? to_utf8(payload_reader.get_remaining(), *char_size) : std::nullopt;
+            if (format)
+            {
+                formats[*format_id] = std::move(*format);
+            }
+            else
+            {
+                is_valid = false;
+            }
+            break;
+        }
+        case BinaryLog::RecordType::Message: {
+            const auto format_id = payload_reader.read<uint32_t>();
+            const auto time = payload_reader.read<int64_t>();
+            const auto thread_index = payload_reader.read<uint32_t>();
+            const auto num_arguments = payload_reader.read<uint8_t>();
+            const auto format = format_id ? formats.find(*format_id) : formats.end();
+            if (!time || !thread_index || !num_arguments || format == formats.end())
+            {
+                is_valid = false;
+                break;
+            }
+
+            record.time = *time;
+            record.thread_index = *thread_index;
+            record.format_id = *format_id;
+            record.format = format->second;
+            for (uint8_t i = 0; i < *num_arguments && is_valid; ++i)
+            {
+                auto argument = read_argument(payload_reader);
+                is_valid = argument.has_value();
+                if (argument)
+                {
+                    record.arguments.emplace_back(std::move(*argument));
+                }
+            }
+
+            if (is_valid)
+            {
+                record.text = format_message(record.format, record.arguments);
+                trim_line_break(record.text);
+                is_json ? write_json(output, record) : write_text(output, record);
+            }
+            break;
+        }
+        case BinaryLog::RecordType::Text: {
+            const auto time = payload_reader.read<int64_t>();
+            const auto thread_index = payload_reader.read<uint32_t>();
+            const auto log_level = payload_reader.read<int32_t>();
+            const auto char_size = payload_reader.read<uint8_t>();
+            auto text = time && thread_index && log_level && char_size ? to_utf8(payload_reader.get_remaining(), *char_size) : std::nullopt;
+            if (!text)
+            {
+                is_valid = false;
+                break;
+            }
+
+            record.time = *time;
+            record.thread_index = *thread_index;
+            record.log_level = *log_level;
+            record.text = std::move(*text);
+            trim_line_break(record.text);
+            is_json ? write_json(output, record) : write_text(output, record);
+            break;
+        }
+        default:
+            // Written by a newer version of the game, the payload size lets the decoder carry on with the next record
+            break;
+        }
+
+        if (!is_valid)
+        {
+            std::fprintf(stderr, "Skipped a malformed record at offset %zu\n", offset);
+        }
+    }
+
+    if (output != stdout)
+    {
+        std::fclose(output);
+    }
+    std::fprintf(stderr, "Decoded %zu records\n", num_records);
+    return 0;
+}
@@ -0,0 +1,21 @@
+-- Standalone command-line tool that turns a file written by Output::BinaryLogDevice into text or JSON
+-- It isn't part of the UE4SS build and only depends on fmt, so it can be built on Linux as well as on Windows:
+--   cd deps/first/DynamicOutput/decoder && xmake && xmake run BinaryLogDecoder [--json] <input file> [output file]
+set_xmakever("2.9.3")
+set_project("BinaryLogDecoder")
+
+add_rules("mode.release", "mode.debug")
+set_defaultmode("release")
+
+add_requires("fmt")
+
+target("BinaryLogDecoder")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_includedirs("../include")
+
+    add_files("BinaryLogDecoder.cpp")
+
+    add_packages("fmt")
@@ -0,0 +1,79 @@
+#ifndef UE4SS_REWRITTEN_ASYNCOUTPUT_HPP
+#define UE4SS_REWRITTEN_ASYNCOUTPUT_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <Constructs/MpscQueue.hpp>
+#include <DynamicOutput/Common.hpp>
+#include <File/Macros.hpp>
+
+namespace RC::Output
+{
+    // What a thread that sends output does when the async queue is full
+    enum class AsyncOverflowPolicy
+    {
+        // Wait for the output thread to make room, no output is ever lost
+        Block,
+
+        // Throw the message away and carry on, the output thread reports how many messages were dropped
+        Drop,
+    };
+
+    struct AsyncOutputOptions
+    {
+        // The maximum number of messages waiting for the output thread, rounded up to a power of two
+        size_t queue_capacity{8192};
+        AsyncOverflowPolicy overflow_policy{AsyncOverflowPolicy::Block};
+    };
+
+    struct AsyncOutputStats
+    {
+        MpscQueueStats queue{};
+
+        // Messages thrown away because of AsyncOverflowPolicy::Drop
+        uint64_t num_dropped{};
+
+        // The number of times that a thread had to wait because of AsyncOverflowPolicy::Block
+        uint64_t num_full_waits{};
+    };
+
+    // Async output hands messages sent to the default devices to a dedicated output thread
+    // The sending thread still formats the message, but the device formatters, the file writes and the console writes happen on the output thread
+    // Messages from the same thread reach the devices in the order they were sent
+    // Output sent with a Targets object is unaffected and is always synchronous
+    //
+    // Default devices must not be added or removed while async output is enabled
+    // 'close_all_default_devices' disables async output before it closes the devices
+    RC_DYNOUT_API auto enable_async_output(const AsyncOutputOptions& options = {}) -> void;
+
+    // Stops the output thread after every message that was queued before the call has reached the devices
+    RC_DYNOUT_API auto disable_async_output() -> void;
+
+    RC_DYNOUT_API auto is_async_output_enabled() -> bool;
+
+    // Passes every queued message to the devices and then flushes the devices before returning, safe to call from any thread
+    // The output thread also flushes the devices whenever it runs out of messages
+    RC_DYNOUT_API auto flush() -> void;
+
+    // Like 'flush', but meant to be called from a crash handler
+    // Gives up after 'timeout' if the output thread doesn't let go of the devices, and does nothing when called from the output thread itself
+    RC_DYNOUT_API auto flush_on_crash(std::chrono::milliseconds timeout = std::chrono::milliseconds{500}) -> void;
+
+    // The stats of the output thread that's currently running, or of the last one if async output is disabled
+    RC_DYNOUT_API auto get_async_output_stats() -> AsyncOutputStats;
+
+    namespace Internal
+    {
+        // Returns false if async output is disabled, the caller must then pass the message to the devices itself
+        RC_DYNOUT_API auto try_send_to_output_thread(File::StringType&& content, int32_t optional_arg) -> bool;
+
+        // Passes a message to every default device on the calling thread, regardless of whether async output is enabled
+        RC_DYNOUT_API auto send_to_default_devices_now(File::StringViewType content, int32_t optional_arg) -> void;
+
+        RC_DYNOUT_API auto flush_default_devices() -> void;
+    } // namespace Internal
+} // namespace RC::Output
+
+#endif // UE4SS_REWRITTEN_ASYNCOUTPUT_HPP
@@ -0,0 +1,196 @@
+#ifndef UE4SS_REWRITTEN_BINARYLOGDEVICE_HPP
+#define UE4SS_REWRITTEN_BINARYLOGDEVICE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <DynamicOutput/BinaryLogFormat.hpp>
+#include <DynamicOutput/Common.hpp>
+#include <DynamicOutput/OutputDevice.hpp>
+#include <File/BufferedWriter.hpp>
+
+namespace RC::Output
+{
+    // Writes messages to a file in the format described in BinaryLogFormat.hpp, the BinaryLogDecoder tool turns the file back into text or JSON
+    //
+    // Messages sent with 'trace' or RC_OUTPUT_TRACE are stored as a format id and the raw arguments, so they're never formatted in the game
+    // The device can also be used like any other device, in which case it stores the text that it receives
+    //
+    // Only one device at a time receives traces, see 'set_trace_device'
+    class RC_DYNOUT_API BinaryLogDevice : public OutputDevice
+    {
+      private:
+        std::filesystem::path m_file_name_and_path;
+        // Not flushed by time because reading the clock a second time would add noticeably to the cost of a trace
+        // The file is written when the buffer is full, by Output::flush and Output::flush_on_crash, and when the device is destroyed
+        File::BufferedWriter::Options m_writer_options{.max_delay = std::chrono::milliseconds::max()};
+
+        mutable std::ofstream m_file{};
+        mutable std::unique_ptr<File::BufferedWriter> m_writer{};
+
+        // Reused for records that are built while 'm_mutex' is locked
+        mutable std::string m_record{};
+
+        // Indexed by format id, whether the format has been written to this file
+        mutable std::vector<bool> m_is_format_written{};
+
+        // Timed so that a crash handler can give up on a thread that crashed while it was writing
+        mutable std::timed_mutex m_mutex{};
+
+      public:
+        BinaryLogDevice() = default;
+        ~BinaryLogDevice() override;
+
+      public:
+        // OutputDevice Interface -> START
+        auto has_optional_arg() const -> bool override;
+        auto receive(File::StringViewType fmt) const -> void override;
+        auto receive_with_optional_arg(File::StringViewType fmt, int32_t optional_arg = 0) const -> void override;
+        auto flush() const -> void override;
+        // OutputDevice Interface -> END
+
+        // Must be called before the first message is received
+        auto set_file_name_and_path(const std::filesystem::path& file_name_and_path) -> void;
+
+        // Must be called before the first message is received to have an effect
+        auto set_buffer_options(const File::BufferedWriter::Options& options) -> void;
+
+        // Writes a message record built by 'trace', also writes the format the first time that 'format_id' is seen
+        auto write_message_record(uint32_t format_id, std::string_view record) const -> void;
+
+        // Like 'flush', but gives up if another thread is writing to the device for longer than 'timeout'
+        auto flush_with_timeout(std::chrono::milliseconds timeout) const -> void;
+
+      private:
+        // Must be called with 'm_mutex' locked
+        auto start_device() const -> void;
+        auto write_format_record(uint32_t format_id) const -> void;
+        auto write_record(std::string& record) const -> void;
+    };
+
+    // Returns the id of 'format', which is the same for the whole process every time that the same format is registered
+    // RC_OUTPUT_TRACE calls this once per call site
+    RC_DYNOUT_API auto register_trace_format(File::StringViewType format) -> uint32_t;
+
+    // Sets the device that receives traces, nullptr disables tracing
+    // The device stops receiving traces when it's destroyed
+    RC_DYNOUT_API auto set_trace_device(BinaryLogDevice* device) -> void;
+
+    [[nodiscard]] RC_DYNOUT_API auto is_tracing_enabled() -> bool;
+
+    // Output::flush and Output::flush_on_crash call this, so the trace device doesn't need to be a default device to be flushed
+    RC_DYNOUT_API auto flush_trace_device(std::chrono::milliseconds timeout = std::chrono::milliseconds::max()) -> void;
+
+    namespace Internal
+    {
+        template <typename>
+        constexpr bool always_false = false;
+
+        template <typename T>
+        auto append_trace_value(std::string& record, const T& value) -> void
+        {
+            record.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <typename CharT>
+        auto append_trace_string(std::string& record, std::basic_string_view<CharT> string) -> void
+        {
+            append_trace_value(record, BinaryLog::ArgumentType::String);
+            append_trace_value(record, static_cast<uint32_t>(string.size()));
+            append_trace_value(record, static_cast<uint8_t>(sizeof(CharT)));
+            record.append(reinterpret_cast<const char*>(string.data()), string.size() * sizeof(CharT));
+        }
+
+        template <typename T>
+        auto append_trace_argument(std::string& record, const T& argument) -> void
+        {
+            using ArgumentType = BinaryLog::ArgumentType;
+
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                append_trace_value(record, ArgumentType::Bool);
+                append_trace_value(record, static_cast<uint8_t>(argument));
+            }
+            else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, File::CharType> || std::is_same_v<T, char8_t> || std::is_same_v<T, char16_t> ||
+                               std::is_same_v<T, char32_t>)
+            {
+                append_trace_value(record, ArgumentType::Char);
+                append_trace_value(record, static_cast<uint32_t>(static_cast<std::make_unsigned_t<T>>(argument)));
+            }
+            else if constexpr (std::is_enum_v<T>)
+            {
+                append_trace_argument(record, static_cast<std::underlying_type_t<T>>(argument));
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            {
+                append_trace_value(record, ArgumentType::Int);
+                append_trace_value(record, static_cast<int64_t>(argument));
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                append_trace_value(record, ArgumentType::UInt);
+                append_trace_value(record, static_cast<uint64_t>(argument));
+            }
+            else if constexpr (std::is_same_v<T, float>)
+            {
+                append_trace_value(record, ArgumentType::Float);
+                append_trace_value(record, argument);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                append_trace_value(record, ArgumentType::Double);
+                append_trace_value(record, static_cast<double>(argument));
+            }
+            else if constexpr (std::is_convertible_v<const T&, File::StringViewType>)
+            {
+                append_trace_string(record, File::StringViewType{argument});
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                append_trace_string(record, std::string_view{argument});
+            }
+            else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>)
+            {
+                append_trace_value(record, ArgumentType::Pointer);
+                append_trace_value(record, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<const volatile void*>(argument))));
+            }
+            else
+            {
+                static_assert(always_false<T>, "Traces only store numbers, characters, strings, pointers and enums, format anything else with Output::send instead");
+            }
+        }
+
+        // Returns a buffer owned by the calling thread with the start of a message record in it
+        RC_DYNOUT_API auto begin_trace_record(uint32_t format_id, uint8_t num_arguments) -> std::string&;
+
+        // Passes the record to the trace device
+        RC_DYNOUT_API auto end_trace_record(uint32_t format_id, std::string& record) -> void;
+    } // namespace Internal
+
+    // Stores a message that's formatted later by the BinaryLogDecoder tool, does nothing if there's no trace device
+    // Use RC_OUTPUT_TRACE instead of calling this directly, it registers the format once and skips evaluating the arguments when tracing is disabled
+    template <typename... Args>
+    auto trace(uint32_t format_id, const Args&... args) -> void
+    {
+        static_assert(sizeof...(Args) <= UINT8_MAX, "Too many arguments for a trace");
+
+        if (!is_tracing_enabled())
+        {
+            return;
+        }
+
+        auto& record = Internal::begin_trace_record(format_id, static_cast<uint8_t>(sizeof...(Args)));
+        (Internal::append_trace_argument(record, args), ...);
+        Internal::end_trace_record(format_id, record);
+    }
+} // namespace RC::Output
+
+#endif // UE4SS_REWRITTEN_BINARYLOGDEVICE_HPP
@@ -0,0 +1,124 @@
+#ifndef UE4SS_REWRITTEN_BINARYLOGFORMAT_HPP
+#define UE4SS_REWRITTEN_BINARYLOGFORMAT_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+// The file format written by BinaryLogDevice and read by the BinaryLogDecoder tool
+// Only depends on the standard library so that the decoder can be built on any platform
+//
+// Every value is stored in little-endian byte order, without padding
+//
+// A file starts with a header:
+//   char magic[8]          "UE4SSBLG"
+//   u32  version           'binary_log_version'
+//   i64  start_time        Nanoseconds since the Unix epoch (UTC) when the file was created
+//
+// Followed by records, until the end of the file:
+//   u8   type              RecordType
+//   u32  payload_size      The number of bytes that follow, so that a reader can skip records that it doesn't know
+//   ...  payload
+//
+// A file that ends in the middle of a record, for example because the game crashed, is valid up to that record
+namespace RC::Output::BinaryLog
+{
+    // Values are copied to and from the file as they are in memory
+    static_assert(std::endian::native == std::endian::little, "The binary log format is only implemented for little-endian machines");
+
+    constexpr char magic[8]{'U', 'E', '4', 'S', 'S', 'B', 'L', 'G'};
+    constexpr uint32_t version = 1;
+    constexpr size_t header_size = sizeof(magic) + sizeof(uint32_t) + sizeof(int64_t);
+    constexpr size_t record_header_size = sizeof(uint8_t) + sizeof(uint32_t);
+
+    enum class RecordType : uint8_t
+    {
+        // Written once per format before the first message that uses it
+        //   u32  format_id
+        //   u8   char_size       Size of a code unit in bytes, 1 = UTF-8, 2 = UTF-16, 4 = UTF-32
+        //   ...  the format string, without a null terminator
+        Format = 1,
+
+        // A message that hasn't been formatted
+        //   u32  format_id
+        //   i64  time            Nanoseconds since the Unix epoch (UTC)
+        //   u32  thread_index    Small number that's unique for each thread that has written to the file
+        //   u8   num_arguments
+        //   ...  arguments, each one is a u8 ArgumentType followed by the value
+        Message = 2,
+
+        // A message that was formatted before it reached the device, for example one sent with Output::send
+        //   i64  time
+        //   u32  thread_index
+        //   i32  log_level
+        //   u8   char_size
+        //   ...  the text, without a null terminator
+        Text = 3,
+    };
+
+    enum class ArgumentType : uint8_t
+    {
+        Bool = 1,    // u8
+        Int = 2,     // i64
+        UInt = 3,    // u64
+        Float = 4,   // f32
+        Double = 5,  // f64
+        Char = 6,    // u32 code point
+        Pointer = 7, // u64
+        String = 8,  // u32 number of code units, u8 char_size, then the code units
+    };
+
+    // Reads values from a block of bytes, every read fails once the block has run out
+    class Reader
+    {
+      private:
+        std::string_view m_data{};
+
+      public:
+        explicit Reader(std::string_view data) : m_data(data)
+        {
+        }
+
+      public:
+        template <typename T>
+        [[nodiscard]] auto read() -> std::optional<T>
+        {
+            if (m_data.size() < sizeof(T))
+            {
+                return std::nullopt;
+            }
+
+            T value{};
+            std::memcpy(&value, m_data.data(), sizeof(T));
+            m_data.remove_prefix(sizeof(T));
+            return value;
+        }
+
+        [[nodiscard]] auto read_bytes(size_t num_bytes) -> std::optional<std::string_view>
+        {
+            if (m_data.size() < num_bytes)
+            {
+                return std::nullopt;
+            }
+
+            const auto bytes = m_data.substr(0, num_bytes);
+            m_data.remove_prefix(num_bytes);
+            return bytes;
+        }
+
+        [[nodiscard]] auto get_remaining() const -> std::string_view
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] auto is_empty() const -> bool
+        {
+            return m_data.empty();
+        }
+    };
+} // namespace RC::Output::BinaryLog
+
+#endif // UE4SS_REWRITTEN_BINARYLOGFORMAT_HPP
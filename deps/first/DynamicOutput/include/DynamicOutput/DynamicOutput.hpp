@@ -5,6 +5,8 @@
 #include <source_location> // Line numbers etc...
 #include <tuple>
 
+#include <DynamicOutput/AsyncOutput.hpp>        // Output thread that takes the device work off of the sending threads
+#include <DynamicOutput/BinaryLogDevice.hpp>    // Binary file that stores traces without formatting them
 #include <DynamicOutput/DebugConsoleDevice.hpp> // stdout
 #include <DynamicOutput/FileDevice.hpp>         // File on drive
 #include <DynamicOutput/Macros.hpp>             // Internal & external utility macros
@@ -1,16 +1,29 @@
 #ifndef UE4SS_REWRITTEN_FILEDEVICE_HPP
 #define UE4SS_REWRITTEN_FILEDEVICE_HPP
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 
 #include <DynamicOutput/Common.hpp>
 #include <DynamicOutput/Macros.hpp>
 #include <DynamicOutput/OutputDevice.hpp>
+#include <File/BufferedWriter.hpp>
 #include <File/File.hpp>
+#include <File/FileRotation.hpp>
 
 namespace RC::Output
 {
+    struct FileRotationOptions
+    {
+        // The file is rotated before a write would make it bigger than this, 0 disables rotation
+        uint64_t max_file_size{};
+
+        // How many older segments are kept next to the file, see File/FileRotation.hpp
+        uint32_t max_num_segments{4};
+    };
+
     // Note: For FileDevice, 'Output::sends()' must only be called after 'FileDevice::set_file_name_and_path()' has been called
 
     // Less simple class that outputs to a file on a drive
@@ -20,11 +33,22 @@ namespace RC::Output
     // Open a file in append mode and keep it open until ~FileDevice
     // Whether to allow the file to be opened by other applications is not defined
     // Write one std::wstring to the file
+    // Messages are converted to UTF-8 into a buffer that's written to the file in blocks, see File::BufferedWriter for when that happens
+    // The buffer is also flushed by 'flush', which the output system calls after each message unless async output is enabled
+    // When rotation is enabled, the file is renamed to a segment and recreated in between two blocks, so every segment holds whole messages
+    // Rotation happens on the thread that writes the file, which is the output thread and not the logging threads when async output is enabled
     class FileDevice : public OutputDevice
     {
       private:
         mutable File::Handle m_file;
         std::filesystem::path m_file_name_and_path;
+        mutable std::unique_ptr<File::BufferedWriter> m_writer{};
+        File::BufferedWriter::Options m_writer_options{};
+        FileRotationOptions m_rotation_options{};
+        mutable uint64_t m_num_bytes_in_file{};
+
+        // Without async output, several threads can send at the same time
+        mutable std::mutex m_writer_mutex{};
 
       protected:
         bool m_always_create_file{};
@@ -48,6 +72,8 @@ namespace RC::Output
                 return;
             }
 
+            // Destroying the writer flushes it
+            m_writer.reset();
             m_file.close();
         }
 #endif
@@ -64,9 +90,52 @@ namespace RC::Output
             m_file = File::open(m_file_name_and_path, File::OpenFor::Appending, File::OverwriteExistingFile::No, File::CreateIfNonExistent::Yes);
         }
 
+        if (m_rotation_options.max_file_size > 0)
+        {
+            if (m_always_create_file)
+            {
+                // Segments left behind by an earlier run would look like older parts of this run
+                File::delete_segments(m_file_name_and_path);
+            }
+            else
+            {
+                File::delete_segments(m_file_name_and_path, m_rotation_options.max_num_segments + 1);
+
+                std::error_code ec{};
+                const auto file_size = std::filesystem::file_size(m_file_name_and_path, ec);
+                m_num_bytes_in_file = ec ? 0 : file_size;
+            }
+        }
+
+        m_writer = std::make_unique<File::BufferedWriter>(
+                [this](std::string_view utf8) {
+                    if (m_rotation_options.max_file_size > 0 && m_num_bytes_in_file > 0 && m_num_bytes_in_file + utf8.size() > m_rotation_options.max_file_size)
+                    {
+                        rotate_file();
+                    }
+
+                    m_file.write_utf8_to_file(utf8);
+                    m_num_bytes_in_file += utf8.size();
+                },
+                m_writer_options);
         m_is_device_ready = true;
     }
 
+    auto rotate_file() const -> void
+    {
+        m_file.close();
+        if (File::rotate_segments(m_file_name_and_path, m_rotation_options.max_num_segments))
+        {
+            m_file = File::open(m_file_name_and_path, File::OpenFor::Appending, File::OverwriteExistingFile::Yes, File::CreateIfNonExistent::Yes);
+        }
+        else
+        {
+            // Keep writing to the same file and try again once another 'max_file_size' bytes have been written
+            m_file = File::open(m_file_name_and_path, File::OpenFor::Appending, File::OverwriteExistingFile::No, File::CreateIfNonExistent::Yes);
+        }
+        m_num_bytes_in_file = 0;
+    }
+
   public:
     // OutputDevice Interface -> START
     // Due to the design of the Output system the opening of the file is done in receive instead of in the constructor
@@ -74,6 +143,7 @@ namespace RC::Output
     // The destructor is responsible for closing the file
     auto receive(File::StringViewType fmt) const -> void override
     {
+        std::lock_guard<std::mutex> lock{m_writer_mutex};
         if (!m_is_device_ready)
         {
             start_device();
@@ -82,10 +152,31 @@ namespace RC::Output
         // Do file output stuff here
         // File should already be open & be ready for writing (happens in constructor)
 
-        m_file.write_string_to_file(m_formatter(fmt));
+        m_writer->write(m_formatter(fmt));
+    }
+
+    auto flush() const -> void override
+    {
+        std::lock_guard<std::mutex> lock{m_writer_mutex};
+        if (m_writer)
+        {
+            m_writer->flush();
+        }
     }
     // OutputDevice Interface -> END
 
+    // Must be called before the first message is received to have an effect
+    auto set_buffer_options(const File::BufferedWriter::Options& options) -> void
+    {
+        m_writer_options = options;
+    }
+
+    // Must be called before the first message is received to have an effect
+    auto set_rotation_options(const FileRotationOptions& options) -> void
+    {
+        m_rotation_options = options;
+    }
+
     auto set_file_name_and_path(const File::StringType& file_name_and_path) -> void
     {
         m_file_name_and_path = file_name_and_path;
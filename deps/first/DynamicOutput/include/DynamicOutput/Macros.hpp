@@ -16,4 +16,28 @@
                                   "construct a Targets object and supply your own devices.")                                                                   \
     }
 
+// Like 'RC::Output::send<log_level>(...)' except that the arguments aren't evaluated unless a default device wants messages with 'log_level'
+// Use it where building the arguments is expensive, for example when they're created with fmt::format or to_wstring
+#define RC_OUTPUT_SEND_IF_ENABLED(log_level, ...)                                                                                                              \
+    do                                                                                                                                                         \
+    {                                                                                                                                                          \
+        if (RC::Output::is_log_level_enabled<log_level>())                                                                                                     \
+        {                                                                                                                                                      \
+            RC::Output::send<log_level>(__VA_ARGS__);                                                                                                          \
+        }                                                                                                                                                      \
+    } while (0)
+
+// Stores a message in the trace device without formatting it, see BinaryLogDevice.hpp
+// The format is registered the first time that the call site runs, and the arguments aren't evaluated unless a trace device is set
+// Usage: RC_OUTPUT_TRACE(STR("Hook for {} called with {} params\n"), function, num_params);
+#define RC_OUTPUT_TRACE(format, ...)                                                                                                                           \
+    do                                                                                                                                                         \
+    {                                                                                                                                                          \
+        if (RC::Output::is_tracing_enabled())                                                                                                                  \
+        {                                                                                                                                                      \
+            static const uint32_t rc_output_trace_format_id = RC::Output::register_trace_format(format);                                                       \
+            RC::Output::trace(rc_output_trace_format_id __VA_OPT__(, ) __VA_ARGS__);                                                                           \
+        }                                                                                                                                                      \
+    } while (0)
+
 #endif // DYNAMIC_OUTPUT_MACROS_HPP
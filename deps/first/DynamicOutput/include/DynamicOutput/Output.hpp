@@ -18,6 +18,11 @@
 #include <DynamicOutput/OutputDevice.hpp>
 #include <File/InternalFile.hpp>
 
+// Messages below this log level are compiled out of the 'send' overloads that take the log level as a template argument
+#ifndef RC_OUTPUT_COMPILE_TIME_MINIMUM_LOG_LEVEL
+#define RC_OUTPUT_COMPILE_TIME_MINIMUM_LOG_LEVEL RC::LogLevel::Verbose
+#endif
+
 #if RC_IS_ANSI == 1
 #define RC_STD_MAKE_FORMAT_ARGS fmt::make_format_args
 #else
@@ -75,6 +80,17 @@ namespace RC::Output
         RC_DYNOUT_API auto static get_default_log_level() -> int32_t;
         RC_DYNOUT_API auto static get_default_devices_ref() -> OutputDevicesContainerType&;
         RC_DYNOUT_API auto static close_all_default_devices() -> void;
+
+        // Messages below the minimum log level never reach the default devices, regardless of the devices own minimum log levels
+        RC_DYNOUT_API auto static set_minimum_log_level(int32_t log_level) -> void;
+        RC_DYNOUT_API auto static get_minimum_log_level() -> int32_t;
+
+        // Whether at least one default device accepts messages with 'log_level'
+        // The answer is cached, so this is a single comparison
+        RC_DYNOUT_API auto static is_log_level_enabled(int32_t log_level) -> bool;
+
+        // Updates the cached answer of 'is_log_level_enabled', called whenever a minimum log level or the default devices change
+        RC_DYNOUT_API auto static refresh_minimum_log_level() -> void;
     };
 
     // RAII class for making output devices not immediately close after calling send()
@@ -121,6 +137,10 @@ namespace RC::Output
             for (const auto& device : m_opened_devices)
             {
                 ASSERT_OUTPUT_DEVICE_IS_VALID(device)
+                if (!device->accepts_log_level(static_cast<int32_t>(optional_arg)))
+                {
+                    continue;
+                }
 
                 if (device->has_optional_arg())
                 {
@@ -144,6 +164,10 @@ namespace RC::Output
             for (const auto& device : m_opened_devices)
             {
                 ASSERT_OUTPUT_DEVICE_IS_VALID(device)
+                if (!device->accepts_log_level(LogLevel::Default))
+                {
+                    continue;
+                }
 
                 if (device->has_optional_arg())
                 {
@@ -167,6 +191,11 @@ namespace RC::Output
             for (const auto& device : m_opened_devices)
             {
                 ASSERT_OUTPUT_DEVICE_IS_VALID(device)
+                if (!device->accepts_log_level(static_cast<int32_t>(optional_arg)))
+                {
+                    continue;
+                }
+
                 if (device->has_optional_arg())
                 {
                     device->receive_with_optional_arg(fmt::vformat(content, fmt_args...), RC_STD_MAKE_FORMAT_ARGS(static_cast<int32_t>(optional_arg)));
@@ -188,6 +217,10 @@ namespace RC::Output
             for (const auto& device : m_opened_devices)
             {
                 ASSERT_OUTPUT_DEVICE_IS_VALID(device)
+                if (!device->accepts_log_level(LogLevel::Default))
+                {
+                    continue;
+                }
 
                 if (device->has_optional_arg())
                 {
@@ -211,6 +244,11 @@ namespace RC::Output
             for (const auto& device : m_opened_devices)
             {
                 ASSERT_OUTPUT_DEVICE_IS_VALID(device)
+                if (!device->accepts_log_level(optional_arg))
+                {
+                    continue;
+                }
+
                 if (device->has_optional_arg())
                 {
                     device->receive_with_optional_arg(fmt::vformat(content, RC_STD_MAKE_FORMAT_ARGS(fmt_arg, fmt_args...)), optional_arg);
@@ -233,6 +271,10 @@ namespace RC::Output
             for (const auto& device : m_opened_devices)
             {
                 ASSERT_OUTPUT_DEVICE_IS_VALID(device)
+                if (!device->accepts_log_level(optional_arg))
+                {
+                    continue;
+                }
 
                 if (device->has_optional_arg())
                 {
@@ -257,7 +299,9 @@ namespace RC::Output
     template <typename DeviceType>
     auto set_default_devices() -> DeviceType&
     {
-        return *static_cast<DeviceType*>(DefaultTargets::get_default_devices_ref().emplace_back(std::make_unique<DeviceType>()).get());
+        auto& device = *static_cast<DeviceType*>(DefaultTargets::get_default_devices_ref().emplace_back(std::make_unique<DeviceType>()).get());
+        DefaultTargets::refresh_minimum_log_level();
+        return device;
     }
 
     // Version of set_default_devices() that can take multiple devices
@@ -271,6 +315,7 @@ namespace RC::Output
     auto inline clear_all_default_devices() -> void
     {
         DefaultTargets::get_default_devices_ref().clear();
+        DefaultTargets::refresh_minimum_log_level();
     }
 
     // Sets the log level that will be used if one isn't explicitly provided with the 'send' function
@@ -280,40 +325,57 @@ namespace RC::Output
         DefaultTargets::set_default_log_level(log_level);
     }
 
+    // Messages below 'log_level' are thrown away by the 'send' functions before the message is formatted
+    auto inline set_minimum_log_level(int32_t log_level) -> void
+    {
+        DefaultTargets::set_minimum_log_level(log_level);
+    }
+
+    // Whether a message with 'log_level' would reach at least one default device
+    // Use it to skip work that only produces arguments for 'send', or use the RC_OUTPUT_SEND_IF_ENABLED macro
+    auto inline is_log_level_enabled(int32_t log_level) -> bool
+    {
+        return DefaultTargets::is_log_level_enabled(log_level);
+    }
+
+    template <int32_t log_level>
+    auto is_log_level_enabled() -> bool
+    {
+        if constexpr (LogLevel::get_severity(log_level) < LogLevel::get_severity(RC_OUTPUT_COMPILE_TIME_MINIMUM_LOG_LEVEL))
+        {
+            return false;
+        }
+        else
+        {
+            return DefaultTargets::is_log_level_enabled(log_level);
+        }
+    }
+
+    // Passes 'content' to every default device, or to the output thread if async output is enabled
+    // Devices that don't take an optional arg receive 'content' without it
+    auto RC_DYNOUT_API send_to_default_devices(File::StringViewType content, int32_t optional_arg) -> void;
+    auto RC_DYNOUT_API send_to_default_devices(File::StringType&& content, int32_t optional_arg) -> void;
+
+    // Every 'send' function checks the log level before formatting, so a message that no device wants costs a call and a comparison
+    // Sending without a log level counts as LogLevel::Normal
     template <typename... FmtArgs>
     auto send(File::StringViewType content, FmtArgs... fmt_args) -> void
     {
-        for (const auto& device : DefaultTargets::get_default_devices_ref())
+        if (!is_log_level_enabled(LogLevel::Default))
         {
-            ASSERT_DEFAULT_OUTPUT_DEVICE_IS_VALID(device)
-
-            if (device->has_optional_arg())
-            {
-                device->receive_with_optional_arg(fmt::vformat(fmt::detail::to_string_view(content), RC_STD_MAKE_FORMAT_ARGS(fmt_args...)), 0);
-            }
-            else
-            {
-                device->receive(fmt::vformat(fmt::detail::to_string_view(content), RC_STD_MAKE_FORMAT_ARGS(fmt_args...)));
-            }
+            return;
         }
+        send_to_default_devices(fmt::vformat(fmt::detail::to_string_view(content), RC_STD_MAKE_FORMAT_ARGS(fmt_args...)), 0);
     }
 
     template <EnumType OptionalArg, typename... FmtArgs>
     auto send(File::StringViewType content, OptionalArg optional_arg, FmtArgs... fmt_args) -> void
     {
-        for (const auto& device : DefaultTargets::get_default_devices_ref())
+        if (!is_log_level_enabled(static_cast<int32_t>(optional_arg)))
         {
-            ASSERT_DEFAULT_OUTPUT_DEVICE_IS_VALID(device)
-
-            if (device->has_optional_arg())
-            {
-                device->receive_with_optional_arg(fmt::vformat(content, RC_STD_MAKE_FORMAT_ARGS(fmt_args...)), static_cast<int32_t>(optional_arg));
-            }
-            else
-            {
-                device->receive(fmt::vformat(content, RC_STD_MAKE_FORMAT_ARGS(fmt_args...)));
-            }
+            return;
         }
+        send_to_default_devices(fmt::vformat(fmt::detail::to_string_view(content), RC_STD_MAKE_FORMAT_ARGS(fmt_args...)), static_cast<int32_t>(optional_arg));
     }
 
     auto RC_DYNOUT_API send(File::StringViewType content) -> void;
@@ -321,55 +383,31 @@ namespace RC::Output
     template <EnumType OptionalArg>
     auto send(File::StringViewType content, OptionalArg optional_arg) -> void
     {
-        for (const auto& device : DefaultTargets::get_default_devices_ref())
+        if (!is_log_level_enabled(static_cast<int32_t>(optional_arg)))
         {
-            ASSERT_DEFAULT_OUTPUT_DEVICE_IS_VALID(device)
-
-            if (device->has_optional_arg())
-            {
-                device->receive_with_optional_arg(content, optional_arg);
-            }
-            else
-            {
-                device->receive(content);
-            }
+            return;
         }
+        send_to_default_devices(content, static_cast<int32_t>(optional_arg));
     }
 
     template <int32_t optional_arg, typename... FmtArgs>
     auto send(File::StringViewType content, FmtArgs... fmt_args) -> void
     {
-        for (const auto& device : DefaultTargets::get_default_devices_ref())
+        if (!is_log_level_enabled<optional_arg>())
         {
-            ASSERT_DEFAULT_OUTPUT_DEVICE_IS_VALID(device)
-
-            if (device->has_optional_arg())
-            {
-                device->receive_with_optional_arg(fmt::vformat(fmt::detail::to_string_view(content), RC_STD_MAKE_FORMAT_ARGS(fmt_args...)), optional_arg);
-            }
-            else
-            {
-                device->receive(fmt::vformat(fmt::detail::to_string_view(content), RC_STD_MAKE_FORMAT_ARGS(fmt_args...)));
-            }
+            return;
         }
+        send_to_default_devices(fmt::vformat(fmt::detail::to_string_view(content), RC_STD_MAKE_FORMAT_ARGS(fmt_args...)), optional_arg);
     }
 
     template <int32_t optional_arg>
     auto send(File::StringViewType content) -> void
     {
-        for (const auto& device : DefaultTargets::get_default_devices_ref())
+        if (!is_log_level_enabled<optional_arg>())
         {
-            ASSERT_DEFAULT_OUTPUT_DEVICE_IS_VALID(device)
-
-            if (device->has_optional_arg())
-            {
-                device->receive_with_optional_arg(content, optional_arg);
-            }
-            else
-            {
-                device->receive(content);
-            }
+            return;
         }
+        send_to_default_devices(content, optional_arg);
     }
 
     template <typename DeviceType>
@@ -1,6 +1,11 @@
 #ifndef UE4SS_REWRITTEN_OUTPUTDEVICE_HPP
 #define UE4SS_REWRITTEN_OUTPUTDEVICE_HPP
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
 #include <DynamicOutput/Common.hpp>
 #include <DynamicOutput/Macros.hpp>
 #include <File/Macros.hpp>
@@ -33,6 +38,26 @@ namespace RC
             Warning = Color::Yellow,
             Error = Color::Red,
         };
+
+        // Orders log levels from least to most severe, the enum values themselves are colors and aren't ordered
+        // Colors that aren't also a log level, like Color::Blue, are as severe as 'Normal'
+        constexpr auto get_severity(int32_t log_level) -> int32_t
+        {
+            switch (log_level)
+            {
+            case Verbose:
+                return 0;
+            case Warning:
+                return 2;
+            case Error:
+                return 3;
+            default:
+                return 1;
+            }
+        }
+
+        // Converts the name of a log level, like "Warning", ignoring case
+        RC_DYNOUT_API auto from_string(File::StringViewType log_level_name) -> std::optional<int32_t>;
     } // namespace LogLevel
 } // namespace RC
 
@@ -49,6 +74,9 @@ namespace RC::Output
         using Formatter = File::StringType (*)(File::StringViewType);
         Formatter m_formatter{&default_format_string};
 
+        // Messages below this level aren't passed to the device
+        std::atomic<int32_t> m_minimum_log_level{LogLevel::Verbose};
+
       public:
         virtual ~OutputDevice() = default;
 
@@ -60,6 +88,9 @@ namespace RC::Output
         // The 'optional_arg' type should be cast to the proper enum by the derived class
         virtual auto receive_with_optional_arg(File::StringViewType fmt, int32_t optional_arg = 0) const -> void;
 
+        // Writes anything that the device has buffered
+        virtual auto flush() const -> void{};
+
         virtual auto lock() const -> void{};
 
         virtual auto unlock() const -> void{};
@@ -67,6 +98,26 @@ namespace RC::Output
       public:
         auto set_formatter(Formatter new_formatter) -> void;
 
+        // If this is a default device, messages that no default device wants anymore are thrown away before they're formatted
+        auto set_minimum_log_level(int32_t log_level) -> void;
+
+        [[nodiscard]] auto get_minimum_log_level() const -> int32_t
+        {
+            return m_minimum_log_level.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] auto accepts_log_level(int32_t log_level) const -> bool
+        {
+            return LogLevel::get_severity(log_level) >= LogLevel::get_severity(get_minimum_log_level());
+        }
+
+        // The time at which the message that the calling thread is passing to its devices was sent
+        // Formatters should use this instead of the current time, which is later than the time of sending for messages that went through the output thread
+        auto static get_message_time() -> std::chrono::system_clock::time_point;
+
+        // Used by the output thread, std::nullopt makes 'get_message_time' return the current time again
+        auto static set_message_time_for_current_thread(std::optional<std::chrono::system_clock::time_point> message_time) -> void;
+
       protected:
         auto static get_now_as_string() -> const File::StringType;
         auto static default_format_string(File::StringViewType) -> File::StringType;
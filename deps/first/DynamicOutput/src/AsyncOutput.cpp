@@ -0,0 +1,354 @@
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <DynamicOutput/AsyncOutput.hpp>
+#include <DynamicOutput/BinaryLogDevice.hpp>
+#include <DynamicOutput/Output.hpp>
+
+namespace RC::Output
+{
+    struct AsyncMessage
+    {
+        File::StringType content{};
+        std::chrono::system_clock::time_point time{};
+        int32_t optional_arg{};
+    };
+
+    class AsyncOutputBackend
+    {
+      private:
+        BoundedMpscQueue<AsyncMessage> m_queue;
+        AsyncOverflowPolicy m_overflow_policy;
+
+        // Held by whichever thread passes messages to the devices, which is the output thread unless another thread is flushing
+        // It also makes sure that only one thread at a time pops from the queue
+        std::timed_mutex m_devices_mutex{};
+
+        std::mutex m_wake_mutex{};
+        std::condition_variable m_wake_condition{};
+        std::atomic<bool> m_is_output_thread_sleeping{};
+        std::atomic<bool> m_is_stop_requested{};
+
+        std::atomic<uint64_t> m_num_dropped{};
+        std::atomic<uint64_t> m_num_full_waits{};
+        uint64_t m_num_dropped_reported{};
+
+        // Set by the output thread itself, so it's known before the constructor has finished storing 'm_output_thread'
+        std::atomic<std::thread::id> m_output_thread_id{};
+        std::thread m_output_thread{};
+
+      public:
+        explicit AsyncOutputBackend(const AsyncOutputOptions& options)
+            : m_queue(options.queue_capacity), m_overflow_policy(options.overflow_policy), m_output_thread(&AsyncOutputBackend::output_loop, this)
+        {
+        }
+
+        ~AsyncOutputBackend()
+        {
+            m_is_stop_requested = true;
+            wake_output_thread();
+            m_output_thread.join();
+        }
+
+        AsyncOutputBackend(const AsyncOutputBackend&) = delete;
+        auto operator=(const AsyncOutputBackend&) -> AsyncOutputBackend& = delete;
+
+      public:
+        auto push(AsyncMessage&& message) -> void
+        {
+            if (m_queue.try_push(std::move(message)))
+            {
+                wake_output_thread();
+                return;
+            }
+
+            if (m_overflow_policy == AsyncOverflowPolicy::Drop)
+            {
+                m_num_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            if (is_output_thread())
+            {
+                // A device sent output while receiving, waiting for the output thread would wait forever
+                send_message_to_devices(message);
+                return;
+            }
+
+            m_num_full_waits.fetch_add(1, std::memory_order_relaxed);
+            do
+            {
+                wake_output_thread();
+                std::this_thread::yield();
+            } while (!m_queue.try_push(std::move(message)));
+            wake_output_thread();
+        }
+
+        auto flush() -> void
+        {
+            if (is_output_thread())
+            {
+                return;
+            }
+
+            std::lock_guard<std::timed_mutex> lock{m_devices_mutex};
+            drain_to_devices();
+            flush_devices();
+        }
+
+        auto flush_on_crash(std::chrono::milliseconds timeout) -> void
+        {
+            if (is_output_thread())
+            {
+                return;
+            }
+
+            std::unique_lock<std::timed_mutex> lock{m_devices_mutex, timeout};
+            if (lock.owns_lock())
+            {
+                drain_to_devices();
+                flush_devices();
+            }
+        }
+
+        auto get_stats() const -> AsyncOutputStats
+        {
+            return AsyncOutputStats{
+                    .queue = m_queue.get_stats(),
+                    .num_dropped = m_num_dropped.load(std::memory_order_relaxed),
+                    .num_full_waits = m_num_full_waits.load(std::memory_order_relaxed),
+            };
+        }
+
+      private:
+        auto is_output_thread() const -> bool
+        {
+            return std::this_thread::get_id() == m_output_thread_id.load(std::memory_order_relaxed);
+        }
+
+        auto wake_output_thread() -> void
+        {
+            // Pairs with the fence in 'output_loop', either the output thread sees the new message or this thread sees that it's sleeping
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_is_output_thread_sleeping.load(std::memory_order_relaxed) && m_is_output_thread_sleeping.exchange(false))
+            {
+                std::lock_guard<std::mutex> lock{m_wake_mutex};
+                m_wake_condition.notify_one();
+            }
+        }
+
+        auto output_loop() -> void
+        {
+            m_output_thread_id = std::this_thread::get_id();
+
+            for (;;)
+            {
+                {
+                    std::lock_guard<std::timed_mutex> lock{m_devices_mutex};
+                    drain_to_devices();
+
+                    // Buffering devices write in large blocks while messages keep coming and catch up as soon as there's a pause
+                    flush_devices();
+                }
+
+                if (m_is_stop_requested)
+                {
+                    // Everything that was queued before the stop request has been drained above
+                    return;
+                }
+
+                m_is_output_thread_sleeping = true;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!m_queue.is_empty())
+                {
+                    // A producer may have claimed a slot without having written it yet, give it a chance to finish
+                    m_is_output_thread_sleeping = false;
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                // The timeout is only a safety net, producers wake the output thread up when they queue a message
+                std::unique_lock<std::mutex> lock{m_wake_mutex};
+                m_wake_condition.wait_for(lock, std::chrono::milliseconds{100}, [&] {
+                    return !m_is_output_thread_sleeping || m_is_stop_requested;
+                });
+                m_is_output_thread_sleeping = false;
+            }
+        }
+
+        // Must be called with 'm_devices_mutex' locked
+        auto drain_to_devices() -> void
+        {
+            m_queue.drain([&](AsyncMessage&& message) {
+                send_message_to_devices(message);
+            });
+
+            if (const uint64_t num_dropped = m_num_dropped.load(std::memory_order_relaxed); num_dropped != m_num_dropped_reported)
+            {
+                AsyncMessage message{
+                        .content = fmt::format(STR("[Output] {} messages were dropped because the output queue was full\n"), num_dropped - m_num_dropped_reported),
+                        .time = std::chrono::system_clock::now(),
+                        .optional_arg = LogLevel::Warning,
+                };
+                m_num_dropped_reported = num_dropped;
+                send_message_to_devices(message);
+            }
+        }
+
+        // Must be called with 'm_devices_mutex' locked
+        auto flush_devices() -> void
+        {
+            try
+            {
+                Internal::flush_default_devices();
+            }
+            catch (std::exception&)
+            {
+                // See 'send_message_to_devices'
+            }
+        }
+
+        auto send_message_to_devices(const AsyncMessage& message) -> void
+        {
+            OutputDevice::set_message_time_for_current_thread(message.time);
+            try
+            {
+                Internal::send_to_default_devices_now(message.content, message.optional_arg);
+            }
+            catch (std::exception&)
+            {
+                // Nobody is around to handle the error on this thread
+                // The devices set File::Internal::StaticStorage::internal_error, which 'has_internal_error' reports
+            }
+            OutputDevice::set_message_time_for_current_thread(std::nullopt);
+        }
+    };
+
+    // Serializes enabling and disabling
+    static std::mutex s_lifetime_mutex{};
+    static std::atomic<AsyncOutputBackend*> s_backend{};
+    static AsyncOutputStats s_last_stats{};
+
+    // Threads that are using 's_backend', it's only destroyed once no thread uses it anymore
+    static std::atomic<uint32_t> s_num_backend_users{};
+
+    class BackendUse
+    {
+      private:
+        AsyncOutputBackend* m_backend{};
+
+      public:
+        BackendUse()
+        {
+            s_num_backend_users.fetch_add(1);
+            m_backend = s_backend.load();
+        }
+
+        ~BackendUse()
+        {
+            s_num_backend_users.fetch_sub(1);
+        }
+
+        BackendUse(const BackendUse&) = delete;
+        auto operator=(const BackendUse&) -> BackendUse& = delete;
+
+      public:
+        auto get() const -> AsyncOutputBackend*
+        {
+            return m_backend;
+        }
+    };
+
+    auto enable_async_output(const AsyncOutputOptions& options) -> void
+    {
+        std::lock_guard<std::mutex> lock{s_lifetime_mutex};
+        if (s_backend.load())
+        {
+            return;
+        }
+
+        s_backend.store(new AsyncOutputBackend{options});
+    }
+
+    auto disable_async_output() -> void
+    {
+        std::lock_guard<std::mutex> lock{s_lifetime_mutex};
+        AsyncOutputBackend* backend = s_backend.exchange(nullptr);
+        if (!backend)
+        {
+            return;
+        }
+
+        // New messages go straight to the devices from here on, messages that are being queued right now still have to make it into the queue
+        while (s_num_backend_users.load() != 0)
+        {
+            std::this_thread::yield();
+        }
+
+        // Joins the output thread, which drains the queue before it exits
+        s_last_stats = backend->get_stats();
+        delete backend;
+    }
+
+    auto is_async_output_enabled() -> bool
+    {
+        return s_backend.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    auto flush() -> void
+    {
+        BackendUse backend{};
+        if (backend.get())
+        {
+            backend.get()->flush();
+        }
+        else
+        {
+            Internal::flush_default_devices();
+        }
+
+        flush_trace_device();
+    }
+
+    auto flush_on_crash(std::chrono::milliseconds timeout) -> void
+    {
+        BackendUse backend{};
+        if (backend.get())
+        {
+            backend.get()->flush_on_crash(timeout);
+        }
+
+        flush_trace_device(timeout);
+    }
+
+    auto get_async_output_stats() -> AsyncOutputStats
+    {
+        std::lock_guard<std::mutex> lock{s_lifetime_mutex};
+        if (auto backend = s_backend.load())
+        {
+            return backend->get_stats();
+        }
+        return s_last_stats;
+    }
+
+    namespace Internal
+    {
+        auto try_send_to_output_thread(File::StringType&& content, int32_t optional_arg) -> bool
+        {
+            BackendUse backend{};
+            if (!backend.get())
+            {
+                return false;
+            }
+
+            backend.get()->push(AsyncMessage{
+                    .content = std::move(content),
+                    .time = std::chrono::system_clock::now(),
+                    .optional_arg = optional_arg,
+            });
+            return true;
+        }
+    } // namespace Internal
+} // namespace RC::Output
@@ -0,0 +1,278 @@
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <DynamicOutput/BinaryLogDevice.hpp>
+
+namespace RC::Output
+{
+    // Format ids start at 1, 'format_id - 1' is the index into 's_formats'
+    static std::mutex s_formats_mutex{};
+    static std::vector<File::StringType> s_formats{};
+    static std::unordered_map<File::StringType, uint32_t> s_format_ids{};
+
+    // Held while a trace is passed to the device, so that the device can't be destroyed in the meantime
+    static std::timed_mutex s_trace_device_mutex{};
+    static BinaryLogDevice* s_trace_device{};
+    static std::atomic<bool> s_is_tracing_enabled{};
+
+    static std::atomic<uint32_t> s_next_thread_index{1};
+
+    static auto get_thread_index() -> uint32_t
+    {
+        thread_local const uint32_t thread_index = s_next_thread_index.fetch_add(1, std::memory_order_relaxed);
+        return thread_index;
+    }
+
+    static auto get_time_since_epoch(std::chrono::system_clock::time_point time) -> int64_t
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+
+    static auto get_trace_format(uint32_t format_id) -> File::StringType
+    {
+        std::lock_guard<std::mutex> lock{s_formats_mutex};
+        if (format_id == 0 || format_id > s_formats.size())
+        {
+            throw std::runtime_error{"[BinaryLogDevice::get_trace_format] Format id was never registered"};
+        }
+        return s_formats[format_id - 1];
+    }
+
+    // Writes the record header, 'finish_record' fills in the payload size once the payload has been appended
+    static auto begin_record(std::string& record, BinaryLog::RecordType type) -> void
+    {
+        record.clear();
+        Internal::append_trace_value(record, type);
+        Internal::append_trace_value(record, uint32_t{});
+    }
+
+    static auto finish_record(std::string& record) -> void
+    {
+        const auto payload_size = static_cast<uint32_t>(record.size() - BinaryLog::record_header_size);
+        std::memcpy(record.data() + sizeof(BinaryLog::RecordType), &payload_size, sizeof(payload_size));
+    }
+
+    BinaryLogDevice::~BinaryLogDevice()
+    {
+        {
+            std::lock_guard<std::timed_mutex> lock{s_trace_device_mutex};
+            if (s_trace_device == this)
+            {
+                s_trace_device = nullptr;
+                s_is_tracing_enabled.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        std::lock_guard<std::timed_mutex> lock{m_mutex};
+
+        // Destroying the writer flushes it
+        m_writer.reset();
+    }
+
+    auto BinaryLogDevice::has_optional_arg() const -> bool
+    {
+        return true;
+    }
+
+    auto BinaryLogDevice::receive(File::StringViewType fmt) const -> void
+    {
+        receive_with_optional_arg(fmt, LogLevel::Default);
+    }
+
+    auto BinaryLogDevice::receive_with_optional_arg(File::StringViewType fmt, int32_t optional_arg) const -> void
+    {
+        std::lock_guard<std::timed_mutex> lock{m_mutex};
+        if (!m_is_device_ready)
+        {
+            start_device();
+        }
+
+        begin_record(m_record, BinaryLog::RecordType::Text);
+        Internal::append_trace_value(m_record, get_time_since_epoch(get_message_time()));
+        Internal::append_trace_value(m_record, get_thread_index());
+        Internal::append_trace_value(m_record, optional_arg);
+        Internal::append_trace_value(m_record, static_cast<uint8_t>(sizeof(File::CharType)));
+        m_record.append(reinterpret_cast<const char*>(fmt.data()), fmt.size() * sizeof(File::CharType));
+        write_record(m_record);
+    }
+
+    auto BinaryLogDevice::flush() const -> void
+    {
+        std::lock_guard<std::timed_mutex> lock{m_mutex};
+        if (m_writer)
+        {
+            m_writer->flush();
+        }
+    }
+
+    auto BinaryLogDevice::flush_with_timeout(std::chrono::milliseconds timeout) const -> void
+    {
+        std::unique_lock<std::timed_mutex> lock{m_mutex, timeout};
+        if (lock.owns_lock() && m_writer)
+        {
+            m_writer->flush();
+        }
+    }
+
+    auto BinaryLogDevice::set_file_name_and_path(const std::filesystem::path& file_name_and_path) -> void
+    {
+        m_file_name_and_path = file_name_and_path;
+    }
+
+    auto BinaryLogDevice::set_buffer_options(const File::BufferedWriter::Options& options) -> void
+    {
+        m_writer_options = options;
+    }
+
+    auto BinaryLogDevice::write_message_record(uint32_t format_id, std::string_view record) const -> void
+    {
+        std::lock_guard<std::timed_mutex> lock{m_mutex};
+        if (!m_is_device_ready)
+        {
+            start_device();
+        }
+
+        if (format_id >= m_is_format_written.size() || !m_is_format_written[format_id])
+        {
+            write_format_record(format_id);
+        }
+
+        m_writer->write_bytes(record);
+    }
+
+    auto BinaryLogDevice::start_device() const -> void
+    {
+        if (m_file_name_and_path.has_parent_path())
+        {
+            std::filesystem::create_directories(m_file_name_and_path.parent_path());
+        }
+
+        // The BufferedWriter already writes in large blocks, a second buffer in the stream would only add a copy
+        m_file.rdbuf()->pubsetbuf(nullptr, 0);
+        m_file.open(m_file_name_and_path, std::ios::binary | std::ios::trunc);
+        if (!m_file)
+        {
+            throw std::runtime_error{"[BinaryLogDevice::start_device] Could not open the file"};
+        }
+
+        m_writer = std::make_unique<File::BufferedWriter>(
+                [this](std::string_view bytes) {
+                    m_file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+                    if (!m_file)
+                    {
+                        throw std::runtime_error{"[BinaryLogDevice] Could not write to the file"};
+                    }
+                },
+                m_writer_options);
+
+        m_record.clear();
+        m_record.append(BinaryLog::magic, sizeof(BinaryLog::magic));
+        Internal::append_trace_value(m_record, BinaryLog::version);
+        Internal::append_trace_value(m_record, get_time_since_epoch(std::chrono::system_clock::now()));
+        m_writer->write_bytes(m_record);
+
+        m_is_device_ready = true;
+    }
+
+    auto BinaryLogDevice::write_format_record(uint32_t format_id) const -> void
+    {
+        const auto format = get_trace_format(format_id);
+
+        begin_record(m_record, BinaryLog::RecordType::Format);
+        Internal::append_trace_value(m_record, format_id);
+        Internal::append_trace_value(m_record, static_cast<uint8_t>(sizeof(File::CharType)));
+        m_record.append(reinterpret_cast<const char*>(format.data()), format.size() * sizeof(File::CharType));
+        write_record(m_record);
+
+        if (format_id >= m_is_format_written.size())
+        {
+            m_is_format_written.resize(format_id + 1);
+        }
+        m_is_format_written[format_id] = true;
+    }
+
+    auto BinaryLogDevice::write_record(std::string& record) const -> void
+    {
+        finish_record(record);
+        m_writer->write_bytes(record);
+    }
+
+    auto register_trace_format(File::StringViewType format) -> uint32_t
+    {
+        std::lock_guard<std::mutex> lock{s_formats_mutex};
+        auto [it, is_new] = s_format_ids.try_emplace(File::StringType{format}, static_cast<uint32_t>(s_formats.size() + 1));
+        if (is_new)
+        {
+            s_formats.emplace_back(format);
+        }
+        return it->second;
+    }
+
+    auto set_trace_device(BinaryLogDevice* device) -> void
+    {
+        std::lock_guard<std::timed_mutex> lock{s_trace_device_mutex};
+        s_trace_device = device;
+        s_is_tracing_enabled.store(device != nullptr, std::memory_order_relaxed);
+    }
+
+    auto is_tracing_enabled() -> bool
+    {
+        return s_is_tracing_enabled.load(std::memory_order_relaxed);
+    }
+
+    auto flush_trace_device(std::chrono::milliseconds timeout) -> void
+    {
+        std::unique_lock<std::timed_mutex> lock{s_trace_device_mutex, std::defer_lock};
+        if (timeout == std::chrono::milliseconds::max())
+        {
+            lock.lock();
+        }
+        else if (!lock.try_lock_for(timeout))
+        {
+            return;
+        }
+
+        if (!s_trace_device)
+        {
+            return;
+        }
+
+        if (timeout == std::chrono::milliseconds::max())
+        {
+            s_trace_device->flush();
+        }
+        else
+        {
+            s_trace_device->flush_with_timeout(timeout);
+        }
+    }
+
+    namespace Internal
+    {
+        auto begin_trace_record(uint32_t format_id, uint8_t num_arguments) -> std::string&
+        {
+            // Reused by every trace from this thread, so tracing doesn't allocate once the buffer has grown to fit the largest record
+            thread_local std::string record{};
+
+            begin_record(record, BinaryLog::RecordType::Message);
+            append_trace_value(record, format_id);
+            append_trace_value(record, get_time_since_epoch(std::chrono::system_clock::now()));
+            append_trace_value(record, get_thread_index());
+            append_trace_value(record, num_arguments);
+            return record;
+        }
+
+        auto end_trace_record(uint32_t format_id, std::string& record) -> void
+        {
+            finish_record(record);
+
+            std::lock_guard<std::timed_mutex> lock{s_trace_device_mutex};
+            if (s_trace_device)
+            {
+                s_trace_device->write_message_record(format_id, record);
+            }
+        }
+    } // namespace Internal
+} // namespace RC::Output
@@ -1,7 +1,16 @@
+#include <algorithm>
+#include <atomic>
+
+#include <DynamicOutput/AsyncOutput.hpp>
 #include <DynamicOutput/Output.hpp>
 
 namespace RC::Output
 {
+    static std::atomic<int32_t> s_minimum_log_level{LogLevel::Verbose};
+
+    // The severity of the least severe message that at least one default device accepts
+    static std::atomic<int32_t> s_minimum_enabled_severity{LogLevel::get_severity(LogLevel::Verbose)};
+
     auto has_internal_error() -> bool
     {
         return File::Internal::StaticStorage::internal_error;
@@ -24,26 +33,110 @@ namespace RC::Output
 
     auto DefaultTargets::close_all_default_devices() -> void
     {
+        // The output thread must not be passing messages to the devices while they're destroyed
+        disable_async_output();
+
         // clear() will empty the container and will also call all the destructors
         default_devices.clear();
+        refresh_minimum_log_level();
+    }
+
+    auto DefaultTargets::set_minimum_log_level(int32_t log_level) -> void
+    {
+        s_minimum_log_level = log_level;
+        refresh_minimum_log_level();
+    }
+
+    auto DefaultTargets::get_minimum_log_level() -> int32_t
+    {
+        return s_minimum_log_level;
+    }
+
+    auto DefaultTargets::is_log_level_enabled(int32_t log_level) -> bool
+    {
+        return LogLevel::get_severity(log_level) >= s_minimum_enabled_severity.load(std::memory_order_relaxed);
+    }
+
+    auto DefaultTargets::refresh_minimum_log_level() -> void
+    {
+        // Without default devices nothing reaches a device anyway, only the global minimum is used so that messages aren't thrown away silently
+        int32_t minimum_device_severity = LogLevel::get_severity(LogLevel::Verbose);
+        if (!default_devices.empty())
+        {
+            minimum_device_severity = LogLevel::get_severity(LogLevel::Error);
+            for (const auto& device : default_devices)
+            {
+                minimum_device_severity = std::min(minimum_device_severity, LogLevel::get_severity(device->get_minimum_log_level()));
+            }
+        }
+
+        s_minimum_enabled_severity = std::max(LogLevel::get_severity(s_minimum_log_level), minimum_device_severity);
+    }
+
+    auto send_to_default_devices(File::StringViewType content, int32_t optional_arg) -> void
+    {
+        if (is_async_output_enabled() && Internal::try_send_to_output_thread(File::StringType{content}, optional_arg))
+        {
+            return;
+        }
+
+        // Without the output thread nothing would flush buffering devices later, so each message is flushed right away
+        Internal::send_to_default_devices_now(content, optional_arg);
+        Internal::flush_default_devices();
+    }
+
+    auto send_to_default_devices(File::StringType&& content, int32_t optional_arg) -> void
+    {
+        if (Internal::try_send_to_output_thread(std::move(content), optional_arg))
+        {
+            return;
+        }
+
+        Internal::send_to_default_devices_now(content, optional_arg);
+        Internal::flush_default_devices();
     }
 
     auto send(File::StringViewType content) -> void
     {
-        for (const auto& device : DefaultTargets::get_default_devices_ref())
+        if (!is_log_level_enabled(LogLevel::Default))
         {
-            ASSERT_DEFAULT_OUTPUT_DEVICE_IS_VALID(device)
+            return;
+        }
+        send_to_default_devices(content, 0);
+    }
 
-            if (device->has_optional_arg())
+    namespace Internal
+    {
+        auto send_to_default_devices_now(File::StringViewType content, int32_t optional_arg) -> void
+        {
+            // The global minimum log level was checked before the message was formatted, but each device can have its own minimum
+            for (const auto& device : DefaultTargets::get_default_devices_ref())
             {
-                device->receive_with_optional_arg(content, 0);
+                ASSERT_DEFAULT_OUTPUT_DEVICE_IS_VALID(device)
+                if (!device->accepts_log_level(optional_arg))
+                {
+                    continue;
+                }
+
+                if (device->has_optional_arg())
+                {
+                    device->receive_with_optional_arg(content, optional_arg);
+                }
+                else
+                {
+                    device->receive(content);
+                }
             }
-            else
+        }
+
+        auto flush_default_devices() -> void
+        {
+            for (const auto& device : DefaultTargets::get_default_devices_ref())
             {
-                device->receive(content);
+                device->flush();
             }
         }
-    }
+    } // namespace Internal
 
     auto close_all_default_devices() -> void
     {
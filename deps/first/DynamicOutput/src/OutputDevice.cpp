@@ -1,11 +1,50 @@
+#include <algorithm>
 #include <chrono>
+#include <cwctype>
 #include <format>
 #include <fmt/xchar.h>
 #include <fmt/chrono.h>
+#include <DynamicOutput/Output.hpp>
 #include <DynamicOutput/OutputDevice.hpp>
 
+namespace RC::LogLevel
+{
+    auto from_string(File::StringViewType log_level_name) -> std::optional<int32_t>
+    {
+        auto equals_ignoring_case = [&](File::StringViewType other) {
+            return std::ranges::equal(log_level_name, other, [](File::CharType a, File::CharType b) {
+                return std::towlower(a) == std::towlower(b);
+            });
+        };
+
+        if (equals_ignoring_case(STR("Default")))
+        {
+            return Default;
+        }
+        if (equals_ignoring_case(STR("Normal")))
+        {
+            return Normal;
+        }
+        if (equals_ignoring_case(STR("Verbose")))
+        {
+            return Verbose;
+        }
+        if (equals_ignoring_case(STR("Warning")))
+        {
+            return Warning;
+        }
+        if (equals_ignoring_case(STR("Error")))
+        {
+            return Error;
+        }
+        return std::nullopt;
+    }
+} // namespace RC::LogLevel
+
 namespace RC::Output
 {
+    static thread_local std::optional<std::chrono::system_clock::time_point> s_message_time{};
+
     auto OutputDevice::has_optional_arg() const -> bool
     {
         return false;
@@ -23,9 +62,25 @@ namespace RC::Output
         m_formatter = new_formatter;
     }
 
+    auto OutputDevice::set_minimum_log_level(int32_t log_level) -> void
+    {
+        m_minimum_log_level = log_level;
+        DefaultTargets::refresh_minimum_log_level();
+    }
+
+    auto OutputDevice::get_message_time() -> std::chrono::system_clock::time_point
+    {
+        return s_message_time ? *s_message_time : std::chrono::system_clock::now();
+    }
+
+    auto OutputDevice::set_message_time_for_current_thread(std::optional<std::chrono::system_clock::time_point> message_time) -> void
+    {
+        s_message_time = message_time;
+    }
+
     auto OutputDevice::get_now_as_string() -> const File::StringType
     {
-        auto now = std::chrono::system_clock::now();
+        auto now = get_message_time();
         const File::StringType when_as_string = fmt::format(STR("{:%Y-%m-%d %X}"), now);
         return when_as_string;
     }
@@ -11,4 +11,4 @@ target(projectName)
 
     add_files("src/**.cpp")
     
-    add_deps("File")
\ No newline at end of file
+    add_deps("File", "Constructs")
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include <File/Common.hpp>
+#include <File/Macros.hpp>
+
+namespace RC::File
+{
+    // Appends 'string' to 'out' encoded as UTF-8, 'out' is only grown and never shrunk so that its memory can be reused
+    // Strings are UTF-16 when CharType is two bytes wide and UTF-32 otherwise, unpaired surrogates and invalid code points are replaced with U+FFFD
+    RC_FILE_API auto append_as_utf8(std::string& out, StringViewType string) -> void;
+
+    // Collects UTF-8 text in memory and hands it to a sink in large blocks, so that many small writes turn into few writes to the OS
+    // Has no dependency on the OS, the sink decides where the bytes go
+    //
+    // The buffer is flushed when:
+    // - it holds at least 'flush_threshold' bytes
+    // - a write happens and the oldest unflushed byte is older than 'max_delay'
+    // - 'flush' is called or the writer is destroyed
+    //
+    // Not thread-safe, callers that write from several threads must serialize access themselves
+    class RC_FILE_API BufferedWriter
+    {
+      public:
+        using Sink = std::function<void(std::string_view utf8)>;
+        using Clock = std::chrono::steady_clock;
+
+        struct Options
+        {
+            size_t flush_threshold{64 * 1024};
+            // std::chrono::milliseconds::max() turns the time check off, which saves reading the clock on every write
+            std::chrono::milliseconds max_delay{1000};
+        };
+
+      private:
+        Sink m_sink{};
+        Options m_options{};
+        std::string m_buffer{};
+        Clock::time_point m_oldest_unflushed_write_time{};
+        uint64_t m_num_flushes{};
+        uint64_t m_num_bytes_flushed{};
+
+      public:
+        explicit BufferedWriter(Sink sink);
+        BufferedWriter(Sink sink, Options options);
+        ~BufferedWriter();
+
+        BufferedWriter(const BufferedWriter&) = delete;
+        auto operator=(const BufferedWriter&) -> BufferedWriter& = delete;
+
+      public:
+        // Converts 'string' to UTF-8 straight into the buffer
+        auto write(StringViewType string) -> void;
+
+        auto write_utf8(std::string_view utf8) -> void;
+
+        // Appends the bytes as they are, for sinks that don't expect text
+        auto write_bytes(std::string_view bytes) -> void;
+
+        // Hands everything in the buffer to the sink, does nothing if the buffer is empty
+        // If the sink throws, the buffered text is thrown away and the exception is passed on
+        auto flush() -> void;
+
+        // Flushes if the oldest unflushed byte is older than 'max_delay'
+        auto flush_if_due(Clock::time_point now = Clock::now()) -> void;
+
+        [[nodiscard]] auto get_num_pending_bytes() const -> size_t
+        {
+            return m_buffer.size();
+        }
+
+        [[nodiscard]] auto get_num_flushes() const -> uint64_t
+        {
+            return m_num_flushes;
+        }
+
+        [[nodiscard]] auto get_num_bytes_flushed() const -> uint64_t
+        {
+            return m_num_bytes_flushed;
+        }
+
+      private:
+        auto after_write(size_t num_bytes_before_write) -> void;
+    };
+} // namespace RC::File
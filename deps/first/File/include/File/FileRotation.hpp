@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+#include <File/Common.hpp>
+
+namespace RC::File
+{
+    // Segments are the older parts of a file that has been rotated, 'UE4SS.log' is always the newest part
+    // Segment 1 is 'UE4SS.1.log', segment 2 is 'UE4SS.2.log', and so on, a higher number means older text
+    //
+    // These functions only use std::filesystem and report failure instead of throwing,
+    // so that a log file that can't be rotated never takes the program down with it
+
+    [[nodiscard]] RC_FILE_API auto get_segment_path(const std::filesystem::path& file_path, uint32_t segment_index) -> std::filesystem::path;
+
+    // Returns 0 if 'path' isn't a segment of 'file_path'
+    [[nodiscard]] RC_FILE_API auto get_segment_index(const std::filesystem::path& file_path, const std::filesystem::path& path) -> uint32_t;
+
+    // Deletes every segment of 'file_path' whose index is at least 'first_segment_index', including gaps left by earlier runs
+    RC_FILE_API auto delete_segments(const std::filesystem::path& file_path, uint32_t first_segment_index = 1) -> void;
+
+    // Turns the closed file at 'file_path' into segment 1, after moving every segment up by one and deleting the ones past 'max_num_segments'
+    // With 'max_num_segments' set to 0, the file is deleted instead
+    // Returns false if the file is still at 'file_path' afterwards, for example because another program has it open without allowing deletion
+    RC_FILE_API auto rotate_segments(const std::filesystem::path& file_path, uint32_t max_num_segments) -> bool;
+} // namespace RC::File
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <span>
+#include <string_view>
 #include <type_traits>
 
 #include <File/Enums.hpp>
@@ -76,6 +77,10 @@ namespace RC::File
         // Throws std::runtime_error if an error occurred
         virtual auto write_string_to_file(StringViewType) -> void = 0;
 
+        // Write bytes that are already encoded as UTF-8 to the currently opened file, with a single write
+        // Throws std::runtime_error if an error occurred
+        virtual auto write_utf8_to_file(std::string_view) -> void = 0;
+
         // Returns whether the currently opened file is the same as another opened file
         // Throws std::runtime_error if an error occurred
         virtual auto is_same_as(InternalFileType& other_file) -> bool = 0;
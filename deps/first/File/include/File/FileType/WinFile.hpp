@@ -76,6 +76,7 @@ namespace RC::File
         RC_FILE_API auto get_serialized_item(size_t data_size, bool is_internal_item = false) -> void* override;
         RC_FILE_API auto close_current_file() -> void override;
         RC_FILE_API auto write_string_to_file(StringViewType string_to_write) -> void override;
+        RC_FILE_API auto write_utf8_to_file(std::string_view utf8_to_write) -> void override;
         RC_FILE_API auto is_same_as(WinFile& other_file) -> bool override;
         [[nodiscard]] RC_FILE_API auto read_all() const -> StringType override;
         [[nodiscard]] RC_FILE_API auto memory_map() -> std::span<uint8_t> override;
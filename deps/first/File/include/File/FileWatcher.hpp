@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <File/Common.hpp>
+
+namespace RC::File
+{
+    // Reports changes in directories as they happen, implemented once per platform
+    class FileWatcherBackend
+    {
+      public:
+        // 'directory_id' is the id that the directory was added with, 'relative_path' is relative to that directory
+        // An empty 'relative_path' means that changes were lost, for example because too many happened at once, and anything in the directory may have changed
+        // May be called from any thread
+        using ChangeCallback = std::function<void(size_t directory_id, const std::filesystem::path& relative_path)>;
+
+      public:
+        virtual ~FileWatcherBackend() = default;
+
+      public:
+        // Directories can only be added before 'start' is called
+        // A recursive watch also reports changes in subdirectories, including ones that are created later
+        virtual auto add_directory(size_t directory_id, const std::filesystem::path& directory, bool is_recursive) -> bool = 0;
+        virtual auto start(ChangeCallback callback) -> bool = 0;
+        // No changes are reported after this returns
+        virtual auto stop() -> void = 0;
+    };
+
+    // inotify on Linux, ReadDirectoryChangesW on Windows
+    RC_FILE_API auto make_platform_file_watcher_backend() -> std::unique_ptr<FileWatcherBackend>;
+
+    struct FileChange
+    {
+        // The id that 'FileWatcher::watch_directory' returned for the directory that the entry is in
+        size_t directory_id{};
+        // The name of the entry directly inside the directory, empty if changes were lost and anything in the directory may have changed
+        std::filesystem::path entry_name{};
+
+        auto operator==(const FileChange&) const -> bool = default;
+    };
+
+    // Groups the changes that a backend reports by the entry directly inside a watched directory, and reports an entry once it stopped changing
+    // Watching 'Mods', a change to 'Mods/MyMod/dlls/main.dll' is reported as a change to 'MyMod'
+    // Copying a mod writes many files over some time, waiting for the changes to settle means that the mod is reported once, after the copy
+    class RC_FILE_API FileWatcher
+    {
+      public:
+        using Clock = std::chrono::steady_clock;
+
+      private:
+        struct WatchedDirectory
+        {
+            // Empty for every entry
+            std::vector<std::filesystem::path> entry_names{};
+            // Empty for every extension
+            std::vector<std::filesystem::path> extensions{};
+        };
+
+        struct PendingChange
+        {
+            FileChange change{};
+            Clock::time_point last_change_time{};
+        };
+
+      private:
+        std::unique_ptr<FileWatcherBackend> m_backend{};
+        std::chrono::milliseconds m_settle_time{};
+        std::vector<WatchedDirectory> m_watched_directories{};
+        std::function<void()> m_change_notifier{};
+        bool m_is_started{};
+
+        // Ordered by when each entry first changed, so that entries are reported in that order
+        std::vector<PendingChange> m_pending_changes{};
+        mutable std::mutex m_pending_changes_mutex{};
+
+      public:
+        FileWatcher(std::unique_ptr<FileWatcherBackend> backend, std::chrono::milliseconds settle_time);
+        ~FileWatcher();
+        FileWatcher(const FileWatcher&) = delete;
+        auto operator=(const FileWatcher&) -> FileWatcher& = delete;
+
+      public:
+        // Watches every entry in 'directory' and everything below them, or only the files named by 'entry_names'
+        // If 'extensions' isn't empty, changes to files with any other extension are ignored, paths without an extension are usually directories and always count
+        // Returns the id that changes in 'directory' are reported with
+        // Returns an empty optional if the watcher was already started or the backend can't watch 'directory'
+        auto watch_directory(const std::filesystem::path& directory,
+                             std::vector<std::filesystem::path> entry_names = {},
+                             std::vector<std::filesystem::path> extensions = {}) -> std::optional<size_t>;
+
+        // Called from the backend's thread whenever a change is recorded, to wake up whoever calls 'take_settled_changes'
+        // Must be set before 'start' is called
+        auto set_change_notifier(std::function<void()> notifier) -> void;
+
+        auto start() -> bool;
+        auto stop() -> void;
+
+        // Records a change as if the backend reported it at 'now'
+        auto add_change(size_t directory_id, const std::filesystem::path& relative_path, Clock::time_point now) -> void;
+
+        // Removes and returns the entries that haven't changed for the settle time as of 'now', in the order that they first changed
+        auto take_settled_changes(Clock::time_point now) -> std::vector<FileChange>;
+
+        // When the next pending entry settles, an empty optional if there are no pending entries
+        [[nodiscard]] auto get_next_settle_time() const -> std::optional<Clock::time_point>;
+    };
+} // namespace RC::File
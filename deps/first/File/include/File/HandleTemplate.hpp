@@ -4,6 +4,7 @@
 #include <memory>
 #include <span>
 #include <string>
+#include <string_view>
 
 #include <File/Common.hpp>
 #include <File/Enums.hpp>
@@ -164,6 +165,11 @@ namespace RC::File
             m_internal_handle.write_string_to_file(string_to_write);
         }
 
+        auto write_utf8_to_file(std::string_view utf8_to_write) -> void
+        {
+            m_internal_handle.write_utf8_to_file(utf8_to_write);
+        }
+
         [[nodiscard]] auto read_all() const -> StringType
         {
             return m_internal_handle.read_all();
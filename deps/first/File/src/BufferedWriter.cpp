@@ -0,0 +1,178 @@
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+#include <File/BufferedWriter.hpp>
+
+namespace RC::File
+{
+    static constexpr char32_t replacement_character = 0xFFFD;
+
+    // Writes at most four bytes to 'out' and returns a pointer past the last byte that was written
+    static auto encode_code_point(char* out, char32_t code_point) -> char*
+    {
+        if (code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF))
+        {
+            code_point = replacement_character;
+        }
+
+        if (code_point < 0x80)
+        {
+            *out++ = static_cast<char>(code_point);
+        }
+        else if (code_point < 0x800)
+        {
+            *out++ = static_cast<char>(0xC0 | (code_point >> 6));
+            *out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else if (code_point < 0x10000)
+        {
+            *out++ = static_cast<char>(0xE0 | (code_point >> 12));
+            *out++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            *out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else
+        {
+            *out++ = static_cast<char>(0xF0 | (code_point >> 18));
+            *out++ = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            *out++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            *out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        return out;
+    }
+
+    auto append_as_utf8(std::string& out, StringViewType string) -> void
+    {
+        // Every UTF-16 code unit needs at most three bytes, and every UTF-32 code point at most four
+        // Growing the string once up front and shrinking it afterwards keeps the loop free of capacity checks
+        const size_t old_size = out.size();
+        out.resize(old_size + string.size() * (sizeof(CharType) == 2 ? 3 : 4));
+        char* write_position = out.data() + old_size;
+
+        for (size_t i = 0; i < string.size(); ++i)
+        {
+            const auto code_unit = static_cast<char32_t>(static_cast<std::make_unsigned_t<CharType>>(string[i]));
+
+            // Log text is mostly ASCII
+            if (code_unit < 0x80)
+            {
+                *write_position++ = static_cast<char>(code_unit);
+                continue;
+            }
+
+            if constexpr (sizeof(CharType) == 2)
+            {
+                if (code_unit >= 0xD800 && code_unit <= 0xDBFF && i + 1 < string.size())
+                {
+                    const auto next_code_unit = static_cast<char32_t>(static_cast<std::make_unsigned_t<CharType>>(string[i + 1]));
+                    if (next_code_unit >= 0xDC00 && next_code_unit <= 0xDFFF)
+                    {
+                        write_position = encode_code_point(write_position, 0x10000 + ((code_unit - 0xD800) << 10) + (next_code_unit - 0xDC00));
+                        ++i;
+                        continue;
+                    }
+                }
+            }
+
+            write_position = encode_code_point(write_position, code_unit);
+        }
+
+        out.resize(static_cast<size_t>(write_position - out.data()));
+    }
+
+    // Not a default argument because 'Options' isn't a complete type until the end of the class
+    BufferedWriter::BufferedWriter(Sink sink) : BufferedWriter(std::move(sink), Options{})
+    {
+    }
+
+    BufferedWriter::BufferedWriter(Sink sink, Options options) : m_sink(std::move(sink)), m_options(options)
+    {
+        m_buffer.reserve(m_options.flush_threshold + 1024);
+    }
+
+    BufferedWriter::~BufferedWriter()
+    {
+        try
+        {
+            flush();
+        }
+        catch (std::exception&)
+        {
+            // Destructors must not throw, the text that couldn't be written is lost
+        }
+    }
+
+    auto BufferedWriter::write(StringViewType string) -> void
+    {
+        const size_t num_bytes_before_write = m_buffer.size();
+        append_as_utf8(m_buffer, string);
+        after_write(num_bytes_before_write);
+    }
+
+    auto BufferedWriter::write_utf8(std::string_view utf8) -> void
+    {
+        write_bytes(utf8);
+    }
+
+    auto BufferedWriter::write_bytes(std::string_view bytes) -> void
+    {
+        const size_t num_bytes_before_write = m_buffer.size();
+        m_buffer.append(bytes);
+        after_write(num_bytes_before_write);
+    }
+
+    auto BufferedWriter::after_write(size_t num_bytes_before_write) -> void
+    {
+        if (m_buffer.size() >= m_options.flush_threshold)
+        {
+            flush();
+            return;
+        }
+
+        if (m_options.max_delay == std::chrono::milliseconds::max())
+        {
+            return;
+        }
+
+        if (num_bytes_before_write == 0)
+        {
+            m_oldest_unflushed_write_time = Clock::now();
+        }
+        else
+        {
+            flush_if_due();
+        }
+    }
+
+    auto BufferedWriter::flush() -> void
+    {
+        if (m_buffer.empty())
+        {
+            return;
+        }
+
+        const size_t num_bytes = m_buffer.size();
+        try
+        {
+            m_sink(std::string_view{m_buffer});
+        }
+        catch (...)
+        {
+            m_buffer.clear();
+            throw;
+        }
+
+        // clear() keeps the capacity, so the buffer is allocated only once
+        m_buffer.clear();
+        ++m_num_flushes;
+        m_num_bytes_flushed += num_bytes;
+    }
+
+    auto BufferedWriter::flush_if_due(Clock::time_point now) -> void
+    {
+        if (!m_buffer.empty() && m_options.max_delay != std::chrono::milliseconds::max() && now - m_oldest_unflushed_write_time >= m_options.max_delay)
+        {
+            flush();
+        }
+    }
+} // namespace RC::File
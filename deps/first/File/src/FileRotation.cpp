@@ -0,0 +1,89 @@
+#include <string>
+#include <system_error>
+
+#include <File/FileRotation.hpp>
+
+namespace RC::File
+{
+    auto get_segment_path(const std::filesystem::path& file_path, uint32_t segment_index) -> std::filesystem::path
+    {
+        auto segment_file_name = file_path.stem();
+        segment_file_name += "." + std::to_string(segment_index);
+        segment_file_name += file_path.extension();
+        return file_path.parent_path() / segment_file_name;
+    }
+
+    auto get_segment_index(const std::filesystem::path& file_path, const std::filesystem::path& path) -> uint32_t
+    {
+        if (path.extension() != file_path.extension())
+        {
+            return 0;
+        }
+
+        // 'UE4SS.1.log' has the stem 'UE4SS.1', which is the stem of 'UE4SS.log' followed by a dot and the index
+        // Native strings because converting a path with non-ASCII characters to std::string can throw on Windows
+        const auto file_stem = file_path.stem().native();
+        const auto stem = path.stem().native();
+        if (stem.size() < file_stem.size() + 2 || !stem.starts_with(file_stem) || stem[file_stem.size()] != '.')
+        {
+            return 0;
+        }
+
+        uint64_t segment_index{};
+        for (size_t i = file_stem.size() + 1; i < stem.size(); ++i)
+        {
+            if (stem[i] < '0' || stem[i] > '9')
+            {
+                return 0;
+            }
+
+            segment_index = segment_index * 10 + static_cast<uint64_t>(stem[i] - '0');
+            if (segment_index > UINT32_MAX)
+            {
+                return 0;
+            }
+        }
+        return segment_index;
+    }
+
+    auto delete_segments(const std::filesystem::path& file_path, uint32_t first_segment_index) -> void
+    {
+        std::error_code ec{};
+        const auto directory = file_path.has_parent_path() ? file_path.parent_path() : std::filesystem::current_path(ec);
+        for (auto it = std::filesystem::directory_iterator{directory, ec}; !ec && it != std::filesystem::directory_iterator{}; it.increment(ec))
+        {
+            const auto segment_index = get_segment_index(file_path, it->path());
+            if (segment_index != 0 && segment_index >= first_segment_index)
+            {
+                // Failing to delete a segment only means that the directory is a bit bigger than it should be
+                std::error_code remove_ec{};
+                std::filesystem::remove(it->path(), remove_ec);
+            }
+        }
+    }
+
+    auto rotate_segments(const std::filesystem::path& file_path, uint32_t max_num_segments) -> bool
+    {
+        std::error_code ec{};
+        if (max_num_segments == 0)
+        {
+            std::filesystem::remove(file_path, ec);
+            return !std::filesystem::exists(file_path, ec);
+        }
+
+        // Deleting the oldest segment first makes room for the one below it, and so on down to segment 1
+        delete_segments(file_path, max_num_segments);
+        for (uint32_t segment_index = max_num_segments - 1; segment_index >= 1; --segment_index)
+        {
+            const auto segment_path = get_segment_path(file_path, segment_index);
+            if (std::filesystem::exists(segment_path, ec))
+            {
+                std::filesystem::rename(segment_path, get_segment_path(file_path, segment_index + 1), ec);
+            }
+        }
+
+        // A rename within a directory is atomic, so every segment is complete at all times, and programs that have the file open keep reading it as segment 1
+        std::filesystem::rename(file_path, get_segment_path(file_path, 1), ec);
+        return !ec;
+    }
+} // namespace RC::File
@@ -1,5 +1,6 @@
 #include <fstream>
 
+#include <File/BufferedWriter.hpp>
 #include <File/File.hpp>
 #include <File/FileType/WinFile.hpp>
 #include <File/HandleTemplate.hpp>
@@ -383,21 +384,22 @@ namespace RC::File
 
     auto WinFile::write_string_to_file(StringViewType string_to_write) -> void
     {
-        int string_size = WideCharToMultiByte(CP_UTF8, 0, FromCharTypePtr<wchar_t>(string_to_write.data()), static_cast<int>(string_to_write.size()), NULL, 0, NULL, NULL);
-        if (string_size == 0)
-        {
-            THROW_INTERNAL_FILE_ERROR(fmt::format("[WinFile::write_string_to_file] Tried writing string to file but string_size was 0. Error: {}", GetLastError()))
-        }
+        // Reused between calls so that converting doesn't allocate once the buffer has grown to fit the longest string
+        thread_local std::string string_converted_to_utf8{};
+        string_converted_to_utf8.clear();
+        append_as_utf8(string_converted_to_utf8, string_to_write);
+
+        write_utf8_to_file(string_converted_to_utf8);
+    }
 
-        std::string string_converted_to_utf8(string_size, 0);
-        if (WideCharToMultiByte(CP_UTF8, 0, FromCharTypePtr<wchar_t>(string_to_write.data()), static_cast<int>(string_to_write.size()), &string_converted_to_utf8[0], string_size, NULL, NULL) ==
-            0)
+    auto WinFile::write_utf8_to_file(std::string_view utf8_to_write) -> void
+    {
+        if (utf8_to_write.empty())
         {
-            THROW_INTERNAL_FILE_ERROR(
-                    fmt::format("[WinFile::write_string_to_file] Tried writing string to file but could not convert to utf-8. Error: {}", GetLastError()))
+            return;
         }
 
-        write_to_file(*this, string_converted_to_utf8.c_str(), string_size);
+        write_to_file(*this, utf8_to_write.data(), static_cast<DWORD>(utf8_to_write.size()));
     }
 
     auto WinFile::is_same_as(WinFile& other_file) -> bool
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cwctype>
+
+#include <File/FileWatcher.hpp>
+
+namespace RC::File
+{
+    // File names on Windows don't depend on case, and the backend reports names as they are on disk rather than as they were watched
+    static auto is_same_file_name(const std::filesystem::path& a, const std::filesystem::path& b) -> bool
+    {
+#ifdef _WIN32
+        const auto& a_native = a.native();
+        const auto& b_native = b.native();
+        return std::equal(a_native.begin(), a_native.end(), b_native.begin(), b_native.end(), [](wchar_t a_char, wchar_t b_char) {
+            return std::towlower(a_char) == std::towlower(b_char);
+        });
+#else
+        return a == b;
+#endif
+    }
+
+    FileWatcher::FileWatcher(std::unique_ptr<FileWatcherBackend> backend, std::chrono::milliseconds settle_time)
+        : m_backend(std::move(backend)), m_settle_time(settle_time)
+    {
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        stop();
+    }
+
+    auto FileWatcher::watch_directory(const std::filesystem::path& directory,
+                                      std::vector<std::filesystem::path> entry_names,
+                                      std::vector<std::filesystem::path> extensions) -> std::optional<size_t>
+    {
+        if (m_is_started || !m_backend)
+        {
+            return std::nullopt;
+        }
+
+        const size_t directory_id = m_watched_directories.size();
+        const bool is_recursive = entry_names.empty();
+        if (!m_backend->add_directory(directory_id, directory, is_recursive))
+        {
+            return std::nullopt;
+        }
+
+        m_watched_directories.emplace_back(WatchedDirectory{std::move(entry_names), std::move(extensions)});
+        return directory_id;
+    }
+
+    auto FileWatcher::set_change_notifier(std::function<void()> notifier) -> void
+    {
+        m_change_notifier = std::move(notifier);
+    }
+
+    auto FileWatcher::start() -> bool
+    {
+        if (m_is_started || !m_backend || m_watched_directories.empty())
+        {
+            return false;
+        }
+
+        m_is_started = m_backend->start([this](size_t directory_id, const std::filesystem::path& relative_path) {
+            add_change(directory_id, relative_path, Clock::now());
+        });
+        return m_is_started;
+    }
+
+    auto FileWatcher::stop() -> void
+    {
+        if (!m_is_started)
+        {
+            return;
+        }
+
+        m_backend->stop();
+        m_is_started = false;
+    }
+
+    auto FileWatcher::add_change(size_t directory_id, const std::filesystem::path& relative_path, Clock::time_point now) -> void
+    {
+        if (directory_id >= m_watched_directories.size())
+        {
+            return;
+        }
+
+        const auto& watched_directory = m_watched_directories[directory_id];
+        FileChange change{directory_id, {}};
+        if (!relative_path.empty())
+        {
+            // Changes to the watched directory itself, like its timestamps, aren't changes to any entry
+            const auto entry_name = *relative_path.begin();
+            if (entry_name.empty() || entry_name == "." || entry_name == "..")
+            {
+                return;
+            }
+
+            if (!watched_directory.entry_names.empty() && std::none_of(watched_directory.entry_names.begin(),
+                                                                        watched_directory.entry_names.end(),
+                                                                        [&](const std::filesystem::path& name) {
+                                                                            return is_same_file_name(name, entry_name);
+                                                                        }))
+            {
+                return;
+            }
+
+            if (const auto extension = relative_path.extension(); !extension.empty() && !watched_directory.extensions.empty() &&
+                                                                  std::none_of(watched_directory.extensions.begin(),
+                                                                               watched_directory.extensions.end(),
+                                                                               [&](const std::filesystem::path& watched_extension) {
+                                                                                   return is_same_file_name(watched_extension, extension);
+                                                                               }))
+            {
+                return;
+            }
+            change.entry_name = entry_name;
+        }
+
+        {
+            std::lock_guard lock{m_pending_changes_mutex};
+            auto pending_change = std::find_if(m_pending_changes.begin(), m_pending_changes.end(), [&](const PendingChange& pending) {
+                return pending.change.directory_id == change.directory_id && is_same_file_name(pending.change.entry_name, change.entry_name);
+            });
+            if (pending_change != m_pending_changes.end())
+            {
+                pending_change->last_change_time = std::max(pending_change->last_change_time, now);
+            }
+            else
+            {
+                m_pending_changes.emplace_back(PendingChange{std::move(change), now});
+            }
+        }
+
+        // Every change is notified, the settle time starts over with each one
+        if (m_change_notifier)
+        {
+            m_change_notifier();
+        }
+    }
+
+    auto FileWatcher::take_settled_changes(Clock::time_point now) -> std::vector<FileChange>
+    {
+        std::vector<FileChange> settled_changes{};
+
+        std::lock_guard lock{m_pending_changes_mutex};
+        std::erase_if(m_pending_changes, [&](PendingChange& pending) {
+            if (now - pending.last_change_time < m_settle_time)
+            {
+                return false;
+            }
+            settled_changes.emplace_back(std::move(pending.change));
+            return true;
+        });
+        return settled_changes;
+    }
+
+    auto FileWatcher::get_next_settle_time() const -> std::optional<Clock::time_point>
+    {
+        std::optional<Clock::time_point> next_settle_time{};
+
+        std::lock_guard lock{m_pending_changes_mutex};
+        for (const auto& pending : m_pending_changes)
+        {
+            const auto settle_time = pending.last_change_time + m_settle_time;
+            next_settle_time = next_settle_time ? std::min(*next_settle_time, settle_time) : settle_time;
+        }
+        return next_settle_time;
+    }
+} // namespace RC::File
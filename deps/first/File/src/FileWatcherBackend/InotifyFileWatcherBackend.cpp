@@ -0,0 +1,242 @@
+#ifdef __linux__
+
+#include <array>
+#include <cerrno>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+
+#include <File/FileWatcher.hpp>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace RC::File
+{
+    // One inotify instance with a watch per directory, inotify doesn't watch subdirectories by itself
+    // Subdirectories that are created while watching are watched by the thread that reads the events
+    class InotifyFileWatcherBackend : public FileWatcherBackend
+    {
+      private:
+        static constexpr uint32_t watch_mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_ONLYDIR;
+
+        struct Directory
+        {
+            size_t id{};
+            std::filesystem::path path{};
+            bool is_recursive{};
+        };
+
+        struct Watch
+        {
+            size_t directory_index{};
+            // Relative to the added directory
+            std::filesystem::path relative_path{};
+        };
+
+      private:
+        std::vector<Directory> m_directories{};
+        std::unordered_map<int, Watch> m_watches{};
+        ChangeCallback m_callback{};
+        std::thread m_thread{};
+        int m_inotify_fd{-1};
+        int m_stop_fd{-1};
+
+      public:
+        ~InotifyFileWatcherBackend() override
+        {
+            stop();
+        }
+
+      public:
+        auto add_directory(size_t directory_id, const std::filesystem::path& directory, bool is_recursive) -> bool override
+        {
+            std::error_code ec{};
+            if (m_thread.joinable() || !std::filesystem::is_directory(directory, ec))
+            {
+                return false;
+            }
+
+            m_directories.emplace_back(Directory{directory_id, directory, is_recursive});
+            return true;
+        }
+
+        auto start(ChangeCallback callback) -> bool override
+        {
+            if (m_thread.joinable())
+            {
+                return false;
+            }
+
+            m_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            m_stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (m_inotify_fd < 0 || m_stop_fd < 0)
+            {
+                close_fds();
+                return false;
+            }
+
+            for (size_t i = 0; i < m_directories.size(); ++i)
+            {
+                if (!add_watches(i, {}))
+                {
+                    close_fds();
+                    return false;
+                }
+            }
+
+            m_callback = std::move(callback);
+            m_thread = std::thread{[this] {
+                run();
+            }};
+            return true;
+        }
+
+        auto stop() -> void override
+        {
+            if (!m_thread.joinable())
+            {
+                return;
+            }
+
+            const uint64_t value = 1;
+            [[maybe_unused]] const auto result = write(m_stop_fd, &value, sizeof(value));
+            m_thread.join();
+            close_fds();
+        }
+
+      private:
+        auto close_fds() -> void
+        {
+            if (m_inotify_fd >= 0)
+            {
+                close(m_inotify_fd);
+                m_inotify_fd = -1;
+            }
+            if (m_stop_fd >= 0)
+            {
+                close(m_stop_fd);
+                m_stop_fd = -1;
+            }
+            m_watches.clear();
+        }
+
+        // Watches the directory at 'relative_path' in the added directory, and every directory below it if the directory is recursive
+        auto add_watches(size_t directory_index, const std::filesystem::path& relative_path) -> bool
+        {
+            const auto& directory = m_directories[directory_index];
+            const auto path = relative_path.empty() ? directory.path : directory.path / relative_path;
+            if (!add_watch(directory_index, path, relative_path))
+            {
+                return false;
+            }
+
+            if (directory.is_recursive)
+            {
+                std::error_code ec{};
+                for (auto it = std::filesystem::recursive_directory_iterator(path, ec); !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+                {
+                    // Subdirectories that disappear before they're watched don't matter, their parent's watch reports that
+                    if (it->is_directory(ec) && !it->is_symlink(ec))
+                    {
+                        add_watch(directory_index, it->path(), it->path().lexically_relative(directory.path));
+                    }
+                }
+            }
+            return true;
+        }
+
+        auto add_watch(size_t directory_index, const std::filesystem::path& path, const std::filesystem::path& relative_path) -> bool
+        {
+            const int watch_descriptor = inotify_add_watch(m_inotify_fd, path.c_str(), watch_mask);
+            if (watch_descriptor < 0)
+            {
+                return false;
+            }
+
+            m_watches.insert_or_assign(watch_descriptor, Watch{directory_index, relative_path});
+            return true;
+        }
+
+        auto run() -> void
+        {
+            // Large enough for many events with names of the maximum length, and aligned like 'inotify_event'
+            alignas(inotify_event) std::array<char, 64 * 1024> buffer{};
+            std::array<pollfd, 2> poll_fds{pollfd{m_inotify_fd, POLLIN, 0}, pollfd{m_stop_fd, POLLIN, 0}};
+
+            for (;;)
+            {
+                if (poll(poll_fds.data(), poll_fds.size(), -1) < 0 && errno != EINTR)
+                {
+                    return;
+                }
+                if (poll_fds[1].revents & POLLIN)
+                {
+                    return;
+                }
+                if (!(poll_fds[0].revents & POLLIN))
+                {
+                    continue;
+                }
+
+                for (;;)
+                {
+                    const auto num_bytes = read(m_inotify_fd, buffer.data(), buffer.size());
+                    if (num_bytes <= 0)
+                    {
+                        break;
+                    }
+
+                    for (ssize_t offset = 0; offset < num_bytes;)
+                    {
+                        const auto& event = *reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+                        offset += static_cast<ssize_t>(sizeof(inotify_event) + event.len);
+                        handle_event(event);
+                    }
+                }
+            }
+        }
+
+        auto handle_event(const inotify_event& event) -> void
+        {
+            if (event.mask & IN_Q_OVERFLOW)
+            {
+                for (const auto& directory : m_directories)
+                {
+                    m_callback(directory.id, {});
+                }
+                return;
+            }
+
+            const auto watch = m_watches.find(event.wd);
+            if (watch == m_watches.end())
+            {
+                return;
+            }
+            if (event.mask & IN_IGNORED)
+            {
+                m_watches.erase(watch);
+                return;
+            }
+
+            // 'watch' may be invalidated by watching a new directory
+            const auto directory_index = watch->second.directory_index;
+            const auto relative_path = event.len > 0 ? watch->second.relative_path / event.name : watch->second.relative_path;
+            if ((event.mask & IN_ISDIR) && (event.mask & (IN_CREATE | IN_MOVED_TO)) && m_directories[directory_index].is_recursive)
+            {
+                add_watches(directory_index, relative_path);
+            }
+
+            m_callback(m_directories[directory_index].id, relative_path);
+        }
+    };
+
+    auto make_platform_file_watcher_backend() -> std::unique_ptr<FileWatcherBackend>
+    {
+        return std::make_unique<InotifyFileWatcherBackend>();
+    }
+} // namespace RC::File
+
+#endif
@@ -0,0 +1,217 @@
+#ifdef _WIN32
+
+#include <array>
+#include <thread>
+
+#include <File/FileWatcher.hpp>
+
+#define NOMINMAX
+#include <Windows.h>
+
+namespace RC::File
+{
+    // One overlapped ReadDirectoryChangesW per directory, all waited on by one thread
+    // ReadDirectoryChangesW watches subdirectories by itself, including ones that are created later
+    class Win32FileWatcherBackend : public FileWatcherBackend
+    {
+      private:
+        // WaitForMultipleObjects waits for at most 64 handles, and one of them is the stop event
+        static constexpr size_t max_directories = MAXIMUM_WAIT_OBJECTS - 1;
+        static constexpr DWORD notify_filter =
+                FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_CREATION;
+
+        struct Directory
+        {
+            size_t id{};
+            std::filesystem::path path{};
+            bool is_recursive{};
+            HANDLE handle{INVALID_HANDLE_VALUE};
+            OVERLAPPED overlapped{};
+            // Must be DWORD-aligned, the entries in it are
+            alignas(DWORD) std::array<std::byte, 64 * 1024> buffer{};
+        };
+
+      private:
+        std::vector<std::unique_ptr<Directory>> m_directories{};
+        ChangeCallback m_callback{};
+        std::thread m_thread{};
+        HANDLE m_stop_event{};
+
+      public:
+        ~Win32FileWatcherBackend() override
+        {
+            stop();
+        }
+
+      public:
+        auto add_directory(size_t directory_id, const std::filesystem::path& directory, bool is_recursive) -> bool override
+        {
+            std::error_code ec{};
+            if (m_thread.joinable() || m_directories.size() >= max_directories || !std::filesystem::is_directory(directory, ec))
+            {
+                return false;
+            }
+
+            auto new_directory = std::make_unique<Directory>();
+            new_directory->id = directory_id;
+            new_directory->path = directory;
+            new_directory->is_recursive = is_recursive;
+            m_directories.emplace_back(std::move(new_directory));
+            return true;
+        }
+
+        auto start(ChangeCallback callback) -> bool override
+        {
+            if (m_thread.joinable())
+            {
+                return false;
+            }
+
+            m_stop_event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            bool has_failed = !m_stop_event;
+            for (auto& directory : m_directories)
+            {
+                if (has_failed)
+                {
+                    break;
+                }
+
+                directory->handle = CreateFileW(directory->path.c_str(),
+                                                FILE_LIST_DIRECTORY,
+                                                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                                nullptr,
+                                                OPEN_EXISTING,
+                                                FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+                                                nullptr);
+                directory->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+                has_failed = directory->handle == INVALID_HANDLE_VALUE || !directory->overlapped.hEvent || !read_changes(*directory);
+            }
+
+            if (has_failed)
+            {
+                close_handles();
+                return false;
+            }
+
+            m_callback = std::move(callback);
+            m_thread = std::thread{[this] {
+                run();
+            }};
+            return true;
+        }
+
+        auto stop() -> void override
+        {
+            if (!m_thread.joinable())
+            {
+                return;
+            }
+
+            SetEvent(m_stop_event);
+            m_thread.join();
+            close_handles();
+        }
+
+      private:
+        auto read_changes(Directory& directory) -> bool
+        {
+            ResetEvent(directory.overlapped.hEvent);
+            return ReadDirectoryChangesW(directory.handle,
+                                         directory.buffer.data(),
+                                         static_cast<DWORD>(directory.buffer.size()),
+                                         directory.is_recursive,
+                                         notify_filter,
+                                         nullptr,
+                                         &directory.overlapped,
+                                         nullptr);
+        }
+
+        // Reads that are still pending must be finished or cancelled before their buffer and event go away
+        auto close_handles() -> void
+        {
+            for (auto& directory : m_directories)
+            {
+                if (directory->handle != INVALID_HANDLE_VALUE)
+                {
+                    DWORD num_bytes{};
+                    if (CancelIoEx(directory->handle, &directory->overlapped) || GetLastError() != ERROR_NOT_FOUND)
+                    {
+                        GetOverlappedResult(directory->handle, &directory->overlapped, &num_bytes, TRUE);
+                    }
+                    CloseHandle(directory->handle);
+                    directory->handle = INVALID_HANDLE_VALUE;
+                }
+                if (directory->overlapped.hEvent)
+                {
+                    CloseHandle(directory->overlapped.hEvent);
+                    directory->overlapped = {};
+                }
+            }
+            if (m_stop_event)
+            {
+                CloseHandle(m_stop_event);
+                m_stop_event = nullptr;
+            }
+        }
+
+        auto run() -> void
+        {
+            std::vector<HANDLE> events{m_stop_event};
+            for (const auto& directory : m_directories)
+            {
+                events.emplace_back(directory->overlapped.hEvent);
+            }
+
+            for (;;)
+            {
+                const auto wait_result = WaitForMultipleObjects(static_cast<DWORD>(events.size()), events.data(), FALSE, INFINITE);
+                if (wait_result <= WAIT_OBJECT_0 || wait_result >= WAIT_OBJECT_0 + events.size())
+                {
+                    return;
+                }
+
+                auto& directory = *m_directories[wait_result - WAIT_OBJECT_0 - 1];
+                DWORD num_bytes{};
+                if (!GetOverlappedResult(directory.handle, &directory.overlapped, &num_bytes, FALSE))
+                {
+                    // The directory itself was deleted or can't be read anymore, it stays quiet from now on
+                    m_callback(directory.id, {});
+                    ResetEvent(directory.overlapped.hEvent);
+                    continue;
+                }
+
+                // No bytes means that the buffer overflowed and the changes were lost
+                if (num_bytes == 0)
+                {
+                    m_callback(directory.id, {});
+                }
+                else
+                {
+                    for (size_t offset = 0;;)
+                    {
+                        const auto& info = *reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(directory.buffer.data() + offset);
+                        m_callback(directory.id, std::filesystem::path{std::wstring_view{info.FileName, info.FileNameLength / sizeof(wchar_t)}});
+                        if (info.NextEntryOffset == 0)
+                        {
+                            break;
+                        }
+                        offset += info.NextEntryOffset;
+                    }
+                }
+
+                if (!read_changes(directory))
+                {
+                    m_callback(directory.id, {});
+                    ResetEvent(directory.overlapped.hEvent);
+                }
+            }
+        }
+    };
+
+    auto make_platform_file_watcher_backend() -> std::unique_ptr<FileWatcherBackend>
+    {
+        return std::make_unique<Win32FileWatcherBackend>();
+    }
+} // namespace RC::File
+
+#endif
@@ -0,0 +1,215 @@
+// Tests for the UTF-8 conversion of the log writer, and for when the buffered text is handed to the sink
+
+#include <chrono>
+#include <cstdio>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <File/BufferedWriter.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+using namespace std::chrono_literals;
+
+// Builds a string from code units, so that surrogates and code points that aren't valid can be put in it
+static auto make_string(std::initializer_list<uint32_t> code_units) -> File::StringType
+{
+    File::StringType string{};
+    for (const auto code_unit : code_units)
+    {
+        string += static_cast<File::CharType>(code_unit);
+    }
+    return string;
+}
+
+static auto to_utf8(const File::StringType& string) -> std::string
+{
+    std::string out{};
+    File::append_as_utf8(out, string);
+    return out;
+}
+
+static auto test_append_as_utf8() -> void
+{
+    // One to three bytes
+    CHECK(to_utf8(make_string({'L', 'o', 'g'})) == "Log");
+    CHECK(to_utf8(make_string({0x7F})) == "\x7F");
+    CHECK(to_utf8(make_string({0x80})) == "\xC2\x80");
+    CHECK(to_utf8(make_string({0xE9})) == "\xC3\xA9");
+    CHECK(to_utf8(make_string({0x7FF})) == "\xDF\xBF");
+    CHECK(to_utf8(make_string({0x800})) == "\xE0\xA0\x80");
+    CHECK(to_utf8(make_string({0x20AC})) == "\xE2\x82\xAC");
+    CHECK(to_utf8(make_string({0xFFFF})) == "\xEF\xBF\xBF");
+
+    // Four bytes, from a surrogate pair where strings are UTF-16 and from a single code point where they're UTF-32
+    const auto emoji = sizeof(File::CharType) == 2 ? make_string({0xD83D, 0xDE00}) : make_string({0x1F600});
+    CHECK(to_utf8(emoji) == "\xF0\x9F\x98\x80");
+    const auto highest = sizeof(File::CharType) == 2 ? make_string({0xDBFF, 0xDFFF}) : make_string({0x10FFFF});
+    CHECK(to_utf8(highest) == "\xF4\x8F\xBF\xBF");
+
+    // Unpaired surrogates become U+FFFD, and the character after a lone high surrogate is kept
+    CHECK(to_utf8(make_string({0xD800})) == "\xEF\xBF\xBD");
+    CHECK(to_utf8(make_string({0xDC00})) == "\xEF\xBF\xBD");
+    CHECK(to_utf8(make_string({'a', 0xD83D, 'b'})) == "a\xEF\xBF\xBD" "b");
+    CHECK(to_utf8(make_string({0xDE00, 0xD83D})) == "\xEF\xBF\xBD\xEF\xBF\xBD");
+    if constexpr (sizeof(File::CharType) == 4)
+    {
+        CHECK(to_utf8(make_string({0x110000})) == "\xEF\xBF\xBD");
+    }
+
+    // The text is appended, and the string shrinks back from the worst case size it was grown to
+    std::string out = "Existing ";
+    File::append_as_utf8(out, make_string({'x', 0xE9}));
+    CHECK(out == "Existing x\xC3\xA9");
+    File::append_as_utf8(out, {});
+    CHECK(out == "Existing x\xC3\xA9");
+}
+
+// Collects what the writer hands over, one element per flush
+struct RecordingSink
+{
+    std::vector<std::string> flushes{};
+
+    auto make_sink() -> File::BufferedWriter::Sink
+    {
+        return [this](std::string_view utf8) {
+            flushes.emplace_back(utf8);
+        };
+    }
+};
+
+static auto test_threshold() -> void
+{
+    RecordingSink sink{};
+    File::BufferedWriter writer{sink.make_sink(), {.flush_threshold = 16, .max_delay = std::chrono::milliseconds::max()}};
+
+    writer.write(STR("0123456789"));
+    CHECK(sink.flushes.empty());
+    CHECK(writer.get_num_pending_bytes() == 10);
+
+    // The write that reaches the threshold is flushed together with everything before it
+    writer.write_utf8("abcdef");
+    CHECK((sink.flushes == std::vector<std::string>{"0123456789abcdef"}));
+    CHECK(writer.get_num_pending_bytes() == 0);
+    CHECK(writer.get_num_flushes() == 1);
+    CHECK(writer.get_num_bytes_flushed() == 16);
+
+    // A single write that's larger than the threshold isn't split
+    writer.write_bytes(std::string(40, 'x'));
+    CHECK(sink.flushes.size() == 2 && sink.flushes[1].size() == 40);
+
+    // The threshold counts bytes, not characters
+    writer.write(make_string({0x20AC, 0x20AC, 0x20AC, 0x20AC, 0x20AC}));
+    CHECK(writer.get_num_pending_bytes() == 15);
+    writer.write(make_string({0xE9}));
+    CHECK(sink.flushes.size() == 3 && sink.flushes[2].size() == 17);
+
+    // Flushing an empty buffer doesn't call the sink
+    writer.flush();
+    CHECK(sink.flushes.size() == 3);
+    CHECK(writer.get_num_flushes() == 3);
+    CHECK(writer.get_num_bytes_flushed() == 73);
+}
+
+static auto test_max_delay() -> void
+{
+    RecordingSink sink{};
+    File::BufferedWriter writer{sink.make_sink(), {.flush_threshold = 1024, .max_delay = 50ms}};
+
+    // The delay is counted from the oldest byte that wasn't flushed, not from the latest write
+    const auto first_write_time = File::BufferedWriter::Clock::now();
+    writer.write(STR("first "));
+    writer.write(STR("second "));
+    CHECK(sink.flushes.empty());
+    writer.flush_if_due(first_write_time + 10ms);
+    CHECK(sink.flushes.empty());
+    writer.flush_if_due(File::BufferedWriter::Clock::now() + 50ms);
+    CHECK((sink.flushes == std::vector<std::string>{"first second "}));
+
+    // A write that comes after the delay has passed flushes itself along with the text before it
+    writer.write(STR("third "));
+    std::this_thread::sleep_for(60ms);
+    writer.write(STR("fourth"));
+    CHECK(sink.flushes.size() == 2 && sink.flushes[1] == "third fourth");
+
+    // Nothing is due while nothing is buffered
+    writer.flush_if_due(File::BufferedWriter::Clock::now() + 1h);
+    CHECK(sink.flushes.size() == 2);
+}
+
+static auto test_no_max_delay() -> void
+{
+    // Without a delay the writer only flushes at the threshold, however old the text is
+    RecordingSink sink{};
+    {
+        File::BufferedWriter writer{sink.make_sink(), {.flush_threshold = 1024, .max_delay = std::chrono::milliseconds::max()}};
+        writer.write(STR("old text"));
+        writer.flush_if_due(File::BufferedWriter::Clock::time_point::max());
+        std::this_thread::sleep_for(5ms);
+        writer.write(STR(", more"));
+        CHECK(sink.flushes.empty());
+    }
+
+    // The rest is flushed when the writer is destroyed
+    CHECK((sink.flushes == std::vector<std::string>{"old text, more"}));
+}
+
+static auto test_throwing_sink() -> void
+{
+    int num_calls{};
+    bool should_throw{true};
+    std::vector<std::string> flushes{};
+    {
+        File::BufferedWriter writer{[&](std::string_view utf8) {
+                                        ++num_calls;
+                                        if (should_throw)
+                                        {
+                                            throw std::runtime_error{"disk full"};
+                                        }
+                                        flushes.emplace_back(utf8);
+                                    },
+                                    {.flush_threshold = 8, .max_delay = std::chrono::milliseconds::max()}};
+
+        // The exception reaches the writer's caller, and the text that couldn't be written is dropped instead of being retried forever
+        bool has_thrown{};
+        try
+        {
+            writer.write(STR("lost text"));
+        }
+        catch (std::runtime_error&)
+        {
+            has_thrown = true;
+        }
+        CHECK(has_thrown);
+        CHECK(num_calls == 1);
+        CHECK(writer.get_num_pending_bytes() == 0);
+        CHECK(writer.get_num_flushes() == 0);
+        CHECK(writer.get_num_bytes_flushed() == 0);
+
+        // The writer keeps working once the sink does
+        should_throw = false;
+        writer.write(STR("kept text"));
+        CHECK((flushes == std::vector<std::string>{"kept text"}));
+        CHECK(writer.get_num_flushes() == 1);
+
+        // Destroying the writer with a sink that throws doesn't throw
+        writer.write(STR("end"));
+        should_throw = true;
+    }
+    CHECK(num_calls == 3);
+    CHECK(flushes.size() == 1);
+}
+
+auto main() -> int
+{
+    test_append_as_utf8();
+    test_threshold();
+    test_max_delay();
+    test_no_max_delay();
+    test_throwing_sink();
+
+    return Test::report_results();
+}
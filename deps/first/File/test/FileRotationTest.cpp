@@ -0,0 +1,133 @@
+// Tests for rotating a log file into numbered segments and deleting old segments, in a temporary directory
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <File/FileRotation.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+
+static auto write_file(const std::filesystem::path& path, const std::string& contents) -> void
+{
+    std::ofstream file{path, std::ios::trunc};
+    file << contents;
+}
+
+static auto read_file(const std::filesystem::path& path) -> std::string
+{
+    std::ifstream file{path};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+static auto count_files(const std::filesystem::path& directory) -> size_t
+{
+    return static_cast<size_t>(std::distance(std::filesystem::directory_iterator{directory}, std::filesystem::directory_iterator{}));
+}
+
+static auto test_segment_names() -> void
+{
+    const std::filesystem::path log_file = "dir/UE4SS.log";
+    CHECK(File::get_segment_path(log_file, 1) == std::filesystem::path{"dir/UE4SS.1.log"});
+    CHECK(File::get_segment_path(log_file, 12) == std::filesystem::path{"dir/UE4SS.12.log"});
+
+    CHECK(File::get_segment_index(log_file, "dir/UE4SS.1.log") == 1);
+    CHECK(File::get_segment_index(log_file, "dir/UE4SS.12.log") == 12);
+    CHECK(File::get_segment_index(log_file, "UE4SS.4294967295.log") == 4294967295);
+
+    // Only the stem of the file followed by a dot and a number is a segment
+    CHECK(File::get_segment_index(log_file, "dir/UE4SS.log") == 0);
+    CHECK(File::get_segment_index(log_file, "dir/UE4SS..log") == 0);
+    CHECK(File::get_segment_index(log_file, "dir/UE4SS.1.txt") == 0);
+    CHECK(File::get_segment_index(log_file, "dir/UE4SS.1a.log") == 0);
+    CHECK(File::get_segment_index(log_file, "dir/UE4SS-1.log") == 0);
+    CHECK(File::get_segment_index(log_file, "dir/Other.1.log") == 0);
+    CHECK(File::get_segment_index(log_file, "dir/UE4SS.4294967296.log") == 0);
+}
+
+static auto test_rotate(const std::filesystem::path& directory) -> void
+{
+    std::filesystem::create_directories(directory);
+    const auto log_file = directory / "UE4SS.log";
+
+    // Every rotation moves the file to segment 1 and the older segments up by one, only the newest three are kept
+    for (int run = 1; run <= 5; ++run)
+    {
+        write_file(log_file, "run " + std::to_string(run));
+        CHECK(File::rotate_segments(log_file, 3));
+        CHECK(!std::filesystem::exists(log_file));
+    }
+    CHECK(read_file(File::get_segment_path(log_file, 1)) == "run 5");
+    CHECK(read_file(File::get_segment_path(log_file, 2)) == "run 4");
+    CHECK(read_file(File::get_segment_path(log_file, 3)) == "run 3");
+    CHECK(!std::filesystem::exists(File::get_segment_path(log_file, 4)));
+    CHECK(count_files(directory) == 3);
+
+    // Lowering the limit drops the segments past it on the next rotation
+    write_file(log_file, "run 6");
+    CHECK(File::rotate_segments(log_file, 2));
+    CHECK(read_file(File::get_segment_path(log_file, 1)) == "run 6");
+    CHECK(read_file(File::get_segment_path(log_file, 2)) == "run 5");
+    CHECK(count_files(directory) == 2);
+
+    // Without segments the file is deleted
+    write_file(log_file, "run 7");
+    CHECK(File::rotate_segments(log_file, 0));
+    CHECK(!std::filesystem::exists(log_file));
+    CHECK(read_file(File::get_segment_path(log_file, 1)) == "run 6");
+
+    // Rotating a file that doesn't exist fails but still moves the segments
+    CHECK(!File::rotate_segments(log_file, 3));
+    CHECK(!std::filesystem::exists(File::get_segment_path(log_file, 1)));
+    CHECK(read_file(File::get_segment_path(log_file, 2)) == "run 6");
+}
+
+static auto test_delete(const std::filesystem::path& directory) -> void
+{
+    std::filesystem::create_directories(directory);
+    const auto log_file = directory / "UE4SS.log";
+
+    // Gaps left by earlier runs with a higher limit are deleted too, other files are left alone
+    for (const uint32_t segment_index : {1, 2, 5, 40})
+    {
+        write_file(File::get_segment_path(log_file, segment_index), "segment");
+    }
+    write_file(log_file, "current");
+    write_file(directory / "UE4SS.1.txt", "other");
+    write_file(directory / "Other.1.log", "other");
+
+    File::delete_segments(log_file, 3);
+    CHECK(std::filesystem::exists(File::get_segment_path(log_file, 1)));
+    CHECK(std::filesystem::exists(File::get_segment_path(log_file, 2)));
+    CHECK(!std::filesystem::exists(File::get_segment_path(log_file, 5)));
+    CHECK(!std::filesystem::exists(File::get_segment_path(log_file, 40)));
+
+    File::delete_segments(log_file);
+    CHECK(!std::filesystem::exists(File::get_segment_path(log_file, 1)));
+    CHECK(!std::filesystem::exists(File::get_segment_path(log_file, 2)));
+    CHECK(read_file(log_file) == "current");
+    CHECK(std::filesystem::exists(directory / "UE4SS.1.txt"));
+    CHECK(std::filesystem::exists(directory / "Other.1.log"));
+
+    // A directory that doesn't exist is ignored
+    File::delete_segments(directory / "missing" / "UE4SS.log");
+}
+
+auto main() -> int
+{
+    const auto directory =
+            std::filesystem::temp_directory_path() / ("FileRotationTest-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+
+    test_segment_names();
+    test_rotate(directory / "rotate");
+    test_delete(directory / "delete");
+
+    std::error_code ec{};
+    std::filesystem::remove_all(directory, ec);
+
+    return Test::report_results();
+}
@@ -0,0 +1,242 @@
+// Tests for how the file watcher maps changed paths to the entries of a watched directory and waits for an entry to settle
+// The last test runs the watcher with the platform backend on a real directory
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <File/FileWatcher.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+using namespace std::chrono_literals;
+
+using Clock = File::FileWatcher::Clock;
+using Changes = std::vector<File::FileChange>;
+
+// Accepts every directory and reports nothing by itself, the tests add the changes
+class NullFileWatcherBackend : public File::FileWatcherBackend
+{
+  public:
+    auto add_directory(size_t, const std::filesystem::path&, bool) -> bool override
+    {
+        return true;
+    }
+
+    auto start(ChangeCallback) -> bool override
+    {
+        return true;
+    }
+
+    auto stop() -> void override
+    {
+    }
+};
+
+static constexpr auto s_settle_time = 500ms;
+
+static auto test_settle() -> void
+{
+    File::FileWatcher watcher{std::make_unique<NullFileWatcherBackend>(), s_settle_time};
+    const auto mods = watcher.watch_directory("Mods");
+    CHECK(mods == 0);
+    int num_notifications{};
+    watcher.set_change_notifier([&] {
+        ++num_notifications;
+    });
+
+    const auto start = Clock::now();
+    CHECK(!watcher.get_next_settle_time());
+    CHECK(watcher.take_settled_changes(start + 1h).empty());
+
+    // A mod that's being copied keeps changing, it settles once it stopped changing for the settle time
+    watcher.add_change(*mods, "ModA/dlls/main.dll", start);
+    watcher.add_change(*mods, "ModB/dlls/main.dll", start + 100ms);
+    watcher.add_change(*mods, "ModA/dlls/helper.dll", start + 300ms);
+    CHECK(num_notifications == 3);
+    CHECK(watcher.get_next_settle_time() == start + 100ms + s_settle_time);
+
+    CHECK(watcher.take_settled_changes(start + 100ms + s_settle_time - 1ms).empty());
+    CHECK((watcher.take_settled_changes(start + 100ms + s_settle_time) == Changes{{*mods, "ModB"}}));
+    CHECK(watcher.get_next_settle_time() == start + 300ms + s_settle_time);
+
+    // A change with an older time than the last one doesn't move the settle time back
+    watcher.add_change(*mods, "ModA/dlls/main.dll", start + 200ms);
+    CHECK(watcher.get_next_settle_time() == start + 300ms + s_settle_time);
+    CHECK((watcher.take_settled_changes(start + 300ms + s_settle_time) == Changes{{*mods, "ModA"}}));
+    CHECK(!watcher.get_next_settle_time());
+
+    // Entries that settle at the same time are reported in the order that they first changed, not in the order that they last changed
+    watcher.add_change(*mods, "ModC/dlls/main.dll", start + 1s);
+    watcher.add_change(*mods, "ModA/dlls/main.dll", start + 1s + 10ms);
+    watcher.add_change(*mods, "ModC/dlls/main.dll", start + 1s + 20ms);
+    CHECK((watcher.take_settled_changes(start + 1h) == Changes{{*mods, "ModC"}, {*mods, "ModA"}}));
+}
+
+static auto test_entry_mapping() -> void
+{
+    File::FileWatcher watcher{std::make_unique<NullFileWatcherBackend>(), s_settle_time};
+    const auto mods = watcher.watch_directory("Mods", {}, {".dll", ".js"});
+    const auto working_directory = watcher.watch_directory("ue4ss", {"UE4SSL.JavaScript.dll"});
+    CHECK(mods == 0);
+    CHECK(working_directory == 1);
+    int num_notifications{};
+    watcher.set_change_notifier([&] {
+        ++num_notifications;
+    });
+
+    const auto now = Clock::now();
+    // Every path inside an entry counts as a change to the entry, a mod folder is one entry no matter how deep the change is
+    watcher.add_change(*mods, "CppMod/dlls/main.dll", now);
+    watcher.add_change(*mods, "CppMod/dlls/deeper/helper.dll", now);
+    watcher.add_change(*mods, "JsMod/js/main.js", now);
+    // Paths without an extension are usually directories, renaming or removing one moves the files inside it
+    watcher.add_change(*mods, "RenamedMod", now);
+    watcher.add_change(*mods, "MovedMod/dlls", now);
+
+    // Mods write their logs and configs while they run, those writes aren't changes to the mod
+    watcher.add_change(*mods, "CppMod/UE4SS.log", now);
+    watcher.add_change(*mods, "LoggingMod/logs/run.txt", now);
+    watcher.add_change(*mods, "ConfigMod/config.json", now);
+    watcher.add_change(*mods, "mods.txt", now);
+
+    // Changes to the watched directory itself aren't changes to any entry
+    watcher.add_change(*mods, ".", now);
+
+    // Only the named files count in a directory that's watched for some files
+    watcher.add_change(*working_directory, "UE4SS.log", now);
+    watcher.add_change(*working_directory, "UE4SSL.JavaScript.dll", now);
+
+    // Unknown directories are ignored
+    watcher.add_change(7, "CppMod/dlls/main.dll", now);
+
+    CHECK(num_notifications == 6);
+    CHECK((watcher.take_settled_changes(now + s_settle_time) == Changes{{*mods, "CppMod"},
+                                                                        {*mods, "JsMod"},
+                                                                        {*mods, "RenamedMod"},
+                                                                        {*mods, "MovedMod"},
+                                                                        {*working_directory, "UE4SSL.JavaScript.dll"}}));
+
+    // Lost changes can't be mapped to an entry, they're reported with an empty entry name once per directory
+    watcher.add_change(*mods, {}, now);
+    watcher.add_change(*mods, {}, now + 10ms);
+    watcher.add_change(*working_directory, {}, now);
+    CHECK((watcher.take_settled_changes(now + 1h) == Changes{{*mods, {}}, {*working_directory, {}}}));
+}
+
+static auto test_start_and_stop() -> void
+{
+    // Directories can't be added once the backend was started
+    File::FileWatcher watcher{std::make_unique<NullFileWatcherBackend>(), s_settle_time};
+    CHECK(!watcher.start());
+    CHECK(watcher.watch_directory("Mods").has_value());
+    CHECK(watcher.start());
+    CHECK(!watcher.start());
+    CHECK(!watcher.watch_directory("Other").has_value());
+    watcher.stop();
+
+    File::FileWatcher without_backend{nullptr, s_settle_time};
+    CHECK(!without_backend.watch_directory("Mods").has_value());
+    CHECK(!without_backend.start());
+}
+
+static auto write_file(const std::filesystem::path& path, const char* contents) -> void
+{
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream file{path, std::ios::trunc};
+    file << contents;
+}
+
+static auto test_platform_backend(const std::filesystem::path& directory) -> void
+{
+    static constexpr auto settle_time = 100ms;
+    // Generous, the machines that run this are often busy
+    static constexpr auto timeout = 10s;
+
+    std::filesystem::create_directories(directory / "Mods" / "ExistingMod" / "dlls");
+    File::FileWatcher watcher{File::make_platform_file_watcher_backend(), settle_time};
+    const auto mods = watcher.watch_directory(directory / "Mods", {}, {".dll", ".js"});
+    CHECK(mods.has_value());
+    if (!mods)
+    {
+        return;
+    }
+
+    std::mutex mutex{};
+    std::condition_variable condition{};
+    bool has_changes{};
+    watcher.set_change_notifier([&] {
+        std::lock_guard lock{mutex};
+        has_changes = true;
+        condition.notify_all();
+    });
+    CHECK(watcher.start());
+
+    // Waits until every pending entry settled and returns them
+    auto wait_for_settled_changes = [&]() -> Changes {
+        Changes changes{};
+        const auto deadline = Clock::now() + timeout;
+        while (Clock::now() < deadline)
+        {
+            {
+                std::unique_lock lock{mutex};
+                condition.wait_for(lock, settle_time, [&] {
+                    return has_changes;
+                });
+                has_changes = false;
+            }
+            const auto next_settle_time = watcher.get_next_settle_time();
+            if (!next_settle_time && !changes.empty())
+            {
+                break;
+            }
+            if (next_settle_time)
+            {
+                std::this_thread::sleep_until(*next_settle_time);
+            }
+            auto settled_changes = watcher.take_settled_changes(Clock::now());
+            changes.insert(changes.end(), settled_changes.begin(), settled_changes.end());
+        }
+        return changes;
+    };
+
+    // A mod's own log doesn't make it reload, its DLL does
+    write_file(directory / "Mods" / "ExistingMod" / "UE4SS.log", "log");
+    std::this_thread::sleep_for(settle_time * 3);
+    CHECK(!watcher.get_next_settle_time());
+    CHECK(watcher.take_settled_changes(Clock::time_point::max()).empty());
+
+    write_file(directory / "Mods" / "ExistingMod" / "dlls" / "main.dll", "dll");
+    CHECK((wait_for_settled_changes() == Changes{{*mods, "ExistingMod"}}));
+
+    // Directories created after the watcher started are watched too
+    write_file(directory / "Mods" / "NewMod" / "js" / "main.js", "script");
+    write_file(directory / "Mods" / "NewMod" / "js" / "main.js", "edited script");
+    CHECK((wait_for_settled_changes() == Changes{{*mods, "NewMod"}}));
+
+    std::filesystem::remove_all(directory / "Mods" / "NewMod");
+    CHECK((wait_for_settled_changes() == Changes{{*mods, "NewMod"}}));
+
+    watcher.stop();
+}
+
+auto main() -> int
+{
+    const auto directory =
+            std::filesystem::temp_directory_path() / ("FileWatcherTest-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+
+    test_settle();
+    test_entry_mapping();
+    test_start_and_stop();
+    test_platform_backend(directory);
+
+    std::error_code ec{};
+    std::filesystem::remove_all(directory, ec);
+
+    return Test::report_results();
+}
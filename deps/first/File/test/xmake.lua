@@ -0,0 +1,51 @@
+-- Standalone tests for the file watcher, the buffered log writer and log rotation
+-- They aren't part of the UE4SS build, which only targets Windows, and can be built and run on Linux with:
+--   cd deps/first/File/test && xmake && xmake test
+set_xmakever("2.9.3")
+set_project("FileTest")
+
+add_rules("mode.debug", "mode.release")
+set_defaultmode("debug")
+
+target("FileWatcherTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_FILE_BUILD_STATIC")
+    add_includedirs("../include", "../../String/include", "../../../../tools/test/include")
+
+    add_files("FileWatcherTest.cpp")
+    add_files("../src/FileWatcher.cpp", "../src/FileWatcherBackend/*.cpp")
+
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
+    add_tests("default")
+
+target("BufferedWriterTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_FILE_BUILD_STATIC")
+    add_includedirs("../include", "../../String/include", "../../../../tools/test/include")
+
+    add_files("BufferedWriterTest.cpp")
+    add_files("../src/BufferedWriter.cpp")
+
+    add_tests("default")
+
+target("FileRotationTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_FILE_BUILD_STATIC")
+    add_includedirs("../include", "../../../../tools/test/include")
+
+    add_files("FileRotationTest.cpp")
+    add_files("../src/FileRotation.cpp")
+
+    add_tests("default")
@@ -0,0 +1,123 @@
+// Measures how fast a large generated file that looks like a dump of object metadata is parsed
+// into a JSONDocument, and how fast it's read with 'parse_json' when nothing is kept
+// Usage: JSONBench [input size in MB]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <IniParser/JSONDocument.hpp>
+
+using namespace RC;
+
+// Counts the values, which is about the least work that a handler can do
+class CountingHandler : public Parser::JSONHandler
+{
+  public:
+    size_t m_num_values{};
+
+  public:
+    auto on_object_start() -> bool override
+    {
+        ++m_num_values;
+        return true;
+    }
+    auto on_array_start() -> bool override
+    {
+        ++m_num_values;
+        return true;
+    }
+    auto on_string(File::StringViewType) -> bool override
+    {
+        ++m_num_values;
+        return true;
+    }
+    auto on_number(double, File::StringViewType) -> bool override
+    {
+        ++m_num_values;
+        return true;
+    }
+    auto on_bool(bool) -> bool override
+    {
+        ++m_num_values;
+        return true;
+    }
+    auto on_null() -> bool override
+    {
+        ++m_num_values;
+        return true;
+    }
+};
+
+static auto generate_input(size_t num_bytes) -> File::StringType
+{
+    File::StringType input;
+    input.reserve(num_bytes + 1024);
+    input.append(STR("{\r\n  \"objects\": [\r\n"));
+
+    size_t object_index{};
+    while (input.size() * sizeof(File::CharType) < num_bytes)
+    {
+        const auto index = File::StringType(1, static_cast<File::CharType>(STR('A') + object_index % 26));
+        input.append(object_index == 0 ? STR("") : STR(",\r\n"));
+        input.append(STR("    {\r\n      \"name\": \"/Script/Engine.BenchClass"));
+        input.append(index);
+        input.append(STR("\",\r\n      \"flags\": 1342177280,\r\n      \"enabled\": true,\r\n      \"outer\": null,\r\n"));
+        input.append(STR("      \"description\": \"Escaped \\\"text\\\" with a \\u00e9 and a\\nnew line\",\r\n"));
+        input.append(STR("      \"members\": [\r\n"));
+        for (size_t member_index = 0; member_index < 8; ++member_index)
+        {
+            input.append(member_index == 0 ? STR("") : STR(",\r\n"));
+            input.append(STR("        {\"name\": \"MemberVariable"));
+            input.append(index);
+            input.append(STR("\", \"offset\": 168, \"size\": 8, \"scale\": -1.25e-3}"));
+        }
+        input.append(STR("\r\n      ]\r\n    }"));
+        ++object_index;
+    }
+
+    input.append(STR("\r\n  ]\r\n}\r\n"));
+    return input;
+}
+
+template <typename Callable>
+static auto best_of(int num_runs, Callable&& callable) -> double
+{
+    double best_seconds{1e30};
+    for (int run = 0; run < num_runs; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        callable();
+        const auto end = std::chrono::steady_clock::now();
+        best_seconds = std::min(best_seconds, std::chrono::duration<double>(end - start).count());
+    }
+    return best_seconds;
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    const size_t input_size_in_mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16;
+    const auto input = generate_input(input_size_in_mb * 1024 * 1024);
+    const double input_mb = static_cast<double>(input.size() * sizeof(File::CharType)) / (1024.0 * 1024.0);
+
+    size_t num_objects{};
+    const auto document_seconds = best_of(3, [&] {
+        Parser::JSONDocument document;
+        document.parse(input);
+        num_objects = document.get_root().find(STR("objects"))->get_items().size();
+    });
+
+    size_t num_values{};
+    const auto handler_seconds = best_of(3, [&] {
+        CountingHandler handler;
+        Parser::parse_json(input, handler);
+        num_values = handler.m_num_values;
+    });
+
+    std::printf("input: %.1f MB, %zu objects, %zu values\n", input_mb, num_objects, num_values);
+    std::printf("JSONDocument: %8.1f ms  %8.1f MB/s\n", document_seconds * 1000.0, input_mb / document_seconds);
+    std::printf("parse_json:   %8.1f ms  %8.1f MB/s\n", handler_seconds * 1000.0, input_mb / handler_seconds);
+    return 0;
+}
@@ -0,0 +1,23 @@
+-- Standalone benchmark for the JSON parser
+-- It isn't part of the UE4SS build, which only targets Windows, and can be built on Linux with:
+--   cd deps/first/IniParser/bench && xmake && xmake run JSONBench [input size in MB]
+set_xmakever("2.9.3")
+set_project("IniParserBench")
+
+add_rules("mode.release", "mode.debug")
+set_defaultmode("release")
+
+add_requires("fmt")
+
+target("JSONBench")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_INI_PARSER_BUILD_STATIC", "RC_FILE_BUILD_STATIC")
+    add_includedirs("../include", "../../File/include", "../../String/include")
+
+    add_files("JSONBench.cpp")
+    add_files("../src/JSONDocument.cpp")
+
+    add_packages("fmt")
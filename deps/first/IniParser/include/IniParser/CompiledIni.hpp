@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <File/Macros.hpp>
+#include <IniParser/Common.hpp>
+
+namespace RC::Ini
+{
+    struct Section;
+
+    // Binary form of the integer values and ordered lists of a parsed INI file, meant to be stored in a cache directory
+    // Loading it skips tokenizing and parsing, and its strings are used where they are, so a memory mapped file can be loaded without copying
+    //
+    // The file starts with a header that contains the hash of the INI source that it was compiled from, a file compiled from a different
+    // source, by a different file version, or with a different character size fails to load, and so does a file that fails its checksum
+    // Integers are little-endian regardless of the host, strings are stored in the native character type of the build
+    class CompiledIni
+    {
+      public:
+        static constexpr uint32_t file_version = 1;
+
+      private:
+        struct CompiledSection
+        {
+            std::unordered_map<File::StringViewType, int64_t> int64_values{};
+            std::vector<File::StringViewType> ordered_list{};
+        };
+
+      private:
+        std::unordered_map<File::StringViewType, CompiledSection> m_sections{};
+        size_t m_num_int64_values{};
+        size_t m_num_ordered_list_items{};
+        // Only used when the source had to be compiled, the sections point into it
+        std::vector<uint8_t> m_owned_data{};
+
+      public:
+        CompiledIni() = default;
+        // A copy would point into the data of the original
+        CompiledIni(const CompiledIni&) = delete;
+        auto operator=(const CompiledIni&) -> CompiledIni& = delete;
+        CompiledIni(CompiledIni&&) = default;
+        auto operator=(CompiledIni&&) -> CompiledIni& = default;
+
+      public:
+        RC_INI_PARSER_API auto static hash_source(File::StringViewType source) -> uint64_t;
+
+        // Only values that can be read as an int64 are stored, strings, floats and bools are left out
+        RC_INI_PARSER_API auto static compile(const std::unordered_map<File::StringType, Section>& sections, uint64_t source_hash) -> std::vector<uint8_t>;
+
+        // Writes to a temporary file that's then renamed, so that a crash while writing can't leave a truncated file behind
+        RC_INI_PARSER_API auto static write_file(const std::filesystem::path& file_path, std::span<const uint8_t> data) -> bool;
+
+        // Returns false and leaves the object empty if 'data' isn't a valid file compiled from a source with the hash 'source_hash'
+        // 'data' may be longer than the file, as is the case for memory maps, and it must outlive this object
+        RC_INI_PARSER_API auto load(std::span<const uint8_t> data, uint64_t source_hash) -> bool;
+
+        // Loads 'cached_data' if it was compiled from 'source', otherwise parses and compiles 'source' into data that this object owns
+        // A cache that is missing, stale, truncated or corrupted is never an error, it only means that 'source' is parsed
+        // Returns true if 'cached_data' was used, which must then outlive this object, and false if 'get_owned_data' should be written to the cache
+        // Throws like Ini::Parser::parse if 'source' is parsed and isn't valid
+        RC_INI_PARSER_API auto load_or_compile(std::span<const uint8_t> cached_data, File::StringType& source) -> bool;
+
+        // Empty unless 'load_or_compile' compiled the source
+        [[nodiscard]] auto get_owned_data() const -> std::span<const uint8_t>
+        {
+            return m_owned_data;
+        }
+
+        // Same as Ini::Parser::get_int64, so code that was written for the parser can be used with a compiled file
+        [[nodiscard]] RC_INI_PARSER_API auto get_int64(File::StringViewType section, File::StringViewType key, int64_t default_value) const noexcept -> int64_t;
+        // Empty if the section doesn't exist
+        [[nodiscard]] RC_INI_PARSER_API auto get_ordered_list(File::StringViewType section) const -> std::span<const File::StringViewType>;
+
+        [[nodiscard]] RC_INI_PARSER_API auto get_num_sections() const -> size_t;
+        [[nodiscard]] RC_INI_PARSER_API auto get_num_int64_values() const -> size_t;
+        [[nodiscard]] RC_INI_PARSER_API auto get_num_ordered_list_items() const -> size_t;
+    };
+} // namespace RC::Ini
@@ -50,5 +50,6 @@ namespace RC::Ini
         RC_INI_PARSER_API auto get_float(const File::StringType& section, const File::StringType& key) const -> float;
         RC_INI_PARSER_API auto get_bool(const File::StringType& section, const File::StringType& key, bool default_value) const noexcept -> bool;
         RC_INI_PARSER_API auto get_bool(const File::StringType& section, const File::StringType& key) const -> bool;
+        RC_INI_PARSER_API auto get_sections() const -> const std::unordered_map<File::StringType, Section>&;
     };
 } // namespace RC::Ini
@@ -4,60 +4,22 @@
 #include <vector>
 
 #include <File/File.hpp>
-#include <ProtoParser/TokenParser.hpp>
+#include <IniParser/Common.hpp>
+#include <IniParser/JSONDocument.hpp>
 
 namespace RC::Parser
 {
     namespace JSONInternal
     {
-        enum TokenType : int
-        {
-            Default = -1,
-            OpenCurlyBrace,
-            CloseCurlyBrace,
-            OpenSquareBracket,
-            CloseSquareBracket,
-            Colon,
-            DoubleQuote,
-            Comma,
-            Characters,
-            EndOfFile,
-        };
-
-        auto static token_type_to_string(const TokenType token_type) -> File::StringType
-        {
-            switch (token_type)
-            {
-            case Default:
-                return STR("Default");
-            case OpenCurlyBrace:
-                return STR("OpenCurlyBrace");
-            case CloseCurlyBrace:
-                return STR("CloseCurlyBrace");
-            case OpenSquareBracket:
-                return STR("OpenSquareBracket");
-            case CloseSquareBracket:
-                return STR("CloseSquareBracket");
-            case Colon:
-                return STR("Colon");
-            case Comma:
-                return STR("Comma");
-                break;
-            case DoubleQuote:
-                return STR("DoubleQuote");
-            case Characters:
-                return STR("Characters");
-            case EndOfFile:
-                return STR("EndOfFile");
-            }
-        }
-
         enum ItemType
         {
             None,
             String,
             Object,
             Array,
+            Number,
+            Bool,
+            Null,
         };
 
         class ItemBase
@@ -67,7 +29,7 @@ namespace RC::Parser
             bool m_is_global_scope{false};
 
           public:
-            auto get_name() -> File::StringViewType;
+            RC_INI_PARSER_API auto get_name() -> File::StringViewType;
 
             virtual ~ItemBase() = default;
             virtual auto to_string() -> File::StringType = 0;
@@ -85,127 +47,95 @@ namespace RC::Parser
             {
             }
 
-            auto to_string() -> File::StringType override;
+            RC_INI_PARSER_API auto to_string() -> File::StringType override;
             auto get_type() -> ItemType override
             {
                 return ItemType::String;
             }
         };
 
-        class ObjectScope : public ItemBase
+        class NumberItem : public ItemBase
         {
           public:
-            std::vector<std::unique_ptr<ItemBase>> m_members{};
-            size_t m_previous_line_without_comma{};
-            size_t m_previous_column_without_comma{};
+            double m_value{};
+            // The number as it was written in the input
+            File::StringType m_text{};
 
           public:
-            auto to_string() -> File::StringType override;
+            RC_INI_PARSER_API auto to_string() -> File::StringType override;
             auto get_type() -> ItemType override
             {
-                return ItemType::Object;
+                return ItemType::Number;
             }
         };
 
-        class ArrayScope : public ItemBase
+        class BoolItem : public ItemBase
         {
           public:
-            std::vector<std::unique_ptr<ItemBase>> m_members{};
+            bool m_value{};
 
           public:
-            auto to_string() -> File::StringType override;
+            RC_INI_PARSER_API auto to_string() -> File::StringType override;
             auto get_type() -> ItemType override
             {
-                return ItemType::Array;
+                return ItemType::Bool;
             }
         };
 
-        class TokenTypeStack
+        class NullItem : public ItemBase
         {
-          private:
-            std::vector<TokenType> m_token_types{};
-
           public:
-            auto operator+=(const TokenType& rhs)
-            {
-                m_token_types.emplace_back(rhs);
-            }
-
-            auto operator[](int32_t relative_index_to_front)
+            RC_INI_PARSER_API auto to_string() -> File::StringType override;
+            auto get_type() -> ItemType override
             {
-                int32_t real_index = (m_token_types.size() - 1) + relative_index_to_front;
-
-                if (real_index < 0)
-                {
-                    return TokenType::Default;
-                }
-                if (real_index > m_token_types.size())
-                {
-                    throw std::runtime_error{"[TokenTypeStack] Stack accessed (+) out-of-bounds"};
-                }
-
-                return m_token_types[real_index];
+                return ItemType::Null;
             }
-
-          public:
         };
 
-        class TokenParser : public Parser::TokenParser
+        class ObjectScope : public ItemBase
         {
-          private:
-            std::vector<std::unique_ptr<ItemBase>> m_items{};
-
-            // Non-owning
-            ItemBase* m_current_item{};
-            ItemType m_next_item_expected{};
-            TokenType m_next_token_expected{TokenType::Default};
-            TokenTypeStack m_processed_token_types{};
-            File::StringType m_string_value_buffer{};
-
-            bool m_double_quote_opened{false};
-            bool m_double_quote_successfully_closed{false};
+          public:
+            std::vector<std::unique_ptr<ItemBase>> m_members{};
 
           public:
-            TokenParser(const Parser::Tokenizer& tokenizer, File::StringType& input) : Parser::TokenParser(tokenizer, input)
+            RC_INI_PARSER_API auto to_string() -> File::StringType override;
+            auto get_type() -> ItemType override
             {
+                return ItemType::Object;
             }
+        };
 
-          private:
-            auto token_to_string(const Token& token) -> File::StringType;
-            auto skip_all_spaces() -> void;
-
-            auto parse_open_curly_brace(const Token& token) -> void;
-            auto parse_close_curly_brace(const Token& token) -> void;
-            auto parse_colon(const Token& token) -> void;
-            auto parse_comma(const Token& token) -> void;
-            auto parse_double_quote(const Token& token) -> void;
-            auto parse_characters(const Token& token) -> void;
-
+        class ArrayScope : public ItemBase
+        {
           public:
-            auto release_contents() -> std::vector<std::unique_ptr<ItemBase>>;
+            std::vector<std::unique_ptr<ItemBase>> m_members{};
 
-          protected:
-            auto parse_token(const Parser::Token& token) -> void override;
+          public:
+            RC_INI_PARSER_API auto to_string() -> File::StringType override;
+            auto get_type() -> ItemType override
+            {
+                return ItemType::Array;
+            }
         };
     } // namespace JSONInternal
 
+    // Parses a document into a tree of items that the caller owns
+    // Prefer JSONDocument, which doesn't allocate per value, or 'parse_json' when no tree is needed
     class JSON
     {
       private:
-        std::unique_ptr<JSONInternal::TokenParser> m_token_parser{};
+        std::vector<std::unique_ptr<JSONInternal::ItemBase>> m_items{};
 
       public:
         JSON() = default;
 
       private:
-        auto parse_internal(File::StringType& input) -> void;
-
-      public:
-        auto parse(File::StringType& input) -> void;
-        auto parse(File::Handle&) -> void;
-        auto release_contents() -> std::vector<std::unique_ptr<JSONInternal::ItemBase>>;
+        auto parse_internal(File::StringViewType input) -> void;
 
       public:
-        auto static test() -> void;
+        RC_INI_PARSER_API auto parse(File::StringType& input) -> void;
+        RC_INI_PARSER_API auto parse(const File::Handle&) -> void;
+        // Contains the root value, with 'm_is_global_scope' set, the members of objects are named after their keys
+        RC_INI_PARSER_API auto release_contents() -> std::vector<std::unique_ptr<JSONInternal::ItemBase>>;
     };
 } // namespace RC::Parser
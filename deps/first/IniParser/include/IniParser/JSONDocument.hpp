@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+
+#include <File/Macros.hpp>
+#include <IniParser/Common.hpp>
+
+namespace RC::Parser
+{
+    // Receives the contents of a JSON document in order, without a tree being built
+    // Use this for large files where only part of the contents is needed
+    //
+    // The views are only valid until the function returns
+    // Return false from any function to stop parsing, 'parse_json' then returns false
+    class JSONHandler
+    {
+      public:
+        virtual ~JSONHandler() = default;
+
+      public:
+        virtual auto on_object_start() -> bool
+        {
+            return true;
+        }
+        virtual auto on_object_end() -> bool
+        {
+            return true;
+        }
+        virtual auto on_array_start() -> bool
+        {
+            return true;
+        }
+        virtual auto on_array_end() -> bool
+        {
+            return true;
+        }
+        // Called for every member of an object, before the value of the member
+        virtual auto on_key([[maybe_unused]] File::StringViewType key) -> bool
+        {
+            return true;
+        }
+        virtual auto on_string([[maybe_unused]] File::StringViewType value) -> bool
+        {
+            return true;
+        }
+        // 'text' is the number as it was written in the input
+        virtual auto on_number([[maybe_unused]] double value, [[maybe_unused]] File::StringViewType text) -> bool
+        {
+            return true;
+        }
+        virtual auto on_bool([[maybe_unused]] bool value) -> bool
+        {
+            return true;
+        }
+        virtual auto on_null() -> bool
+        {
+            return true;
+        }
+    };
+
+    // Throws std::runtime_error with the line and column if the input isn't valid JSON (RFC 8259)
+    // A byte order mark at the start of the input is skipped
+    RC_INI_PARSER_API auto parse_json(File::StringViewType input, JSONHandler& handler) -> bool;
+
+    struct JSONMember;
+
+    // A value in a JSONDocument, everything that it points to is owned by the document
+    class JSONValue
+    {
+      private:
+        friend class JSONDocumentBuilder;
+
+      public:
+        enum class Type : uint8_t
+        {
+            Null,
+            Bool,
+            Number,
+            String,
+            Array,
+            Object,
+        };
+
+      private:
+        Type m_type{Type::Null};
+        union {
+            bool m_bool;
+            double m_number;
+            const File::CharType* m_string;
+            const JSONValue* m_items;
+            const JSONMember* m_members;
+        };
+        // Number of characters for strings, number of items or members for arrays and objects
+        uint32_t m_size{};
+
+      public:
+        JSONValue() : m_number(0.0)
+        {
+        }
+
+      public:
+        [[nodiscard]] auto get_type() const -> Type
+        {
+            return m_type;
+        }
+        [[nodiscard]] auto is_null() const -> bool
+        {
+            return m_type == Type::Null;
+        }
+        [[nodiscard]] auto is_bool() const -> bool
+        {
+            return m_type == Type::Bool;
+        }
+        [[nodiscard]] auto is_number() const -> bool
+        {
+            return m_type == Type::Number;
+        }
+        [[nodiscard]] auto is_string() const -> bool
+        {
+            return m_type == Type::String;
+        }
+        [[nodiscard]] auto is_array() const -> bool
+        {
+            return m_type == Type::Array;
+        }
+        [[nodiscard]] auto is_object() const -> bool
+        {
+            return m_type == Type::Object;
+        }
+
+        // The getters throw if the value has a different type
+        [[nodiscard]] RC_INI_PARSER_API auto get_bool() const -> bool;
+        [[nodiscard]] RC_INI_PARSER_API auto get_number() const -> double;
+        [[nodiscard]] RC_INI_PARSER_API auto get_string() const -> File::StringViewType;
+        [[nodiscard]] RC_INI_PARSER_API auto get_items() const -> std::span<const JSONValue>;
+        [[nodiscard]] RC_INI_PARSER_API auto get_members() const -> std::span<const JSONMember>;
+
+        // Returns the value of the first member called 'key', or nullptr if the value isn't an object or doesn't have the member
+        [[nodiscard]] RC_INI_PARSER_API auto find(File::StringViewType key) const -> const JSONValue*;
+    };
+
+    struct JSONMember
+    {
+        File::StringViewType key;
+        JSONValue value;
+    };
+
+    // A parsed JSON document
+    // All values and strings are stored in one arena that's freed with the document, the input can be freed once 'parse' returns
+    class JSONDocument
+    {
+      private:
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> m_arena{};
+        JSONValue m_root{};
+
+      public:
+        // Replaces the previous contents of the document, throws like 'parse_json'
+        RC_INI_PARSER_API auto parse(File::StringViewType input) -> void;
+
+        [[nodiscard]] RC_INI_PARSER_API auto get_root() const -> const JSONValue&;
+    };
+} // namespace RC::Parser
@@ -3,7 +3,7 @@
 #include <array>
 #include <cstdint>
 
-#include <File/File.hpp>
+#include <File/Macros.hpp>
 #include <IniParser/Common.hpp>
 
 namespace RC::Ini
@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <IniParser/CompiledIni.hpp>
+#include <IniParser/Ini.hpp>
+#include <IniParser/Section.hpp>
+
+namespace RC::Ini
+{
+    static constexpr std::array<uint8_t, 8> s_file_magic{'U', 'E', '4', 'S', 'S', 'I', 'N', 'I'};
+
+    // Magic, version, character size, source hash, payload size and payload checksum
+    static constexpr size_t s_header_size = 8 + 4 + 4 + 8 + 8 + 8;
+
+    // Strings are padded to this so that every string starts at an offset that's aligned for File::CharType
+    static constexpr size_t s_string_alignment = 4;
+    static_assert(alignof(File::CharType) <= s_string_alignment);
+
+    static auto hash_bytes(std::span<const uint8_t> bytes, uint64_t seed = 0xcbf29ce484222325) -> uint64_t
+    {
+        uint64_t hash = seed;
+        for (const auto byte : bytes)
+        {
+            hash ^= byte;
+            hash *= 0x100000001b3;
+        }
+        return hash;
+    }
+
+    namespace
+    {
+        class ByteWriter
+        {
+          private:
+            std::vector<uint8_t>& m_buffer;
+
+          public:
+            explicit ByteWriter(std::vector<uint8_t>& buffer) : m_buffer(buffer)
+            {
+            }
+
+            template <typename IntType>
+            auto write(IntType value) -> void
+            {
+                for (size_t i = 0; i < sizeof(IntType); ++i)
+                {
+                    m_buffer.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (i * 8)));
+                }
+            }
+
+            auto write_bytes(std::span<const uint8_t> bytes) -> void
+            {
+                m_buffer.insert(m_buffer.end(), bytes.begin(), bytes.end());
+            }
+
+            auto write_string(File::StringViewType string) -> void
+            {
+                write<uint32_t>(static_cast<uint32_t>(string.size()));
+                write_bytes({reinterpret_cast<const uint8_t*>(string.data()), string.size() * sizeof(File::CharType)});
+                m_buffer.resize((m_buffer.size() + s_string_alignment - 1) / s_string_alignment * s_string_alignment);
+            }
+        };
+
+        class ByteReader
+        {
+          private:
+            std::span<const uint8_t> m_data;
+            size_t m_offset{};
+            bool m_has_failed{};
+
+          public:
+            explicit ByteReader(std::span<const uint8_t> data) : m_data(data)
+            {
+            }
+
+            template <typename IntType>
+            auto read() -> IntType
+            {
+                if (m_has_failed || m_data.size() - m_offset < sizeof(IntType))
+                {
+                    m_has_failed = true;
+                    return {};
+                }
+
+                uint64_t value{};
+                for (size_t i = 0; i < sizeof(IntType); ++i)
+                {
+                    value |= static_cast<uint64_t>(m_data[m_offset++]) << (i * 8);
+                }
+                return static_cast<IntType>(value);
+            }
+
+            auto read_bytes(size_t size) -> std::span<const uint8_t>
+            {
+                if (m_has_failed || m_data.size() - m_offset < size)
+                {
+                    m_has_failed = true;
+                    return {};
+                }
+
+                auto bytes = m_data.subspan(m_offset, size);
+                m_offset += size;
+                return bytes;
+            }
+
+            // The returned view points into the data
+            auto read_string() -> File::StringViewType
+            {
+                const auto num_characters = read<uint32_t>();
+                const auto num_padded_bytes = (static_cast<size_t>(num_characters) * sizeof(File::CharType) + s_string_alignment - 1) / s_string_alignment * s_string_alignment;
+                auto bytes = read_bytes(num_padded_bytes);
+                if (m_has_failed || reinterpret_cast<uintptr_t>(bytes.data()) % alignof(File::CharType) != 0)
+                {
+                    m_has_failed = true;
+                    return {};
+                }
+                return File::StringViewType{reinterpret_cast<const File::CharType*>(bytes.data()), num_characters};
+            }
+
+            [[nodiscard]] auto has_failed() const -> bool
+            {
+                return m_has_failed;
+            }
+        };
+    } // namespace
+
+    auto CompiledIni::hash_source(File::StringViewType source) -> uint64_t
+    {
+        return hash_bytes({reinterpret_cast<const uint8_t*>(source.data()), source.size() * sizeof(File::CharType)});
+    }
+
+    auto CompiledIni::compile(const std::unordered_map<File::StringType, Section>& sections, uint64_t source_hash) -> std::vector<uint8_t>
+    {
+        std::vector<uint8_t> payload{};
+        ByteWriter payload_writer{payload};
+
+        payload_writer.write<uint32_t>(static_cast<uint32_t>(sections.size()));
+        for (const auto& [section_name, section] : sections)
+        {
+            payload_writer.write_string(section_name);
+
+            const auto num_int64_values = std::count_if(section.key_value_pairs.begin(), section.key_value_pairs.end(), [](const auto& key_value_pair) {
+                return key_value_pair.second.get_ref()->is_valid_int64();
+            });
+            payload_writer.write<uint32_t>(static_cast<uint32_t>(num_int64_values));
+            for (const auto& [key, value] : section.key_value_pairs)
+            {
+                if (value.get_ref()->is_valid_int64())
+                {
+                    payload_writer.write_string(key);
+                    payload_writer.write<int64_t>(value.get_ref()->get_int64_value());
+                }
+            }
+
+            payload_writer.write<uint32_t>(static_cast<uint32_t>(section.ordered_list.size()));
+            for (const auto& item : section.ordered_list)
+            {
+                payload_writer.write_string(item);
+            }
+        }
+
+        std::vector<uint8_t> buffer{};
+        buffer.reserve(s_header_size + payload.size());
+        ByteWriter writer{buffer};
+        writer.write_bytes(s_file_magic);
+        writer.write<uint32_t>(file_version);
+        writer.write<uint32_t>(static_cast<uint32_t>(sizeof(File::CharType)));
+        writer.write<uint64_t>(source_hash);
+        writer.write<uint64_t>(payload.size());
+        writer.write<uint64_t>(hash_bytes(payload));
+        writer.write_bytes(payload);
+        return buffer;
+    }
+
+    auto CompiledIni::write_file(const std::filesystem::path& file_path, std::span<const uint8_t> data) -> bool
+    {
+        std::error_code ec{};
+        std::filesystem::create_directories(file_path.parent_path(), ec);
+
+        auto temporary_path = file_path;
+        temporary_path += ".tmp";
+        {
+            std::ofstream file{temporary_path, std::ios::binary | std::ios::trunc};
+            if (!file)
+            {
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!file)
+            {
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary_path, file_path, ec);
+        if (ec)
+        {
+            std::filesystem::remove(temporary_path, ec);
+            return false;
+        }
+        return true;
+    }
+
+    auto CompiledIni::load(std::span<const uint8_t> data, uint64_t source_hash) -> bool
+    {
+        m_sections.clear();
+        m_num_int64_values = 0;
+        m_num_ordered_list_items = 0;
+
+        ByteReader header_reader{data};
+        auto magic = header_reader.read_bytes(s_file_magic.size());
+        if (header_reader.has_failed() || !std::equal(magic.begin(), magic.end(), s_file_magic.begin()))
+        {
+            return false;
+        }
+        if (header_reader.read<uint32_t>() != file_version || header_reader.read<uint32_t>() != sizeof(File::CharType) ||
+            header_reader.read<uint64_t>() != source_hash)
+        {
+            return false;
+        }
+        const auto payload_size = header_reader.read<uint64_t>();
+        const auto payload_checksum = header_reader.read<uint64_t>();
+        if (header_reader.has_failed() || payload_size > data.size() - s_header_size)
+        {
+            return false;
+        }
+        const auto payload = data.subspan(s_header_size, static_cast<size_t>(payload_size));
+        if (hash_bytes(payload) != payload_checksum)
+        {
+            return false;
+        }
+
+        std::unordered_map<File::StringViewType, CompiledSection> sections{};
+        size_t num_int64_values{};
+        size_t num_ordered_list_items{};
+
+        ByteReader reader{payload};
+        const auto num_sections = reader.read<uint32_t>();
+        for (uint32_t section_index = 0; section_index < num_sections && !reader.has_failed(); ++section_index)
+        {
+            auto& section = sections[reader.read_string()];
+
+            const auto num_values = reader.read<uint32_t>();
+            for (uint32_t value_index = 0; value_index < num_values && !reader.has_failed(); ++value_index)
+            {
+                const auto key = reader.read_string();
+                section.int64_values.emplace(key, reader.read<int64_t>());
+            }
+            num_int64_values += num_values;
+
+            const auto num_items = reader.read<uint32_t>();
+            for (uint32_t item_index = 0; item_index < num_items && !reader.has_failed(); ++item_index)
+            {
+                section.ordered_list.emplace_back(reader.read_string());
+            }
+            num_ordered_list_items += num_items;
+        }
+
+        if (reader.has_failed())
+        {
+            return false;
+        }
+
+        m_sections = std::move(sections);
+        m_num_int64_values = num_int64_values;
+        m_num_ordered_list_items = num_ordered_list_items;
+        return true;
+    }
+
+    auto CompiledIni::load_or_compile(std::span<const uint8_t> cached_data, File::StringType& source) -> bool
+    {
+        const auto source_hash = hash_source(source);
+        m_owned_data.clear();
+        if (load(cached_data, source_hash))
+        {
+            return true;
+        }
+
+        Parser parser{};
+        parser.parse(source);
+        m_owned_data = compile(parser.get_sections(), source_hash);
+        if (!load(m_owned_data, source_hash))
+        {
+            throw std::runtime_error{"[CompiledIni::load_or_compile] Could not load data that was just compiled"};
+        }
+        return false;
+    }
+
+    auto CompiledIni::get_int64(File::StringViewType section, File::StringViewType key, int64_t default_value) const noexcept -> int64_t
+    {
+        const auto section_it = m_sections.find(section);
+        if (section_it == m_sections.end())
+        {
+            return default_value;
+        }
+
+        const auto value_it = section_it->second.int64_values.find(key);
+        return value_it == section_it->second.int64_values.end() ? default_value : value_it->second;
+    }
+
+    auto CompiledIni::get_ordered_list(File::StringViewType section) const -> std::span<const File::StringViewType>
+    {
+        const auto section_it = m_sections.find(section);
+        if (section_it == m_sections.end())
+        {
+            return {};
+        }
+        return section_it->second.ordered_list;
+    }
+
+    auto CompiledIni::get_num_sections() const -> size_t
+    {
+        return m_sections.size();
+    }
+
+    auto CompiledIni::get_num_int64_values() const -> size_t
+    {
+        return m_num_int64_values;
+    }
+
+    auto CompiledIni::get_num_ordered_list_items() const -> size_t
+    {
+        return m_num_ordered_list_items;
+    }
+} // namespace RC::Ini
@@ -274,4 +274,9 @@ namespace RC::Ini
             }
         }
     }
+
+    auto Parser::get_sections() const -> const std::unordered_map<File::StringType, Section>&
+    {
+        return m_sections;
+    }
 } // namespace RC::Ini
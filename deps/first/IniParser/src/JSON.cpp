@@ -1,29 +1,7 @@
-#include <format>
-
 #include <IniParser/JSON.hpp>
-#include <ParserBase/Token.hpp>
-#include <ParserBase/Tokenizer.hpp>
-
-#include <Helpers/String.hpp>
 
 namespace RC::Parser
 {
-    static auto has_only_spaces(const File::StringType& data) -> bool
-    {
-        if (std::all_of(data.begin(), data.end(), [](File::CharType c) {
-                return std::isspace(c) || c == '\n';
-            }))
-        {
-            printf_s("SKIPPING\n");
-            return true;
-        }
-        else
-        {
-            printf_s("NOT SKIPPING, data: '%S'\n", data.c_str());
-            return false;
-        }
-    }
-
     auto JSONInternal::ItemBase::get_name() -> File::StringViewType
     {
         if (m_is_global_scope)
@@ -38,325 +16,134 @@ namespace RC::Parser
 
     auto JSONInternal::StringItem::to_string() -> File::StringType
     {
-        return fmt::format(STR("String = \"{}\""), m_value);
+        return File::StringType{STR("String = \"")} + m_value + STR("\"");
     }
 
-    auto JSONInternal::ObjectScope::to_string() -> File::StringType
+    auto JSONInternal::NumberItem::to_string() -> File::StringType
     {
-        File::StringType str = fmt::format(STR("Object = \"{}\""), get_name());
-
-        for (const auto& member : m_members)
-        {
-            str.append(fmt::format(STR("\n\"{}\" = {}"), member->get_name(), member->to_string()));
-        }
+        return File::StringType{STR("Number = ")} + m_text;
+    }
 
-        return str;
+    auto JSONInternal::BoolItem::to_string() -> File::StringType
+    {
+        return m_value ? STR("Bool = true") : STR("Bool = false");
     }
 
-    auto JSONInternal::ArrayScope::to_string() -> File::StringType
+    auto JSONInternal::NullItem::to_string() -> File::StringType
     {
-        return fmt::format(STR("Array = \"{}\""), get_name());
+        return STR("Null");
     }
 
-    auto JSONInternal::TokenParser::token_to_string(const Token& token) -> File::StringType
+    auto JSONInternal::ObjectScope::to_string() -> File::StringType
     {
-        File::StringType string{};
+        File::StringType str = File::StringType{STR("Object = \"")} + File::StringType{get_name()} + STR("\"");
 
-        // TODO: Support manual escaping of double quotes with '\'
-        while (peek().get_type() != TokenType::DoubleQuote)
+        for (const auto& member : m_members)
         {
-            // Get the next token after the 'DoubleQuote' token
-            auto& next_token = consume();
-
-            // Auto-escaping all token identifiers after the opening double quote
-            if (next_token.get_type() == TokenType::Characters)
-            {
-                string.append(get_data(next_token));
-            }
-            else
-            {
-                string.append(next_token.get_identifier());
-            }
+            str.append(STR("\n\"")).append(member->get_name()).append(STR("\" = ")).append(member->to_string());
         }
 
-        return string;
+        return str;
     }
 
-    auto JSONInternal::TokenParser::skip_all_spaces() -> void
+    auto JSONInternal::ArrayScope::to_string() -> File::StringType
     {
-        auto& peeked_token = peek();
-        if (peeked_token.get_type() == TokenType::Characters)
-        {
-            // We have either a non-string value or we have spaces which need to be ignored
-            if (has_only_spaces(get_data(peeked_token)))
-            {
-                consume();
-                printf_s("Consumed '%S', which contained: '%S'\n", peeked_token.to_string().c_str(), get_data(peeked_token).c_str());
-            }
-        }
+        return File::StringType{STR("Array = \"")} + File::StringType{get_name()} + STR("\"");
     }
 
-    auto JSONInternal::TokenParser::parse_open_curly_brace(const Token& token) -> void
+    // Builds the item tree directly, so that numbers keep the text that they were written with
+    class JSONItemBuilder : public JSONHandler
     {
-        bool is_first_item = !m_current_item;
+      private:
+        std::vector<std::unique_ptr<JSONInternal::ItemBase>> m_items{};
+        // Arrays and objects that haven't ended yet, the items are owned by their parents or by 'm_items'
+        std::vector<JSONInternal::ItemBase*> m_scopes{};
+        File::StringType m_key{};
 
-        // Open array scope
-        m_current_item = m_items.emplace_back(std::make_unique<ObjectScope>()).get();
-
-        if (is_first_item)
+      public:
+        auto release_items() -> std::vector<std::unique_ptr<JSONInternal::ItemBase>>
         {
-            m_current_item->m_is_global_scope = true;
+            return std::move(m_items);
         }
 
-        // Right after opening an object, the only valid token is a quoted string
-        m_next_token_expected = TokenType::DoubleQuote;
-        m_processed_token_types += TokenType::OpenCurlyBrace;
-    }
-
-    auto JSONInternal::TokenParser::parse_close_curly_brace(const Token& token) -> void
-    {
-        if (m_current_item->get_type() == ItemType::Object)
+        auto on_object_start() -> bool override
         {
-            if (static_cast<ObjectScope*>(m_current_item)->m_previous_line_without_comma == 0)
-            {
-                throw std::runtime_error{
-                        fmt::format("Syntax error ({} : {}): Unexpected 'Comma' token, expected 'CloseCurlyBrace'.", token.get_line(), token.get_column())};
-            }
+            m_scopes.emplace_back(add_item(std::make_unique<JSONInternal::ObjectScope>()));
+            return true;
         }
-        else if (m_current_item->get_type() == ItemType::Array)
+        auto on_object_end() -> bool override
         {
+            m_scopes.pop_back();
+            return true;
         }
-
-        m_processed_token_types += TokenType::CloseCurlyBrace;
-    }
-
-    auto JSONInternal::TokenParser::parse_colon(const Token& token) -> void
-    {
-        // This might be a complicated token
-        // We don't know the type of item that we're creating yet, so we can't just set the token type
-
-        skip_all_spaces();
-
-        auto token_type = peek().get_type();
-        if (token_type == TokenType::DoubleQuote)
+        auto on_array_start() -> bool override
         {
-            // Consume the opening 'DoubleQuote' token
-            parse_double_quote(consume());
-
-            auto value = token_to_string(peek());
-
-            if (m_current_item->get_type() == ItemType::Object)
-            {
-                auto& typed_current_item = static_cast<ObjectScope&>(*m_current_item);
-
-                // Enforce 'Comma' token, if this isn't the first item
-                if (!typed_current_item.m_members.empty() && typed_current_item.m_previous_line_without_comma != 0)
-                {
-                    throw std::runtime_error{fmt::format("Syntax error ({} : {}): Expected 'Comma' token before new item.",
-                                                         typed_current_item.m_previous_line_without_comma,
-                                                         typed_current_item.m_previous_column_without_comma)};
-                }
-
-                auto& item = typed_current_item.m_members.emplace_back(std::make_unique<StringItem>(value));
-                printf_s("Adding string, '%S', to object, it has the name '%S'\n", value.c_str(), m_string_value_buffer.c_str());
-                item->m_name = std::move(m_string_value_buffer);
-                m_string_value_buffer.clear();
-
-                auto& next_token = peek();
-                typed_current_item.m_previous_line_without_comma = next_token.get_line();
-                typed_current_item.m_previous_column_without_comma = next_token.get_column();
-            }
-            else if (m_current_item->get_type() == ItemType::Array)
-            {
-                throw std::runtime_error{"Invalid scope: Arrays are not yet implemented"};
-            }
-            else
-            {
-                throw std::runtime_error{"Invalid scope: No type"};
-            }
-
-            // Consume the closing 'DoubleQuote' token
-            if (peek().get_type() != TokenType::DoubleQuote)
-            {
-                throw std::runtime_error{fmt::format("Syntax error ({} : {}): Expected 'DoubleQuote' token, got '{}'.",
-                                                     token.get_line(),
-                                                     token.get_column(),
-                                                     to_string(token.to_string()))};
-            }
-            parse_double_quote(consume());
-
-            m_next_token_expected = TokenType::Default;
+            m_scopes.emplace_back(add_item(std::make_unique<JSONInternal::ArrayScope>()));
+            return true;
         }
-        else if (token_type == TokenType::OpenCurlyBrace)
+        auto on_array_end() -> bool override
         {
-            // Consider returning here without doing anything
-            // That would let the main handler deal with this
-            // You would need some way of telling the handler that the thing (object in this case) being created is part of
-            // an object or array, and also which object or array that it's part of
-            throw std::runtime_error{"Object in object or object in array\n"};
+            m_scopes.pop_back();
+            return true;
         }
-        else if (token_type == TokenType::OpenSquareBracket)
+        auto on_key(File::StringViewType key) -> bool override
         {
-            // Consider returning here without doing anything
-            // That would let the main handler deal with this
-            // You would need some way of telling the handler that the thing (object in this case) being created is part of
-            // an object or array, and also which object or array that it's part of
-            throw std::runtime_error{"Array in object or array in array\n"};
+            m_key = key;
+            return true;
         }
-        else
+        auto on_string(File::StringViewType value) -> bool override
         {
-            // No valid for now
-            throw std::runtime_error{"Unsupported type after 'Colon' token, expected 'DoubleQuote', 'OpenCurlyBrace', or 'OpenSquareBracket'"};
+            add_item(std::make_unique<JSONInternal::StringItem>(File::StringType{value}));
+            return true;
         }
-
-        m_processed_token_types += TokenType::Colon;
-    }
-
-    auto JSONInternal::TokenParser::parse_comma(const Token& token) -> void
-    {
-        auto item_type = m_current_item->get_type();
-        if (item_type == ItemType::Object)
+        auto on_number(double value, File::StringViewType text) -> bool override
         {
-            ObjectScope& current_item = static_cast<ObjectScope&>(*m_current_item);
-            current_item.m_previous_line_without_comma = 0;
-            current_item.m_previous_column_without_comma = 0;
+            auto item = std::make_unique<JSONInternal::NumberItem>();
+            item->m_value = value;
+            item->m_text = text;
+            add_item(std::move(item));
+            return true;
         }
-        else if (item_type == ItemType::Array)
+        auto on_bool(bool value) -> bool override
         {
+            auto item = std::make_unique<JSONInternal::BoolItem>();
+            item->m_value = value;
+            add_item(std::move(item));
+            return true;
         }
-        else
+        auto on_null() -> bool override
         {
-            throw std::runtime_error{fmt::format("Syntax error ({} : {}): Unexpected 'Comma' token.", token.get_line(), token.get_column())};
+            add_item(std::make_unique<JSONInternal::NullItem>());
+            return true;
         }
 
-        m_processed_token_types += TokenType::Comma;
-    }
-
-    auto JSONInternal::TokenParser::parse_double_quote(const Token& token) -> void
-    {
-        if (!m_double_quote_opened)
+      private:
+        auto add_item(std::unique_ptr<JSONInternal::ItemBase> item) -> JSONInternal::ItemBase*
         {
-            m_next_token_expected = TokenType::Characters;
-            m_double_quote_opened = true;
-        }
-        else
-        {
-            // If last processed token was a 'Comma', 'OpenCurlyBrace', or 'OpenSquareBracket', then a colon is expected
-            // This means that this is the LHS of an assignment, not the RHS
-            // Therefore we expect the next token to be an assignment token (Colon)
-            auto last_processed_token_type = m_processed_token_types[-1];
-            if (last_processed_token_type == TokenType::Comma || last_processed_token_type == TokenType::OpenCurlyBrace ||
-                last_processed_token_type == TokenType::OpenSquareBracket)
+            auto raw_item = item.get();
+            if (m_scopes.empty())
             {
-                skip_all_spaces();
-
-                auto& peeked_token = peek();
-                if (peeked_token.get_type() != TokenType::Colon)
-                {
-                    throw std::runtime_error{fmt::format("Syntax error ({} : {}): Expected 'Colon' token, got '{}'.",
-                                                         peeked_token.get_line(),
-                                                         peeked_token.get_column(),
-                                                         to_string(peeked_token.to_string()))};
-                }
+                item->m_is_global_scope = true;
+                m_items.emplace_back(std::move(item));
             }
-
-            m_double_quote_opened = false;
-            m_double_quote_successfully_closed = true;
-            m_next_token_expected = TokenType::Default;
-        }
-
-        m_processed_token_types += TokenType::DoubleQuote;
-    }
-
-    auto JSONInternal::TokenParser::parse_characters(const Token& token) -> void
-    {
-        auto& data = get_data(token);
-
-        // Ignore if the data only contains spaces
-        if (has_only_spaces(data))
-        {
-            return;
-        }
-
-        m_string_value_buffer = std::move(data);
-
-        // Simulate that we dealt with the token successfully until there's a proper implementation
-        m_next_token_expected = TokenType::Default;
-    }
-
-    auto JSONInternal::TokenParser::release_contents() -> std::vector<std::unique_ptr<ItemBase>>
-    {
-        return std::move(m_items);
-    }
-
-    auto JSONInternal::TokenParser::parse_token(const Token& token) -> void
-    {
-        TokenType token_type = static_cast<TokenType>(token.get_type());
-
-        printf_s("current: %S <-> previous: %S <-> next: %S <-> expected: %S\n",
-                 token.to_string().data(),
-                 peek(PeekDirection::Backward).to_string().data(),
-                 peek(PeekDirection::Forward).to_string().data(),
-                 token_type_to_string(m_next_token_expected).data());
-
-        // If type is 'Default', then this is the first token
-        // If type is 'Characters', then let the 'Characters' handler handle this as a 'Characters' token may be ignored if it's only spaces
-        // Otherwise, if the type is not what is expected, throw an exception
-        if (m_next_token_expected != TokenType::Default && token_type != TokenType::Characters && token_type != m_next_token_expected)
-        {
-            throw std::runtime_error{
-                    fmt::format("Syntax error ({} : {}): Expected 'Colon' token, got '{}'.", token.get_line(), token.get_column(), to_string(token.to_string()))};
-        }
-
-        switch (token_type)
-        {
-        case Default:
-            break;
-        case OpenCurlyBrace:
-            parse_open_curly_brace(token);
-            break;
-        case CloseCurlyBrace:
-            parse_close_curly_brace(token);
-            break;
-        case OpenSquareBracket:
-            break;
-        case CloseSquareBracket:
-            break;
-        case Colon:
-            parse_colon(token);
-            break;
-        case Comma:
-            parse_comma(token);
-            break;
-        case DoubleQuote:
-            parse_double_quote(token);
-            break;
-        case Characters:
-            parse_characters(token);
-            break;
-        case EndOfFile:
-            break;
+            else if (auto parent = m_scopes.back(); parent->get_type() == JSONInternal::ItemType::Object)
+            {
+                item->m_name = m_key;
+                static_cast<JSONInternal::ObjectScope*>(parent)->m_members.emplace_back(std::move(item));
+            }
+            else
+            {
+                static_cast<JSONInternal::ArrayScope*>(parent)->m_members.emplace_back(std::move(item));
+            }
+            return raw_item;
         }
-    }
+    };
 
-    auto JSON::parse_internal(File::StringType& input) -> void
+    auto JSON::parse_internal(File::StringViewType input) -> void
     {
-        Tokenizer tokenizer;
-        TokenContainer tc;
-        tc.add(Token::create(JSONInternal::TokenType::OpenCurlyBrace, STR("OpenCurlyBrace"), STR("{")));
-        tc.add(Token::create(JSONInternal::TokenType::CloseCurlyBrace, STR("CloseCurlyBrace"), STR("}")));
-        tc.add(Token::create(JSONInternal::TokenType::OpenSquareBracket, STR("OpenSquareBracket"), STR("[")));
-        tc.add(Token::create(JSONInternal::TokenType::CloseSquareBracket, STR("CloseSquareBracket"), STR("]")));
-        tc.add(Token::create(JSONInternal::TokenType::Colon, STR("Colon"), STR(":")));
-        tc.add(Token::create(JSONInternal::TokenType::Comma, STR("Comma"), STR(",")));
-        tc.add(Token::create(JSONInternal::TokenType::DoubleQuote, STR("DoubleQuote"), STR("\"")));
-        tc.add(Token::create(JSONInternal::TokenType::Characters, STR("Characters"), STR(""), Token::HasData::Yes));
-        tc.set_eof_token(JSONInternal::TokenType::EndOfFile);
-        tokenizer.set_available_tokens(std::move(tc));
-        tokenizer.tokenize(input);
-
-        m_token_parser = std::make_unique<JSONInternal::TokenParser>(tokenizer, input);
-        m_token_parser->parse();
+        JSONItemBuilder builder{};
+        parse_json(input, builder);
+        m_items = builder.release_items();
     }
 
     auto JSON::parse(File::StringType& input) -> void
@@ -364,7 +151,7 @@ namespace RC::Parser
         parse_internal(input);
     }
 
-    auto JSON::parse(File::Handle& file) -> void
+    auto JSON::parse(const File::Handle& file) -> void
     {
         auto input = file.read_all();
         parse_internal(input);
@@ -372,39 +159,6 @@ namespace RC::Parser
 
     auto JSON::release_contents() -> std::vector<std::unique_ptr<JSONInternal::ItemBase>>
     {
-        return m_token_parser->release_contents();
-    }
-
-    auto JSON::test() -> void
-    {
-        // Current problems:
-        /*
-            No escaping in strings
-            All token types would need to be escaped, and I hate this, things like commas should be auto-escaped in strings
-            In fact, everything that's not a double quote should be auto-escaped in strings
-
-            Development is very early on, this is an experiment but hopefully eventually it will be good enough to use
-            I suspect that the recursive-ness of JSON is going to be a problem
-        */
-
-        /**/
-        File::StringType input = LR"(
-{
-    "my key": "my string, value",
-    "my second key": "my other string value",
-    "my third key": {
-        "my fourth key: "some other string value"
-    }
-})"; //*/
-
-        JSON parser;
-        parser.parse(input);
-
-        // The content gets moved, the owner of the vector is now the current scope.
-        auto items = parser.release_contents();
-        for (const auto& item : items)
-        {
-            printf_s("%S\n", item->to_string().c_str());
-        }
+        return std::move(m_items);
     }
 } // namespace RC::Parser
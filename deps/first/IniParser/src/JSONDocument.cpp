@@ -0,0 +1,661 @@
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <IniParser/JSONDocument.hpp>
+
+#include <fmt/core.h>
+
+namespace RC::Parser
+{
+    using UnsignedCharType = std::make_unsigned_t<File::CharType>;
+
+    // Deeper documents are rejected instead of risking a stack overflow
+    constexpr size_t max_json_depth = 512;
+
+    // Reads a document in a single pass and passes its contents to 'Handler', which is either a JSONHandler or the builder for JSONDocument
+    // Strings without escape sequences are passed as views of the input, the others are unescaped into a buffer that's reused
+    template <typename Handler>
+    class JSONReader
+    {
+      private:
+        const File::CharType* m_begin;
+        const File::CharType* m_cursor;
+        const File::CharType* m_end;
+        Handler& m_handler;
+        File::StringType m_string_buffer{};
+        std::string m_number_buffer{};
+
+      public:
+        JSONReader(File::StringViewType input, Handler& handler)
+            : m_begin(input.data()), m_cursor(input.data()), m_end(input.data() + input.size()), m_handler(handler)
+        {
+        }
+
+      public:
+        auto read() -> bool
+        {
+            if (m_cursor != m_end && static_cast<UnsignedCharType>(*m_cursor) == 0xFEFF)
+            {
+                ++m_cursor;
+            }
+
+            skip_whitespace();
+            if (!read_value(0))
+            {
+                return false;
+            }
+
+            skip_whitespace();
+            if (m_cursor != m_end)
+            {
+                fail("Unexpected character after the end of the document");
+            }
+            return true;
+        }
+
+      private:
+        [[noreturn]] auto fail(const char* message) const -> void
+        {
+            size_t line{1};
+            const File::CharType* start_of_line = m_begin;
+            for (auto c = m_begin; c < m_cursor && c < m_end; ++c)
+            {
+                if (*c == STR('\n'))
+                {
+                    ++line;
+                    start_of_line = c + 1;
+                }
+            }
+            throw std::runtime_error{fmt::format("Syntax error ({} : {}): {}", line, m_cursor - start_of_line + 1, message)};
+        }
+
+        auto skip_whitespace() -> void
+        {
+            while (m_cursor != m_end && (*m_cursor == STR(' ') || *m_cursor == STR('\n') || *m_cursor == STR('\r') || *m_cursor == STR('\t')))
+            {
+                ++m_cursor;
+            }
+        }
+
+        auto expect(File::CharType character, const char* message) -> void
+        {
+            if (m_cursor == m_end || *m_cursor != character)
+            {
+                fail(message);
+            }
+            ++m_cursor;
+        }
+
+        auto read_value(size_t depth) -> bool
+        {
+            if (m_cursor == m_end)
+            {
+                fail("Unexpected end of input, expected a value");
+            }
+
+            switch (*m_cursor)
+            {
+            case STR('{'):
+                return read_object(depth + 1);
+            case STR('['):
+                return read_array(depth + 1);
+            case STR('"'):
+                return m_handler.on_string(read_string());
+            case STR('t'):
+                read_literal(STR("true"));
+                return m_handler.on_bool(true);
+            case STR('f'):
+                read_literal(STR("false"));
+                return m_handler.on_bool(false);
+            case STR('n'):
+                read_literal(STR("null"));
+                return m_handler.on_null();
+            default:
+                if (*m_cursor == STR('-') || (*m_cursor >= STR('0') && *m_cursor <= STR('9')))
+                {
+                    return read_number();
+                }
+                fail("Expected a value");
+            }
+        }
+
+        auto read_object(size_t depth) -> bool
+        {
+            if (depth > max_json_depth)
+            {
+                fail("Objects and arrays are nested too deeply");
+            }
+
+            ++m_cursor;
+            if (!m_handler.on_object_start())
+            {
+                return false;
+            }
+
+            skip_whitespace();
+            if (m_cursor != m_end && *m_cursor == STR('}'))
+            {
+                ++m_cursor;
+                return m_handler.on_object_end();
+            }
+
+            while (true)
+            {
+                if (m_cursor == m_end || *m_cursor != STR('"'))
+                {
+                    fail("Expected a string as the key of an object member");
+                }
+                if (!m_handler.on_key(read_string()))
+                {
+                    return false;
+                }
+
+                skip_whitespace();
+                expect(STR(':'), "Expected ':' after the key of an object member");
+                skip_whitespace();
+                if (!read_value(depth))
+                {
+                    return false;
+                }
+
+                skip_whitespace();
+                if (m_cursor != m_end && *m_cursor == STR(','))
+                {
+                    ++m_cursor;
+                    skip_whitespace();
+                    continue;
+                }
+                expect(STR('}'), "Expected ',' or '}' after an object member");
+                return m_handler.on_object_end();
+            }
+        }
+
+        auto read_array(size_t depth) -> bool
+        {
+            if (depth > max_json_depth)
+            {
+                fail("Objects and arrays are nested too deeply");
+            }
+
+            ++m_cursor;
+            if (!m_handler.on_array_start())
+            {
+                return false;
+            }
+
+            skip_whitespace();
+            if (m_cursor != m_end && *m_cursor == STR(']'))
+            {
+                ++m_cursor;
+                return m_handler.on_array_end();
+            }
+
+            while (true)
+            {
+                if (!read_value(depth))
+                {
+                    return false;
+                }
+
+                skip_whitespace();
+                if (m_cursor != m_end && *m_cursor == STR(','))
+                {
+                    ++m_cursor;
+                    skip_whitespace();
+                    continue;
+                }
+                expect(STR(']'), "Expected ',' or ']' after an array item");
+                return m_handler.on_array_end();
+            }
+        }
+
+        auto read_literal(File::StringViewType literal) -> void
+        {
+            if (static_cast<size_t>(m_end - m_cursor) < literal.size() || File::StringViewType{m_cursor, literal.size()} != literal)
+            {
+                fail("Expected a value");
+            }
+            m_cursor += literal.size();
+        }
+
+        auto read_number() -> bool
+        {
+            auto start = m_cursor;
+            auto is_digit = [&] {
+                return m_cursor != m_end && *m_cursor >= STR('0') && *m_cursor <= STR('9');
+            };
+            auto skip_digits = [&] {
+                if (!is_digit())
+                {
+                    fail("Expected a digit");
+                }
+                while (is_digit())
+                {
+                    ++m_cursor;
+                }
+            };
+
+            if (*m_cursor == STR('-'))
+            {
+                ++m_cursor;
+            }
+            // Leading zeros aren't allowed
+            if (m_cursor != m_end && *m_cursor == STR('0'))
+            {
+                ++m_cursor;
+            }
+            else
+            {
+                skip_digits();
+            }
+            if (m_cursor != m_end && *m_cursor == STR('.'))
+            {
+                ++m_cursor;
+                skip_digits();
+            }
+            if (m_cursor != m_end && (*m_cursor == STR('e') || *m_cursor == STR('E')))
+            {
+                ++m_cursor;
+                if (m_cursor != m_end && (*m_cursor == STR('+') || *m_cursor == STR('-')))
+                {
+                    ++m_cursor;
+                }
+                skip_digits();
+            }
+
+            // The grammar above only lets ASCII through, so the characters can be narrowed for std::from_chars
+            m_number_buffer.assign(start, m_cursor);
+            double value{};
+            auto [end_of_number, error] = std::from_chars(m_number_buffer.data(), m_number_buffer.data() + m_number_buffer.size(), value);
+            if (error == std::errc::result_out_of_range)
+            {
+                // Numbers that are too large become infinity and numbers that are too small become zero, the same as in most parsers
+                value = std::strtod(m_number_buffer.c_str(), nullptr);
+            }
+
+            return m_handler.on_number(value, File::StringViewType{start, static_cast<size_t>(m_cursor - start)});
+        }
+
+        auto read_hex_code_unit() -> uint32_t
+        {
+            if (m_end - m_cursor < 4)
+            {
+                fail("Expected four hexadecimal digits after '\\u'");
+            }
+
+            uint32_t code_unit{};
+            for (int i = 0; i < 4; ++i, ++m_cursor)
+            {
+                const auto c = *m_cursor;
+                code_unit <<= 4;
+                if (c >= STR('0') && c <= STR('9'))
+                {
+                    code_unit |= static_cast<uint32_t>(c - STR('0'));
+                }
+                else if (c >= STR('a') && c <= STR('f'))
+                {
+                    code_unit |= static_cast<uint32_t>(c - STR('a') + 10);
+                }
+                else if (c >= STR('A') && c <= STR('F'))
+                {
+                    code_unit |= static_cast<uint32_t>(c - STR('A') + 10);
+                }
+                else
+                {
+                    fail("Expected four hexadecimal digits after '\\u'");
+                }
+            }
+            return code_unit;
+        }
+
+        auto append_code_point(uint32_t code_point) -> void
+        {
+            if constexpr (sizeof(File::CharType) == 2)
+            {
+                if (code_point > 0xFFFF)
+                {
+                    code_point -= 0x10000;
+                    m_string_buffer.push_back(static_cast<File::CharType>(0xD800 + (code_point >> 10)));
+                    m_string_buffer.push_back(static_cast<File::CharType>(0xDC00 + (code_point & 0x3FF)));
+                    return;
+                }
+            }
+            m_string_buffer.push_back(static_cast<File::CharType>(code_point));
+        }
+
+        auto read_escape_sequence() -> void
+        {
+            // Skip the backslash
+            ++m_cursor;
+            if (m_cursor == m_end)
+            {
+                fail("Unterminated string");
+            }
+
+            switch (*m_cursor++)
+            {
+            case STR('"'):
+                m_string_buffer.push_back(STR('"'));
+                break;
+            case STR('\\'):
+                m_string_buffer.push_back(STR('\\'));
+                break;
+            case STR('/'):
+                m_string_buffer.push_back(STR('/'));
+                break;
+            case STR('b'):
+                m_string_buffer.push_back(STR('\b'));
+                break;
+            case STR('f'):
+                m_string_buffer.push_back(STR('\f'));
+                break;
+            case STR('n'):
+                m_string_buffer.push_back(STR('\n'));
+                break;
+            case STR('r'):
+                m_string_buffer.push_back(STR('\r'));
+                break;
+            case STR('t'):
+                m_string_buffer.push_back(STR('\t'));
+                break;
+            case STR('u'): {
+                auto code_point = read_hex_code_unit();
+                // A surrogate pair is written as two escape sequences, an unpaired surrogate is kept as it is
+                if (code_point >= 0xD800 && code_point <= 0xDBFF && m_end - m_cursor >= 6 && m_cursor[0] == STR('\\') && m_cursor[1] == STR('u'))
+                {
+                    const auto before_low_surrogate = m_cursor;
+                    m_cursor += 2;
+                    const auto low_surrogate = read_hex_code_unit();
+                    if (low_surrogate >= 0xDC00 && low_surrogate <= 0xDFFF)
+                    {
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low_surrogate - 0xDC00);
+                    }
+                    else
+                    {
+                        m_cursor = before_low_surrogate;
+                    }
+                }
+                append_code_point(code_point);
+                break;
+            }
+            default:
+                --m_cursor;
+                fail("Invalid escape sequence");
+            }
+        }
+
+        // Returns a view that's valid until the next string is read
+        auto read_string() -> File::StringViewType
+        {
+            // Skip the opening quote
+            ++m_cursor;
+            const auto start = m_cursor;
+
+            auto is_plain_character = [](File::CharType c) {
+                return c != STR('"') && c != STR('\\') && static_cast<UnsignedCharType>(c) >= 0x20;
+            };
+
+            while (m_cursor != m_end && is_plain_character(*m_cursor))
+            {
+                ++m_cursor;
+            }
+            if (m_cursor != m_end && *m_cursor == STR('"'))
+            {
+                return File::StringViewType{start, static_cast<size_t>(m_cursor++ - start)};
+            }
+
+            m_string_buffer.assign(start, m_cursor);
+            while (true)
+            {
+                if (m_cursor == m_end)
+                {
+                    fail("Unterminated string");
+                }
+
+                const auto c = *m_cursor;
+                if (c == STR('"'))
+                {
+                    ++m_cursor;
+                    return m_string_buffer;
+                }
+                if (c == STR('\\'))
+                {
+                    read_escape_sequence();
+                }
+                else if (static_cast<UnsignedCharType>(c) < 0x20)
+                {
+                    fail("Control characters must be escaped in strings");
+                }
+                else
+                {
+                    m_string_buffer.push_back(c);
+                    ++m_cursor;
+                }
+            }
+        }
+    };
+
+    // Builds the values of a JSONDocument in its arena
+    // Values are collected on a stack until their array or object ends, they're then copied into the arena as one contiguous block
+    class JSONDocumentBuilder
+    {
+      private:
+        std::pmr::memory_resource& m_arena;
+        // The key is empty for values that aren't object members
+        std::vector<JSONMember> m_stack{};
+        // Index into 'm_stack' of the first child of each array or object that hasn't ended yet
+        std::vector<size_t> m_first_child_indices{};
+        File::StringViewType m_key{};
+
+      public:
+        explicit JSONDocumentBuilder(std::pmr::memory_resource& arena) : m_arena(arena)
+        {
+        }
+
+      public:
+        auto get_root() const -> const JSONValue&
+        {
+            return m_stack.front().value;
+        }
+
+        auto on_object_start() -> bool
+        {
+            return start_container(JSONValue::Type::Object);
+        }
+        auto on_object_end() -> bool
+        {
+            const auto first_child_index = end_container();
+            auto members = static_cast<JSONMember*>(m_arena.allocate(sizeof(JSONMember) * (m_stack.size() - first_child_index), alignof(JSONMember)));
+            auto& object = m_stack[first_child_index - 1].value;
+            object.m_members = members;
+            object.m_size = get_container_size(first_child_index);
+            std::uninitialized_copy(m_stack.begin() + first_child_index, m_stack.end(), members);
+            m_stack.resize(first_child_index);
+            return true;
+        }
+        auto on_array_start() -> bool
+        {
+            return start_container(JSONValue::Type::Array);
+        }
+        auto on_array_end() -> bool
+        {
+            const auto first_child_index = end_container();
+            auto items = static_cast<JSONValue*>(m_arena.allocate(sizeof(JSONValue) * (m_stack.size() - first_child_index), alignof(JSONValue)));
+            auto& array = m_stack[first_child_index - 1].value;
+            array.m_items = items;
+            array.m_size = get_container_size(first_child_index);
+            for (size_t i = first_child_index; i < m_stack.size(); ++i)
+            {
+                std::construct_at(items++, m_stack[i].value);
+            }
+            m_stack.resize(first_child_index);
+            return true;
+        }
+        auto on_key(File::StringViewType key) -> bool
+        {
+            m_key = copy_string(key);
+            return true;
+        }
+        auto on_string(File::StringViewType string) -> bool
+        {
+            const auto copy = copy_string(string);
+            auto& value = add_value(JSONValue::Type::String);
+            value.m_string = copy.data();
+            value.m_size = static_cast<uint32_t>(copy.size());
+            return true;
+        }
+        auto on_number(double number, File::StringViewType) -> bool
+        {
+            add_value(JSONValue::Type::Number).m_number = number;
+            return true;
+        }
+        auto on_bool(bool boolean) -> bool
+        {
+            add_value(JSONValue::Type::Bool).m_bool = boolean;
+            return true;
+        }
+        auto on_null() -> bool
+        {
+            add_value(JSONValue::Type::Null);
+            return true;
+        }
+
+      private:
+        auto copy_string(File::StringViewType string) -> File::StringViewType
+        {
+            if (string.size() > UINT32_MAX)
+            {
+                throw std::runtime_error{"[JSONDocument::parse] String is too long"};
+            }
+            if (string.empty())
+            {
+                return {};
+            }
+            auto copy = static_cast<File::CharType*>(m_arena.allocate(sizeof(File::CharType) * string.size(), alignof(File::CharType)));
+            std::char_traits<File::CharType>::copy(copy, string.data(), string.size());
+            return File::StringViewType{copy, string.size()};
+        }
+
+        auto add_value(JSONValue::Type type) -> JSONValue&
+        {
+            auto& member = m_stack.emplace_back(JSONMember{m_key, JSONValue{}});
+            member.value.m_type = type;
+            m_key = {};
+            return member.value;
+        }
+
+        auto start_container(JSONValue::Type type) -> bool
+        {
+            add_value(type);
+            m_first_child_indices.emplace_back(m_stack.size());
+            return true;
+        }
+
+        auto end_container() -> size_t
+        {
+            const auto first_child_index = m_first_child_indices.back();
+            m_first_child_indices.pop_back();
+            return first_child_index;
+        }
+
+        auto get_container_size(size_t first_child_index) const -> uint32_t
+        {
+            if (m_stack.size() - first_child_index > UINT32_MAX)
+            {
+                throw std::runtime_error{"[JSONDocument::parse] Array or object has too many values"};
+            }
+            return static_cast<uint32_t>(m_stack.size() - first_child_index);
+        }
+    };
+
+    auto parse_json(File::StringViewType input, JSONHandler& handler) -> bool
+    {
+        JSONReader<JSONHandler> reader{input, handler};
+        return reader.read();
+    }
+
+    auto JSONValue::get_bool() const -> bool
+    {
+        if (m_type != Type::Bool)
+        {
+            throw std::runtime_error{"[JSONValue::get_bool] Value isn't a bool"};
+        }
+        return m_bool;
+    }
+
+    auto JSONValue::get_number() const -> double
+    {
+        if (m_type != Type::Number)
+        {
+            throw std::runtime_error{"[JSONValue::get_number] Value isn't a number"};
+        }
+        return m_number;
+    }
+
+    auto JSONValue::get_string() const -> File::StringViewType
+    {
+        if (m_type != Type::String)
+        {
+            throw std::runtime_error{"[JSONValue::get_string] Value isn't a string"};
+        }
+        return File::StringViewType{m_string, m_size};
+    }
+
+    auto JSONValue::get_items() const -> std::span<const JSONValue>
+    {
+        if (m_type != Type::Array)
+        {
+            throw std::runtime_error{"[JSONValue::get_items] Value isn't an array"};
+        }
+        return std::span<const JSONValue>{m_items, m_size};
+    }
+
+    auto JSONValue::get_members() const -> std::span<const JSONMember>
+    {
+        if (m_type != Type::Object)
+        {
+            throw std::runtime_error{"[JSONValue::get_members] Value isn't an object"};
+        }
+        return std::span<const JSONMember>{m_members, m_size};
+    }
+
+    auto JSONValue::find(File::StringViewType key) const -> const JSONValue*
+    {
+        if (m_type != Type::Object)
+        {
+            return nullptr;
+        }
+
+        for (const auto& member : get_members())
+        {
+            if (member.key == key)
+            {
+                return &member.value;
+            }
+        }
+        return nullptr;
+    }
+
+    auto JSONDocument::parse(File::StringViewType input) -> void
+    {
+        // Most of the arena is used by values and strings, which together take up around as much memory as the input
+        auto arena = std::make_unique<std::pmr::monotonic_buffer_resource>(std::max<size_t>(input.size() * sizeof(File::CharType), 4096));
+
+        JSONDocumentBuilder builder{*arena};
+        JSONReader<JSONDocumentBuilder> reader{input, builder};
+        reader.read();
+
+        m_root = builder.get_root();
+        m_arena = std::move(arena);
+    }
+
+    auto JSONDocument::get_root() const -> const JSONValue&
+    {
+        return m_root;
+    }
+} // namespace RC::Parser
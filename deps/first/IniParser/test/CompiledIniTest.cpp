@@ -0,0 +1,285 @@
+// Tests for the compiled form of the layout INI files, and for falling back to parsing whenever the cached file can't be used
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <IniParser/CompiledIni.hpp>
+#include <IniParser/Ini.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+
+// Offsets into the header, see CompiledIni::compile
+static constexpr size_t s_version_offset = 8;
+static constexpr size_t s_char_size_offset = 12;
+
+// Shaped like MemberVariableLayout.ini and VTableLayout.ini, which are what the compiled files are used for
+static const File::StringType s_source = STR(R"([UObjectBase]
+ClassPrivate = 0x10
+NamePrivate = 24
+OuterPrivate = -8
+Comment = not a number
+
+[UField]
+Next = 0x28
+
+[UObjectBaseUtility]
+CanBeClusterRoot
+CanBeInCluster
+CreateCluster
+
+[UScriptStruct::ICppStructOps]
+Destruct
+HasZeroConstructor
+)");
+
+// Same as above with one offset changed
+static const File::StringType s_edited_source = STR(R"([UObjectBase]
+ClassPrivate = 0x18
+NamePrivate = 24
+OuterPrivate = -8
+Comment = not a number
+
+[UField]
+Next = 0x28
+
+[UObjectBaseUtility]
+CanBeClusterRoot
+CanBeInCluster
+CreateCluster
+
+[UScriptStruct::ICppStructOps]
+Destruct
+HasZeroConstructor
+)");
+
+// Checks the values that the tests look at against what the parser reads from the same source
+static auto has_values_of(const Ini::CompiledIni& compiled_ini, const File::StringType& source) -> bool
+{
+    auto source_copy = source;
+    Ini::Parser parser{};
+    parser.parse(source_copy);
+
+    const auto& sections = parser.get_sections();
+    if (compiled_ini.get_num_sections() != sections.size())
+    {
+        return false;
+    }
+    for (const auto& [section_name, section] : sections)
+    {
+        for (const auto& [key, value] : section.key_value_pairs)
+        {
+            if (value.get_ref()->is_valid_int64() && compiled_ini.get_int64(section_name, key, -1) != value.get_ref()->get_int64_value())
+            {
+                return false;
+            }
+        }
+        const auto ordered_list = compiled_ini.get_ordered_list(section_name);
+        if (!std::equal(ordered_list.begin(), ordered_list.end(), section.ordered_list.begin(), section.ordered_list.end()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static auto compile(const File::StringType& source) -> std::vector<uint8_t>
+{
+    auto source_copy = source;
+    Ini::Parser parser{};
+    parser.parse(source_copy);
+    return Ini::CompiledIni::compile(parser.get_sections(), Ini::CompiledIni::hash_source(source));
+}
+
+static auto read_file(const std::filesystem::path& path) -> std::vector<uint8_t>
+{
+    std::ifstream file{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+static auto test_values() -> void
+{
+    const auto data = compile(s_source);
+    Ini::CompiledIni compiled_ini{};
+    CHECK(compiled_ini.load(data, Ini::CompiledIni::hash_source(s_source)));
+    CHECK(has_values_of(compiled_ini, s_source));
+
+    CHECK(compiled_ini.get_int64(STR("UObjectBase"), STR("ClassPrivate"), -1) == 0x10);
+    CHECK(compiled_ini.get_int64(STR("UObjectBase"), STR("NamePrivate"), -1) == 24);
+    CHECK(compiled_ini.get_int64(STR("UObjectBase"), STR("OuterPrivate"), 0) == -8);
+    CHECK(compiled_ini.get_int64(STR("UObjectBase"), STR("Comment"), -1) == -1);
+    CHECK(compiled_ini.get_int64(STR("UObjectBase"), STR("Missing"), -1) == -1);
+    CHECK(compiled_ini.get_int64(STR("Missing"), STR("ClassPrivate"), -1) == -1);
+    CHECK(compiled_ini.get_int64(STR("UField"), STR("Next"), -1) == 0x28);
+
+    const auto ordered_list = compiled_ini.get_ordered_list(STR("UObjectBaseUtility"));
+    CHECK(ordered_list.size() == 3);
+    CHECK(ordered_list.size() == 3 && ordered_list[0] == STR("CanBeClusterRoot") && ordered_list[2] == STR("CreateCluster"));
+    CHECK(compiled_ini.get_ordered_list(STR("Missing")).empty());
+    CHECK(compiled_ini.get_num_int64_values() == 4);
+    CHECK(compiled_ini.get_num_ordered_list_items() == 5);
+
+    // A memory map is rounded up to whole pages, the bytes after the file must be ignored
+    auto padded_data = data;
+    padded_data.resize(data.size() + 0x1000 - data.size() % 0x1000, 0xCC);
+    CHECK(compiled_ini.load(padded_data, Ini::CompiledIni::hash_source(s_source)));
+    CHECK(has_values_of(compiled_ini, s_source));
+}
+
+static auto test_cache_round_trip(const std::filesystem::path& directory) -> void
+{
+    const auto cache_file = directory / "cache" / "MemberVariableLayout.bin";
+    auto source = s_source;
+
+    // No cache yet, the source is parsed and the result is meant to be written
+    Ini::CompiledIni first_start{};
+    CHECK(!first_start.load_or_compile({}, source));
+    CHECK(has_values_of(first_start, s_source));
+    CHECK(!first_start.get_owned_data().empty());
+    CHECK(Ini::CompiledIni::write_file(cache_file, first_start.get_owned_data()));
+    CHECK(!std::filesystem::exists(std::filesystem::path{cache_file} += ".tmp"));
+
+    // The next start uses the cache and owns nothing
+    const auto cached_data = read_file(cache_file);
+    Ini::CompiledIni second_start{};
+    CHECK(second_start.load_or_compile(cached_data, source));
+    CHECK(has_values_of(second_start, s_source));
+    CHECK(second_start.get_owned_data().empty());
+
+    // The object can be moved, the views keep pointing into the same data
+    Ini::CompiledIni moved{std::move(first_start)};
+    CHECK(has_values_of(moved, s_source));
+}
+
+static auto test_invalidation(const std::filesystem::path& directory) -> void
+{
+    const auto cache_file = directory / "cache" / "VTableLayout.bin";
+    auto source = s_source;
+    Ini::CompiledIni compiled_ini{};
+    CHECK(!compiled_ini.load_or_compile({}, source));
+    CHECK(Ini::CompiledIni::write_file(cache_file, compiled_ini.get_owned_data()));
+
+    // The INI file was edited since the cache was written, the cache must not be used
+    auto edited_source = s_edited_source;
+    const auto stale_data = read_file(cache_file);
+    Ini::CompiledIni after_edit{};
+    CHECK(!after_edit.load_or_compile(stale_data, edited_source));
+    CHECK(has_values_of(after_edit, s_edited_source));
+    CHECK(after_edit.get_int64(STR("UObjectBase"), STR("ClassPrivate"), -1) == 0x18);
+
+    // Writing the recompiled data replaces the stale cache, which is then used
+    CHECK(Ini::CompiledIni::write_file(cache_file, after_edit.get_owned_data()));
+    const auto updated_data = read_file(cache_file);
+    Ini::CompiledIni after_update{};
+    CHECK(after_update.load_or_compile(updated_data, edited_source));
+    CHECK(after_update.get_int64(STR("UObjectBase"), STR("ClassPrivate"), -1) == 0x18);
+
+    // Even a change that doesn't change any value makes it compile again, only the exact same text is trusted
+    auto whitespace_source = s_edited_source + STR("\n");
+    CHECK(!after_update.load_or_compile(updated_data, whitespace_source));
+    CHECK(has_values_of(after_update, s_edited_source));
+}
+
+static auto test_header_mismatch() -> void
+{
+    const auto data = compile(s_source);
+    auto source = s_source;
+
+    auto other_version = data;
+    other_version[s_version_offset] = static_cast<uint8_t>(Ini::CompiledIni::file_version + 1);
+    Ini::CompiledIni compiled_ini{};
+    CHECK(!compiled_ini.load(other_version, Ini::CompiledIni::hash_source(s_source)));
+    CHECK(compiled_ini.get_num_sections() == 0);
+    CHECK(!compiled_ini.load_or_compile(other_version, source));
+    CHECK(has_values_of(compiled_ini, s_source));
+
+    // Written by a build with a different character type, its strings can't be read by this one
+    auto other_char_size = data;
+    other_char_size[s_char_size_offset] = sizeof(File::CharType) == 2 ? 4 : 2;
+    CHECK(!compiled_ini.load(other_char_size, Ini::CompiledIni::hash_source(s_source)));
+    CHECK(!compiled_ini.load_or_compile(other_char_size, source));
+    CHECK(has_values_of(compiled_ini, s_source));
+}
+
+static auto test_truncated() -> void
+{
+    const auto data = compile(s_source);
+    auto source = s_source;
+    const auto source_hash = Ini::CompiledIni::hash_source(s_source);
+
+    // Every prefix is rejected, and a failed load leaves nothing from an earlier load behind
+    Ini::CompiledIni compiled_ini{};
+    for (size_t size = 0; size < data.size(); ++size)
+    {
+        CHECK(compiled_ini.load(data, source_hash));
+        CHECK(!compiled_ini.load({data.data(), size}, source_hash));
+        CHECK(compiled_ini.get_num_sections() == 0);
+        CHECK(compiled_ini.get_int64(STR("UField"), STR("Next"), -1) == -1);
+    }
+
+    // A truncated cache falls back to parsing
+    for (size_t size = 0; size < data.size(); size += 7)
+    {
+        CHECK(!compiled_ini.load_or_compile({data.data(), size}, source));
+        CHECK(has_values_of(compiled_ini, s_source));
+    }
+}
+
+static auto test_corrupted() -> void
+{
+    const auto data = compile(s_source);
+    auto source = s_source;
+    const auto source_hash = Ini::CompiledIni::hash_source(s_source);
+
+    Ini::CompiledIni compiled_ini{};
+    for (size_t offset = 0; offset < data.size(); ++offset)
+    {
+        auto corrupted = data;
+        corrupted[offset] ^= 0x01;
+        CHECK(!compiled_ini.load(corrupted, source_hash));
+        CHECK(!compiled_ini.load_or_compile(corrupted, source));
+        CHECK(has_values_of(compiled_ini, s_source));
+    }
+}
+
+static auto test_invalid_source() -> void
+{
+    // A source that isn't valid throws like the parser does, whether or not there's a cache
+    File::StringType source = STR("[Unterminated\nKey = 1\n");
+    bool has_thrown{};
+    try
+    {
+        Ini::CompiledIni compiled_ini{};
+        compiled_ini.load_or_compile({}, source);
+    }
+    catch (std::exception&)
+    {
+        has_thrown = true;
+    }
+    CHECK(has_thrown);
+}
+
+auto main() -> int
+{
+    const auto directory =
+            std::filesystem::temp_directory_path() / ("CompiledIniTest-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(directory);
+
+    test_values();
+    test_cache_round_trip(directory);
+    test_invalidation(directory);
+    test_header_mismatch();
+    test_truncated();
+    test_corrupted();
+    test_invalid_source();
+
+    std::error_code ec{};
+    std::filesystem::remove_all(directory, ec);
+
+    return Test::report_results();
+}
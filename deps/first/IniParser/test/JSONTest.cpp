@@ -0,0 +1,588 @@
+// Conformance tests for the JSON reader, run through all three ways of reading a document: 'parse_json', JSONDocument and the JSON item tree
+// The mods.json fixtures must give the same contents through every one of them, and the same mods as mods.txt
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <IniParser/JSON.hpp>
+#include <IniParser/JSONDocument.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+using namespace RC::Parser;
+
+// One step through a document, the three readers are compared by the list of steps that they produce
+struct Event
+{
+    enum class Kind
+    {
+        ObjectStart,
+        ObjectEnd,
+        ArrayStart,
+        ArrayEnd,
+        Key,
+        String,
+        Number,
+        Bool,
+        Null,
+    };
+
+    Kind kind{};
+    File::StringType text{};
+    double number{};
+
+    auto operator==(const Event&) const -> bool = default;
+};
+
+using Events = std::vector<Event>;
+
+class EventRecorder : public JSONHandler
+{
+  public:
+    Events m_events{};
+    // The text of every number as it was written in the input
+    std::vector<File::StringType> m_number_texts{};
+
+  public:
+    auto on_object_start() -> bool override
+    {
+        m_events.emplace_back(Event{Event::Kind::ObjectStart});
+        return true;
+    }
+    auto on_object_end() -> bool override
+    {
+        m_events.emplace_back(Event{Event::Kind::ObjectEnd});
+        return true;
+    }
+    auto on_array_start() -> bool override
+    {
+        m_events.emplace_back(Event{Event::Kind::ArrayStart});
+        return true;
+    }
+    auto on_array_end() -> bool override
+    {
+        m_events.emplace_back(Event{Event::Kind::ArrayEnd});
+        return true;
+    }
+    auto on_key(File::StringViewType key) -> bool override
+    {
+        m_events.emplace_back(Event{Event::Kind::Key, File::StringType{key}});
+        return true;
+    }
+    auto on_string(File::StringViewType value) -> bool override
+    {
+        m_events.emplace_back(Event{Event::Kind::String, File::StringType{value}});
+        return true;
+    }
+    auto on_number(double value, File::StringViewType text) -> bool override
+    {
+        m_events.emplace_back(Event{Event::Kind::Number, {}, value});
+        m_number_texts.emplace_back(text);
+        return true;
+    }
+    auto on_bool(bool value) -> bool override
+    {
+        m_events.emplace_back(Event{Event::Kind::Bool, {}, value ? 1.0 : 0.0});
+        return true;
+    }
+    auto on_null() -> bool override
+    {
+        m_events.emplace_back(Event{Event::Kind::Null});
+        return true;
+    }
+};
+
+static auto record_value(const JSONValue& value, Events& events) -> void
+{
+    switch (value.get_type())
+    {
+    case JSONValue::Type::Null:
+        events.emplace_back(Event{Event::Kind::Null});
+        break;
+    case JSONValue::Type::Bool:
+        events.emplace_back(Event{Event::Kind::Bool, {}, value.get_bool() ? 1.0 : 0.0});
+        break;
+    case JSONValue::Type::Number:
+        events.emplace_back(Event{Event::Kind::Number, {}, value.get_number()});
+        break;
+    case JSONValue::Type::String:
+        events.emplace_back(Event{Event::Kind::String, File::StringType{value.get_string()}});
+        break;
+    case JSONValue::Type::Array:
+        events.emplace_back(Event{Event::Kind::ArrayStart});
+        for (const auto& item : value.get_items())
+        {
+            record_value(item, events);
+        }
+        events.emplace_back(Event{Event::Kind::ArrayEnd});
+        break;
+    case JSONValue::Type::Object:
+        events.emplace_back(Event{Event::Kind::ObjectStart});
+        for (const auto& member : value.get_members())
+        {
+            events.emplace_back(Event{Event::Kind::Key, File::StringType{member.key}});
+            record_value(member.value, events);
+        }
+        events.emplace_back(Event{Event::Kind::ObjectEnd});
+        break;
+    }
+}
+
+static auto record_item(JSONInternal::ItemBase& item, Events& events) -> void
+{
+    switch (item.get_type())
+    {
+    case JSONInternal::ItemType::Null:
+        events.emplace_back(Event{Event::Kind::Null});
+        break;
+    case JSONInternal::ItemType::Bool:
+        events.emplace_back(Event{Event::Kind::Bool, {}, static_cast<JSONInternal::BoolItem&>(item).m_value ? 1.0 : 0.0});
+        break;
+    case JSONInternal::ItemType::Number:
+        events.emplace_back(Event{Event::Kind::Number, {}, static_cast<JSONInternal::NumberItem&>(item).m_value});
+        break;
+    case JSONInternal::ItemType::String:
+        events.emplace_back(Event{Event::Kind::String, static_cast<JSONInternal::StringItem&>(item).m_value});
+        break;
+    case JSONInternal::ItemType::Array:
+        events.emplace_back(Event{Event::Kind::ArrayStart});
+        for (const auto& member : static_cast<JSONInternal::ArrayScope&>(item).m_members)
+        {
+            record_item(*member, events);
+        }
+        events.emplace_back(Event{Event::Kind::ArrayEnd});
+        break;
+    case JSONInternal::ItemType::Object:
+        events.emplace_back(Event{Event::Kind::ObjectStart});
+        for (const auto& member : static_cast<JSONInternal::ObjectScope&>(item).m_members)
+        {
+            events.emplace_back(Event{Event::Kind::Key, member->m_name});
+            record_item(*member, events);
+        }
+        events.emplace_back(Event{Event::Kind::ObjectEnd});
+        break;
+    case JSONInternal::ItemType::None:
+        break;
+    }
+}
+
+// Reads the input with every reader, checks that they agree and returns what 'parse_json' produced
+static auto read_all_ways(File::StringViewType input) -> EventRecorder
+{
+    EventRecorder recorder{};
+    CHECK(parse_json(input, recorder));
+
+    JSONDocument document{};
+    document.parse(input);
+    Events document_events{};
+    record_value(document.get_root(), document_events);
+    CHECK(document_events == recorder.m_events);
+
+    JSON tree{};
+    File::StringType tree_input{input};
+    tree.parse(tree_input);
+    auto items = tree.release_contents();
+    CHECK(items.size() == 1 && items[0]->m_is_global_scope);
+    Events tree_events{};
+    for (const auto& item : items)
+    {
+        record_item(*item, tree_events);
+    }
+    CHECK(tree_events == recorder.m_events);
+
+    return recorder;
+}
+
+static auto is_accepted(File::StringViewType input) -> bool
+{
+    try
+    {
+        read_all_ways(input);
+        return true;
+    }
+    catch (const std::runtime_error&)
+    {
+        return false;
+    }
+}
+
+// Every reader has to reject the input, not only the first one that's tried
+static auto is_rejected(File::StringViewType input) -> bool
+{
+    auto throws = [](const std::function<void()>& parse) {
+        try
+        {
+            parse();
+            return false;
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+    };
+
+    EventRecorder recorder{};
+    JSONDocument document{};
+    JSON tree{};
+    File::StringType tree_input{input};
+    return throws([&] {
+               parse_json(input, recorder);
+           }) &&
+           throws([&] {
+               document.parse(input);
+           }) &&
+           throws([&] {
+               tree.parse(tree_input);
+           });
+}
+
+static auto get_error_message(File::StringViewType input) -> std::string
+{
+    try
+    {
+        JSONDocument{}.parse(input);
+    }
+    catch (const std::runtime_error& error)
+    {
+        return error.what();
+    }
+    return {};
+}
+
+// The only string in the document, which is expected to be a single string
+static auto read_string(File::StringViewType input) -> File::StringType
+{
+    JSONDocument document{};
+    document.parse(input);
+    const auto string = File::StringType{document.get_root().get_string()};
+    CHECK(read_all_ways(input).m_events == Events{Event{Event::Kind::String, string}});
+    return string;
+}
+
+static auto read_number(File::StringViewType input) -> double
+{
+    const auto recorder = read_all_ways(input);
+    CHECK(recorder.m_events.size() == 1 && recorder.m_events[0].kind == Event::Kind::Number);
+    CHECK(recorder.m_number_texts.size() == 1 && recorder.m_number_texts[0] == input);
+    return recorder.m_events.empty() ? 0.0 : recorder.m_events[0].number;
+}
+
+// The string that a code point outside of the BMP is stored as, which depends on the size of the character type
+static auto make_string(std::initializer_list<char32_t> code_points) -> File::StringType
+{
+    File::StringType string{};
+    for (auto code_point : code_points)
+    {
+        if (sizeof(File::CharType) == 2 && code_point > 0xFFFF)
+        {
+            string.push_back(static_cast<File::CharType>(0xD800 + ((code_point - 0x10000) >> 10)));
+            string.push_back(static_cast<File::CharType>(0xDC00 + ((code_point - 0x10000) & 0x3FF)));
+        }
+        else
+        {
+            string.push_back(static_cast<File::CharType>(code_point));
+        }
+    }
+    return string;
+}
+
+static auto test_escapes() -> void
+{
+    CHECK(read_string(STR(R"("plain")")) == STR("plain"));
+    CHECK(read_string(STR(R"("")")) == STR(""));
+    CHECK(read_string(STR(R"("\"\\\/\b\f\n\r\t")")) == STR("\"\\/\b\f\n\r\t"));
+    CHECK(read_string(STR(R"("a\u0041\u00e9\u00E9z")")) == STR("aA\u00e9\u00e9z"));
+    CHECK(read_string(STR(R"("\u0000")")) == File::StringType(1, STR('\0')));
+    CHECK(read_string(STR(R"("Mods\\BPModLoaderMod\\Scripts")")) == STR("Mods\\BPModLoaderMod\\Scripts"));
+
+    // A string that starts out without escapes and then has one, which moves it from a view of the input to the buffer
+    CHECK(read_string(STR(R"("before \n after")")) == STR("before \n after"));
+
+    CHECK(is_rejected(STR(R"("\x")")));
+    CHECK(is_rejected(STR(R"("\u12")")));
+    CHECK(is_rejected(STR(R"("\u12G4")")));
+    CHECK(is_rejected(STR(R"("\U0041")")));
+    CHECK(is_rejected(STR(R"("\)")));
+    CHECK(is_rejected(STR("\"tab\tinside\"")));
+    CHECK(is_rejected(STR("\"line\nbreak\"")));
+    CHECK(is_rejected(STR(R"("unterminated)")));
+    CHECK(is_rejected(STR(R"('single quotes')")));
+}
+
+static auto test_surrogate_pairs() -> void
+{
+    CHECK(read_string(STR(R"("\ud83d\ude00")")) == make_string({0x1F600}));
+    CHECK(read_string(STR(R"("\uD834\uDD1E!")")) == make_string({0x1D11E, U'!'}));
+    CHECK(read_string(STR(R"("\udbff\udfff")")) == make_string({0x10FFFF}));
+
+    // Unpaired surrogates are kept as they are instead of failing the whole document
+    CHECK(read_string(STR(R"("\ud83d")")) == make_string({0xD83D}));
+    CHECK(read_string(STR(R"("\ud83dA")")) == make_string({0xD83D, U'A'}));
+    CHECK(read_string(STR(R"("\ud83d\u0041")")) == make_string({0xD83D, U'A'}));
+    CHECK(read_string(STR(R"("\ude00\ud83d")")) == make_string({0xDE00, 0xD83D}));
+
+    // A high surrogate followed by a broken escape is still an error
+    CHECK(is_rejected(STR(R"("\ud83d\u12")")));
+
+    // Characters outside of the BMP that aren't escaped are passed through
+    const auto raw = STR("\"") + make_string({0x1F600}) + STR("\"");
+    CHECK(read_string(raw) == make_string({0x1F600}));
+}
+
+static auto test_numbers() -> void
+{
+    CHECK(read_number(STR("0")) == 0.0);
+    CHECK(read_number(STR("-0")) == 0.0 && std::signbit(read_number(STR("-0"))));
+    CHECK(read_number(STR("42")) == 42.0);
+    CHECK(read_number(STR("-17")) == -17.0);
+    CHECK(read_number(STR("3.25")) == 3.25);
+    CHECK(read_number(STR("-1.5E+3")) == -1500.0);
+    CHECK(read_number(STR("2e-2")) == 0.02);
+    CHECK(read_number(STR("0.5e1")) == 5.0);
+    CHECK(read_number(STR("123.456e-7")) == 123.456e-7);
+
+    // The value is the nearest double, the text is kept for callers that need every digit
+    CHECK(read_number(STR("9007199254740993")) == 9007199254740992.0);
+    CHECK(read_number(STR("1e400")) == std::numeric_limits<double>::infinity());
+    CHECK(read_number(STR("-1e400")) == -std::numeric_limits<double>::infinity());
+    CHECK(read_number(STR("1e-400")) == 0.0);
+
+    for (auto invalid : {STR("01"), STR("-01"), STR("+1"), STR(".5"), STR("1."), STR("1e"), STR("1e+"), STR("-"), STR("0x10"), STR("NaN"),
+                         STR("Infinity"), STR("-Infinity"), STR("1.2.3"), STR("- 1"), STR("1 2")})
+    {
+        CHECK(is_rejected(invalid));
+    }
+}
+
+static auto test_literals_and_structure() -> void
+{
+    CHECK((read_all_ways(STR("true")).m_events == Events{Event{Event::Kind::Bool, {}, 1.0}}));
+    CHECK((read_all_ways(STR("false")).m_events == Events{Event{Event::Kind::Bool, {}, 0.0}}));
+    CHECK((read_all_ways(STR("null")).m_events == Events{Event{Event::Kind::Null}}));
+    CHECK((read_all_ways(STR(" \t\r\n[ ] ")).m_events == Events{Event{Event::Kind::ArrayStart}, Event{Event::Kind::ArrayEnd}}));
+    CHECK((read_all_ways(STR("{}")).m_events == Events{Event{Event::Kind::ObjectStart}, Event{Event::Kind::ObjectEnd}}));
+
+    // A byte order mark is skipped, which is what files written as UTF-8 with a signature start with
+    CHECK(is_accepted(STR("\uFEFF{\"a\": 1}")));
+
+    // Duplicate keys are kept, 'find' returns the first
+    JSONDocument document{};
+    document.parse(STR(R"({"a": 1, "b": [true, null], "a": 2})"));
+    CHECK(document.get_root().get_members().size() == 3);
+    CHECK(document.get_root().find(STR("a"))->get_number() == 1.0);
+    CHECK(document.get_root().find(STR("b"))->get_items().size() == 2);
+    CHECK(!document.get_root().find(STR("c")));
+
+    for (auto invalid : {STR(""), STR("   "), STR("tru"), STR("nul"), STR("True"), STR("[1,]"), STR("[,1]"), STR("{\"a\":1,}"), STR("{\"a\" 1}"),
+                         STR("{a:1}"), STR("{1:1}"), STR("[1 2]"), STR("{} x"), STR("[1],"), STR("[]]"), STR("{\"a\":}"), STR("\uFEFF\uFEFF{}")})
+    {
+        CHECK(is_rejected(invalid));
+    }
+
+    // Errors point at where the reader gave up
+    const auto error = get_error_message(STR("{\n  \"a\": x\n}"));
+    CHECK(error.find("(2 : 8)") != std::string::npos);
+
+    // A handler stops the reader by returning false, which isn't an error
+    class StopAtSecondItem : public JSONHandler
+    {
+      public:
+        int m_num_numbers{};
+
+        auto on_number(double, File::StringViewType) -> bool override
+        {
+            return ++m_num_numbers < 2;
+        }
+    };
+    StopAtSecondItem stop_at_second_item{};
+    CHECK(!parse_json(STR("[1, 2, 3]"), stop_at_second_item));
+    CHECK(stop_at_second_item.m_num_numbers == 2);
+}
+
+static auto test_deep_nesting() -> void
+{
+    static constexpr size_t max_depth = 512;
+    auto nested_arrays = [](size_t depth) {
+        return File::StringType(depth, STR('[')) + File::StringType(depth, STR(']'));
+    };
+    auto nested_objects = [](size_t depth) {
+        File::StringType input{};
+        for (size_t i = 0; i < depth; ++i)
+        {
+            input += STR("{\"a\":");
+        }
+        input += STR("0");
+        input += File::StringType(depth, STR('}'));
+        return input;
+    };
+
+    CHECK(is_accepted(nested_arrays(max_depth)));
+    CHECK(is_rejected(nested_arrays(max_depth + 1)));
+    CHECK(is_accepted(nested_objects(max_depth)));
+    CHECK(is_rejected(nested_objects(max_depth + 1)));
+
+    // Far deeper than any stack would survive with one frame per level
+    CHECK(is_rejected(File::StringType(1'000'000, STR('['))));
+}
+
+static auto test_truncated_input() -> void
+{
+    // No prefix of these is a document on its own, so every single one must be rejected
+    for (auto input : {STR(R"({"mod_name": "BPModLoaderMod", "mod_enabled": true})"),
+                       STR(R"([{"a": [1, -2.5e3, "x\u00e9\"y"]}, null, false, {}])"),
+                       STR(R"(["\ud83d\ude00", "\\\"", 0.125])")})
+    {
+        CHECK(is_accepted(input));
+        const File::StringViewType view{input};
+        for (size_t size = 0; size < view.size(); ++size)
+        {
+            if (!is_rejected(view.substr(0, size)))
+            {
+                std::fprintf(stderr, "A prefix of %zu characters was accepted\n", size);
+                Test::fail();
+            }
+        }
+    }
+}
+
+// Decodes UTF-8, which is what mods.json is written in
+static auto decode_utf8(const std::string& bytes) -> File::StringType
+{
+    std::vector<char32_t> code_points{};
+    for (size_t i = 0; i < bytes.size();)
+    {
+        const auto byte = static_cast<unsigned char>(bytes[i]);
+        const size_t length = byte < 0x80 ? 1 : byte < 0xE0 ? 2 : byte < 0xF0 ? 3 : 4;
+        char32_t code_point = length == 1 ? byte : byte & (0x7F >> length);
+        for (size_t j = 1; j < length && i + j < bytes.size(); ++j)
+        {
+            code_point = (code_point << 6) | (static_cast<unsigned char>(bytes[i + j]) & 0x3F);
+        }
+        code_points.emplace_back(code_point);
+        i += length;
+    }
+
+    File::StringType string{};
+    for (auto code_point : code_points)
+    {
+        string += make_string({code_point});
+    }
+    return string;
+}
+
+static auto read_file(const char* path) -> std::string
+{
+    std::ifstream file{path, std::ios::binary};
+    CHECK(file.is_open());
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+struct ModEntry
+{
+    File::StringType name{};
+    bool is_enabled{};
+
+    auto operator==(const ModEntry&) const -> bool = default;
+};
+
+static auto get_mods_from_json(File::StringViewType input) -> std::vector<ModEntry>
+{
+    JSONDocument document{};
+    document.parse(input);
+    std::vector<ModEntry> mods{};
+    for (const auto& mod : document.get_root().get_items())
+    {
+        mods.emplace_back(ModEntry{File::StringType{mod.find(STR("mod_name"))->get_string()}, mod.find(STR("mod_enabled"))->get_bool()});
+    }
+    return mods;
+}
+
+// Lines are 'ModName : 1', comments start with ';'
+static auto get_mods_from_txt(const std::string& input) -> std::vector<ModEntry>
+{
+    std::vector<ModEntry> mods{};
+    size_t line_start{};
+    while (line_start < input.size())
+    {
+        auto line_end = input.find('\n', line_start);
+        line_end = line_end == std::string::npos ? input.size() : line_end;
+        const auto line = input.substr(line_start, line_end - line_start);
+        line_start = line_end + 1;
+
+        const auto separator = line.find(':');
+        if (line.empty() || line[0] == ';' || separator == std::string::npos)
+        {
+            continue;
+        }
+        auto name = line.substr(0, separator);
+        name.erase(name.find_last_not_of(" \t") + 1);
+        const auto value = line.substr(line.find_first_not_of(" \t", separator + 1));
+        mods.emplace_back(ModEntry{decode_utf8(name), value[0] == '1'});
+    }
+    return mods;
+}
+
+static auto test_mods_json_fixtures() -> void
+{
+    const auto mods_json = decode_utf8(read_file(UE4SS_MODS_DIRECTORY "/mods.json"));
+    const auto mods = get_mods_from_json(mods_json);
+    CHECK(!mods.empty());
+    CHECK(mods == get_mods_from_txt(read_file(UE4SS_MODS_DIRECTORY "/mods.txt")));
+    read_all_ways(mods_json);
+
+    // What the release script writes back, Python's json module escapes everything that isn't ASCII and the file has a byte order mark
+    const auto rewritten_mods_json = STR("\uFEFF[\n    {\n        \"mod_name\": \"CheatManagerEnablerMod\",\n        \"mod_enabled\": true\n    },\n"
+                                         "    {\n        \"mod_name\": \"Caf\\u00e9Mod \\ud83d\\ude00\",\n        \"mod_enabled\": false\n    }\n]");
+    CHECK((get_mods_from_json(rewritten_mods_json) ==
+           std::vector<ModEntry>{{STR("CheatManagerEnablerMod"), true}, {STR("Caf\u00e9Mod ") + make_string({0x1F600}), false}}));
+    read_all_ways(rewritten_mods_json);
+
+    // Edited on Windows and compacted by hand, neither changes the contents
+    File::StringType crlf_mods_json{};
+    for (auto c : mods_json)
+    {
+        if (c == STR('\n'))
+        {
+            crlf_mods_json += STR('\r');
+        }
+        crlf_mods_json += c;
+    }
+    File::StringType compact_mods_json{};
+    bool is_in_string{};
+    for (size_t i = 0; i < mods_json.size(); ++i)
+    {
+        const auto c = mods_json[i];
+        is_in_string ^= c == STR('"') && (i == 0 || mods_json[i - 1] != STR('\\'));
+        if (is_in_string || (c != STR(' ') && c != STR('\n') && c != STR('\r') && c != STR('\t')))
+        {
+            compact_mods_json += c;
+        }
+    }
+    CHECK(read_all_ways(crlf_mods_json).m_events == read_all_ways(mods_json).m_events);
+    CHECK(read_all_ways(compact_mods_json).m_events == read_all_ways(mods_json).m_events);
+    CHECK(get_mods_from_json(crlf_mods_json) == mods);
+
+    // A mods.json that was cut off while it was being written must not be half-read
+    CHECK(is_rejected(File::StringViewType{mods_json}.substr(0, mods_json.size() / 2)));
+    CHECK(is_rejected(File::StringViewType{mods_json}.substr(0, mods_json.find_last_of(STR(']')))));
+}
+
+auto main() -> int
+{
+    test_escapes();
+    test_surrogate_pairs();
+    test_numbers();
+    test_literals_and_structure();
+    test_deep_nesting();
+    test_truncated_input();
+    test_mods_json_fixtures();
+
+    return Test::report_results();
+}
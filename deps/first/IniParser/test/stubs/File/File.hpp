@@ -0,0 +1,18 @@
+#pragma once
+
+// Stands in for the real File/File.hpp, which only builds on Windows
+// The JSON item tree and the INI parser only need a handle that can read the whole file, and the tests never pass one
+
+#include <File/Macros.hpp>
+
+namespace RC::File
+{
+    class Handle
+    {
+      public:
+        auto read_all() const -> StringType
+        {
+            return {};
+        }
+    };
+} // namespace RC::File
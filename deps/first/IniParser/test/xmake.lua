@@ -0,0 +1,43 @@
+-- Standalone tests for the JSON reader and the compiled INI files
+-- They aren't part of the UE4SS build, which only targets Windows, and can be built and run on Linux with:
+--   cd deps/first/IniParser/test && xmake && xmake test
+set_xmakever("2.9.3")
+set_project("IniParserTest")
+
+add_rules("mode.debug", "mode.release")
+set_defaultmode("debug")
+
+add_requires("fmt")
+
+target("JSONTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_INI_PARSER_BUILD_STATIC", "RC_FILE_BUILD_STATIC")
+    add_defines(format('UE4SS_MODS_DIRECTORY="%s"', path.unix(path.join(os.scriptdir(), "../../../../assets/Mods"))))
+    -- The stubs come first so that they replace the parts of the File library that only build on Windows
+    add_includedirs("stubs", "../include", "../../File/include", "../../String/include", "../../../../tools/test/include")
+
+    add_files("JSONTest.cpp")
+    add_files("../src/JSON.cpp", "../src/JSONDocument.cpp")
+
+    add_packages("fmt")
+
+    add_tests("default")
+
+target("CompiledIniTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_INI_PARSER_BUILD_STATIC", "RC_FILE_BUILD_STATIC", "RC_PARSER_BASE_BUILD_STATIC")
+    add_includedirs("stubs", "../include", "../../File/include", "../../String/include", "../../ParserBase/include", "../../Helpers/include", "../../../../tools/test/include")
+
+    add_files("CompiledIniTest.cpp")
+    add_files("../src/CompiledIni.cpp", "../src/Ini.cpp", "../src/Value.cpp", "../src/TokenParser.cpp")
+    add_files("../../ParserBase/src/*.cpp")
+
+    add_packages("fmt")
+
+    add_tests("default")
@@ -10,7 +10,7 @@ target(projectName)
     add_headerfiles("include/**.hpp")
 
     add_files(
-        "src/Ini.cpp", "src/Value.cpp", "src/TokenParser.cpp"
+        "src/Ini.cpp", "src/Value.cpp", "src/TokenParser.cpp", "src/JSON.cpp", "src/JSONDocument.cpp", "src/CompiledIni.cpp"
     )
     
     add_deps("File", "Helpers", "ParserBase")
\ No newline at end of file
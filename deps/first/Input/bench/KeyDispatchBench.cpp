@@ -0,0 +1,153 @@
+// Measures how long it takes Input::Handler to turn a key press into the callbacks of its key binds
+// The key presses come from an input source that's driven by the benchmark, so no platform input is involved
+// Usage: KeyDispatchBench [number of key binds]
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+
+#include <Input/Handler.hpp>
+
+using namespace RC;
+
+// Counts allocations, so that the benchmark can show that dispatching doesn't allocate
+static std::atomic<size_t> s_num_allocations{};
+
+auto operator new(size_t size) -> void*
+{
+    s_num_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+auto operator delete(void* memory) noexcept -> void
+{
+    std::free(memory);
+}
+
+auto operator delete(void* memory, size_t) noexcept -> void
+{
+    std::free(memory);
+}
+
+class BenchInputSource : public Input::InputSource
+{
+  public:
+    EventCallback m_callback{};
+
+  public:
+    auto start(EventCallback callback) -> bool override
+    {
+        m_callback = std::move(callback);
+        return true;
+    }
+    auto stop() -> void override
+    {
+    }
+
+    auto send(Input::InputEventType type, uint8_t key) -> void
+    {
+        m_callback(Input::InputEvent{type, key});
+    }
+};
+
+// Keys that UE4SS and mods commonly bind, the modifier keys themselves are left out
+static constexpr uint8_t s_bindable_keys[] = {0x08, 0x09, 0x0D, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x2D, 0x2E, 0x30, 0x31, 0x32,
+                                              0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A,
+                                              0x4B, 0x4C, 0x4D, 0x4E, 0x4F, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x60,
+                                              0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77,
+                                              0x78, 0x79, 0x7A, 0x7B};
+
+int main(int argc, char* argv[])
+{
+    const size_t num_binds = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500;
+    constexpr size_t num_presses = 1'000'000;
+
+    std::mt19937 random{1234};
+    Input::Handler handler{L"BenchWindow"};
+    auto source = std::make_unique<BenchInputSource>();
+    auto& bench_source = *source;
+    handler.start(std::move(source));
+    bench_source.send(Input::InputEventType::FocusGained, 0);
+
+    size_t num_calls{};
+    for (size_t i = 0; i < num_binds; ++i)
+    {
+        const auto key = static_cast<Input::Key>(s_bindable_keys[random() % std::size(s_bindable_keys)]);
+        switch (random() % 4)
+        {
+        case 0:
+            handler.register_keydown_event(key, [&num_calls] {
+                ++num_calls;
+            });
+            break;
+        case 1:
+            handler.register_keydown_event(key, {Input::ModifierKey::CONTROL}, [&num_calls] {
+                ++num_calls;
+            });
+            break;
+        case 2:
+            handler.register_keydown_event(key, {Input::ModifierKey::CONTROL, Input::ModifierKey::SHIFT}, [&num_calls] {
+                ++num_calls;
+            });
+            break;
+        default:
+            handler.register_keydown_event(key, {Input::ModifierKey::ALT}, [&num_calls] {
+                ++num_calls;
+            });
+            break;
+        }
+    }
+
+    // The first key press after the key binds changed builds the table
+    auto start_time = std::chrono::steady_clock::now();
+    bench_source.send(Input::InputEventType::KeyDown, 0x41);
+    bench_source.send(Input::InputEventType::KeyUp, 0x41);
+    handler.process_event();
+    const auto build_time = std::chrono::steady_clock::now() - start_time;
+
+    // Every other press is made with control down
+    std::vector<uint8_t> keys(4096);
+    for (auto& key : keys)
+    {
+        key = s_bindable_keys[random() % std::size(s_bindable_keys)];
+    }
+
+    num_calls = 0;
+    const size_t num_allocations_before = s_num_allocations.load();
+    start_time = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_presses; ++i)
+    {
+        const bool with_control = i % 2;
+        if (with_control)
+        {
+            bench_source.send(Input::InputEventType::KeyDown, 0xA2);
+        }
+        bench_source.send(Input::InputEventType::KeyDown, keys[i % keys.size()]);
+        bench_source.send(Input::InputEventType::KeyUp, keys[i % keys.size()]);
+        if (with_control)
+        {
+            bench_source.send(Input::InputEventType::KeyUp, 0xA2);
+        }
+        handler.process_event();
+    }
+    const auto dispatch_time = std::chrono::steady_clock::now() - start_time;
+    const size_t num_allocations = s_num_allocations.load() - num_allocations_before;
+
+    using namespace std::chrono;
+    std::printf("%zu key binds, table built in %.1f us\n", num_binds, duration<double, std::micro>(build_time).count());
+    std::printf("%zu key presses in %.1f ms, %.1f ns per press, %zu callbacks called, %zu allocations\n",
+                num_presses,
+                duration<double, std::milli>(dispatch_time).count(),
+                duration<double, std::nano>(dispatch_time).count() / num_presses,
+                num_calls,
+                num_allocations);
+    return 0;
+}
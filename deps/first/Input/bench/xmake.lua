@@ -0,0 +1,19 @@
+-- Standalone benchmark for key bind dispatch
+-- It isn't part of the UE4SS build, which only targets Windows, and can be built on Linux with:
+--   cd deps/first/Input/bench && xmake && xmake run KeyDispatchBench [number of key binds]
+set_xmakever("2.9.3")
+set_project("InputBench")
+
+add_rules("mode.release", "mode.debug")
+set_defaultmode("release")
+
+target("KeyDispatchBench")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_INPUT_BUILD_STATIC")
+    add_includedirs("../include", "../../Constructs/include")
+
+    add_files("KeyDispatchBench.cpp")
+    add_files("../src/Handler.cpp", "../src/KeyDef.cpp")
@@ -1,14 +1,17 @@
 #ifndef IO_INPUT_HANDLER_HPP
 #define IO_INPUT_HANDLER_HPP
 
-// TODO: Abstract more... need to get rid of Windows.h from InputHandler.cpp
-
+#include <atomic>
+#include <bitset>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
+#include <Constructs/MpscQueue.hpp>
 #include <Input/Common.hpp>
+#include <Input/InputSource.hpp>
 #include <Input/KeyDef.hpp>
 
 namespace RC::Input
@@ -24,7 +27,6 @@ namespace RC::Input
         uint8_t custom_data{};
         void* custom_data2{};
         bool requires_modifier_keys{};
-        bool is_down{};
     };
 
     struct KeySet
@@ -32,13 +34,38 @@ namespace RC::Input
         std::unordered_map<Key, std::vector<KeyData>> key_data;
     };
 
+    // Calls the callbacks of key binds when an input source reports that their key was pressed
+    // Nothing is polled, 'process_event' only does work when the input source has sent events since the last call
     class RC_INPUT_API Handler
     {
+      private:
+        // Events that arrive while the queue is full are dropped, and the key state is reset so that no key is stuck down
+        static constexpr size_t max_pending_events = 1024;
+        // Every combination of shift, control and alt
+        static constexpr size_t num_modifier_states = 8;
+        static constexpr size_t num_dispatch_slots = 256 * num_modifier_states;
+
       private:
         std::vector<const wchar_t*> m_active_window_classes{};
         std::vector<KeySet> m_key_sets{};
-        std::unordered_map<ModifierKey, bool> m_modifier_keys_down{};
-        bool m_any_keys_are_down{};
+        // The key binds compiled into one list of callbacks per key and modifier state, only used by the thread that calls 'process_event'
+        // The callbacks of slot 'key * num_modifier_states + modifier_state' are the ones from 'm_dispatch_offsets[slot]' to 'm_dispatch_offsets[slot + 1]'
+        // The table points to the callbacks in 'm_key_sets' instead of copying them, copies could outlive the mod that they came from
+        std::vector<uint32_t> m_dispatch_offsets{};
+        std::vector<const EventCallbackCallable*> m_dispatch_callbacks{};
+        // Set whenever the key binds may have changed, the table is rebuilt when the next key is pressed
+        std::atomic<bool> m_are_binds_changed{true};
+        // Counts the calls to 'get_events', after which callbacks may have been removed
+        std::atomic<uint32_t> m_num_bind_edits{};
+        // Whether the input source was last told that mouse buttons are wanted
+        std::atomic<bool> m_has_mouse_button_binds{};
+        std::unique_ptr<InputSource> m_input_source{};
+        std::function<void()> m_event_notifier{};
+        BoundedMpscQueue<InputEvent> m_pending_events{max_pending_events};
+        std::atomic<bool> m_has_dropped_events{};
+        // Indexed by virtual-key code, only used by the thread that calls 'process_event'
+        std::bitset<256> m_keys_down{};
+        bool m_is_focused{};
         bool m_allow_input{true};
 
       public:
@@ -48,12 +75,11 @@ namespace RC::Input
         {
             static_assert(std::conjunction<std::is_same<const wchar_t*, WindowClasses>...>::value, "WindowClasses must be of type const wchar_t*");
 
-            m_modifier_keys_down.emplace(ModifierKey::SHIFT, false);
-            m_modifier_keys_down.emplace(ModifierKey::CONTROL, false);
-            m_modifier_keys_down.emplace(ModifierKey::ALT, false);
-
             register_window_classes(window_classes...);
         }
+        Handler(const Handler&) = delete;
+        auto operator=(const Handler&) -> Handler& = delete;
+        ~Handler();
 
       private:
         template <typename WindowClass>
@@ -69,10 +95,24 @@ namespace RC::Input
             register_window_classes(window_classes...);
         }
 
-        auto are_modifier_keys_down(const std::vector<ModifierKey>&) -> bool;
-        auto is_program_focused() -> bool;
+        auto is_modifier_key_down(ModifierKey) const -> bool;
+        // Bit 0 is shift, bit 1 is control and bit 2 is alt
+        auto get_modifier_state() const -> uint8_t;
+        auto rebuild_dispatch_table() -> void;
+        auto set_has_mouse_button_binds(bool has_mouse_button_binds) -> void;
+        auto dispatch_key_down(Key) -> void;
 
       public:
+        // Called from the input source's thread every time that an event is queued, to wake up the thread that calls 'process_event'
+        // Must be set before 'start'
+        auto set_event_notifier(std::function<void()> notifier) -> void;
+        // Stops the current input source, if any, and starts receiving events from 'input_source'
+        auto start(std::unique_ptr<InputSource> input_source) -> bool;
+        auto stop() -> void;
+        // Safe to call from any thread, the event is handled by the next call to 'process_event'
+        auto queue_event(const InputEvent&) -> void;
+        // Handles the events that were queued since the last call and calls the callbacks of the key binds that were pressed
+        // Key binds that were changed through 'get_events' take effect here, so the input source stops sending mouse buttons soon after the last mouse bind is gone
         auto process_event() -> void;
         auto register_keydown_event(Input::Key, EventCallbackCallable, uint8_t custom_data = 0, void* custom_data2 = nullptr) -> void;
 
@@ -83,7 +123,14 @@ namespace RC::Input
         auto is_keydown_event_registered(Input::Key) -> bool;
         auto is_keydown_event_registered(Input::Key, const ModifierKeyArray&) -> bool;
 
+        // Key binds may be changed or removed through the returned reference
         auto get_events() -> std::vector<KeySet>&;
+        // Removes every key bind that 'predicate' returns true for, and rebuilds the dispatch table right away so that nothing points to their callbacks
+        // Must be called from the thread that calls 'process_event', a callback that removes binds stops the remaining callbacks of its key press
+        // Returns the number of key binds that were removed
+        auto remove_keydown_events_if(const std::function<bool(KeyData&)>& predicate) -> size_t;
+        auto get_window_classes() const -> const std::vector<const wchar_t*>&;
+        auto is_focused() const -> bool;
         auto get_allow_input() -> bool;
         auto set_allow_input(bool new_value) -> void;
     };
@@ -0,0 +1,55 @@
+#ifndef IO_INPUT_INPUT_SOURCE_HPP
+#define IO_INPUT_INPUT_SOURCE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <Input/Common.hpp>
+
+namespace RC::Input
+{
+    enum class InputEventType : uint8_t
+    {
+        KeyDown,
+        KeyUp,
+        // One of the window classes that the handler was created with became the foreground window, or stopped being it
+        FocusGained,
+        FocusLost,
+    };
+
+    struct InputEvent
+    {
+        InputEventType type{};
+        // Windows virtual-key code, left and right modifier keys may be sent as either the generic or the side-specific code
+        uint8_t key{};
+    };
+
+    // Sends key transitions and focus changes as they happen, the handler doesn't look at the keyboard itself
+    class InputSource
+    {
+      public:
+        // May be called from any thread, and must return quickly because the source may be holding up input to the whole system while it runs
+        using EventCallback = std::function<void(const InputEvent&)>;
+
+      public:
+        virtual ~InputSource() = default;
+
+      public:
+        // The first event must be FocusGained if a window is already focused, the handler starts out unfocused
+        virtual auto start(EventCallback callback) -> bool = 0;
+        // No events are sent after this returns
+        virtual auto stop() -> void = 0;
+        // Mouse buttons are only sent while they're wanted, a source that has to hook the mouse to see them only does so while they are
+        // Called after 'start' whenever the first key bind for a mouse button is added or the last one is removed, from any thread
+        virtual auto set_wants_mouse_buttons([[maybe_unused]] bool wants_mouse_buttons) -> void
+        {
+        }
+    };
+
+    // Hooks the keyboard and mouse of the current platform
+    RC_INPUT_API auto make_platform_input_source(std::vector<const wchar_t*> window_classes) -> std::unique_ptr<InputSource>;
+} // namespace RC::Input
+
+#endif // IO_INPUT_INPUT_SOURCE_HPP
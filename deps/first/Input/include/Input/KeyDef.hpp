@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <stdexcept>
 
 namespace RC::Input
@@ -7,7 +8,7 @@ namespace RC::Input
     static constexpr uint32_t max_callbacks_per_event = 30;
     static constexpr uint8_t max_keys = 0xFF;
 
-#ifdef _WIN32
+    // The values are Windows virtual-key codes on every platform, input sources on other platforms translate their key codes to these
     enum Key : uint8_t
     {
         RESERVED_START_OF_ENUM = 0x0,
@@ -246,9 +247,5 @@ namespace RC::Input
 
     static constexpr uint8_t max_modifier_keys = MODIFIER_KEYS_MAX;
 
-#else
-    static_assert(false, "The input library only works on Windows.");
-#endif
-
     auto operator++(Input::Key& key) -> Input::Key&;
 } // namespace RC::Input
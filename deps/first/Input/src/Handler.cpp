@@ -2,9 +2,6 @@
 
 #include <Input/Handler.hpp>
 
-#define NOMINMAX
-#include <Windows.h>
-
 namespace RC::Input
 {
     auto is_modifier_key_required(ModifierKey modifier_key, std::vector<ModifierKey> modifier_keys) -> bool
@@ -25,137 +22,247 @@ namespace RC::Input
         return false;
     }
 
-    auto Handler::are_modifier_keys_down(const std::vector<ModifierKey>& required_modifier_keys) -> bool
+    // Input sources may send either the generic or the side-specific code of a modifier key
+    static constexpr auto get_side_specific_keys(ModifierKey modifier_key) -> std::array<uint8_t, 2>
+    {
+        switch (modifier_key)
+        {
+        case ModifierKey::SHIFT:
+            return {0xA0, 0xA1};
+        case ModifierKey::CONTROL:
+            return {0xA2, 0xA3};
+        case ModifierKey::ALT:
+            return {0xA4, 0xA5};
+        default:
+            return {modifier_key, modifier_key};
+        }
+    }
+
+    static constexpr std::array<ModifierKey, 3> s_modifier_keys{ModifierKey::SHIFT, ModifierKey::CONTROL, ModifierKey::ALT};
+
+    static constexpr auto is_mouse_button(Key key) -> bool
+    {
+        return key == Key::LEFT_MOUSE_BUTTON || key == Key::RIGHT_MOUSE_BUTTON || key == Key::MIDDLE_MOUSE_BUTTON || key == Key::XBUTTON_ONE ||
+               key == Key::XBUTTON_TWO;
+    }
+
+    Handler::~Handler()
+    {
+        stop();
+    }
+
+    auto Handler::is_modifier_key_down(ModifierKey modifier_key) const -> bool
+    {
+        const auto [left_key, right_key] = get_side_specific_keys(modifier_key);
+        return m_keys_down[modifier_key] || m_keys_down[left_key] || m_keys_down[right_key];
+    }
+
+    auto Handler::get_modifier_state() const -> uint8_t
     {
-        bool are_required_modifier_keys_down = true;
+        uint8_t modifier_state{};
+        for (size_t i = 0; i < s_modifier_keys.size(); ++i)
+        {
+            if (is_modifier_key_down(s_modifier_keys[i]))
+            {
+                modifier_state |= static_cast<uint8_t>(1 << i);
+            }
+        }
+        return modifier_state;
+    }
+
+    auto Handler::rebuild_dispatch_table() -> void
+    {
+        // Calls 'callable' with every slot that 'key_data' is triggered from, the rules are the same as before the table existed:
+        // A bind without modifier keys requires that no modifier key is down
+        // A bind with modifier keys requires that exactly those modifier keys are down
+        // A bind whose modifier keys were all MOD_KEY_START_OF_ENUM doesn't care about modifier keys
+        auto for_each_slot = [](Key key, const KeyData& key_data, auto&& callable) {
+            const size_t first_slot = static_cast<size_t>(key) * num_modifier_states;
+            if (key_data.requires_modifier_keys && key_data.required_modifier_keys.empty())
+            {
+                for (size_t modifier_state = 0; modifier_state < num_modifier_states; ++modifier_state)
+                {
+                    callable(first_slot + modifier_state);
+                }
+                return;
+            }
+
+            uint8_t required_modifier_state{};
+            for (size_t i = 0; key_data.requires_modifier_keys && i < s_modifier_keys.size(); ++i)
+            {
+                if (is_modifier_key_required(s_modifier_keys[i], key_data.required_modifier_keys))
+                {
+                    required_modifier_state |= static_cast<uint8_t>(1 << i);
+                }
+            }
+            callable(first_slot + required_modifier_state);
+        };
 
-        for (const auto& [modifier_key, modifier_key_is_down] : m_modifier_keys_down)
+        // The callbacks of each slot are counted first, so that they can be copied into place in the order that they were registered in
+        m_dispatch_offsets.assign(num_dispatch_slots + 1, 0);
+        bool has_mouse_button_binds{};
+        for (const auto& key_set : m_key_sets)
         {
-            for (const auto& required_modifier_key : required_modifier_keys)
+            for (const auto& [key, key_data_array] : key_set.key_data)
             {
-                if (modifier_key == required_modifier_key && !modifier_key_is_down)
+                has_mouse_button_binds |= is_mouse_button(key) && !key_data_array.empty();
+                for (const auto& key_data : key_data_array)
                 {
-                    are_required_modifier_keys_down = false;
+                    for_each_slot(key, key_data, [&](size_t slot) {
+                        m_dispatch_offsets[slot + 1] += static_cast<uint32_t>(key_data.callbacks.size());
+                    });
                 }
+            }
+        }
+        for (size_t slot = 0; slot < num_dispatch_slots; ++slot)
+        {
+            m_dispatch_offsets[slot + 1] += m_dispatch_offsets[slot];
+        }
 
-                if (modifier_key != required_modifier_key && modifier_key_is_down && !is_modifier_key_required(modifier_key, required_modifier_keys))
+        std::vector<uint32_t> next_callback_index(m_dispatch_offsets.begin(), m_dispatch_offsets.end() - 1);
+        m_dispatch_callbacks.resize(m_dispatch_offsets.back());
+        for (const auto& key_set : m_key_sets)
+        {
+            for (const auto& [key, key_data_array] : key_set.key_data)
+            {
+                for (const auto& key_data : key_data_array)
                 {
-                    return false;
+                    for_each_slot(key, key_data, [&](size_t slot) {
+                        for (const auto& callback : key_data.callbacks)
+                        {
+                            m_dispatch_callbacks[next_callback_index[slot]++] = &callback;
+                        }
+                    });
                 }
             }
         }
 
-        return are_required_modifier_keys_down;
+        set_has_mouse_button_binds(has_mouse_button_binds);
     }
 
-    auto Handler::is_program_focused() -> bool
+    auto Handler::set_has_mouse_button_binds(bool has_mouse_button_binds) -> void
     {
-        HWND hwnd = GetForegroundWindow();
-        if (!hwnd) return false;
+        if (m_has_mouse_button_binds.exchange(has_mouse_button_binds) != has_mouse_button_binds && m_input_source)
+        {
+            m_input_source->set_wants_mouse_buttons(has_mouse_button_binds);
+        }
+    }
 
-        wchar_t current_window_class_name[MAX_PATH];
-        if (!GetClassNameW(hwnd, current_window_class_name, MAX_PATH)) return false;
+    auto Handler::dispatch_key_down(Key key) -> void
+    {
+        if (m_are_binds_changed.exchange(false, std::memory_order_acquire))
+        {
+            rebuild_dispatch_table();
+        }
 
-        for (const auto& active_window_class : m_active_window_classes)
+        // Registering a key bind doesn't move existing callbacks, so a callback that registers a key bind doesn't affect the callbacks that are left
+        // A callback that changed the key binds through 'get_events' may have removed the callbacks that are left, so they're skipped
+        const auto num_bind_edits = m_num_bind_edits.load(std::memory_order_acquire);
+        const size_t slot = static_cast<size_t>(key) * num_modifier_states + get_modifier_state();
+        for (uint32_t i = m_dispatch_offsets[slot]; i < m_dispatch_offsets[slot + 1]; ++i)
         {
-            if (wcscmp(current_window_class_name, active_window_class) == 0)
+            (*m_dispatch_callbacks[i])();
+            if (m_num_bind_edits.load(std::memory_order_acquire) != num_bind_edits)
             {
-                return true;
+                break;
             }
         }
+    }
 
-        return false;
+    auto Handler::set_event_notifier(std::function<void()> notifier) -> void
+    {
+        m_event_notifier = std::move(notifier);
     }
 
-    auto Handler::process_event() -> void
+    auto Handler::start(std::unique_ptr<InputSource> input_source) -> bool
     {
-        if (!is_program_focused())
+        stop();
+        if (!input_source)
         {
-            return;
+            return false;
         }
 
-        std::vector<EventCallbackCallable> callbacks_to_call{};
+        m_input_source = std::move(input_source);
+        if (!m_input_source->start([this](const InputEvent& event) {
+                queue_event(event);
+            }))
+        {
+            return false;
+        }
 
-        bool skip_this_frame = !get_allow_input();
-        bool is_any_modifier_keys_down = false;
-        bool any_keys_are_down = false;
+        // Mouse buttons may have been bound before the source existed
+        m_input_source->set_wants_mouse_buttons(m_has_mouse_button_binds.load());
+        return true;
+    }
 
-        if (m_any_keys_are_down)
+    auto Handler::stop() -> void
+    {
+        if (m_input_source)
         {
-            skip_this_frame = true;
+            m_input_source->stop();
+            m_input_source.reset();
         }
+    }
 
-        // Check if any modifier keys are down
-        for (auto& [modifier_key, key_is_down] : m_modifier_keys_down)
+    auto Handler::queue_event(const InputEvent& event) -> void
+    {
+        if (!m_pending_events.try_push(event))
         {
-            if (GetAsyncKeyState(modifier_key))
-            {
-                is_any_modifier_keys_down = true;
-                key_is_down = true;
-            }
-            else
-            {
-                key_is_down = false;
-            }
+            m_has_dropped_events.store(true, std::memory_order_release);
         }
 
-        for (auto& key_set_data : m_key_sets)
+        if (m_event_notifier)
         {
-            for (auto& [key, key_data_array] : key_set_data.key_data)
-            {
-                for (auto& key_data : key_data_array)
-                {
-                    if (GetAsyncKeyState(key) && !key_data.is_down)
-                    {
-                        any_keys_are_down = true;
-                        bool should_propagate = true;
-
-                        if (key_data.requires_modifier_keys)
-                        {
-                            if (!are_modifier_keys_down(key_data.required_modifier_keys))
-                            {
-                                should_propagate = false;
-                            }
-                        }
-
-                        if (!key_data.requires_modifier_keys && is_any_modifier_keys_down)
-                        {
-                            should_propagate = false;
-                        }
-
-                        if (should_propagate)
-                        {
-                            key_data.is_down = true;
-                            for (const auto& callback : key_data.callbacks)
-                            {
-                                callbacks_to_call.emplace_back(callback);
-                            }
-                        }
-                    }
-                    else if (!GetAsyncKeyState(key) && key_data.is_down)
-                    {
-                        key_data.is_down = false;
-                    }
-                }
-            }
+            m_event_notifier();
         }
+    }
 
-        if (any_keys_are_down)
+    auto Handler::process_event() -> void
+    {
+        if (m_are_binds_changed.exchange(false, std::memory_order_acquire))
         {
-            m_any_keys_are_down = true;
+            rebuild_dispatch_table();
         }
-        else
+
+        if (m_pending_events.is_empty())
         {
-            m_any_keys_are_down = false;
+            return;
         }
 
-        for (const auto& callback : callbacks_to_call)
-        {
-            if (skip_this_frame)
+        const bool has_dropped_events = m_has_dropped_events.exchange(false, std::memory_order_acquire);
+
+        m_pending_events.drain([&](InputEvent&& event) {
+            switch (event.type)
             {
-                return;
+            case InputEventType::KeyDown:
+                // Held keys repeat their key down, only the first one counts
+                // Keys are still tracked while the program isn't focused, but their binds aren't triggered
+                if (!m_keys_down[event.key])
+                {
+                    m_keys_down[event.key] = true;
+                    if (m_is_focused && get_allow_input())
+                    {
+                        dispatch_key_down(static_cast<Key>(event.key));
+                    }
+                }
+                break;
+            case InputEventType::KeyUp:
+                m_keys_down[event.key] = false;
+                break;
+            case InputEventType::FocusGained:
+                m_is_focused = true;
+                break;
+            case InputEventType::FocusLost:
+                m_is_focused = false;
+                break;
             }
-            callback();
+        });
+
+        // A dropped key up would leave its key down until it's pressed again
+        // The dropped events came after the ones that were in the queue, so forgetting every key that's down is as close as it gets
+        if (has_dropped_events)
+        {
+            m_keys_down.reset();
         }
     }
 
@@ -177,6 +284,12 @@ namespace RC::Input
         key_data.callbacks.emplace_back(callback);
         key_data.custom_data = custom_data;
         key_data.custom_data2 = custom_data2;
+        m_are_binds_changed.store(true, std::memory_order_release);
+        if (is_mouse_button(key))
+        {
+            // Mouse buttons aren't sent until they're wanted, so this can't wait until the table is rebuilt
+            set_has_mouse_button_binds(true);
+        }
     }
 
     auto Handler::register_keydown_event(
@@ -198,6 +311,12 @@ namespace RC::Input
         key_data.callbacks.emplace_back(callback);
         key_data.custom_data = custom_data;
         key_data.custom_data2 = custom_data2;
+        m_are_binds_changed.store(true, std::memory_order_release);
+        if (is_mouse_button(key))
+        {
+            // Mouse buttons aren't sent until they're wanted, so this can't wait until the table is rebuilt
+            set_has_mouse_button_binds(true);
+        }
         key_data.requires_modifier_keys = true;
 
         for (const auto& modifier_key : modifier_keys)
@@ -330,9 +449,42 @@ namespace RC::Input
 
     auto Handler::get_events() -> std::vector<KeySet>&
     {
+        // The caller may change or remove key binds, the table is rebuilt before the next key is dispatched
+        m_num_bind_edits.fetch_add(1, std::memory_order_release);
+        m_are_binds_changed.store(true, std::memory_order_release);
         return m_key_sets;
     }
 
+    auto Handler::remove_keydown_events_if(const std::function<bool(KeyData&)>& predicate) -> size_t
+    {
+        size_t num_removed{};
+        for (auto& key_set : m_key_sets)
+        {
+            for (auto it = key_set.key_data.begin(); it != key_set.key_data.end();)
+            {
+                num_removed += std::erase_if(it->second, predicate);
+                it = it->second.empty() ? key_set.key_data.erase(it) : std::next(it);
+            }
+        }
+        std::erase_if(m_key_sets, [](const KeySet& key_set) {
+            return key_set.key_data.empty();
+        });
+
+        m_num_bind_edits.fetch_add(1, std::memory_order_release);
+        rebuild_dispatch_table();
+        return num_removed;
+    }
+
+    auto Handler::get_window_classes() const -> const std::vector<const wchar_t*>&
+    {
+        return m_active_window_classes;
+    }
+
+    auto Handler::is_focused() const -> bool
+    {
+        return m_is_focused;
+    }
+
     auto Handler::get_allow_input() -> bool
     {
         return m_allow_input;
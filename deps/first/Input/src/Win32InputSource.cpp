@@ -0,0 +1,300 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cwchar>
+#include <future>
+#include <thread>
+
+#include <Input/InputSource.hpp>
+
+#define NOMINMAX
+#include <Windows.h>
+
+namespace RC::Input
+{
+    // Low-level keyboard and mouse hooks, and a WinEvent hook for foreground window changes, all serviced by one thread with a message loop
+    // The hooks see input for the whole system, so key state stays correct while the game isn't focused and nothing that the game registered is replaced
+    // Every mouse move in the system goes through a low-level mouse hook, so it's only installed while a mouse button is bound
+    // If the hooks can't be installed, the thread polls GetAsyncKeyState instead and still only sends transitions
+    class Win32InputSource : public InputSource
+    {
+      private:
+        // Only used when the hooks couldn't be installed
+        static constexpr auto fallback_poll_interval = std::chrono::milliseconds{16};
+        // Posted to the hook thread, hooks must be installed and removed by the thread that services them
+        static constexpr UINT update_mouse_hook_message = WM_APP + 1;
+
+        // Hook procedures don't take a user pointer
+        static inline std::atomic<Win32InputSource*> s_active_source{};
+
+      private:
+        std::vector<const wchar_t*> m_window_classes{};
+        EventCallback m_callback{};
+        std::thread m_thread{};
+        std::atomic<DWORD> m_thread_id{};
+        std::atomic<bool> m_wants_mouse_buttons{};
+        HHOOK m_keyboard_hook{};
+        HHOOK m_mouse_hook{};
+        HWINEVENTHOOK m_foreground_hook{};
+        // Only used by the hook thread
+        HWND m_last_foreground_window{};
+        bool m_is_focused{};
+
+      public:
+        explicit Win32InputSource(std::vector<const wchar_t*> window_classes) : m_window_classes(std::move(window_classes))
+        {
+        }
+
+        ~Win32InputSource() override
+        {
+            stop();
+        }
+
+      public:
+        auto start(EventCallback callback) -> bool override
+        {
+            Win32InputSource* expected{};
+            if (m_thread.joinable() || !s_active_source.compare_exchange_strong(expected, this))
+            {
+                return false;
+            }
+
+            m_callback = std::move(callback);
+            std::promise<DWORD> thread_id_promise{};
+            auto thread_id_future = thread_id_promise.get_future();
+            m_thread = std::thread{[this, &thread_id_promise] {
+                // Creates the message queue before the thread id is handed out, so that 'stop' can always post WM_QUIT
+                MSG message{};
+                PeekMessageW(&message, nullptr, WM_USER, WM_USER, PM_NOREMOVE);
+                thread_id_promise.set_value(GetCurrentThreadId());
+                run();
+            }};
+            m_thread_id = thread_id_future.get();
+            return true;
+        }
+
+        auto stop() -> void override
+        {
+            if (!m_thread.joinable())
+            {
+                return;
+            }
+
+            PostThreadMessageW(m_thread_id, WM_QUIT, 0, 0);
+            m_thread.join();
+            m_thread_id = 0;
+            s_active_source.store(nullptr);
+        }
+
+        auto set_wants_mouse_buttons(bool wants_mouse_buttons) -> void override
+        {
+            m_wants_mouse_buttons.store(wants_mouse_buttons);
+            if (m_thread_id)
+            {
+                PostThreadMessageW(m_thread_id, update_mouse_hook_message, 0, 0);
+            }
+        }
+
+      private:
+        auto send(InputEventType type, uint8_t key = 0) -> void
+        {
+            m_callback(InputEvent{type, key});
+        }
+
+        auto update_focus(HWND foreground_window) -> void
+        {
+            // The class name is only looked up when the foreground window changes
+            if (foreground_window == m_last_foreground_window)
+            {
+                return;
+            }
+            m_last_foreground_window = foreground_window;
+
+            bool is_focused{};
+            wchar_t class_name[MAX_PATH]{};
+            if (foreground_window && GetClassNameW(foreground_window, class_name, MAX_PATH))
+            {
+                for (const auto& window_class : m_window_classes)
+                {
+                    if (wcscmp(class_name, window_class) == 0)
+                    {
+                        is_focused = true;
+                        break;
+                    }
+                }
+            }
+
+            if (is_focused != m_is_focused)
+            {
+                m_is_focused = is_focused;
+                send(is_focused ? InputEventType::FocusGained : InputEventType::FocusLost);
+            }
+        }
+
+        auto install_hooks() -> bool
+        {
+            HMODULE module{};
+            GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                               reinterpret_cast<LPCWSTR>(&Win32InputSource::keyboard_hook),
+                               &module);
+
+            m_keyboard_hook = SetWindowsHookExW(WH_KEYBOARD_LL, &Win32InputSource::keyboard_hook, module, 0);
+            m_foreground_hook =
+                    SetWinEventHook(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, nullptr, &Win32InputSource::foreground_hook, 0, 0, WINEVENT_OUTOFCONTEXT);
+            if (m_keyboard_hook && m_foreground_hook)
+            {
+                update_mouse_hook();
+                return true;
+            }
+
+            uninstall_hooks();
+            return false;
+        }
+
+        auto update_mouse_hook() -> void
+        {
+            const bool wants_mouse_buttons = m_wants_mouse_buttons.load();
+            if (wants_mouse_buttons && !m_mouse_hook)
+            {
+                HMODULE module{};
+                GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                                   reinterpret_cast<LPCWSTR>(&Win32InputSource::mouse_hook),
+                                   &module);
+                m_mouse_hook = SetWindowsHookExW(WH_MOUSE_LL, &Win32InputSource::mouse_hook, module, 0);
+            }
+            else if (!wants_mouse_buttons && m_mouse_hook)
+            {
+                UnhookWindowsHookEx(m_mouse_hook);
+                m_mouse_hook = nullptr;
+            }
+        }
+
+        auto uninstall_hooks() -> void
+        {
+            if (m_keyboard_hook)
+            {
+                UnhookWindowsHookEx(m_keyboard_hook);
+                m_keyboard_hook = nullptr;
+            }
+            if (m_mouse_hook)
+            {
+                UnhookWindowsHookEx(m_mouse_hook);
+                m_mouse_hook = nullptr;
+            }
+            if (m_foreground_hook)
+            {
+                UnhookWinEvent(m_foreground_hook);
+                m_foreground_hook = nullptr;
+            }
+        }
+
+        auto run() -> void
+        {
+            const bool has_hooks = install_hooks();
+            update_focus(GetForegroundWindow());
+
+            std::array<bool, 256> keys_down{};
+            for (;;)
+            {
+                // With the hooks installed the thread sleeps until there's input, the hooks are called from inside the message loop
+                const auto wait_result = MsgWaitForMultipleObjects(0, nullptr, FALSE, has_hooks ? INFINITE : static_cast<DWORD>(fallback_poll_interval.count()), QS_ALLINPUT);
+
+                MSG message{};
+                while (PeekMessageW(&message, nullptr, 0, 0, PM_REMOVE))
+                {
+                    if (message.message == WM_QUIT)
+                    {
+                        uninstall_hooks();
+                        return;
+                    }
+                    if (message.message == update_mouse_hook_message)
+                    {
+                        // Polling sees the mouse buttons either way
+                        if (has_hooks)
+                        {
+                            update_mouse_hook();
+                        }
+                        continue;
+                    }
+                    TranslateMessage(&message);
+                    DispatchMessageW(&message);
+                }
+
+                if (!has_hooks && wait_result == WAIT_TIMEOUT)
+                {
+                    update_focus(GetForegroundWindow());
+                    for (int key = 1; key < static_cast<int>(keys_down.size()); ++key)
+                    {
+                        const bool is_down = GetAsyncKeyState(key) & 0x8000;
+                        if (is_down != keys_down[key])
+                        {
+                            keys_down[key] = is_down;
+                            send(is_down ? InputEventType::KeyDown : InputEventType::KeyUp, static_cast<uint8_t>(key));
+                        }
+                    }
+                }
+            }
+        }
+
+        static LRESULT CALLBACK keyboard_hook(int code, WPARAM w_param, LPARAM l_param)
+        {
+            if (auto source = s_active_source.load(std::memory_order_relaxed); source && code == HC_ACTION)
+            {
+                const auto& keyboard = *reinterpret_cast<const KBDLLHOOKSTRUCT*>(l_param);
+                const bool is_down = w_param == WM_KEYDOWN || w_param == WM_SYSKEYDOWN;
+                source->send(is_down ? InputEventType::KeyDown : InputEventType::KeyUp, static_cast<uint8_t>(keyboard.vkCode));
+            }
+            return CallNextHookEx(nullptr, code, w_param, l_param);
+        }
+
+        static LRESULT CALLBACK mouse_hook(int code, WPARAM w_param, LPARAM l_param)
+        {
+            if (auto source = s_active_source.load(std::memory_order_relaxed); source && code == HC_ACTION)
+            {
+                const auto& mouse = *reinterpret_cast<const MSLLHOOKSTRUCT*>(l_param);
+                const uint8_t x_button = HIWORD(mouse.mouseData) == XBUTTON1 ? VK_XBUTTON1 : VK_XBUTTON2;
+                switch (w_param)
+                {
+                case WM_LBUTTONDOWN:
+                    source->send(InputEventType::KeyDown, VK_LBUTTON);
+                    break;
+                case WM_LBUTTONUP:
+                    source->send(InputEventType::KeyUp, VK_LBUTTON);
+                    break;
+                case WM_RBUTTONDOWN:
+                    source->send(InputEventType::KeyDown, VK_RBUTTON);
+                    break;
+                case WM_RBUTTONUP:
+                    source->send(InputEventType::KeyUp, VK_RBUTTON);
+                    break;
+                case WM_MBUTTONDOWN:
+                    source->send(InputEventType::KeyDown, VK_MBUTTON);
+                    break;
+                case WM_MBUTTONUP:
+                    source->send(InputEventType::KeyUp, VK_MBUTTON);
+                    break;
+                case WM_XBUTTONDOWN:
+                    source->send(InputEventType::KeyDown, x_button);
+                    break;
+                case WM_XBUTTONUP:
+                    source->send(InputEventType::KeyUp, x_button);
+                    break;
+                }
+            }
+            return CallNextHookEx(nullptr, code, w_param, l_param);
+        }
+
+        static void CALLBACK foreground_hook(HWINEVENTHOOK, DWORD, HWND window, LONG object_id, LONG, DWORD, DWORD)
+        {
+            if (auto source = s_active_source.load(std::memory_order_relaxed); source && object_id == OBJID_WINDOW)
+            {
+                source->update_focus(window);
+            }
+        }
+    };
+
+    auto make_platform_input_source(std::vector<const wchar_t*> window_classes) -> std::unique_ptr<InputSource>
+    {
+        return std::make_unique<Win32InputSource>(std::move(window_classes));
+    }
+} // namespace RC::Input
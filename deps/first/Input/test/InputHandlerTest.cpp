@@ -0,0 +1,204 @@
+// Tests for when the handler asks its input source for mouse buttons, which a source may have to hook every mouse move in the system for,
+// and for removing key binds whose callbacks are about to be unloaded
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <Input/Handler.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+
+// Records what the handler asked for, events are sent by the tests themselves through the callback
+class RecordingInputSource : public Input::InputSource
+{
+  public:
+    struct State
+    {
+        EventCallback callback{};
+        std::vector<bool> wants_mouse_buttons_calls{};
+    };
+
+  private:
+    State& m_state;
+
+  public:
+    explicit RecordingInputSource(State& state) : m_state(state)
+    {
+    }
+
+  public:
+    auto start(EventCallback callback) -> bool override
+    {
+        m_state.callback = std::move(callback);
+        return true;
+    }
+
+    auto stop() -> void override
+    {
+        m_state.callback = nullptr;
+    }
+
+    auto set_wants_mouse_buttons(bool wants_mouse_buttons) -> void override
+    {
+        m_state.wants_mouse_buttons_calls.emplace_back(wants_mouse_buttons);
+    }
+};
+
+static auto press(RecordingInputSource::State& state, Input::Handler& handler, Input::Key key) -> void
+{
+    state.callback(Input::InputEvent{Input::InputEventType::KeyDown, key});
+    state.callback(Input::InputEvent{Input::InputEventType::KeyUp, key});
+    handler.process_event();
+}
+
+// Removes the binds of 'key' the way that mods remove theirs, through 'get_events'
+static auto remove_binds(Input::Handler& handler, Input::Key key) -> void
+{
+    for (auto& key_set : handler.get_events())
+    {
+        key_set.key_data.erase(key);
+    }
+}
+
+static auto test_mouse_buttons_only_while_bound() -> void
+{
+    RecordingInputSource::State state{};
+    Input::Handler handler{L"UnrealWindow"};
+    CHECK(handler.start(std::make_unique<RecordingInputSource>(state)));
+    CHECK((state.wants_mouse_buttons_calls == std::vector<bool>{false}));
+    state.callback(Input::InputEvent{Input::InputEventType::FocusGained});
+
+    // Keyboard binds don't need the mouse
+    int num_key_presses{};
+    handler.register_keydown_event(Input::Key::F1, [&] {
+        ++num_key_presses;
+    });
+    handler.process_event();
+    CHECK(state.wants_mouse_buttons_calls.size() == 1);
+
+    // The first mouse bind asks for mouse buttons right away, without waiting for the event loop
+    int num_clicks{};
+    handler.register_keydown_event(Input::Key::LEFT_MOUSE_BUTTON, [&] {
+        ++num_clicks;
+    });
+    CHECK((state.wants_mouse_buttons_calls == std::vector<bool>{false, true}));
+    handler.register_keydown_event(Input::Key::XBUTTON_TWO, {Input::ModifierKey::CONTROL}, [&] {
+        ++num_clicks;
+    });
+    handler.process_event();
+    CHECK(state.wants_mouse_buttons_calls.size() == 2);
+
+    press(state, handler, Input::Key::LEFT_MOUSE_BUTTON);
+    press(state, handler, Input::Key::F1);
+    CHECK(num_clicks == 1);
+    CHECK(num_key_presses == 1);
+
+    // Mouse buttons are still wanted while any mouse bind is left
+    remove_binds(handler, Input::Key::LEFT_MOUSE_BUTTON);
+    handler.process_event();
+    CHECK(state.wants_mouse_buttons_calls.size() == 2);
+
+    // Removing the last one stops them on the next pass of the event loop, even when no key is pressed
+    remove_binds(handler, Input::Key::XBUTTON_TWO);
+    handler.process_event();
+    CHECK((state.wants_mouse_buttons_calls == std::vector<bool>{false, true, false}));
+    handler.process_event();
+    CHECK(state.wants_mouse_buttons_calls.size() == 3);
+
+    // Binding a mouse button again asks again
+    handler.register_keydown_event(Input::Key::MIDDLE_MOUSE_BUTTON, [&] {
+        ++num_clicks;
+    });
+    CHECK((state.wants_mouse_buttons_calls == std::vector<bool>{false, true, false, true}));
+    press(state, handler, Input::Key::MIDDLE_MOUSE_BUTTON);
+    CHECK(num_clicks == 2);
+    handler.stop();
+}
+
+static auto test_bound_before_start() -> void
+{
+    // Mods can bind keys before the event loop starts the input source
+    RecordingInputSource::State state{};
+    Input::Handler handler{L"UnrealWindow"};
+    handler.register_keydown_event(Input::Key::RIGHT_MOUSE_BUTTON, [] {});
+    CHECK(handler.start(std::make_unique<RecordingInputSource>(state)));
+    CHECK((state.wants_mouse_buttons_calls == std::vector<bool>{true}));
+
+    // A key whose binds were all erased doesn't count
+    for (auto& key_set : handler.get_events())
+    {
+        for (auto& [key, key_data_array] : key_set.key_data)
+        {
+            key_data_array.clear();
+        }
+    }
+    handler.process_event();
+    CHECK((state.wants_mouse_buttons_calls == std::vector<bool>{true, false}));
+}
+
+static auto test_remove_keydown_events_if() -> void
+{
+    RecordingInputSource::State state{};
+    Input::Handler handler{L"UnrealWindow"};
+    CHECK(handler.start(std::make_unique<RecordingInputSource>(state)));
+    state.callback(Input::InputEvent{Input::InputEventType::FocusGained});
+
+    // Binds are told apart by their custom data, like the binds of a mod that's about to be unloaded
+    std::vector<int> calls{};
+    handler.register_keydown_event(Input::Key::F1, [&] {
+        calls.emplace_back(1);
+    });
+    handler.register_keydown_event(Input::Key::F1, [&] {
+        calls.emplace_back(2);
+    }, 7);
+    handler.register_keydown_event(Input::Key::F2, [&] {
+        calls.emplace_back(3);
+    }, 7);
+    handler.register_keydown_event(Input::Key::LEFT_MOUSE_BUTTON, [&] {
+        calls.emplace_back(4);
+    }, 7);
+    press(state, handler, Input::Key::F1);
+    CHECK((calls == std::vector<int>{1, 2}));
+
+    CHECK(handler.remove_keydown_events_if([](Input::KeyData& key_data) {
+        return key_data.custom_data == 7;
+    }) == 3);
+    CHECK(handler.is_keydown_event_registered(Input::Key::F1));
+    CHECK(!handler.is_keydown_event_registered(Input::Key::F2));
+    CHECK(!handler.is_keydown_event_registered(Input::Key::LEFT_MOUSE_BUTTON));
+
+    // The table was rebuilt right away, and the mouse isn't wanted anymore
+    CHECK((state.wants_mouse_buttons_calls == std::vector<bool>{false, true, false}));
+    calls.clear();
+    press(state, handler, Input::Key::F1);
+    press(state, handler, Input::Key::F2);
+    press(state, handler, Input::Key::LEFT_MOUSE_BUTTON);
+    CHECK((calls == std::vector<int>{1}));
+
+    // A callback that removes binds, like the key bind that re-installs every mod, stops the callbacks after it
+    handler.register_keydown_event(Input::Key::F3, [&] {
+        calls.emplace_back(5);
+        handler.remove_keydown_events_if([](Input::KeyData& key_data) {
+            return key_data.custom_data == 7;
+        });
+    });
+    handler.register_keydown_event(Input::Key::F3, [&] {
+        calls.emplace_back(6);
+    }, 7);
+    calls.clear();
+    press(state, handler, Input::Key::F3);
+    CHECK((calls == std::vector<int>{5}));
+    press(state, handler, Input::Key::F3);
+    CHECK((calls == std::vector<int>{5, 5}));
+}
+
+auto main() -> int
+{
+    test_mouse_buttons_only_while_bound();
+    test_bound_before_start();
+    test_remove_keydown_events_if();
+
+    return Test::report_results();
+}
@@ -0,0 +1,21 @@
+-- Standalone tests for the key bind handler
+-- They aren't part of the UE4SS build, which only targets Windows, and can be built and run on Linux with:
+--   cd deps/first/Input/test && xmake && xmake test
+set_xmakever("2.9.3")
+set_project("InputTest")
+
+add_rules("mode.debug", "mode.release")
+set_defaultmode("debug")
+
+target("InputHandlerTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_INPUT_BUILD_STATIC")
+    add_includedirs("../include", "../../Constructs/include", "../../../../tools/test/include")
+
+    add_files("InputHandlerTest.cpp")
+    add_files("../src/Handler.cpp", "../src/KeyDef.cpp")
+
+    add_tests("default")
@@ -9,4 +9,6 @@ target(projectName)
     add_includedirs("include", { public = true })
     add_headerfiles("include/**.hpp")
 
-    add_files("src/**.cpp")
\ No newline at end of file
+    add_files("src/**.cpp")
+
+    add_deps("Constructs")
\ No newline at end of file
@@ -0,0 +1,138 @@
+// Measures how fast the tokenizer gets through a large generated file that looks like MemberVariableLayout.ini
+// The tokens are the same as the ones that IniParser uses, and the parser reads the data of every token that has data
+// Usage: TokenizerBench [input size in MB]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <ParserBase/Token.hpp>
+#include <ParserBase/TokenParser.hpp>
+#include <ParserBase/Tokenizer.hpp>
+
+using namespace RC;
+
+// Mirrors IniTokenType
+enum BenchTokenType : int
+{
+    CarriageReturn,
+    NewLine,
+    Space,
+    Characters,
+    Equals,
+    ClosingSquareBracket,
+    OpeningSquareBracket,
+    SemiColon,
+    EndOfFile,
+};
+
+static auto create_available_tokens() -> ParserBase::TokenContainer
+{
+    ParserBase::TokenContainer tc;
+    tc.add(ParserBase::Token::create(BenchTokenType::CarriageReturn, STR("CarriageReturn"), STR("\r")));
+    tc.add(ParserBase::Token::create(BenchTokenType::NewLine, STR("NewLine"), STR("\n")));
+    tc.add(ParserBase::Token::create(BenchTokenType::Space, STR("Space"), STR(" ")));
+    tc.add(ParserBase::Token::create(BenchTokenType::Characters, STR("Characters"), STR(""), ParserBase::Token::HasData::Yes));
+    tc.add(ParserBase::Token::create(BenchTokenType::Equals, STR("Equals"), STR("=")));
+    tc.add(ParserBase::Token::create(BenchTokenType::ClosingSquareBracket, STR("CloseSquareBracket"), STR("]")));
+    tc.add(ParserBase::Token::create(BenchTokenType::OpeningSquareBracket, STR("OpenSquareBracket"), STR("[")));
+    tc.add(ParserBase::Token::create(BenchTokenType::SemiColon, STR("SemiColon"), STR(";")));
+    tc.set_eof_token(BenchTokenType::EndOfFile);
+    return tc;
+}
+
+// Reads the data of every token that has data, which is the part of parsing that depends on the tokenizer
+class BenchTokenParser : public ParserBase::TokenParser
+{
+  public:
+    size_t m_num_data_characters{};
+
+  public:
+    BenchTokenParser(const ParserBase::Tokenizer& tokenizer, File::StringType& input) : TokenParser(tokenizer, input)
+    {
+    }
+
+  protected:
+    auto parse_token(const ParserBase::Token& token) -> void override
+    {
+        if (token.has_data())
+        {
+            m_num_data_characters += get_data(token).size();
+        }
+    }
+};
+
+static auto generate_input(size_t num_bytes) -> File::StringType
+{
+    File::StringType input;
+    input.reserve(num_bytes + 256);
+
+    size_t section_index{};
+    while (input.size() * sizeof(File::CharType) < num_bytes)
+    {
+        input.append(STR("; Offsets for class number "));
+        input.append(File::StringType(1, static_cast<File::CharType>(STR('0') + section_index % 10)));
+        input.append(STR("\r\n[BenchClass"));
+        input.append(File::StringType(1, static_cast<File::CharType>(STR('A') + section_index % 26)));
+        input.append(STR("]\r\n"));
+        for (size_t member_index = 0; member_index < 24; ++member_index)
+        {
+            input.append(STR("MemberVariableNumber"));
+            input.append(File::StringType(1, static_cast<File::CharType>(STR('a') + member_index % 26)));
+            input.append(STR(" = 0x"));
+            input.append(File::StringType(1, static_cast<File::CharType>(STR('0') + member_index % 10)));
+            input.append(STR("A8\r\n"));
+        }
+        input.append(STR("\r\n"));
+        ++section_index;
+    }
+
+    return input;
+}
+
+template <typename Callable>
+static auto best_of(int num_runs, Callable&& callable) -> double
+{
+    double best_seconds{1e30};
+    for (int run = 0; run < num_runs; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        callable();
+        const auto end = std::chrono::steady_clock::now();
+        best_seconds = std::min(best_seconds, std::chrono::duration<double>(end - start).count());
+    }
+    return best_seconds;
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    const size_t input_size_in_mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8;
+    auto input = generate_input(input_size_in_mb * 1024 * 1024);
+    const double input_mb = static_cast<double>(input.size() * sizeof(File::CharType)) / (1024.0 * 1024.0);
+
+    size_t num_tokens{};
+    const auto tokenize_seconds = best_of(3, [&] {
+        ParserBase::Tokenizer tokenizer;
+        tokenizer.set_available_tokens(create_available_tokens());
+        tokenizer.tokenize(input);
+        num_tokens = tokenizer.get_tokens().size();
+    });
+
+    size_t num_data_characters{};
+    const auto parse_seconds = best_of(3, [&] {
+        ParserBase::Tokenizer tokenizer;
+        tokenizer.set_available_tokens(create_available_tokens());
+        tokenizer.tokenize(input);
+        BenchTokenParser parser{tokenizer, input};
+        parser.parse();
+        num_data_characters = parser.m_num_data_characters;
+    });
+
+    std::printf("input: %.1f MB, %zu tokens, %zu data characters\n", input_mb, num_tokens, num_data_characters);
+    std::printf("tokenize:         %8.1f ms  %8.1f MB/s\n", tokenize_seconds * 1000.0, input_mb / tokenize_seconds);
+    std::printf("tokenize + parse: %8.1f ms  %8.1f MB/s\n", parse_seconds * 1000.0, input_mb / parse_seconds);
+    return 0;
+}
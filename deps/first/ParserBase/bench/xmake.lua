@@ -0,0 +1,19 @@
+-- Standalone benchmark for the tokenizer
+-- It isn't part of the UE4SS build, which only targets Windows, and can be built on Linux with:
+--   cd deps/first/ParserBase/bench && xmake && xmake run TokenizerBench [input size in MB]
+set_xmakever("2.9.3")
+set_project("ParserBaseBench")
+
+add_rules("mode.release", "mode.debug")
+set_defaultmode("release")
+
+target("TokenizerBench")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_PARSER_BASE_BUILD_STATIC", "RC_FILE_BUILD_STATIC")
+    add_includedirs("../include", "../../File/include", "../../String/include", "../../Constructs/include")
+
+    add_files("TokenizerBench.cpp")
+    add_files("../src/Token.cpp", "../src/Tokenizer.cpp", "../src/TokenParser.cpp")
@@ -42,19 +42,35 @@ namespace RC::ParserBase
         };
 
       private:
-        File::StringType m_debug_name;
-        File::StringType m_identifier;
-        std::vector<std::shared_ptr<TokenRule>> m_rules;
+        // Everything that describes a token type, shared by the available token and every token that the tokenizer finds
+        struct Definition
+        {
+            File::StringType debug_name;
+            File::StringType identifier;
+            std::vector<std::shared_ptr<TokenRule>> rules;
+            HasData has_data;
+        };
+
+      private:
+        // Empty for tokens found by the tokenizer, they point at the definition of the available token instead of copying it
+        // This means that a found token is only valid for as long as the Tokenizer that found it
+        std::shared_ptr<Definition> m_owned_definition;
+        const Definition* m_definition;
         int m_type; // To be cast to an enum before use. This is to avoid using a template which forces everything to be in the header file.
         mutable size_t m_start{};
         mutable size_t m_end{};
         mutable size_t m_line{};
         mutable size_t m_column{};
-        HasData m_has_data;
 
       public:
         RC_PB_API Token(int type, File::StringViewType name, File::StringViewType identifier, HasData has_data = HasData::No);
 
+      private:
+        // Used by the tokenizer for the tokens that it finds in the input
+        RC_PB_API Token(const Token& available_token, size_t start, size_t end, size_t line, size_t column);
+
+        RC_PB_API auto get_owned_definition() -> Definition&;
+
       public:
         RC_PB_API auto get_type() const -> int;
         RC_PB_API auto set_has_data(HasData) -> void;
@@ -70,7 +86,7 @@ namespace RC::ParserBase
         template <typename TokenRuleType>
         auto add_rule(std::shared_ptr<TokenRuleType>&& token_rule) -> void
         {
-            m_rules.emplace_back(std::move(token_rule));
+            get_owned_definition().rules.emplace_back(std::move(token_rule));
         }
 
         RC_PB_API auto get_rules() const -> const std::vector<std::shared_ptr<TokenRule>>&;
@@ -34,7 +34,8 @@ namespace RC::ParserBase
 
       private:
         const class Tokenizer& m_tokenizer;
-        mutable File::StringType m_data;
+        // The input that was given to the tokenizer, it must outlive the parser
+        File::StringViewType m_data;
 
       protected:
         mutable size_t m_current_token_index_being_parsed{0};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -41,11 +43,27 @@ namespace RC::ParserBase
         size_t m_current_line{0};
         size_t m_current_column{0};
 
+      private:
+        // Characters below this get their own list of candidate tokens, all other characters share one list
+        constexpr static size_t num_dispatch_characters = 128;
+        constexpr static size_t non_ascii_dispatch_index = num_dispatch_characters;
+        constexpr static size_t end_of_input_dispatch_index = num_dispatch_characters + 1;
+
+        // Indices into the available tokens, in the order that they were added, of the tokens that can match at a character
+        // A token is a candidate if its identifier starts with the character or if its identifier is empty (matches everything)
+        std::array<std::vector<uint32_t>, num_dispatch_characters + 2> m_candidates_by_first_character{};
+
       public:
         RC_PB_API auto set_available_tokens(TokenContainer&&) -> void;
         // TODO: Maybe the constructor should take the input instead of 'tokenize'
-        RC_PB_API auto tokenize(const File::StringType& input) -> void;
+        // The tokens that are found only store offsets into 'input', and they share the definitions of the available tokens
+        // 'input' isn't copied, it only needs to stay alive until 'tokenize' returns
+        RC_PB_API auto tokenize(File::StringViewType input) -> void;
         [[nodiscard]] RC_PB_API auto get_tokens() const -> const std::vector<Token>&;
         [[nodiscard]] RC_PB_API auto get_last_token() const -> const Token&;
+
+      private:
+        auto build_dispatch_table() -> void;
+        auto get_candidates(File::StringViewType input, size_t cursor) const -> const std::vector<uint32_t>&;
     };
 } // namespace RC::ParserBase
@@ -1,10 +1,27 @@
+#include <stdexcept>
+
 #include <ParserBase/Token.hpp>
 
 namespace RC::ParserBase
 {
     Token::Token(int type, File::StringViewType name, File::StringViewType identifier, Token::HasData has_data)
-        : m_debug_name(name), m_identifier(identifier), m_type(type), m_has_data(has_data)
+        : m_owned_definition(std::make_shared<Definition>(File::StringType{name}, File::StringType{identifier}, std::vector<std::shared_ptr<TokenRule>>{}, has_data)),
+          m_definition(m_owned_definition.get()), m_type(type)
+    {
+    }
+
+    Token::Token(const Token& available_token, size_t start, size_t end, size_t line, size_t column)
+        : m_definition(available_token.m_definition), m_type(available_token.m_type), m_start(start), m_end(end), m_line(line), m_column(column)
+    {
+    }
+
+    auto Token::get_owned_definition() -> Definition&
     {
+        if (!m_owned_definition)
+        {
+            throw std::runtime_error{"[Token::get_owned_definition] Tokens found by the tokenizer can't be changed, change the available token instead"};
+        }
+        return *m_owned_definition;
     }
 
     auto Token::get_type() const -> int
@@ -14,12 +31,12 @@ namespace RC::ParserBase
 
     auto Token::set_has_data(HasData new_has_data) -> void
     {
-        m_has_data = new_has_data;
+        get_owned_definition().has_data = new_has_data;
     }
 
     auto Token::has_data() const -> bool
     {
-        return m_has_data == HasData::Yes;
+        return m_definition->has_data == HasData::Yes;
     }
 
     auto Token::set_start(size_t new_start) -> void
@@ -44,7 +61,7 @@ namespace RC::ParserBase
 
     auto Token::get_identifier() const -> File::StringViewType
     {
-        return m_identifier;
+        return m_definition->identifier;
     }
 
     auto Token::get_line() const -> size_t
@@ -59,12 +76,12 @@ namespace RC::ParserBase
 
     auto Token::get_rules() const -> const std::vector<std::shared_ptr<TokenRule>>&
     {
-        return m_rules;
+        return m_definition->rules;
     }
 
     auto Token::to_string() const -> File::StringType
     {
-        return m_debug_name;
+        return m_definition->debug_name;
     }
 
     auto Token::create(int type, File::StringViewType name, File::StringViewType identifier, HasData has_data) -> Token
@@ -21,8 +21,7 @@ namespace RC::ParserBase
         }
 
         auto data = m_data.substr(token.get_start(), token.get_end() - token.get_start() + 1);
-        data.erase(std::find(data.begin(), data.end(), STR('\0')), data.end());
-        return data;
+        return File::StringType{data.substr(0, data.find(STR('\0')))};
     }
 
     /*
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <fstream>
 #include <sstream>
+#include <type_traits>
 
 #include <ParserBase/Token.hpp>
 #include <ParserBase/Tokenizer.hpp>
@@ -41,7 +43,44 @@ namespace RC::ParserBase
         m_token_container = std::move(token_container);
     }
 
-    auto Tokenizer::tokenize(const File::StringType& input) -> void
+    auto Tokenizer::build_dispatch_table() -> void
+    {
+        for (auto& candidates : m_candidates_by_first_character)
+        {
+            candidates.clear();
+        }
+
+        const auto& tokens = m_token_container.get_all();
+        for (uint32_t token_index = 0; token_index < tokens.size(); ++token_index)
+        {
+            auto identifier = tokens[token_index].get_identifier();
+            if (identifier.empty())
+            {
+                for (auto& candidates : m_candidates_by_first_character)
+                {
+                    candidates.emplace_back(token_index);
+                }
+                continue;
+            }
+
+            const auto first_character = static_cast<std::make_unsigned_t<File::CharType>>(identifier[0]);
+            const auto dispatch_index = first_character < num_dispatch_characters ? first_character : non_ascii_dispatch_index;
+            m_candidates_by_first_character[dispatch_index].emplace_back(token_index);
+        }
+    }
+
+    auto Tokenizer::get_candidates(File::StringViewType input, size_t cursor) const -> const std::vector<uint32_t>&
+    {
+        if (cursor >= input.size())
+        {
+            return m_candidates_by_first_character[end_of_input_dispatch_index];
+        }
+
+        const auto character = static_cast<std::make_unsigned_t<File::CharType>>(input[cursor]);
+        return m_candidates_by_first_character[character < num_dispatch_characters ? character : non_ascii_dispatch_index];
+    }
+
+    auto Tokenizer::tokenize(File::StringViewType input) -> void
     {
         // printf_s("Tokenizer::tokenize()\n\n");
 
@@ -75,54 +114,32 @@ namespace RC::ParserBase
             throw std::runtime_error{"[Tokenizer::tokenize] Input was empty"};
         }
 
-        File::StringType a;
+        build_dispatch_table();
 
-        const File::CharType* input_array = input.c_str();
+        const auto& available_tokens = m_token_container.get_all();
+        const File::CharType* c = input.data();
         size_t global_cursor{};
 
-        auto peek = [&](File::StringType& out_str, const File::CharType* character, size_t num_chars) -> void {
-            if (global_cursor + num_chars <= input.size())
-            {
-                for (size_t i = 0; i < num_chars; ++i)
-                {
-                    out_str += *character;
-                    ++character;
-                }
-            }
-        };
-
-        struct TokenFoundWrapper
-        {
-            const Token* token{nullptr};
-            bool matched_anything{false};
-        };
-
-        File::StringType current_empty_token{};
-        File::StringType empty_token_data{};
-        TokenFoundWrapper empty_token{};
+        // Consecutive characters that only matched a token with an empty identifier are combined into one token
+        const Token* empty_token{};
         size_t start_of_empty_token{};
-        bool start_of_empty_token_set{};
-        const File::CharType* c = input_array;
 
         auto deal_with_possible_empty_token = [&]() {
-            if (empty_token.token)
+            if (empty_token)
             {
-                empty_token.token->m_start = start_of_empty_token;
-                empty_token.token->m_end = global_cursor - 1;
-                empty_token.token->m_line = m_current_line;
-                empty_token.token->m_column = m_current_column + 1;
-                m_tokens_in_input.emplace_back(*empty_token.token);
-                empty_token_data.clear();
-                empty_token = {};
-                start_of_empty_token_set = false;
+                empty_token->m_start = start_of_empty_token;
+                empty_token->m_end = global_cursor - 1;
+                m_tokens_in_input.emplace_back(Token{*empty_token, start_of_empty_token, global_cursor - 1, m_current_line, m_current_column + 1});
+                empty_token = nullptr;
             }
         };
 
         for (; global_cursor < input.size(); ++c, ++global_cursor)
         {
-            TokenFoundWrapper token_found{};
+            const Token* token_found{};
+            bool token_found_matched_anything{};
 
-            if (c && *c == STR('\n'))
+            if (*c == STR('\n'))
             {
                 ++m_current_line;
                 m_current_column = 0;
@@ -132,79 +149,89 @@ namespace RC::ParserBase
                 ++m_current_column;
             }
 
-            for (auto& token : m_token_container.get_all())
+            // The candidates are tried in the order that the tokens were added, the first token with a matching identifier wins
+            // Tokens with an empty identifier match everything, but they don't stop the search for a token with a matching identifier
+            const auto* candidates = &get_candidates(input, global_cursor);
+            for (size_t candidate_index = 0; candidate_index < candidates->size(); ++candidate_index)
             {
-                int advance_cursor_by{-1};
-                bool all_rules_obeyed{true};
+                const auto token_index = (*candidates)[candidate_index];
+                const auto& token = available_tokens[token_index];
 
                 File::StringViewType identifier_to_find = token.get_identifier();
-                File::StringType compare_to;
                 size_t identifier_size = identifier_to_find.size();
-                peek(compare_to, c, identifier_size);
                 bool identifier_should_match_all = identifier_to_find.empty();
 
-                // Empty identifier matches everything
-                if (identifier_to_find == compare_to || identifier_should_match_all)
+                if (!identifier_should_match_all &&
+                    (global_cursor + identifier_size > input.size() || File::StringViewType{c, identifier_size} != identifier_to_find))
                 {
-                    for (const auto& rule : token.get_rules())
-                    {
-                        advance_cursor_by = rule->exec(token, c, global_cursor, *this);
+                    continue;
+                }
 
-                        if (advance_cursor_by == -1)
-                        {
-                            all_rules_obeyed = false;
-                        }
-                    }
+                int advance_cursor_by{-1};
+                bool all_rules_obeyed{true};
+                for (const auto& rule : token.get_rules())
+                {
+                    advance_cursor_by = rule->exec(token, c, global_cursor, *this);
 
-                    if (all_rules_obeyed /* && !identifier_should_match_all*/)
+                    if (advance_cursor_by == -1)
                     {
-                        // current_empty_token.clear();
-                        token_found = {.token = &token, .matched_anything = identifier_should_match_all};
-                        token_found.token->m_start = global_cursor;
-
-                        if (identifier_size > 1)
-                        {
-                            advance_cursor_by += static_cast<int>(advance_cursor_by == -1 ? identifier_size : identifier_size - 1);
-                        }
-
-                        if (advance_cursor_by > 0)
-                        {
-                            c += advance_cursor_by;
-                            global_cursor += advance_cursor_by;
-                            m_current_column += advance_cursor_by;
-                        }
-
-                        token_found.token->m_end = global_cursor;
-
-                        if (!identifier_should_match_all)
-                        {
-                            break;
-                        }
+                        all_rules_obeyed = false;
                     }
                 }
+
+                if (!all_rules_obeyed)
+                {
+                    continue;
+                }
+
+                token_found = &token;
+                token_found_matched_anything = identifier_should_match_all;
+                token.m_start = global_cursor;
+
+                if (identifier_size > 1)
+                {
+                    advance_cursor_by += static_cast<int>(advance_cursor_by == -1 ? identifier_size : identifier_size - 1);
+                }
+
+                if (advance_cursor_by > 0)
+                {
+                    c += advance_cursor_by;
+                    global_cursor += advance_cursor_by;
+                    m_current_column += advance_cursor_by;
+                }
+
+                token.m_end = global_cursor;
+
+                if (!identifier_should_match_all)
+                {
+                    break;
+                }
+
+                // A rule moved the cursor, the remaining tokens are matched against the character that the cursor was moved to
+                if (advance_cursor_by > 0)
+                {
+                    candidates = &get_candidates(input, global_cursor);
+                    candidate_index = std::upper_bound(candidates->begin(), candidates->end(), token_index) - candidates->begin();
+                    --candidate_index;
+                }
             }
 
-            if (token_found.token)
+            if (token_found)
             {
-                if (token_found.matched_anything)
+                if (token_found_matched_anything)
                 {
-                    if (!start_of_empty_token_set)
+                    if (!empty_token)
                     {
                         start_of_empty_token = global_cursor;
-                        start_of_empty_token_set = true;
                     }
 
-                    empty_token_data += *c;
                     empty_token = token_found;
                 }
                 else
                 {
                     deal_with_possible_empty_token();
 
-                    token_found.token->m_line = m_current_line;
-                    token_found.token->m_column = m_current_column;
-                    m_tokens_in_input.emplace_back(*token_found.token);
-                    a.clear();
+                    m_tokens_in_input.emplace_back(Token{*token_found, token_found->m_start, token_found->m_end, m_current_line, m_current_column});
                 }
             }
         }
@@ -0,0 +1,221 @@
+// Measures how long it takes to forward many matches to the containers while several threads scan the same memory
+// Compares the scanner, which collects the matches of each chunk in its own buffer and forwards one chunk at a time,
+// with the way matches used to be forwarded, where every thread called the container under one global mutex as soon as it found a match
+// Usage: MatchDispatchBench [buffer size in MB] [highest number of threads]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SigScanner/MemorySource.hpp>
+#include <SigScanner/SinglePassSigScanner.hpp>
+
+using namespace RC;
+
+// Every byte of the buffer is readable
+class BufferMemorySource : public MemorySource
+{
+  private:
+    std::span<uint8_t> m_buffer;
+
+  public:
+    explicit BufferMemorySource(std::span<uint8_t> buffer) : m_buffer(buffer)
+    {
+    }
+
+  public:
+    auto query(const uint8_t* address) const -> std::optional<MemoryRegion> override
+    {
+        if (address < m_buffer.data() || address >= m_buffer.data() + m_buffer.size())
+        {
+            return std::nullopt;
+        }
+        return MemoryRegion{.base = m_buffer.data(), .size = m_buffer.size(), .is_readable = true};
+    }
+};
+
+template <typename Callable>
+static auto measure_seconds(Callable&& callable) -> double
+{
+    // Best of three runs to reduce noise from the rest of the system
+    double best_seconds = 1e30;
+    for (int run = 0; run < 3; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        callable();
+        best_seconds = std::min(best_seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best_seconds;
+}
+
+static constexpr size_t s_num_containers = 16;
+static constexpr size_t s_signature_length = 12;
+static constexpr size_t s_num_copies_per_signature = 10'000;
+
+// Random bytes with every signature planted many times, so that there are far more matches than chunks
+static auto make_buffer(size_t size, std::vector<std::string>& signatures) -> std::vector<uint8_t>
+{
+    std::mt19937 random{1234};
+    std::vector<uint8_t> buffer(size);
+    for (auto& byte : buffer)
+    {
+        byte = static_cast<uint8_t>(random());
+    }
+
+    for (size_t container = 0; container < s_num_containers; ++container)
+    {
+        std::vector<uint8_t> bytes(s_signature_length);
+        std::string signature{};
+        for (auto& byte : bytes)
+        {
+            static constexpr char hex_digits[] = "0123456789ABCDEF";
+            byte = static_cast<uint8_t>(random());
+            signature += signature.empty() ? "" : " ";
+            signature += hex_digits[byte >> 4];
+            signature += hex_digits[byte & 0xF];
+        }
+        signatures.emplace_back(std::move(signature));
+
+        for (size_t copy = 0; copy < s_num_copies_per_signature; ++copy)
+        {
+            std::ranges::copy(bytes, buffer.begin() + static_cast<ptrdiff_t>(random() % (size - bytes.size())));
+        }
+    }
+    return buffer;
+}
+
+// What a mod does with a match, 'work' stands in for resolving the address that the signature points at
+struct MatchReceiver
+{
+    size_t work{};
+    std::vector<size_t> num_matches_per_container = std::vector<size_t>(s_num_containers);
+    uint64_t checksum{};
+
+    auto receive(size_t container, const uint8_t* match_address) -> void
+    {
+        ++num_matches_per_container[container];
+        auto value = reinterpret_cast<uint64_t>(match_address);
+        for (size_t i = 0; i < work; ++i)
+        {
+            value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+        checksum += value;
+    }
+
+    auto get_num_matches() const -> size_t
+    {
+        size_t num_matches{};
+        for (const auto container_num_matches : num_matches_per_container)
+        {
+            num_matches += container_num_matches;
+        }
+        return num_matches;
+    }
+};
+
+static auto make_containers(const std::vector<std::string>& signatures, MatchReceiver& receiver) -> std::vector<SignatureContainer>
+{
+    std::vector<SignatureContainer> signature_containers{};
+    for (size_t container = 0; container < signatures.size(); ++container)
+    {
+        signature_containers.emplace_back(
+                std::vector<SignatureData>{SignatureData{.signature = signatures[container]}},
+                [&receiver, container](SignatureContainer& self) {
+                    receiver.receive(container, self.get_match_address());
+                    return false;
+                },
+                [](SignatureContainer&) {});
+    }
+    return signature_containers;
+}
+
+// The module is split into one range per thread, and every match is forwarded under one mutex right after the piece of the range it's in is scanned
+static auto scan_with_global_mutex(std::span<uint8_t> buffer,
+                                   std::vector<SignatureContainer>& signature_containers,
+                                   MatchReceiver& receiver,
+                                   uint32_t num_threads) -> void
+{
+    // Small enough that the threads keep forwarding while the others scan, like a thread that forwarded every match as it found it
+    static constexpr size_t piece_size = 0x10000;
+    std::mutex mutex{};
+    const size_t range_size = (buffer.size() + num_threads - 1) / num_threads;
+
+    std::vector<std::jthread> threads{};
+    for (uint32_t thread = 0; thread < num_threads; ++thread)
+    {
+        threads.emplace_back([&, thread] {
+            std::vector<ScanMatch> matches{};
+            const size_t range_start = std::min(buffer.size(), thread * range_size);
+            const size_t range_end = std::min(buffer.size(), range_start + range_size);
+            for (size_t piece_start = range_start; piece_start < range_end; piece_start += piece_size)
+            {
+                matches.clear();
+                SinglePassScanner::scanner_work_thread(buffer.data() + piece_start,
+                                                       buffer.data() + std::min(range_end, piece_start + piece_size),
+                                                       signature_containers,
+                                                       matches);
+                for (const auto& match : matches)
+                {
+                    std::lock_guard lock{mutex};
+                    receiver.receive(match.container_index, match.match_address);
+                }
+            }
+        });
+    }
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    const size_t buffer_size = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64) * 1024 * 1024;
+    const uint32_t max_threads = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : std::max(8u, std::thread::hardware_concurrency());
+
+    std::vector<std::string> signatures{};
+    auto buffer = make_buffer(buffer_size, signatures);
+    BufferMemorySource memory_source{buffer};
+    SinglePassScanner::set_memory_source(&memory_source);
+    SinglePassScanner::m_scan_method = SinglePassScanner::ScanMethod::Vectorized;
+
+    std::printf("Buffer: %zu MB, signatures: %zu, hardware threads: %u\n\n", buffer_size / 1024 / 1024, signatures.size(), std::thread::hardware_concurrency());
+
+    for (const size_t work : {0, 1000})
+    {
+        for (uint32_t num_threads = 1; num_threads <= max_threads; num_threads *= 2)
+        {
+            SinglePassScanner::m_num_threads = num_threads;
+
+            MatchReceiver mutex_receiver{.work = work};
+            auto mutex_containers = make_containers(signatures, mutex_receiver);
+            const double mutex_seconds = measure_seconds([&] {
+                mutex_receiver.num_matches_per_container.assign(s_num_containers, 0);
+                scan_with_global_mutex(buffer, mutex_containers, mutex_receiver, num_threads);
+            });
+
+            MatchReceiver chunk_receiver{.work = work};
+            auto chunk_containers = make_containers(signatures, chunk_receiver);
+            const double chunk_seconds = measure_seconds([&] {
+                chunk_receiver.num_matches_per_container.assign(s_num_containers, 0);
+                SinglePassScanner::scan_range(buffer.data(), buffer.size(), chunk_containers);
+            });
+
+            std::printf("callback work: %4zu  threads: %2u  global mutex: %8.2f ms  per-chunk buffers: %8.2f ms  (%.2fx)  matches: %zu / %zu\n",
+                        work,
+                        num_threads,
+                        mutex_seconds * 1000.0,
+                        chunk_seconds * 1000.0,
+                        mutex_seconds / chunk_seconds,
+                        mutex_receiver.get_num_matches(),
+                        chunk_receiver.get_num_matches());
+        }
+        std::printf("\n");
+    }
+
+    SinglePassScanner::set_memory_source(nullptr);
+    return 0;
+}
@@ -0,0 +1,214 @@
+// Measures signature scan throughput of every ScanMethod on a PE image mapped from disk, or on a synthetic one
+// Usage: SigScanBench [path to a PE file | synthetic .text size in MB] [number of threads]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SigScanner/MappedPeFile.hpp>
+#include <SigScanner/MultiPatternMatcher.hpp>
+#include <SigScanner/SinglePassSigScanner.hpp>
+
+using namespace RC;
+
+template <typename Callable>
+static auto measure_seconds(Callable&& callable) -> double
+{
+    // Best of three runs to reduce noise from the rest of the system
+    // A run that takes seconds isn't noticeably affected by noise, and repeating it would make the slow methods dominate the run time
+    double best_seconds = 1e30;
+    for (int run = 0; run < 3 && (run == 0 || best_seconds < 2.0); ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        callable();
+        best_seconds = std::min(best_seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best_seconds;
+}
+
+template <typename IntType>
+static auto write_le(std::vector<uint8_t>& buffer, size_t offset, IntType value) -> void
+{
+    for (size_t i = 0; i < sizeof(IntType); ++i)
+    {
+        buffer[offset + i] = static_cast<uint8_t>(static_cast<uint64_t>(value) >> (i * 8));
+    }
+}
+
+// A minimal PE32+ file with a .text section full of bytes distributed roughly like x86-64 code, followed by a small .data section
+static auto make_synthetic_pe_file(size_t text_size) -> std::vector<uint8_t>
+{
+    static constexpr size_t headers_size = 0x400;
+    static constexpr size_t data_size = 0x10000;
+    text_size = (text_size + 0xFFF) & ~size_t{0xFFF};
+
+    std::vector<uint8_t> file(headers_size + text_size + data_size);
+
+    static constexpr size_t nt_headers_offset = 0x80;
+    static constexpr size_t optional_header_offset = nt_headers_offset + 24;
+    static constexpr size_t optional_header_size = 240;
+    static constexpr size_t section_table_offset = optional_header_offset + optional_header_size;
+
+    write_le<uint16_t>(file, 0, 0x5A4D);
+    write_le<uint32_t>(file, 0x3C, nt_headers_offset);
+    write_le<uint32_t>(file, nt_headers_offset, 0x00004550);
+    write_le<uint16_t>(file, nt_headers_offset + 4, 0x8664);
+    write_le<uint16_t>(file, nt_headers_offset + 6, 2);
+    write_le<uint32_t>(file, nt_headers_offset + 8, 0x5F5E0FF);
+    write_le<uint16_t>(file, nt_headers_offset + 20, optional_header_size);
+    write_le<uint16_t>(file, optional_header_offset, 0x20B);
+    write_le<uint32_t>(file, optional_header_offset + 56, static_cast<uint32_t>(0x1000 + text_size + data_size));
+    write_le<uint32_t>(file, optional_header_offset + 60, headers_size);
+
+    auto write_section = [&](size_t index, const char* name, uint32_t virtual_address, uint32_t size, uint32_t file_offset, uint32_t characteristics) {
+        const size_t offset = section_table_offset + index * 40;
+        std::memcpy(file.data() + offset, name, std::strlen(name));
+        write_le<uint32_t>(file, offset + 8, size);
+        write_le<uint32_t>(file, offset + 12, virtual_address);
+        write_le<uint32_t>(file, offset + 16, size);
+        write_le<uint32_t>(file, offset + 20, file_offset);
+        write_le<uint32_t>(file, offset + 36, characteristics);
+    };
+    write_section(0, ".text", 0x1000, static_cast<uint32_t>(text_size), headers_size, 0x60000020);
+    write_section(1, ".data", static_cast<uint32_t>(0x1000 + text_size), data_size, static_cast<uint32_t>(headers_size + text_size), 0xC0000040);
+
+    // Common bytes are much more common than rare ones, the anchor filters would look unrealistically good on uniform random bytes
+    std::vector<double> weights(256);
+    for (size_t byte = 0; byte < weights.size(); ++byte)
+    {
+        const double rank = MultiPatternMatcher::get_byte_frequency(static_cast<uint8_t>(byte)) + 1.0;
+        weights[byte] = rank * rank;
+    }
+    std::discrete_distribution<int> byte_distribution{weights.begin(), weights.end()};
+    std::mt19937_64 random{1234};
+    std::generate_n(file.begin() + headers_size, text_size, [&] {
+        return static_cast<uint8_t>(byte_distribution(random));
+    });
+
+    return file;
+}
+
+// Signatures copied from random places in .text with some bytes replaced by wildcards, the same shape as the signatures UE4SS uses
+static auto make_signatures(const MappedPeFile& image, size_t num_signatures) -> std::vector<SignatureData>
+{
+    const auto* text = image.get_pe_image().find_section(".text");
+    if (!text)
+    {
+        text = &image.get_pe_image().get_sections().front();
+    }
+
+    auto* image_base = const_cast<MappedPeFile&>(image).get_image_base();
+    std::mt19937_64 random{5678};
+    std::vector<SignatureData> signatures{};
+    for (size_t signature_index = 0; signature_index < num_signatures; ++signature_index)
+    {
+        static constexpr size_t signature_length = 16;
+        const size_t offset = text->virtual_address + random() % (std::max<size_t>(text->virtual_size, signature_length + 1) - signature_length);
+
+        std::string signature{};
+        for (size_t i = 0; i < signature_length; ++i)
+        {
+            static constexpr char hex_digits[] = "0123456789ABCDEF";
+            if (random() % 5 == 0 && i > 0)
+            {
+                signature += "??";
+            }
+            else
+            {
+                signature += hex_digits[image_base[offset + i] >> 4];
+                signature += hex_digits[image_base[offset + i] & 0xF];
+            }
+            signature += i + 1 < signature_length ? " " : "";
+        }
+        signatures.emplace_back(SignatureData{.signature = std::move(signature)});
+    }
+    return signatures;
+}
+
+static auto to_string(SinglePassScanner::ScanMethod scan_method) -> const char*
+{
+    switch (scan_method)
+    {
+    case SinglePassScanner::ScanMethod::Scalar:
+        return "Scalar";
+    case SinglePassScanner::ScanMethod::StdFind:
+        return "StdFind";
+    case SinglePassScanner::ScanMethod::Vectorized:
+        return "Vectorized";
+    case SinglePassScanner::ScanMethod::MultiPattern:
+        return "MultiPattern";
+    }
+    return "Unknown";
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    std::unique_ptr<MappedPeFile> image{};
+    if (argc > 1 && std::strtoull(argv[1], nullptr, 10) == 0)
+    {
+        image = MappedPeFile::open(argv[1]);
+    }
+    else
+    {
+        const size_t text_size = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64) * 1024 * 1024;
+        image = std::make_unique<MappedPeFile>(make_synthetic_pe_file(text_size));
+    }
+
+    SinglePassScanner::m_num_threads = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : std::max(1u, std::thread::hardware_concurrency());
+    SinglePassScanner::set_memory_source(image.get());
+
+    std::printf("Image: %zu MB, threads: %u, instruction set: %d\n\n",
+                image->get_size_of_image() / 1024 / 1024,
+                SinglePassScanner::m_num_threads,
+                static_cast<int>(PatternMatcher::get_instruction_set()));
+
+    for (const size_t num_signatures : {1, 10, 50, 200})
+    {
+        const auto signatures = make_signatures(*image, num_signatures);
+
+        for (const auto scan_method : {SinglePassScanner::ScanMethod::Scalar,
+                                       SinglePassScanner::ScanMethod::StdFind,
+                                       SinglePassScanner::ScanMethod::Vectorized,
+                                       SinglePassScanner::ScanMethod::MultiPattern})
+        {
+            SinglePassScanner::m_scan_method = scan_method;
+
+            // One container per signature, every match is collected so that every method has to walk the whole image
+            size_t num_matches{};
+            std::vector<SignatureContainer> signature_containers{};
+            for (const auto& signature : signatures)
+            {
+                signature_containers.emplace_back(
+                        std::vector<SignatureData>{signature},
+                        [&](SignatureContainer&) {
+                            ++num_matches;
+                            return false;
+                        },
+                        [](SignatureContainer&) {});
+            }
+
+            const double seconds = measure_seconds([&] {
+                num_matches = 0;
+                SinglePassScanner::scan_range(image->get_image_base(), image->get_size_of_image(), signature_containers);
+            });
+
+            std::printf("%-14s signatures: %3zu  %9.2f ms  %7.2f GB/s  matches: %zu\n",
+                        to_string(scan_method),
+                        num_signatures,
+                        seconds * 1000.0,
+                        static_cast<double>(image->get_size_of_image()) / seconds / 1e9,
+                        num_matches);
+        }
+        std::printf("\n");
+    }
+
+    SinglePassScanner::set_memory_source(nullptr);
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Measures UTF-16 string search throughput on a synthetic 200 MB buffer
+// Usage: StringScanBench [buffer size in MB]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <SigScanner/WideStringSearcher.hpp>
+
+using namespace RC;
+
+template <typename Callable>
+static auto measure_seconds(Callable&& callable) -> double
+{
+    // Best of three runs to reduce noise from the rest of the system
+    double best_seconds = 1e30;
+    for (int run = 0; run < 3; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        callable();
+        best_seconds = std::min(best_seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best_seconds;
+}
+
+static auto report(const char* name, size_t num_strings, size_t buffer_size, double seconds, size_t num_found) -> void
+{
+    std::printf("%-28s strings: %3zu  %8.2f ms  %7.2f GB/s  found: %zu\n",
+                name,
+                num_strings,
+                seconds * 1000.0,
+                static_cast<double>(buffer_size) / seconds / 1e9,
+                num_found);
+}
+
+// The previous implementation of 'SinglePassScanner::string_scan', a full compare at every byte
+static auto naive_search(std::span<const uint8_t> data, const std::vector<uint8_t>& needle) -> const uint8_t*
+{
+    for (size_t offset = 0; offset + needle.size() <= data.size(); ++offset)
+    {
+        if (std::memcmp(data.data() + offset, needle.data(), needle.size()) == 0)
+        {
+            return data.data() + offset;
+        }
+    }
+    return nullptr;
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    const size_t buffer_size = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200) * 1024 * 1024;
+
+    // Random bytes interleaved with UTF-16 text so that the anchor filters see a realistic number of candidates
+    std::vector<uint8_t> buffer(buffer_size);
+    std::mt19937_64 random{1234};
+    static constexpr std::wstring_view filler_words[]{L"Engine", L"Object", L"Actor", L"Default__", L"Script", L"Function", L"Property", L"None"};
+    for (size_t offset = 0; offset < buffer.size();)
+    {
+        if (random() % 4 == 0)
+        {
+            const auto bytes = WideStringSearcher::to_utf16le(filler_words[random() % std::size(filler_words)]);
+            const size_t size = std::min(bytes.size(), buffer.size() - offset);
+            std::memcpy(buffer.data() + offset, bytes.data(), size);
+            offset += size;
+        }
+        else
+        {
+            const size_t size = std::min<size_t>(64, buffer.size() - offset);
+            for (size_t i = 0; i < size; ++i)
+            {
+                buffer[offset + i] = static_cast<uint8_t>(random());
+            }
+            offset += size;
+        }
+    }
+
+    // The strings being searched for are planted near the end, which is the worst case for a search that stops at the first match
+    std::vector<std::wstring> strings{};
+    for (size_t string_index = 0; string_index < 50; ++string_index)
+    {
+        strings.emplace_back(L"Benchmark string literal number " + std::to_wstring(string_index));
+        const auto bytes = WideStringSearcher::to_utf16le(strings.back());
+        const size_t offset = buffer.size() - (string_index + 1) * 256;
+        std::memcpy(buffer.data() + offset, bytes.data(), bytes.size());
+    }
+
+    std::printf("Buffer: %zu MB, instruction set: %d\n\n", buffer_size / 1024 / 1024, static_cast<int>(PatternMatcher::get_instruction_set()));
+
+    {
+        const auto needle = WideStringSearcher::to_utf16le(strings[0]);
+        const uint8_t* match{};
+        const double seconds = measure_seconds([&] {
+            match = naive_search(buffer, needle);
+        });
+        report("naive", 1, buffer.size(), seconds, match ? 1 : 0);
+    }
+
+    for (const size_t num_strings : {1, 10, 50})
+    {
+        std::vector<std::wstring_view> views(strings.begin(), strings.begin() + num_strings);
+
+        // One pass per string
+        size_t num_found{};
+        double seconds = measure_seconds([&] {
+            num_found = 0;
+            for (const auto view : views)
+            {
+                WideStringSearcher searcher{std::span{&view, 1}};
+                std::vector<const uint8_t*> first_matches(1);
+                searcher.search(buffer, first_matches);
+                num_found += first_matches[0] != nullptr;
+            }
+        });
+        report("one pass per string", num_strings, buffer.size(), seconds, num_found);
+
+        // All strings in one pass
+        if (num_strings > 1)
+        {
+            WideStringSearcher searcher{views};
+            seconds = measure_seconds([&] {
+                std::vector<const uint8_t*> first_matches(num_strings);
+                searcher.search(buffer, first_matches);
+                num_found = std::ranges::count_if(first_matches, [](const uint8_t* match) {
+                    return match != nullptr;
+                });
+            });
+            report("batched", num_strings, buffer.size(), seconds, num_found);
+        }
+    }
+
+    return 0;
+}
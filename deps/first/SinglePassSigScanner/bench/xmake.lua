@@ -0,0 +1,61 @@
+-- Standalone benchmarks for the portable parts of the scanner
+-- They aren't part of the UE4SS build, which only targets Windows, and can be built on Linux with:
+--   cd deps/first/SinglePassSigScanner/bench && xmake && xmake run StringScanBench
+--   xmake run SigScanBench [path to a game executable] [number of threads]
+--   xmake run MatchDispatchBench [buffer size in MB] [highest number of threads]
+set_xmakever("2.9.3")
+set_project("SinglePassSigScannerBench")
+
+add_rules("mode.release", "mode.debug")
+set_defaultmode("release")
+
+add_requires("fmt")
+
+target("StringScanBench")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_SINGLE_PASS_SIG_SCANNER_BUILD_STATIC")
+    add_includedirs("../include")
+
+    add_files("StringScanBench.cpp")
+    add_files("../src/PatternMatcher.cpp", "../src/MultiPatternMatcher.cpp", "../src/WideStringSearcher.cpp")
+
+    add_packages("fmt")
+
+target("SigScanBench")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_SINGLE_PASS_SIG_SCANNER_BUILD_STATIC")
+    add_includedirs("../include")
+
+    add_files("SigScanBench.cpp")
+    add_files("../src/PatternMatcher.cpp", "../src/MultiPatternMatcher.cpp", "../src/PeImage.cpp", "../src/MappedPeFile.cpp", "../src/WideStringSearcher.cpp")
+    add_files("../src/ScannerWorkerPool.cpp", "../src/ScanResultCache.cpp", "../src/SinglePassScannerCore.cpp")
+
+    add_packages("fmt")
+
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
+target("MatchDispatchBench")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_SINGLE_PASS_SIG_SCANNER_BUILD_STATIC")
+    add_includedirs("../include")
+
+    add_files("MatchDispatchBench.cpp")
+    add_files("../src/PatternMatcher.cpp", "../src/MultiPatternMatcher.cpp", "../src/PeImage.cpp", "../src/WideStringSearcher.cpp")
+    add_files("../src/ScannerWorkerPool.cpp", "../src/ScanResultCache.cpp", "../src/SinglePassScannerCore.cpp")
+
+    add_packages("fmt")
+
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
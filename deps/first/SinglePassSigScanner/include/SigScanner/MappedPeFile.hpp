@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <SigScanner/Common.hpp>
+#include <SigScanner/MemorySource.hpp>
+#include <SigScanner/PeImage.hpp>
+
+namespace RC
+{
+    // A PE file from disk laid out the way the Windows loader maps it, every section at its virtual address
+    // Nothing is executed and relocations aren't applied, this only exists so that images can be scanned outside of the game
+    // The headers and the sections are readable, the gaps between them aren't
+    class MappedPeFile : public MemorySource
+    {
+      private:
+        std::vector<uint8_t> m_image{};
+        PeImage m_pe_image{};
+
+        // Sorted and without gaps, covers the whole image
+        std::vector<MemoryRegion> m_regions{};
+
+      public:
+        // Throws std::runtime_error if 'file_contents' isn't a PE file
+        RC_SPSS_API explicit MappedPeFile(std::span<const uint8_t> file_contents);
+
+        // The regions point into 'm_image'
+        MappedPeFile(const MappedPeFile&) = delete;
+        auto operator=(const MappedPeFile&) -> MappedPeFile& = delete;
+
+      public:
+        // Throws std::runtime_error if the file can't be read or isn't a PE file
+        RC_SPSS_API auto static open(const std::filesystem::path& file_path) -> std::unique_ptr<MappedPeFile>;
+
+      public:
+        RC_SPSS_API auto query(const uint8_t* address) const -> std::optional<MemoryRegion> override;
+
+        [[nodiscard]] auto get_image_base() -> uint8_t*
+        {
+            return m_image.data();
+        }
+        [[nodiscard]] auto get_size_of_image() const -> size_t
+        {
+            return m_image.size();
+        }
+        [[nodiscard]] auto get_pe_image() const -> const PeImage&
+        {
+            return m_pe_image;
+        }
+    };
+} // namespace RC
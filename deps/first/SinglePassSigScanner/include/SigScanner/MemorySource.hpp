@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <SigScanner/Common.hpp>
+
+namespace RC
+{
+    struct RC_SPSS_API MemoryRegion
+    {
+        uint8_t* base{};
+        size_t size{};
+
+        // Whether every byte in the region can be read, regions that can't are skipped by the scanner
+        bool is_readable{};
+    };
+
+    // Where the scanner gets its memory layout from
+    // The scanner walks memory one region at a time and never reads past the end of a readable region
+    class MemorySource
+    {
+      public:
+        virtual ~MemorySource() = default;
+
+      public:
+        // Returns the region that contains 'address', or an empty optional if nothing is known about 'address' or anything after it
+        virtual auto query(const uint8_t* address) const -> std::optional<MemoryRegion> = 0;
+    };
+
+    // The memory of the current process, as reported by VirtualQuery
+    class ProcessMemorySource : public MemorySource
+    {
+      public:
+        RC_SPSS_API auto static get() -> ProcessMemorySource&;
+
+      public:
+        RC_SPSS_API auto query(const uint8_t* address) const -> std::optional<MemoryRegion> override;
+    };
+} // namespace RC
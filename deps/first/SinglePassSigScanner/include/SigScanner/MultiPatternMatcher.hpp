@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include <SigScanner/Common.hpp>
+#include <SigScanner/PatternMatcher.hpp>
+
+namespace RC
+{
+    // Searches for many patterns in a single pass over memory
+    // Every pattern is indexed by an anchor, the rarest run of four fully specified bytes in it or, if it has none, the rarest pair of them
+    // Each position in memory is looked up once per kind of anchor and only verified against the patterns that share the anchor found there,
+    // so the cost per byte barely grows with the number of patterns, unlike a single anchor byte that is far too common in code to tell many patterns apart
+    class MultiPatternMatcher
+    {
+      public:
+        // Called with the address of every match and the index that 'add_pattern' returned for the pattern, return true to stop searching
+        using MatchCallback = std::function<bool(const uint8_t* match_address, size_t pattern_index)>;
+
+      private:
+        // Anchors are looked up by key, the key of the pair at 'position' is 'data[position] | data[position + 1] << 8'
+        // and the key of the four bytes at 'position' is 'num_pair_keys' plus a hash of them, collisions only cost a verification
+        static constexpr size_t num_pair_keys = size_t{1} << 16;
+        static constexpr size_t num_quad_keys = size_t{1} << 17;
+        static constexpr size_t num_keys = num_pair_keys + num_quad_keys;
+
+        // Up to this many distinct starts of anchors are searched for with the vectorized filter, more fill its buckets and let most positions through
+        static constexpr size_t max_vectorized_anchor_starts = 16;
+
+        struct AnchorEntry
+        {
+            uint32_t pattern_index{};
+            // The offset of the first byte of the anchor in the pattern
+            uint32_t anchor_offset{};
+            // The 8 bytes of the pattern that start at the anchor, compared as one word to reject most candidates without reading the pattern
+            uint64_t window_bytes{};
+            uint64_t window_mask{};
+        };
+
+        // Nibble tables for the first four bytes of every anchor (its start), used by the vectorized filter
+        // Each start is put in one of 8 buckets, and a position is a candidate if all eight nibbles agree on a bucket
+        struct NibbleFilter
+        {
+            alignas(16) std::array<std::array<uint8_t, 16>, 4> low_nibble_buckets{};
+            alignas(16) std::array<std::array<uint8_t, 16>, 4> high_nibble_buckets{};
+        };
+
+      private:
+        std::vector<const BytePattern*> m_patterns{};
+        // One bit per key, small enough to stay in the L1 cache
+        std::vector<uint64_t> m_is_anchor_key{};
+        // The number of set bits in 'm_is_anchor_key' before each word, which turns a key into the index of its bucket without a table per key
+        std::vector<uint32_t> m_num_keys_before_word{};
+        // Sorted by key, the entries in bucket 'i' start at 'm_bucket_offsets[i]' and end at 'm_bucket_offsets[i + 1]'
+        std::vector<AnchorEntry> m_entries{};
+        std::vector<uint32_t> m_bucket_offsets{};
+        // Patterns that are one byte long, which are the only patterns that can match the last byte of the data
+        std::vector<uint32_t> m_single_byte_patterns{};
+        NibbleFilter m_nibble_filter{};
+        bool m_has_pair_anchors{};
+        bool m_is_vectorized_filter_usable{};
+        bool m_is_built{};
+
+      public:
+        // Returns the frequency rank of a byte in typical x86-64 code, lower is rarer
+        RC_SPSS_API auto static get_byte_frequency(uint8_t byte) -> uint8_t;
+
+        // Returns the offset of the rarest fully specified byte in the pattern
+        RC_SPSS_API auto static find_rarest_byte_offset(const BytePattern& pattern) -> size_t;
+
+        // Returns the offset of the first byte of the rarest run of 'run_length' fully specified bytes in the pattern
+        // Returns 'pattern.length' if the pattern has no such run
+        RC_SPSS_API auto static find_rarest_run_offset(const BytePattern& pattern, size_t run_length) -> size_t;
+
+      public:
+        // The pattern isn't copied and must outlive the matcher
+        RC_SPSS_API auto add_pattern(const BytePattern& pattern) -> size_t;
+
+        // Must be called after the last 'add_pattern' and before the first 'find_all'
+        RC_SPSS_API auto build() -> void;
+
+        [[nodiscard]] auto get_pattern_count() const -> size_t
+        {
+            return m_patterns.size();
+        }
+
+        // Calls 'on_match' for every occurrence of every pattern that fits entirely inside 'data'
+        // Matches are reported in the order of their anchor, which isn't necessarily the order of their start address
+        // Returns true if the search was stopped by the callback
+        RC_SPSS_API auto find_all(std::span<const uint8_t> data, const MatchCallback& on_match) const -> bool;
+        RC_SPSS_API auto find_all(std::span<const uint8_t> data, const MatchCallback& on_match, PatternMatcher::InstructionSet instruction_set) const -> bool;
+
+      private:
+        auto static get_quad_key(uint32_t quad) -> size_t
+        {
+            return num_pair_keys + ((quad * 0x9E3779B1u) >> (32 - std::countr_zero(num_quad_keys)));
+        }
+
+        [[nodiscard]] auto is_anchor_key(size_t key) const -> bool
+        {
+            return m_is_anchor_key[key / 64] >> (key % 64) & 1;
+        }
+
+        // The number of anchor keys below 'key'
+        [[nodiscard]] auto get_bucket(size_t key) const -> size_t
+        {
+            return m_num_keys_before_word[key / 64] + std::popcount(m_is_anchor_key[key / 64] & ((uint64_t{1} << (key % 64)) - 1));
+        }
+
+        // Verifies the patterns whose anchor has 'key' against the data at 'position', the key must be an anchor key
+        auto check_anchor(std::span<const uint8_t> data, size_t position, size_t key, const MatchCallback& on_match) const -> bool;
+        // Looks up both kinds of anchor at 'position'
+        auto check_position(std::span<const uint8_t> data, size_t position, const MatchCallback& on_match) const -> bool;
+        template <bool has_pair_anchors>
+        auto find_all_scalar(std::span<const uint8_t> data, size_t first_position, const MatchCallback& on_match) const -> bool;
+    };
+} // namespace RC
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <SigScanner/Common.hpp>
+
+namespace RC
+{
+    // A signature that has been converted from text into a value and a mask
+    // A byte in memory matches 'bytes[i]' if '(memory[i] & mask[i]) == bytes[i]'
+    // Both 'bytes' and 'mask' are zero-padded to a multiple of 'PatternMatcher::pattern_alignment' so that they can be compared in whole vectors
+    struct RC_SPSS_API BytePattern
+    {
+        std::vector<uint8_t> bytes{};
+        std::vector<uint8_t> mask{};
+
+        // The number of bytes in the signature, excluding padding
+        size_t length{};
+
+        // Offsets of two fully specified bytes that are used to discard candidates before the full compare
+        // These are usually the first and last fully specified bytes in the signature, and they can be the same byte
+        size_t first_anchor{};
+        size_t last_anchor{};
+
+        // Offset of the fully specified byte that is least common in x86-64 code
+        // Searching for this byte first produces the fewest candidates that have to be verified
+        size_t rarest_anchor{};
+    };
+
+    // Masked signature matching on a plain span of bytes
+    // This has no dependencies on the memory layout of the process so it can be used on any buffer
+    class PatternMatcher
+    {
+      public:
+        enum class InstructionSet
+        {
+            Scalar,
+            SSE2,
+            AVX2,
+        };
+
+        static constexpr size_t pattern_alignment = 32;
+
+        // Called with the address of every match, return true to stop searching
+        using MatchCallback = std::function<bool(const uint8_t* match_address)>;
+
+      public:
+        // Throws std::runtime_error if the signature is malformed or doesn't contain at least one fully specified byte
+        // Accepted formats: "48 8B ?? 05", "48 8B ? 05", "48 8B 0? 05" (nibble wildcard), "488B??05" and the legacy "4 8/8 B/? ?/0 5"
+        RC_SPSS_API auto static compile(std::string_view signature) -> BytePattern;
+
+        // Builds a pattern that matches exactly 'bytes', throws std::runtime_error if 'bytes' is empty
+        // The second anchor is the last non-zero byte, which avoids anchoring on the zero high byte of a UTF-16 character
+        RC_SPSS_API auto static from_bytes(std::span<const uint8_t> bytes) -> BytePattern;
+
+        // The best instruction set supported by both the build and the CPU, detected once
+        RC_SPSS_API auto static get_instruction_set() -> InstructionSet;
+
+        // Calls 'on_match' for every occurrence of 'pattern' that fits entirely inside 'data', in address order
+        // Returns true if the search was stopped by the callback
+        RC_SPSS_API auto static find_all(std::span<const uint8_t> data, const BytePattern& pattern, const MatchCallback& on_match) -> bool;
+        RC_SPSS_API auto static find_all(std::span<const uint8_t> data, const BytePattern& pattern, const MatchCallback& on_match, InstructionSet instruction_set)
+                -> bool;
+
+        // Returns the first match or nullptr
+        RC_SPSS_API auto static find_first(std::span<const uint8_t> data, const BytePattern& pattern) -> const uint8_t*;
+
+        // Compares every byte of the pattern at 'address', the caller must make sure that 'pattern.length' bytes are readable
+        RC_SPSS_API auto static matches_at(const uint8_t* address, const BytePattern& pattern) -> bool;
+    };
+} // namespace RC
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SigScanner/Common.hpp>
+
+namespace RC
+{
+    struct RC_SPSS_API PeSection
+    {
+        std::string name{};
+        uint32_t virtual_address{};
+        uint32_t virtual_size{};
+        uint32_t pointer_to_raw_data{};
+        uint32_t size_of_raw_data{};
+        uint32_t characteristics{};
+    };
+
+    // The parts of the PE headers that the scanner cares about
+    // The headers are parsed by hand so that this works on any platform and on images that weren't loaded by the Windows loader
+    class PeImage
+    {
+      private:
+        std::vector<PeSection> m_sections{};
+        uint32_t m_time_date_stamp{};
+        uint32_t m_size_of_image{};
+        uint32_t m_size_of_headers{};
+
+      public:
+        // 'headers' must start at the DOS header, the headers are at the start of both a mapped image and a file on disk
+        // Returns an empty optional if the headers are truncated or aren't valid PE headers
+        RC_SPSS_API auto static parse(std::span<const uint8_t> headers) -> std::optional<PeImage>;
+
+      public:
+        // Returns nullptr if there's no section with that name
+        RC_SPSS_API auto find_section(std::string_view name) const -> const PeSection*;
+
+        [[nodiscard]] auto get_sections() const -> const std::vector<PeSection>&
+        {
+            return m_sections;
+        }
+        [[nodiscard]] auto get_time_date_stamp() const -> uint32_t
+        {
+            return m_time_date_stamp;
+        }
+        [[nodiscard]] auto get_size_of_image() const -> uint32_t
+        {
+            return m_size_of_image;
+        }
+        [[nodiscard]] auto get_size_of_headers() const -> uint32_t
+        {
+            return m_size_of_headers;
+        }
+    };
+} // namespace RC
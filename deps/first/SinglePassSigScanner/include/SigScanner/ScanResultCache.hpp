@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <SigScanner/Common.hpp>
+
+namespace RC
+{
+    struct SignatureData;
+
+    // Identifies one build of a module, taken from its PE headers
+    struct RC_SPSS_API ModuleIdentity
+    {
+        // UTF-8, only used as a key
+        std::string path{};
+        uint32_t time_date_stamp{};
+        uint32_t size_of_image{};
+
+        auto operator==(const ModuleIdentity&) const -> bool = default;
+    };
+
+    struct RC_SPSS_API CachedMatch
+    {
+        uint32_t index_into_signatures{};
+        // Relative to the base of the module
+        uint64_t rva{};
+
+        auto operator==(const CachedMatch&) const -> bool = default;
+    };
+
+    // Persistent storage for the matches of previous scans
+    // Each module stores its identity and, for every set of signatures that was scanned for, the matches that were forwarded to 'on_match_found'
+    // A module whose identity changed has all of its entries dropped, and the scanner re-verifies the bytes at every cached match before
+    // using an entry so that an executable that was patched in place only invalidates the entries whose matches were touched by the patch
+    // The file format is little-endian regardless of the host and ends with a checksum, a file that fails validation is discarded entirely
+    class ScanResultCache
+    {
+      public:
+        static constexpr uint32_t file_version = 1;
+
+      private:
+        struct ModuleEntries
+        {
+            ModuleIdentity identity{};
+            std::unordered_map<uint64_t, std::vector<CachedMatch>> matches_by_signatures{};
+        };
+
+      private:
+        std::filesystem::path m_file_path{};
+        uint64_t m_owner_tag{};
+        std::unordered_map<std::string, ModuleEntries> m_modules{};
+        bool m_is_dirty{};
+        mutable std::mutex m_mutex{};
+
+      public:
+        // 'owner_tag' identifies whoever is using the cache, a file that was written with a different tag is discarded when loaded
+        RC_SPSS_API ScanResultCache(std::filesystem::path file_path, uint64_t owner_tag);
+
+      public:
+        // Hashes the signature strings of a container, this is the key that entries are stored under
+        RC_SPSS_API auto static hash_signatures(std::span<const SignatureData> signatures) -> uint64_t;
+        RC_SPSS_API auto static hash_bytes(std::span<const uint8_t> bytes, uint64_t seed = 0xcbf29ce484222325) -> uint64_t;
+
+        // Returns false and leaves the cache empty if the file doesn't exist or fails validation
+        RC_SPSS_API auto load() -> bool;
+        // Writes the file if anything changed since it was loaded or last saved
+        RC_SPSS_API auto save() -> void;
+
+        RC_SPSS_API auto serialize() const -> std::vector<uint8_t>;
+        RC_SPSS_API auto deserialize(std::span<const uint8_t> data) -> bool;
+
+        RC_SPSS_API auto find(const ModuleIdentity& module, uint64_t signatures_hash) const -> std::optional<std::vector<CachedMatch>>;
+        RC_SPSS_API auto store(const ModuleIdentity& module, uint64_t signatures_hash, std::vector<CachedMatch> matches) -> void;
+        RC_SPSS_API auto invalidate(const ModuleIdentity& module, uint64_t signatures_hash) -> void;
+
+        [[nodiscard]] auto get_file_path() const -> const std::filesystem::path&
+        {
+            return m_file_path;
+        }
+    };
+} // namespace RC
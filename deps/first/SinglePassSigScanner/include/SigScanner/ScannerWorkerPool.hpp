@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <SigScanner/Common.hpp>
+
+namespace RC
+{
+    // A set of threads that stays alive between scans so that the cost of creating threads is only paid once
+    // The pool only runs one job at a time, and every participating thread runs the same job
+    // Jobs are expected to pull their own work from a shared atomic cursor, which keeps the threads busy until all work is done
+    class ScannerWorkerPool
+    {
+      public:
+        using Job = std::function<void(uint32_t worker_index)>;
+
+      private:
+        std::vector<std::jthread> m_threads{};
+        std::mutex m_run_mutex{};
+        std::mutex m_state_mutex{};
+        std::condition_variable m_job_available{};
+        std::condition_variable m_job_finished{};
+        const Job* m_job{};
+        uint64_t m_generation{};
+        uint32_t m_num_participants{};
+        uint32_t m_num_running{};
+        std::exception_ptr m_first_exception{};
+
+      public:
+        // The pool is never destroyed, joining threads from a static destructor can deadlock on the loader lock when the dll is unloaded
+        RC_SPSS_API auto static get() -> ScannerWorkerPool&;
+
+        // Runs 'job' on 'num_workers' threads and returns when every one of them has returned
+        // The calling thread participates as worker 0, so 'num_workers - 1' pool threads are used
+        // The first exception thrown by any worker is re-thrown on the calling thread
+        RC_SPSS_API auto run(uint32_t num_workers, const Job& job) -> void;
+
+        [[nodiscard]] auto get_num_threads() const -> size_t
+        {
+            return m_threads.size();
+        }
+
+      private:
+        ScannerWorkerPool() = default;
+        auto worker_loop(uint32_t worker_index) -> void;
+    };
+} // namespace RC
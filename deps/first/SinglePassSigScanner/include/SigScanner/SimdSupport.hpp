@@ -0,0 +1,20 @@
+#pragma once
+
+// Shared by the matchers that have hand-written SIMD paths
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define RC_SPSS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define RC_SPSS_X86 0
+#endif
+
+// MSVC allows intrinsics for any instruction set in any function, GCC and Clang need the function to opt-in
+#if RC_SPSS_X86 && !(defined(_MSC_VER) && !defined(__clang__))
+#define RC_SPSS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define RC_SPSS_TARGET_AVX2
+#endif
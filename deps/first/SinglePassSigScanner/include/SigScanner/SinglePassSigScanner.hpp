@@ -1,18 +1,23 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <filesystem>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <vector>
 
 #include <SigScanner/Common.hpp>
+#include <SigScanner/MemorySource.hpp>
+#include <SigScanner/MultiPatternMatcher.hpp>
+#include <SigScanner/PatternMatcher.hpp>
+#include <SigScanner/ScanResultCache.hpp>
 
 #define HI_NIBBLE(b) (((b) >> 4) & 0x0F)
 #define LO_NIBBLE(b) ((b)&0x0F)
 
 // Windows.h forward declarations
-struct _SYSTEM_INFO;
-typedef _SYSTEM_INFO SYSTEM_INFO;
 struct _MODULEINFO;
 typedef _MODULEINFO MODULEINFO;
 
@@ -212,7 +217,7 @@ namespace RC
         // It will be zero-defaulted in the event of no custom data being supplied
         int32_t custom_data{};
 
-        // A mask that's used for the StdFind scanning method.
+        // Unused, signatures are compiled into a value and a mask when the container is constructed
         std::string mask{};
     };
 
@@ -227,6 +232,10 @@ namespace RC
 
       private:
         std::vector<SignatureData> signatures;
+
+        // One compiled pattern per signature, built when the container is constructed and only read by the scanner threads
+        std::vector<BytePattern> compiled_signatures{};
+
         const std::function<bool(SignatureContainer&)> on_match_found;
         const std::function<void(SignatureContainer&)> on_scan_finished;
 
@@ -239,8 +248,34 @@ namespace RC
         // True if the scan was successful, otherwise false
         bool did_succeed{false};
 
+        // std::atomic isn't copyable but containers are copied when the scanner merges them
+        struct AtomicFlag
+        {
+            std::atomic<bool> value{};
+
+            AtomicFlag() = default;
+            AtomicFlag(const AtomicFlag& other) : value(other.value.load(std::memory_order_relaxed))
+            {
+            }
+            auto operator=(const AtomicFlag& other) -> AtomicFlag&
+            {
+                value.store(other.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                return *this;
+            }
+            auto operator=(bool new_value) -> AtomicFlag&
+            {
+                value.store(new_value, std::memory_order_relaxed);
+                return *this;
+            }
+            operator bool() const
+            {
+                return value.load(std::memory_order_relaxed);
+            }
+        };
+
         // The scanner will use this to cancel all future calls to 'callable' if the 'callable' signaled
-        bool ignore{};
+        // Scanner threads read this without any locking to stop searching for signatures that are no longer wanted
+        AtomicFlag ignore{};
 
         // The scanner will set this to whichever signature a match was found for
         size_t index_into_signatures{};
@@ -252,17 +287,33 @@ namespace RC
         // The scanner will set this to the size of the signature that was matched
         size_t match_signature_size{};
 
+        // Every match that was forwarded to 'on_match_found', recorded for the result cache when it's enabled
+        std::vector<SignatureContainerLight> dispatched_matches{};
+
       public:
         template <typename OnMatchFound, typename OnScanFinished>
         SignatureContainer(std::vector<SignatureData> sig_param, OnMatchFound on_match_found_param, OnScanFinished on_scan_finished_param)
             : signatures(std::move(sig_param)), on_match_found(on_match_found_param), on_scan_finished(on_scan_finished_param)
         {
+            compile_signatures();
         }
 
         template <typename OnMatchFound, typename OnScanFinished>
         SignatureContainer(std::vector<SignatureData> sig_param, OnMatchFound on_match_found_param, OnScanFinished on_scan_finished_param, bool store_results_param)
             : signatures(std::move(sig_param)), on_match_found(on_match_found_param), on_scan_finished(on_scan_finished_param), store_results(store_results_param)
         {
+            compile_signatures();
+        }
+
+      private:
+        // Throws std::runtime_error if a signature is malformed, so that bad signatures are reported when they're registered instead of in the middle of a scan
+        auto compile_signatures() -> void
+        {
+            compiled_signatures.reserve(signatures.size());
+            for (const auto& signature_data : signatures)
+            {
+                compiled_signatures.emplace_back(PatternMatcher::compile(signature_data.signature));
+            }
         }
 
       public:
@@ -286,6 +337,10 @@ namespace RC
         {
             return signatures;
         }
+        [[nodiscard]] auto get_compiled_signatures() const -> const std::vector<BytePattern>&
+        {
+            return compiled_signatures;
+        }
         [[nodiscard]] auto get_result_store() const -> const std::vector<SignatureContainerLight>&
         {
             return result_store;
@@ -296,48 +351,150 @@ namespace RC
         }
     };
 
+    // A match that a scanner thread found but hasn't forwarded to its container yet
+    struct ScanMatch
+    {
+        uint8_t* match_address{};
+        uint32_t container_index{};
+        uint32_t signature_index{};
+    };
+
+    // Every signature of every container that wants matches, in one matcher that is built once and shared by every thread scanning the same memory
+    struct MultiPatternScan
+    {
+        MultiPatternMatcher matcher{};
+        // The container and signature of each pattern in the matcher, 'match_address' is unused
+        std::vector<ScanMatch> pattern_owners{};
+        size_t longest_pattern_length{};
+    };
+
     class SinglePassScanner
     {
       private:
-        static std::mutex m_scanner_mutex;
+        static std::unique_ptr<ScanResultCache> m_result_cache;
+        static const MemorySource* m_memory_source;
 
       public:
         enum class ScanMethod
         {
             Scalar,
             StdFind,
+            // Compares whole vectors of memory against precompiled value and mask vectors, falls back to scalar code on CPUs without SIMD
+            Vectorized,
+            // Searches for the signatures of every container in a single pass, scales better than 'Vectorized' when there are many signatures
+            MultiPattern,
         };
 
       public:
         RC_SPSS_API static uint32_t m_num_threads;
         RC_SPSS_API static ScanMethod m_scan_method;
 
-        // The minimum size a module has to be for multi-threading to be enabled
-        // Smaller modules might increase the cost of scanning due to the cost of creating threads
+        // The minimum number of bytes a scan has to cover, across all modules, for multi-threading to be enabled
+        // The scanner threads are persistent so this mostly guards against the cost of waking them up for tiny modules
         RC_SPSS_API static uint32_t m_multithreading_module_size_threshold;
 
+        // The size of the pieces a module is split into, matches are forwarded to the containers one chunk at a time
+        // Threads pull chunks one by one until none are left, so a smaller size evens out the work at the cost of more scheduling
+        RC_SPSS_API static uint32_t m_chunk_size;
+
       private:
-        RC_SPSS_API auto static string_to_vector(std::string_view signature) -> std::vector<int>;
-        RC_SPSS_API auto static string_to_vector(const std::vector<SignatureData>& signatures) -> std::vector<std::vector<int>>;
-        RC_SPSS_API auto static format_aob_strings(std::vector<SignatureContainer>& signature_containers) -> void;
+        // Everything the scanner needs to know about one module for the duration of a scan
+        struct ModuleScan
+        {
+            uint8_t* module_start_address{};
+            size_t module_size{};
+            std::vector<SignatureContainer>* signature_containers{};
+
+            // Only used when the result cache is enabled
+            ModuleIdentity module_identity{};
+            std::vector<uint64_t> signatures_hashes{};
+            std::vector<bool> needs_scan{};
+
+            bool is_scan_required{};
+
+            // Only used by the multi-pattern scan method
+            std::unique_ptr<MultiPatternScan> multi_pattern_scan{};
+
+            // A chunk is forwarded to the containers once every chunk before it in the same module has been forwarded
+            size_t num_chunks{};
+            std::vector<std::vector<ScanMatch>> matches_per_chunk{};
+            std::unique_ptr<std::atomic<bool>[]> is_chunk_scanned{};
+            std::atomic<size_t> next_chunk_to_dispatch{};
+        };
+
+        // Replays the containers that have valid cached results and decides whether the module still has to be scanned
+        RC_SPSS_API auto static prepare_module_scan(ModuleScan& module_scan) -> void;
+        // Scans every module that needs it on the scanner threads, the chunks of all modules are scheduled together
+        RC_SPSS_API auto static scan_modules(std::span<ModuleScan> module_scans) -> void;
+        // Stores new results in the result cache and calls 'on_scan_finished' for every container of the module
+        RC_SPSS_API auto static finish_module_scan(ModuleScan& module_scan) -> void;
+        // Forwards a match to the container, this is only ever called by one thread at a time
+        // Returns true if the container is refusing more calls
+        RC_SPSS_API auto static dispatch_match(SignatureContainer& signature_container, size_t signature_index, uint8_t* match_address, size_t match_signature_size)
+                -> bool;
+        // Forwards matches that are sorted by address, skipping containers that are refusing more calls
+        RC_SPSS_API auto static dispatch_matches(std::vector<SignatureContainer>& signature_containers, std::span<const ScanMatch> matches) -> void;
 
       public:
+        // Each of these appends the matches that start inside [start_address, end_address) to 'matches' in no particular order
+        // A match may extend past 'end_address', so adjacent ranges don't miss signatures that straddle the boundary between them
+        // Nothing is forwarded to the containers from here, the scanner does that after sorting the matches by address
         RC_SPSS_API auto static scanner_work_thread(uint8_t* start_address,
                                                     uint8_t* end_address,
-                                                    SYSTEM_INFO& info,
-                                                    std::vector<SignatureContainer>& signature_containers) -> void;
+                                                    std::vector<SignatureContainer>& signature_containers,
+                                                    std::vector<ScanMatch>& matches) -> void;
         RC_SPSS_API auto static scanner_work_thread_scalar(uint8_t* start_address,
                                                            uint8_t* end_address,
-                                                           SYSTEM_INFO& info,
-                                                           std::vector<SignatureContainer>& signature_containers) -> void;
+                                                           std::vector<SignatureContainer>& signature_containers,
+                                                           std::vector<ScanMatch>& matches) -> void;
         RC_SPSS_API auto static scanner_work_thread_stdfind(uint8_t* start_address,
                                                             uint8_t* end_address,
-                                                            SYSTEM_INFO& info,
-                                                            std::vector<SignatureContainer>& signature_containers) -> void;
+                                                            std::vector<SignatureContainer>& signature_containers,
+                                                            std::vector<ScanMatch>& matches) -> void;
+        RC_SPSS_API auto static scanner_work_thread_vectorized(uint8_t* start_address,
+                                                               uint8_t* end_address,
+                                                               std::vector<SignatureContainer>& signature_containers,
+                                                               std::vector<ScanMatch>& matches) -> void;
+        RC_SPSS_API auto static scanner_work_thread_multi_pattern(uint8_t* start_address,
+                                                                  uint8_t* end_address,
+                                                                  std::vector<SignatureContainer>& signature_containers,
+                                                                  std::vector<ScanMatch>& matches) -> void;
+        // Same as above with a matcher that was built beforehand, which the scanner does once per module instead of once per chunk
+        RC_SPSS_API auto static scanner_work_thread_multi_pattern(uint8_t* start_address,
+                                                                  uint8_t* end_address,
+                                                                  std::vector<SignatureContainer>& signature_containers,
+                                                                  const MultiPatternScan& multi_pattern_scan,
+                                                                  std::vector<ScanMatch>& matches) -> void;
+        // Puts the signatures of every container that isn't ignored into one matcher
+        // The containers must outlive the returned object and must not be resized while it's in use
+        RC_SPSS_API auto static make_multi_pattern_scan(const std::vector<SignatureContainer>& signature_containers) -> std::unique_ptr<MultiPatternScan>;
+
+        // Loads the results of previous scans from 'cache_file' and stores the results of future scans there
+        // A file written with a different 'owner_tag' is discarded, which lets the caller invalidate everything when it changes itself
+        RC_SPSS_API auto static enable_result_cache(std::filesystem::path cache_file, uint64_t owner_tag) -> void;
+        RC_SPSS_API auto static disable_result_cache() -> void;
+
+        // Everything the scanner reads goes through the memory source, nullptr restores the default
+        // The default is the memory of the current process on Windows, other platforms have to set one before scanning
+        // The memory source must outlive every scan that uses it
+        RC_SPSS_API auto static set_memory_source(const MemorySource* memory_source) -> void;
+        RC_SPSS_API auto static get_memory_source() -> const MemorySource&;
+
+        // Scans [start_address, start_address + size) for the containers and calls 'on_scan_finished' for each of them
+        // Unlike 'start_scan' this doesn't need a scan target and doesn't use the result cache, the range doesn't have to be a loaded module
+        RC_SPSS_API auto static scan_range(uint8_t* start_address, size_t size, std::vector<SignatureContainer>& signature_containers) -> void;
 
         using SignatureContainerMap = std::unordered_map<ScanTarget, std::vector<SignatureContainer>>;
         RC_SPSS_API auto static start_scan(SignatureContainerMap& signature_containers) -> void;
 
+        // Returns the address of the first UTF-16 occurrence of the string in the module, or nullptr if it isn't found
+        // The .rdata section is searched first since that's where string literals are, the rest of the module is only searched if that fails
         RC_SPSS_API auto static string_scan(std::wstring_view string_to_scan_for, ScanTarget = ScanTarget::MainExe) -> void*;
+        // Searches for many strings at once, returns one address (or nullptr) per string in the same order
+        RC_SPSS_API auto static string_scan(std::span<const std::wstring_view> strings_to_scan_for, ScanTarget = ScanTarget::MainExe) -> std::vector<void*>;
+        // Same as 'string_scan' for the module at [start_address, start_address + size), read through the memory source
+        // Every string gets the address that searching for it alone would return, whatever else is searched for with it
+        RC_SPSS_API auto static string_scan_range(uint8_t* start_address, size_t size, std::span<const std::wstring_view> strings_to_scan_for)
+                -> std::vector<void*>;
     };
 } // namespace RC
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <SigScanner/Common.hpp>
+#include <SigScanner/MultiPatternMatcher.hpp>
+#include <SigScanner/PatternMatcher.hpp>
+
+namespace RC
+{
+    // Searches memory for the UTF-16LE encoding of one or more strings, the way string literals are stored in Windows executables
+    // A single string uses the vectorized first/last byte filter of PatternMatcher, several strings are searched for in one pass
+    class WideStringSearcher
+    {
+      private:
+        std::vector<BytePattern> m_patterns{};
+        MultiPatternMatcher m_matcher{};
+
+      public:
+        // Empty strings are never found
+        RC_SPSS_API explicit WideStringSearcher(std::span<const std::wstring_view> strings);
+
+        // 'm_matcher' points into 'm_patterns'
+        WideStringSearcher(const WideStringSearcher&) = delete;
+        auto operator=(const WideStringSearcher&) -> WideStringSearcher& = delete;
+
+      public:
+        // Encodes a string as UTF-16LE, regardless of the size of wchar_t on the platform
+        RC_SPSS_API auto static to_utf16le(std::wstring_view string) -> std::vector<uint8_t>;
+
+        // For every string that 'first_matches' holds no address for yet, records the lowest address in 'data' where it's found
+        // 'first_matches' must have one element per string and null elements are treated as not found yet
+        // Strings that already have an address are left alone, so searching regions in order of preference keeps the first region's match
+        // Returns true if every string has been found
+        RC_SPSS_API auto search(std::span<const uint8_t> data, std::span<const uint8_t*> first_matches) const -> bool;
+
+        [[nodiscard]] auto get_string_count() const -> size_t
+        {
+            return m_patterns.size();
+        }
+    };
+} // namespace RC
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <fmt/core.h>
+#include <SigScanner/MappedPeFile.hpp>
+
+namespace RC
+{
+    static constexpr size_t s_page_size = 0x1000;
+
+    static auto align_up(size_t value, size_t alignment) -> size_t
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    MappedPeFile::MappedPeFile(std::span<const uint8_t> file_contents)
+    {
+        auto pe_image = PeImage::parse(file_contents);
+        if (!pe_image)
+        {
+            throw std::runtime_error{"[MappedPeFile::MappedPeFile] The file doesn't start with valid PE headers"};
+        }
+        m_pe_image = std::move(*pe_image);
+        m_image.resize(m_pe_image.get_size_of_image());
+
+        struct Range
+        {
+            size_t start{};
+            size_t end{};
+        };
+        std::vector<Range> readable_ranges{};
+
+        const size_t headers_size = std::min<size_t>({m_pe_image.get_size_of_headers(), file_contents.size(), m_image.size()});
+        std::copy_n(file_contents.begin(), headers_size, m_image.begin());
+        readable_ranges.emplace_back(Range{0, std::min(align_up(headers_size, s_page_size), m_image.size())});
+
+        for (const auto& section : m_pe_image.get_sections())
+        {
+            if (section.virtual_address >= m_image.size())
+            {
+                continue;
+            }
+
+            // The loader maps 'virtual_size' bytes and zero-fills whatever isn't backed by raw data
+            const size_t mapped_size = section.virtual_size ? section.virtual_size : section.size_of_raw_data;
+            const size_t section_end = std::min(align_up(section.virtual_address + mapped_size, s_page_size), m_image.size());
+
+            if (section.pointer_to_raw_data < file_contents.size())
+            {
+                const size_t raw_size = std::min<size_t>({section.size_of_raw_data,
+                                                          file_contents.size() - section.pointer_to_raw_data,
+                                                          section_end - section.virtual_address});
+                std::copy_n(file_contents.begin() + section.pointer_to_raw_data, raw_size, m_image.begin() + section.virtual_address);
+            }
+
+            readable_ranges.emplace_back(Range{section.virtual_address, section_end});
+        }
+
+        std::ranges::sort(readable_ranges, {}, &Range::start);
+
+        // Overlapping sections are merged and the gaps become unreadable regions
+        size_t position{};
+        for (const auto& range : readable_ranges)
+        {
+            if (range.end <= position)
+            {
+                continue;
+            }
+            if (range.start > position)
+            {
+                m_regions.emplace_back(MemoryRegion{m_image.data() + position, range.start - position, false});
+                position = range.start;
+            }
+            m_regions.emplace_back(MemoryRegion{m_image.data() + position, range.end - position, true});
+            position = range.end;
+        }
+        if (position < m_image.size())
+        {
+            m_regions.emplace_back(MemoryRegion{m_image.data() + position, m_image.size() - position, false});
+        }
+    }
+
+    auto MappedPeFile::open(const std::filesystem::path& file_path) -> std::unique_ptr<MappedPeFile>
+    {
+        std::ifstream file{file_path, std::ios::binary};
+        if (!file)
+        {
+            throw std::runtime_error{fmt::format("[MappedPeFile::open] Could not open '{}'", file_path.string())};
+        }
+
+        std::vector<uint8_t> file_contents{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+        return std::make_unique<MappedPeFile>(file_contents);
+    }
+
+    auto MappedPeFile::query(const uint8_t* address) const -> std::optional<MemoryRegion>
+    {
+        if (address < m_image.data() || address >= m_image.data() + m_image.size())
+        {
+            return std::nullopt;
+        }
+
+        auto it = std::ranges::upper_bound(m_regions, address, {}, [](const MemoryRegion& region) -> const uint8_t* {
+            return region.base;
+        });
+        return *std::prev(it);
+    }
+} // namespace RC
@@ -0,0 +1,527 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+#include <SigScanner/MultiPatternMatcher.hpp>
+#include <SigScanner/SimdSupport.hpp>
+
+namespace RC
+{
+    // Approximate frequencies of bytes in the code sections of x86-64 game binaries
+    // Only the relative order matters, it's used to pick the byte in a signature that will produce the fewest false candidates
+    static constexpr auto s_byte_frequencies = [] {
+        std::array<uint8_t, 256> frequencies{};
+        frequencies.fill(8);
+
+        constexpr std::pair<uint8_t, uint8_t> common_bytes[] = {
+                {0x00, 255}, {0x48, 220}, {0xFF, 200}, {0x8B, 200}, {0x89, 150}, {0x24, 140}, {0x4C, 120}, {0xE8, 110}, {0x0F, 110}, {0x44, 100},
+                {0x85, 90},  {0xC0, 90},  {0x8D, 90},  {0x74, 80},  {0x01, 80},  {0x83, 80},  {0x49, 70},  {0x41, 70},  {0xCC, 70},  {0x45, 60},
+                {0x4D, 60},  {0x08, 60},  {0x10, 60},  {0x20, 55},  {0x40, 55},  {0x28, 50},  {0x30, 50},  {0x38, 45},  {0x18, 45},  {0xC3, 45},
+                {0x75, 45},  {0xEB, 40},  {0x84, 40},  {0xC7, 40},  {0x33, 40},  {0x02, 35},  {0x04, 35},  {0x05, 35},  {0x90, 35},  {0x50, 30},
+                {0x5C, 30},  {0x54, 30},  {0xF8, 30},  {0xD2, 30},  {0xC9, 30},  {0x15, 30},  {0x03, 30},  {0x0D, 25},  {0x06, 25},  {0x07, 25},
+                {0x0C, 25},  {0x14, 25},  {0x3B, 25},  {0x39, 25},  {0x80, 25},  {0x66, 25},  {0xF0, 25},  {0xFE, 25},  {0xDB, 25},  {0x7C, 20},
+                {0xB8, 20},  {0xBA, 20},  {0x8A, 20},  {0x88, 20},  {0xC1, 20},  {0xE0, 20},  {0x25, 20},  {0x2B, 20},  {0xC6, 20},  {0x78, 20},
+                {0x70, 20},  {0x60, 20},  {0x68, 20},  {0x58, 20},  {0x5D, 20},  {0x5E, 20},  {0x5F, 20},  {0x53, 20},  {0x55, 20},  {0x56, 20},
+                {0x57, 20},
+        };
+
+        for (const auto& [byte, frequency] : common_bytes)
+        {
+            frequencies[byte] = frequency;
+        }
+
+        return frequencies;
+    }();
+
+    auto MultiPatternMatcher::get_byte_frequency(uint8_t byte) -> uint8_t
+    {
+        return s_byte_frequencies[byte];
+    }
+
+    auto MultiPatternMatcher::find_rarest_byte_offset(const BytePattern& pattern) -> size_t
+    {
+        size_t rarest_offset = pattern.first_anchor;
+        for (size_t offset = pattern.first_anchor; offset <= pattern.last_anchor; ++offset)
+        {
+            if (pattern.mask[offset] == 0xFF && get_byte_frequency(pattern.bytes[offset]) < get_byte_frequency(pattern.bytes[rarest_offset]))
+            {
+                rarest_offset = offset;
+            }
+        }
+        return rarest_offset;
+    }
+
+    auto MultiPatternMatcher::find_rarest_run_offset(const BytePattern& pattern, size_t run_length) -> size_t
+    {
+        // The product of the frequency ranks is a rough estimate of how often the run occurs, if its bytes were independent
+        auto get_run_frequency = [&](size_t offset) {
+            uint64_t frequency = 1;
+            for (size_t i = offset; i < offset + run_length; ++i)
+            {
+                frequency *= get_byte_frequency(pattern.bytes[i]) + 1u;
+            }
+            return frequency;
+        };
+
+        size_t rarest_offset = pattern.length;
+        for (size_t offset = pattern.first_anchor; offset + run_length <= pattern.last_anchor + 1; ++offset)
+        {
+            const bool is_fully_specified = std::all_of(pattern.mask.begin() + offset, pattern.mask.begin() + offset + run_length, [](uint8_t mask) {
+                return mask == 0xFF;
+            });
+            if (is_fully_specified && (rarest_offset == pattern.length || get_run_frequency(offset) < get_run_frequency(rarest_offset)))
+            {
+                rarest_offset = offset;
+            }
+        }
+        return rarest_offset;
+    }
+
+    auto MultiPatternMatcher::add_pattern(const BytePattern& pattern) -> size_t
+    {
+        m_is_built = false;
+        m_patterns.emplace_back(&pattern);
+        return m_patterns.size() - 1;
+    }
+
+    auto MultiPatternMatcher::build() -> void
+    {
+        m_is_anchor_key.assign(num_keys / 64, 0);
+        m_num_keys_before_word.assign(num_keys / 64, 0);
+        m_entries.clear();
+        m_bucket_offsets.clear();
+        m_single_byte_patterns.clear();
+        m_nibble_filter = {};
+        m_has_pair_anchors = false;
+
+        struct KeyedEntry
+        {
+            uint32_t key{};
+            AnchorEntry entry{};
+        };
+        std::vector<KeyedEntry> keyed_entries{};
+        keyed_entries.reserve(m_patterns.size());
+        auto add_entry = [&](size_t key, size_t pattern_index, size_t anchor_offset) {
+            // Bytes past the end of the pattern are wildcards in the window
+            const auto& pattern = *m_patterns[pattern_index];
+            std::array<uint8_t, sizeof(uint64_t)> window_bytes{};
+            std::array<uint8_t, sizeof(uint64_t)> window_mask{};
+            for (size_t i = 0; i < window_bytes.size() && anchor_offset + i < pattern.length; ++i)
+            {
+                window_bytes[i] = pattern.bytes[anchor_offset + i] & pattern.mask[anchor_offset + i];
+                window_mask[i] = pattern.mask[anchor_offset + i];
+            }
+
+            auto& keyed_entry = keyed_entries.emplace_back(KeyedEntry{
+                    .key = static_cast<uint32_t>(key),
+                    .entry = AnchorEntry{.pattern_index = static_cast<uint32_t>(pattern_index), .anchor_offset = static_cast<uint32_t>(anchor_offset)},
+            });
+            std::memcpy(&keyed_entry.entry.window_bytes, window_bytes.data(), window_bytes.size());
+            std::memcpy(&keyed_entry.entry.window_mask, window_mask.data(), window_mask.size());
+            m_is_anchor_key[key / 64] |= uint64_t{1} << (key % 64);
+        };
+        auto get_pair_key = [](uint8_t first_byte, uint8_t second_byte) -> size_t {
+            return first_byte | second_byte << 8;
+        };
+
+        for (size_t pattern_index = 0; pattern_index < m_patterns.size(); ++pattern_index)
+        {
+            const auto& pattern = *m_patterns[pattern_index];
+            if (const size_t quad_offset = find_rarest_run_offset(pattern, sizeof(uint32_t)); quad_offset < pattern.length)
+            {
+                uint32_t quad{};
+                std::memcpy(&quad, pattern.bytes.data() + quad_offset, sizeof(quad));
+                add_entry(get_quad_key(quad), pattern_index, quad_offset);
+                continue;
+            }
+
+            m_has_pair_anchors = true;
+            if (const size_t pair_offset = find_rarest_run_offset(pattern, 2); pair_offset < pattern.length)
+            {
+                add_entry(get_pair_key(pattern.bytes[pair_offset], pattern.bytes[pair_offset + 1]), pattern_index, pair_offset);
+                continue;
+            }
+
+            // No two fully specified bytes are adjacent, so the pattern is listed under every pair that its rarest byte can be part of
+            // Signatures like that are rare, it's much cheaper to list them 256 times than to check a third kind of anchor for every byte of memory
+            const size_t byte_offset = pattern.rarest_anchor;
+            const uint8_t byte = pattern.bytes[byte_offset];
+            for (size_t other_byte = 0; other_byte < 256; ++other_byte)
+            {
+                if (byte_offset + 1 < pattern.length || byte_offset == 0)
+                {
+                    add_entry(get_pair_key(byte, static_cast<uint8_t>(other_byte)), pattern_index, byte_offset);
+                }
+                else
+                {
+                    add_entry(get_pair_key(static_cast<uint8_t>(other_byte), byte), pattern_index, byte_offset - 1);
+                }
+            }
+
+            if (pattern.length == 1)
+            {
+                m_single_byte_patterns.emplace_back(static_cast<uint32_t>(pattern_index));
+            }
+        }
+
+        // Every distinct key gets a bucket, in the order of the keys, and the entries are stored back to back in that order
+        uint32_t num_buckets{};
+        for (size_t word = 0; word < m_is_anchor_key.size(); ++word)
+        {
+            m_num_keys_before_word[word] = num_buckets;
+            num_buckets += static_cast<uint32_t>(std::popcount(m_is_anchor_key[word]));
+        }
+
+        m_bucket_offsets.assign(num_buckets + 1, 0);
+        for (const auto& keyed_entry : keyed_entries)
+        {
+            ++m_bucket_offsets[get_bucket(keyed_entry.key) + 1];
+        }
+        for (size_t bucket = 1; bucket < m_bucket_offsets.size(); ++bucket)
+        {
+            m_bucket_offsets[bucket] += m_bucket_offsets[bucket - 1];
+        }
+
+        m_entries.resize(keyed_entries.size());
+        auto next_slot = m_bucket_offsets;
+        for (const auto& keyed_entry : keyed_entries)
+        {
+            m_entries[next_slot[get_bucket(keyed_entry.key)]++] = keyed_entry.entry;
+        }
+
+        // The vectorized filter looks at the first four bytes of each anchor, including the wildcards and the bytes after a pair anchor
+        // The distinct starts are spread over its 8 buckets in turn
+        std::unordered_set<uint64_t> anchor_starts{};
+        for (const auto& entry : m_entries)
+        {
+            const auto start_bytes = static_cast<uint32_t>(entry.window_bytes);
+            const auto start_mask = static_cast<uint32_t>(entry.window_mask);
+            if (!anchor_starts.emplace(start_bytes | uint64_t{start_mask} << 32).second || anchor_starts.size() > max_vectorized_anchor_starts)
+            {
+                continue;
+            }
+
+            const auto bucket_bit = static_cast<uint8_t>(1 << (anchor_starts.size() % 8));
+            for (size_t byte_index = 0; byte_index < 4; ++byte_index)
+            {
+                const auto byte = static_cast<uint8_t>(start_bytes >> (byte_index * 8));
+                const auto mask = static_cast<uint8_t>(start_mask >> (byte_index * 8));
+                for (uint8_t nibble = 0; nibble < 16; ++nibble)
+                {
+                    if (((nibble ^ byte) & mask & 0x0F) == 0)
+                    {
+                        m_nibble_filter.low_nibble_buckets[byte_index][nibble] |= bucket_bit;
+                    }
+                    if (((nibble ^ (byte >> 4)) & (mask >> 4)) == 0)
+                    {
+                        m_nibble_filter.high_nibble_buckets[byte_index][nibble] |= bucket_bit;
+                    }
+                }
+            }
+        }
+        m_is_vectorized_filter_usable = anchor_starts.size() <= max_vectorized_anchor_starts;
+
+        m_is_built = true;
+    }
+
+    auto MultiPatternMatcher::check_anchor(std::span<const uint8_t> data, size_t position, size_t key, const MatchCallback& on_match) const -> bool
+    {
+        // The window can only be compared if the data doesn't end within 8 bytes of the anchor
+        uint64_t window{};
+        const bool is_window_readable = position + sizeof(window) <= data.size();
+        if (is_window_readable)
+        {
+            std::memcpy(&window, data.data() + position, sizeof(window));
+        }
+
+        const size_t bucket = get_bucket(key);
+        for (uint32_t entry_index = m_bucket_offsets[bucket]; entry_index < m_bucket_offsets[bucket + 1]; ++entry_index)
+        {
+            const auto& entry = m_entries[entry_index];
+            if ((is_window_readable && (window & entry.window_mask) != entry.window_bytes) || position < entry.anchor_offset)
+            {
+                continue;
+            }
+
+            const auto& pattern = *m_patterns[entry.pattern_index];
+            const size_t start = position - entry.anchor_offset;
+            if (start + pattern.length > data.size())
+            {
+                continue;
+            }
+
+            const uint8_t* address = data.data() + start;
+            if (address[pattern.first_anchor] != pattern.bytes[pattern.first_anchor] || address[pattern.last_anchor] != pattern.bytes[pattern.last_anchor])
+            {
+                continue;
+            }
+
+            if (PatternMatcher::matches_at(address, pattern) && on_match(address, entry.pattern_index))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    auto MultiPatternMatcher::check_position(std::span<const uint8_t> data, size_t position, const MatchCallback& on_match) const -> bool
+    {
+        if (position + sizeof(uint32_t) <= data.size())
+        {
+            uint32_t quad{};
+            std::memcpy(&quad, data.data() + position, sizeof(quad));
+            if (const size_t quad_key = get_quad_key(quad); is_anchor_key(quad_key) && check_anchor(data, position, quad_key, on_match))
+            {
+                return true;
+            }
+        }
+
+        if (m_has_pair_anchors && position + 1 < data.size())
+        {
+            if (const size_t pair_key = data[position] | data[position + 1] << 8; is_anchor_key(pair_key) && check_anchor(data, position, pair_key, on_match))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <bool has_pair_anchors>
+    auto MultiPatternMatcher::find_all_scalar(std::span<const uint8_t> data, size_t first_position, const MatchCallback& on_match) const -> bool
+    {
+        if (first_position >= data.size())
+        {
+            return false;
+        }
+
+        // The loop is specialized for whether there are pair anchors, most signature sets don't have any and only need one lookup per position
+        size_t position = first_position;
+        for (; position + sizeof(uint32_t) <= data.size(); ++position)
+        {
+            uint32_t quad{};
+            std::memcpy(&quad, data.data() + position, sizeof(quad));
+            const size_t quad_key = get_quad_key(quad);
+            if (is_anchor_key(quad_key) && check_anchor(data, position, quad_key, on_match))
+            {
+                return true;
+            }
+
+            if constexpr (has_pair_anchors)
+            {
+                const size_t pair_key = quad & 0xFFFF;
+                if (is_anchor_key(pair_key) && check_anchor(data, position, pair_key, on_match))
+                {
+                    return true;
+                }
+            }
+        }
+
+        // Only pairs fit in the last few positions
+        for (; position + 1 < data.size(); ++position)
+        {
+            if (check_position(data, position, on_match))
+            {
+                return true;
+            }
+        }
+
+        // The last byte has no pair, only a pattern that's one byte long can start there
+        const uint8_t* last_address = data.data() + data.size() - 1;
+        for (const uint32_t pattern_index : m_single_byte_patterns)
+        {
+            if (PatternMatcher::matches_at(last_address, *m_patterns[pattern_index]) && on_match(last_address, pattern_index))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+#if RC_SPSS_X86
+    // Vectorized filter for up to 'max_vectorized_anchor_starts' anchor starts, using one nibble lookup per nibble of the first four bytes
+    // Calls 'on_candidate' with every position that may hold an anchor, and returns the position where the scalar code must take over
+    template <typename OnCandidate>
+    RC_SPSS_TARGET_AVX2 static auto find_anchor_candidates_avx2(std::span<const uint8_t> data,
+                                                                const std::array<std::array<uint8_t, 16>, 4>& low_nibble_buckets,
+                                                                const std::array<std::array<uint8_t, 16>, 4>& high_nibble_buckets,
+                                                                bool& was_stopped,
+                                                                OnCandidate&& on_candidate) -> size_t
+    {
+        static constexpr size_t lanes = 32;
+        static constexpr size_t anchor_start_size = 4;
+
+        const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i low_tables[anchor_start_size];
+        __m256i high_tables[anchor_start_size];
+        for (size_t byte_index = 0; byte_index < anchor_start_size; ++byte_index)
+        {
+            low_tables[byte_index] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(low_nibble_buckets[byte_index].data())));
+            high_tables[byte_index] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(high_nibble_buckets[byte_index].data())));
+        }
+
+        // Byte 'i' of the anchor start at each position of a block is loaded by a load that starts 'i' bytes later
+        size_t block_start = 0;
+        for (; block_start + lanes + anchor_start_size - 1 <= data.size(); block_start += lanes)
+        {
+            __m256i buckets = _mm256_set1_epi8(-1);
+            for (size_t byte_index = 0; byte_index < anchor_start_size; ++byte_index)
+            {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data.data() + block_start + byte_index));
+                const __m256i low_buckets = _mm256_shuffle_epi8(low_tables[byte_index], _mm256_and_si256(block, nibble_mask));
+                const __m256i high_buckets = _mm256_shuffle_epi8(high_tables[byte_index], _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble_mask));
+                buckets = _mm256_and_si256(buckets, _mm256_and_si256(low_buckets, high_buckets));
+            }
+            auto candidates = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(buckets, zero)));
+
+            while (candidates)
+            {
+                const size_t position = block_start + std::countr_zero(candidates);
+                candidates &= candidates - 1;
+
+                if (on_candidate(position))
+                {
+                    was_stopped = true;
+                    return block_start;
+                }
+            }
+        }
+
+        return block_start;
+    }
+
+    // Looks up the anchor keys of 32 positions at a time with gathers from the bitmap, for sets with too many anchors for the nibble filter
+    // 'is_anchor_key' is read as 32-bit words, bit 'key' is bit 'key % 32' of word 'key / 32' on a little-endian CPU
+    // Calls 'on_candidate' with every position that holds an anchor key, and returns the position where the scalar code must take over
+    template <typename OnCandidate>
+    RC_SPSS_TARGET_AVX2 static auto find_anchor_keys_avx2(std::span<const uint8_t> data,
+                                                          const uint64_t* is_anchor_key,
+                                                          uint32_t quad_key_offset,
+                                                          uint32_t quad_key_shift,
+                                                          bool has_pair_anchors,
+                                                          bool& was_stopped,
+                                                          OnCandidate&& on_candidate) -> size_t
+    {
+        static constexpr size_t lanes = 32;
+        static constexpr size_t quad_size = 4;
+
+        const auto* bitmap = reinterpret_cast<const int*>(is_anchor_key);
+        const __m256i hash_multiplier = _mm256_set1_epi32(static_cast<int>(0x9E3779B1u));
+        const __m256i key_offset = _mm256_set1_epi32(static_cast<int>(quad_key_offset));
+        const __m256i pair_mask = _mm256_set1_epi32(0xFFFF);
+        const __m256i bit_mask = _mm256_set1_epi32(31);
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m128i hash_shift = _mm_cvtsi32_si128(static_cast<int>(quad_key_shift));
+
+        auto is_key_set = [&](__m256i keys) RC_SPSS_TARGET_AVX2 {
+            const __m256i words = _mm256_i32gather_epi32(bitmap, _mm256_srli_epi32(keys, 5), 4);
+            return _mm256_and_si256(_mm256_srlv_epi32(words, _mm256_and_si256(keys, bit_mask)), one);
+        };
+
+        // The load at 'offset' holds the quads at positions 'offset', 'offset + 4', ... in its 32-bit lanes
+        size_t block_start = 0;
+        for (; block_start + lanes + quad_size - 1 <= data.size(); block_start += lanes)
+        {
+            std::array<uint32_t, quad_size> candidates_per_offset{};
+            uint32_t any_candidates{};
+            for (size_t offset = 0; offset < quad_size; ++offset)
+            {
+                const __m256i quads = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data.data() + block_start + offset));
+                const __m256i quad_keys = _mm256_add_epi32(_mm256_srl_epi32(_mm256_mullo_epi32(quads, hash_multiplier), hash_shift), key_offset);
+                __m256i is_candidate = is_key_set(quad_keys);
+                if (has_pair_anchors)
+                {
+                    is_candidate = _mm256_or_si256(is_candidate, is_key_set(_mm256_and_si256(quads, pair_mask)));
+                }
+                candidates_per_offset[offset] = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(is_candidate, one))));
+                any_candidates |= candidates_per_offset[offset];
+            }
+
+            if (!any_candidates)
+            {
+                continue;
+            }
+
+            for (size_t offset = 0; offset < quad_size; ++offset)
+            {
+                for (auto candidates = candidates_per_offset[offset]; candidates; candidates &= candidates - 1)
+                {
+                    if (on_candidate(block_start + offset + std::countr_zero(candidates) * quad_size))
+                    {
+                        was_stopped = true;
+                        return block_start;
+                    }
+                }
+            }
+        }
+
+        return block_start;
+    }
+#endif
+
+    auto MultiPatternMatcher::find_all(std::span<const uint8_t> data, const MatchCallback& on_match, PatternMatcher::InstructionSet instruction_set) const -> bool
+    {
+        if (!m_is_built)
+        {
+            throw std::runtime_error{"[MultiPatternMatcher::find_all] build() must be called after the last pattern has been added"};
+        }
+
+        if (m_patterns.empty())
+        {
+            return false;
+        }
+
+        size_t first_scalar_position{};
+
+#if !RC_SPSS_X86
+        (void)instruction_set;
+#else
+        if (std::min(instruction_set, PatternMatcher::get_instruction_set()) == PatternMatcher::InstructionSet::AVX2)
+        {
+            auto on_candidate = [&](size_t position) {
+                return check_position(data, position, on_match);
+            };
+
+            bool was_stopped{};
+            if (m_is_vectorized_filter_usable)
+            {
+                first_scalar_position = find_anchor_candidates_avx2(data,
+                                                                    m_nibble_filter.low_nibble_buckets,
+                                                                    m_nibble_filter.high_nibble_buckets,
+                                                                    was_stopped,
+                                                                    on_candidate);
+            }
+            else
+            {
+                first_scalar_position = find_anchor_keys_avx2(data,
+                                                              m_is_anchor_key.data(),
+                                                              static_cast<uint32_t>(num_pair_keys),
+                                                              32 - std::countr_zero(num_quad_keys),
+                                                              m_has_pair_anchors,
+                                                              was_stopped,
+                                                              on_candidate);
+            }
+            if (was_stopped)
+            {
+                return true;
+            }
+        }
+#endif
+
+        if (m_has_pair_anchors)
+        {
+            return find_all_scalar<true>(data, first_scalar_position, on_match);
+        }
+        return find_all_scalar<false>(data, first_scalar_position, on_match);
+    }
+
+    auto MultiPatternMatcher::find_all(std::span<const uint8_t> data, const MatchCallback& on_match) const -> bool
+    {
+        return find_all(data, on_match, PatternMatcher::get_instruction_set());
+    }
+} // namespace RC
@@ -0,0 +1,359 @@
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+
+#include <fmt/core.h>
+#include <SigScanner/MultiPatternMatcher.hpp>
+#include <SigScanner/PatternMatcher.hpp>
+#include <SigScanner/SimdSupport.hpp>
+
+namespace RC
+{
+    static auto hex_char_to_nibble(char ch) -> uint8_t
+    {
+        if (ch >= '0' && ch <= '9') return static_cast<uint8_t>(ch - '0');
+        if (ch >= 'A' && ch <= 'F') return static_cast<uint8_t>(ch - 'A' + 10);
+        return static_cast<uint8_t>(ch - 'a' + 10);
+    }
+
+    static auto is_whitespace(char ch) -> bool
+    {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+
+    auto PatternMatcher::compile(std::string_view signature) -> BytePattern
+    {
+        // Every hex digit or '?' is one nibble, except for a lone '?' which is a whole byte wildcard
+        // In the legacy format the nibbles of a byte are separated by a space and the bytes by '/', so every '?' is one nibble
+        const bool is_legacy_format = signature.size() >= 4 && signature[3] == '/';
+        std::string nibbles{};
+        nibbles.reserve(signature.size());
+
+        for (size_t i = 0; i < signature.size(); ++i)
+        {
+            const char symbol = signature[i];
+            if (symbol == '?')
+            {
+                const bool is_lone = !is_legacy_format && (i == 0 || is_whitespace(signature[i - 1])) &&
+                                     (i + 1 == signature.size() || is_whitespace(signature[i + 1]));
+                nibbles.append(is_lone ? 2 : 1, '?');
+            }
+            else if (std::isxdigit(static_cast<unsigned char>(symbol)))
+            {
+                nibbles.push_back(symbol);
+            }
+            else if (!is_whitespace(symbol) && symbol != '/')
+            {
+                throw std::runtime_error{fmt::format("[PatternMatcher::compile] Invalid character '{}' in signature.\nSignature: {}", symbol, signature)};
+            }
+        }
+
+        if (nibbles.empty() || nibbles.size() % 2 != 0)
+        {
+            throw std::runtime_error{fmt::format("[PatternMatcher::compile] A signature must contain a whole number of bytes.\nSignature: {}", signature)};
+        }
+
+        BytePattern pattern{};
+        pattern.length = nibbles.size() / 2;
+
+        const size_t padded_size = (pattern.length + pattern_alignment - 1) / pattern_alignment * pattern_alignment;
+        pattern.bytes.resize(padded_size, 0x00);
+        pattern.mask.resize(padded_size, 0x00);
+
+        bool has_anchor{};
+        for (size_t i = 0; i < pattern.length; ++i)
+        {
+            const char hi = nibbles[i * 2];
+            const char lo = nibbles[i * 2 + 1];
+
+            uint8_t value{};
+            uint8_t mask{};
+            if (hi != '?')
+            {
+                value |= hex_char_to_nibble(hi) << 4;
+                mask |= 0xF0;
+            }
+            if (lo != '?')
+            {
+                value |= hex_char_to_nibble(lo);
+                mask |= 0x0F;
+            }
+
+            pattern.bytes[i] = value;
+            pattern.mask[i] = mask;
+
+            if (mask == 0xFF)
+            {
+                if (!has_anchor)
+                {
+                    pattern.first_anchor = i;
+                    has_anchor = true;
+                }
+                pattern.last_anchor = i;
+            }
+        }
+
+        if (!has_anchor)
+        {
+            throw std::runtime_error{fmt::format("[PatternMatcher::compile] A signature must contain at least one byte without wildcards.\nSignature: {}", signature)};
+        }
+
+        pattern.rarest_anchor = MultiPatternMatcher::find_rarest_byte_offset(pattern);
+
+        return pattern;
+    }
+
+    auto PatternMatcher::from_bytes(std::span<const uint8_t> bytes) -> BytePattern
+    {
+        if (bytes.empty())
+        {
+            throw std::runtime_error{"[PatternMatcher::from_bytes] A pattern must contain at least one byte"};
+        }
+
+        BytePattern pattern{};
+        pattern.length = bytes.size();
+
+        const size_t padded_size = (pattern.length + pattern_alignment - 1) / pattern_alignment * pattern_alignment;
+        pattern.bytes.resize(padded_size, 0x00);
+        pattern.mask.resize(padded_size, 0x00);
+        std::copy(bytes.begin(), bytes.end(), pattern.bytes.begin());
+        std::fill_n(pattern.mask.begin(), pattern.length, static_cast<uint8_t>(0xFF));
+
+        pattern.first_anchor = 0;
+        pattern.last_anchor = pattern.length - 1;
+        while (pattern.last_anchor > 0 && bytes[pattern.last_anchor] == 0x00)
+        {
+            --pattern.last_anchor;
+        }
+        pattern.rarest_anchor = MultiPatternMatcher::find_rarest_byte_offset(pattern);
+
+        return pattern;
+    }
+
+    static auto detect_instruction_set() -> PatternMatcher::InstructionSet
+    {
+#if RC_SPSS_X86
+#if defined(_MSC_VER)
+        int registers[4]{};
+        __cpuid(registers, 0);
+        if (registers[0] >= 7)
+        {
+            __cpuid(registers, 1);
+            const bool has_os_xsave = registers[2] & (1 << 27);
+            const bool has_avx = registers[2] & (1 << 28);
+            // The OS must also save the upper halves of the ymm registers
+            if (has_os_xsave && has_avx && (_xgetbv(0) & 0x6) == 0x6)
+            {
+                __cpuidex(registers, 7, 0);
+                if (registers[1] & (1 << 5))
+                {
+                    return PatternMatcher::InstructionSet::AVX2;
+                }
+            }
+        }
+        return PatternMatcher::InstructionSet::SSE2;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? PatternMatcher::InstructionSet::AVX2 : PatternMatcher::InstructionSet::SSE2;
+#endif
+#else
+        return PatternMatcher::InstructionSet::Scalar;
+#endif
+    }
+
+    auto PatternMatcher::get_instruction_set() -> InstructionSet
+    {
+        static const InstructionSet instruction_set = detect_instruction_set();
+        return instruction_set;
+    }
+
+    auto PatternMatcher::matches_at(const uint8_t* address, const BytePattern& pattern) -> bool
+    {
+        for (size_t i = 0; i < pattern.length; ++i)
+        {
+            if ((address[i] & pattern.mask[i]) != pattern.bytes[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static auto find_all_scalar(std::span<const uint8_t> data, const BytePattern& pattern, const PatternMatcher::MatchCallback& on_match) -> bool
+    {
+        if (data.size() < pattern.length)
+        {
+            return false;
+        }
+
+        const uint8_t* base = data.data();
+        const size_t last_start = data.size() - pattern.length;
+        const uint8_t rarest_anchor_byte = pattern.bytes[pattern.rarest_anchor];
+        const uint8_t first_anchor_byte = pattern.bytes[pattern.first_anchor];
+        const uint8_t last_anchor_byte = pattern.bytes[pattern.last_anchor];
+
+        for (size_t start = 0; start <= last_start; ++start)
+        {
+            // memchr is vectorized by every CRT, so this is still reasonably fast when no SIMD path is available
+            auto hit = static_cast<const uint8_t*>(std::memchr(base + start + pattern.rarest_anchor, rarest_anchor_byte, last_start - start + 1));
+            if (!hit)
+            {
+                break;
+            }
+
+            start = static_cast<size_t>(hit - base) - pattern.rarest_anchor;
+            if (base[start + pattern.first_anchor] == first_anchor_byte && base[start + pattern.last_anchor] == last_anchor_byte &&
+                PatternMatcher::matches_at(base + start, pattern) && on_match(base + start))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+#if RC_SPSS_X86
+    static auto verify_sse2(const uint8_t* address, const BytePattern& pattern) -> bool
+    {
+        for (size_t offset = 0; offset < pattern.bytes.size(); offset += 16)
+        {
+            const __m128i memory = _mm_loadu_si128(reinterpret_cast<const __m128i*>(address + offset));
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.bytes.data() + offset));
+            const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.mask.data() + offset));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(memory, mask), value)) != 0xFFFF)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static auto find_all_sse2(std::span<const uint8_t> data, const BytePattern& pattern, const PatternMatcher::MatchCallback& on_match) -> bool
+    {
+        static constexpr size_t lanes = 16;
+        if (data.size() < pattern.length)
+        {
+            return false;
+        }
+
+        const uint8_t* base = data.data();
+        const size_t last_start = data.size() - pattern.length;
+        const __m128i first_anchor_byte = _mm_set1_epi8(static_cast<char>(pattern.bytes[pattern.first_anchor]));
+        const __m128i last_anchor_byte = _mm_set1_epi8(static_cast<char>(pattern.bytes[pattern.last_anchor]));
+
+        // Each iteration tests 16 consecutive start positions against both anchors at once
+        size_t block_start = 0;
+        for (; block_start + lanes <= last_start + 1; block_start += lanes)
+        {
+            const __m128i first_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + block_start + pattern.first_anchor));
+            const __m128i last_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + block_start + pattern.last_anchor));
+            auto candidates = static_cast<uint32_t>(
+                    _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first_block, first_anchor_byte), _mm_cmpeq_epi8(last_block, last_anchor_byte))));
+
+            while (candidates)
+            {
+                const size_t start = block_start + std::countr_zero(candidates);
+                candidates &= candidates - 1;
+
+                // The padded compare reads past the end of the signature so it can only be used when that memory belongs to 'data'
+                const bool is_match = start + pattern.bytes.size() <= data.size() ? verify_sse2(base + start, pattern) : PatternMatcher::matches_at(base + start, pattern);
+                if (is_match && on_match(base + start))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return find_all_scalar(data.subspan(block_start), pattern, on_match);
+    }
+
+    RC_SPSS_TARGET_AVX2 static auto verify_avx2(const uint8_t* address, const BytePattern& pattern) -> bool
+    {
+        for (size_t offset = 0; offset < pattern.bytes.size(); offset += 32)
+        {
+            const __m256i memory = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(address + offset));
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern.bytes.data() + offset));
+            const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern.mask.data() + offset));
+            if (static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(memory, mask), value))) != 0xFFFFFFFF)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    RC_SPSS_TARGET_AVX2 static auto find_all_avx2(std::span<const uint8_t> data, const BytePattern& pattern, const PatternMatcher::MatchCallback& on_match) -> bool
+    {
+        static constexpr size_t lanes = 32;
+        if (data.size() < pattern.length)
+        {
+            return false;
+        }
+
+        const uint8_t* base = data.data();
+        const size_t last_start = data.size() - pattern.length;
+        const __m256i first_anchor_byte = _mm256_set1_epi8(static_cast<char>(pattern.bytes[pattern.first_anchor]));
+        const __m256i last_anchor_byte = _mm256_set1_epi8(static_cast<char>(pattern.bytes[pattern.last_anchor]));
+
+        // Each iteration tests 32 consecutive start positions against both anchors at once
+        size_t block_start = 0;
+        for (; block_start + lanes <= last_start + 1; block_start += lanes)
+        {
+            const __m256i first_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + block_start + pattern.first_anchor));
+            const __m256i last_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + block_start + pattern.last_anchor));
+            auto candidates = static_cast<uint32_t>(
+                    _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first_block, first_anchor_byte), _mm256_cmpeq_epi8(last_block, last_anchor_byte))));
+
+            while (candidates)
+            {
+                const size_t start = block_start + std::countr_zero(candidates);
+                candidates &= candidates - 1;
+
+                // The padded compare reads past the end of the signature so it can only be used when that memory belongs to 'data'
+                const bool is_match = start + pattern.bytes.size() <= data.size() ? verify_avx2(base + start, pattern) : PatternMatcher::matches_at(base + start, pattern);
+                if (is_match && on_match(base + start))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return find_all_scalar(data.subspan(block_start), pattern, on_match);
+    }
+#endif
+
+    auto PatternMatcher::find_all(std::span<const uint8_t> data, const BytePattern& pattern, const MatchCallback& on_match, InstructionSet instruction_set) -> bool
+    {
+        // Never use an instruction set that the CPU doesn't support, even if asked to
+        instruction_set = std::min(instruction_set, get_instruction_set());
+
+        switch (instruction_set)
+        {
+#if RC_SPSS_X86
+        case InstructionSet::AVX2:
+            return find_all_avx2(data, pattern, on_match);
+        case InstructionSet::SSE2:
+            return find_all_sse2(data, pattern, on_match);
+#endif
+        default:
+            return find_all_scalar(data, pattern, on_match);
+        }
+    }
+
+    auto PatternMatcher::find_all(std::span<const uint8_t> data, const BytePattern& pattern, const MatchCallback& on_match) -> bool
+    {
+        return find_all(data, pattern, on_match, get_instruction_set());
+    }
+
+    auto PatternMatcher::find_first(std::span<const uint8_t> data, const BytePattern& pattern) -> const uint8_t*
+    {
+        const uint8_t* first_match{};
+        find_all(data, pattern, [&](const uint8_t* match_address) {
+            first_match = match_address;
+            return true;
+        });
+        return first_match;
+    }
+} // namespace RC
@@ -0,0 +1,89 @@
+#include <algorithm>
+
+#include <SigScanner/PeImage.hpp>
+
+namespace RC
+{
+    template <typename IntType>
+    static auto read_le(std::span<const uint8_t> data, size_t offset) -> std::optional<IntType>
+    {
+        if (offset > data.size() || data.size() - offset < sizeof(IntType))
+        {
+            return std::nullopt;
+        }
+
+        uint64_t value{};
+        for (size_t i = 0; i < sizeof(IntType); ++i)
+        {
+            value |= static_cast<uint64_t>(data[offset + i]) << (i * 8);
+        }
+        return static_cast<IntType>(value);
+    }
+
+    auto PeImage::parse(std::span<const uint8_t> headers) -> std::optional<PeImage>
+    {
+        // IMAGE_DOS_HEADER::e_magic and e_lfanew
+        if (read_le<uint16_t>(headers, 0) != 0x5A4D)
+        {
+            return std::nullopt;
+        }
+        const auto nt_headers_offset = read_le<uint32_t>(headers, 0x3C);
+        if (!nt_headers_offset || read_le<uint32_t>(headers, *nt_headers_offset) != 0x00004550)
+        {
+            return std::nullopt;
+        }
+
+        // IMAGE_FILE_HEADER follows the signature
+        const size_t file_header_offset = *nt_headers_offset + 4;
+        const auto number_of_sections = read_le<uint16_t>(headers, file_header_offset + 2);
+        const auto time_date_stamp = read_le<uint32_t>(headers, file_header_offset + 4);
+        const auto size_of_optional_header = read_le<uint16_t>(headers, file_header_offset + 16);
+        if (!number_of_sections || !time_date_stamp || !size_of_optional_header)
+        {
+            return std::nullopt;
+        }
+
+        // SizeOfImage and SizeOfHeaders are at the same offsets in IMAGE_OPTIONAL_HEADER32 and IMAGE_OPTIONAL_HEADER64
+        const size_t optional_header_offset = file_header_offset + 20;
+        const auto size_of_image = read_le<uint32_t>(headers, optional_header_offset + 56);
+        const auto size_of_headers = read_le<uint32_t>(headers, optional_header_offset + 60);
+        if (!size_of_image || !size_of_headers)
+        {
+            return std::nullopt;
+        }
+
+        PeImage image{};
+        image.m_time_date_stamp = *time_date_stamp;
+        image.m_size_of_image = *size_of_image;
+        image.m_size_of_headers = *size_of_headers;
+        image.m_sections.reserve(*number_of_sections);
+
+        // IMAGE_SECTION_HEADER, 40 bytes each
+        const size_t section_table_offset = optional_header_offset + *size_of_optional_header;
+        for (size_t section_index = 0; section_index < *number_of_sections; ++section_index)
+        {
+            const size_t section_offset = section_table_offset + section_index * 40;
+            if (section_offset > headers.size() || headers.size() - section_offset < 40)
+            {
+                return std::nullopt;
+            }
+
+            auto& section = image.m_sections.emplace_back();
+            const auto name = headers.subspan(section_offset, 8);
+            section.name.assign(name.begin(), std::find(name.begin(), name.end(), 0));
+            section.virtual_size = *read_le<uint32_t>(headers, section_offset + 8);
+            section.virtual_address = *read_le<uint32_t>(headers, section_offset + 12);
+            section.size_of_raw_data = *read_le<uint32_t>(headers, section_offset + 16);
+            section.pointer_to_raw_data = *read_le<uint32_t>(headers, section_offset + 20);
+            section.characteristics = *read_le<uint32_t>(headers, section_offset + 36);
+        }
+
+        return image;
+    }
+
+    auto PeImage::find_section(std::string_view name) const -> const PeSection*
+    {
+        auto it = std::ranges::find(m_sections, name, &PeSection::name);
+        return it == m_sections.end() ? nullptr : &*it;
+    }
+} // namespace RC
@@ -0,0 +1,28 @@
+#define NOMINMAX
+#include <Windows.h>
+
+#include <SigScanner/MemorySource.hpp>
+
+namespace RC
+{
+    auto ProcessMemorySource::get() -> ProcessMemorySource&
+    {
+        static ProcessMemorySource memory_source{};
+        return memory_source;
+    }
+
+    auto ProcessMemorySource::query(const uint8_t* address) const -> std::optional<MemoryRegion>
+    {
+        MEMORY_BASIC_INFORMATION memory_info{};
+        if (!VirtualQuery(address, &memory_info, sizeof(memory_info)))
+        {
+            return std::nullopt;
+        }
+
+        return MemoryRegion{
+                .base = static_cast<uint8_t*>(memory_info.BaseAddress),
+                .size = memory_info.RegionSize,
+                .is_readable = !(memory_info.Protect & (PAGE_GUARD | PAGE_NOCACHE | PAGE_NOACCESS)) && (memory_info.State & MEM_COMMIT),
+        };
+    }
+} // namespace RC
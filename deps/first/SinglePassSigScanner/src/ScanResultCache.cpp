@@ -0,0 +1,316 @@
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+
+#include <SigScanner/ScanResultCache.hpp>
+#include <SigScanner/SinglePassSigScanner.hpp>
+
+namespace RC
+{
+    static constexpr std::array<uint8_t, 8> s_file_magic{'U', 'E', '4', 'S', 'S', 'A', 'O', 'B'};
+
+    namespace
+    {
+        class ByteWriter
+        {
+          private:
+            std::vector<uint8_t>& m_buffer;
+
+          public:
+            explicit ByteWriter(std::vector<uint8_t>& buffer) : m_buffer(buffer)
+            {
+            }
+
+            template <typename IntType>
+            auto write(IntType value) -> void
+            {
+                for (size_t i = 0; i < sizeof(IntType); ++i)
+                {
+                    m_buffer.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (i * 8)));
+                }
+            }
+
+            auto write_bytes(std::span<const uint8_t> bytes) -> void
+            {
+                m_buffer.insert(m_buffer.end(), bytes.begin(), bytes.end());
+            }
+        };
+
+        class ByteReader
+        {
+          private:
+            std::span<const uint8_t> m_data;
+            size_t m_offset{};
+            bool m_has_failed{};
+
+          public:
+            explicit ByteReader(std::span<const uint8_t> data) : m_data(data)
+            {
+            }
+
+            template <typename IntType>
+            auto read() -> IntType
+            {
+                if (m_has_failed || m_data.size() - m_offset < sizeof(IntType))
+                {
+                    m_has_failed = true;
+                    return {};
+                }
+
+                uint64_t value{};
+                for (size_t i = 0; i < sizeof(IntType); ++i)
+                {
+                    value |= static_cast<uint64_t>(m_data[m_offset++]) << (i * 8);
+                }
+                return static_cast<IntType>(value);
+            }
+
+            auto read_bytes(size_t size) -> std::span<const uint8_t>
+            {
+                if (m_has_failed || m_data.size() - m_offset < size)
+                {
+                    m_has_failed = true;
+                    return {};
+                }
+
+                auto bytes = m_data.subspan(m_offset, size);
+                m_offset += size;
+                return bytes;
+            }
+
+            [[nodiscard]] auto has_failed() const -> bool
+            {
+                return m_has_failed;
+            }
+
+            [[nodiscard]] auto get_offset() const -> size_t
+            {
+                return m_offset;
+            }
+        };
+    } // namespace
+
+    ScanResultCache::ScanResultCache(std::filesystem::path file_path, uint64_t owner_tag) : m_file_path(std::move(file_path)), m_owner_tag(owner_tag)
+    {
+    }
+
+    auto ScanResultCache::hash_bytes(std::span<const uint8_t> bytes, uint64_t seed) -> uint64_t
+    {
+        // FNV-1a
+        uint64_t hash = seed;
+        for (const auto byte : bytes)
+        {
+            hash ^= byte;
+            hash *= 0x100000001b3;
+        }
+        return hash;
+    }
+
+    auto ScanResultCache::hash_signatures(std::span<const SignatureData> signatures) -> uint64_t
+    {
+        uint64_t hash = hash_bytes({});
+        for (const auto& signature_data : signatures)
+        {
+            hash = hash_bytes({reinterpret_cast<const uint8_t*>(signature_data.signature.data()), signature_data.signature.size()}, hash);
+            // Separator so that {"AB", "CD"} and {"ABC", "D"} don't hash the same
+            static constexpr uint8_t separator = 0xFF;
+            hash = hash_bytes({&separator, 1}, hash);
+        }
+        return hash;
+    }
+
+    auto ScanResultCache::serialize() const -> std::vector<uint8_t>
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        std::vector<uint8_t> buffer{};
+        ByteWriter writer{buffer};
+
+        writer.write_bytes(s_file_magic);
+        writer.write<uint32_t>(file_version);
+        writer.write<uint64_t>(m_owner_tag);
+        writer.write<uint32_t>(static_cast<uint32_t>(m_modules.size()));
+
+        for (const auto& [path, module_entries] : m_modules)
+        {
+            writer.write<uint32_t>(static_cast<uint32_t>(path.size()));
+            writer.write_bytes({reinterpret_cast<const uint8_t*>(path.data()), path.size()});
+            writer.write<uint32_t>(module_entries.identity.time_date_stamp);
+            writer.write<uint32_t>(module_entries.identity.size_of_image);
+            writer.write<uint32_t>(static_cast<uint32_t>(module_entries.matches_by_signatures.size()));
+
+            for (const auto& [signatures_hash, matches] : module_entries.matches_by_signatures)
+            {
+                writer.write<uint64_t>(signatures_hash);
+                writer.write<uint32_t>(static_cast<uint32_t>(matches.size()));
+                for (const auto& match : matches)
+                {
+                    writer.write<uint32_t>(match.index_into_signatures);
+                    writer.write<uint64_t>(match.rva);
+                }
+            }
+        }
+
+        writer.write<uint64_t>(hash_bytes(buffer));
+        return buffer;
+    }
+
+    auto ScanResultCache::deserialize(std::span<const uint8_t> data) -> bool
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_modules.clear();
+        m_is_dirty = false;
+
+        // The checksum covers everything before it
+        if (data.size() < sizeof(uint64_t))
+        {
+            return false;
+        }
+        ByteReader checksum_reader{data.subspan(data.size() - sizeof(uint64_t))};
+        if (checksum_reader.read<uint64_t>() != hash_bytes(data.first(data.size() - sizeof(uint64_t))))
+        {
+            return false;
+        }
+
+        ByteReader reader{data.first(data.size() - sizeof(uint64_t))};
+        auto magic = reader.read_bytes(s_file_magic.size());
+        if (reader.has_failed() || !std::equal(magic.begin(), magic.end(), s_file_magic.begin()))
+        {
+            return false;
+        }
+        if (reader.read<uint32_t>() != file_version || reader.read<uint64_t>() != m_owner_tag)
+        {
+            return false;
+        }
+
+        std::unordered_map<std::string, ModuleEntries> modules{};
+        const auto num_modules = reader.read<uint32_t>();
+        for (uint32_t module_index = 0; module_index < num_modules && !reader.has_failed(); ++module_index)
+        {
+            ModuleEntries module_entries{};
+            auto path = reader.read_bytes(reader.read<uint32_t>());
+            module_entries.identity.path.assign(reinterpret_cast<const char*>(path.data()), path.size());
+            module_entries.identity.time_date_stamp = reader.read<uint32_t>();
+            module_entries.identity.size_of_image = reader.read<uint32_t>();
+
+            const auto num_entries = reader.read<uint32_t>();
+            for (uint32_t entry_index = 0; entry_index < num_entries && !reader.has_failed(); ++entry_index)
+            {
+                const auto signatures_hash = reader.read<uint64_t>();
+                const auto num_matches = reader.read<uint32_t>();
+
+                std::vector<CachedMatch> matches{};
+                for (uint32_t match_index = 0; match_index < num_matches && !reader.has_failed(); ++match_index)
+                {
+                    auto& match = matches.emplace_back();
+                    match.index_into_signatures = reader.read<uint32_t>();
+                    match.rva = reader.read<uint64_t>();
+                }
+                module_entries.matches_by_signatures.emplace(signatures_hash, std::move(matches));
+            }
+
+            modules.emplace(module_entries.identity.path, std::move(module_entries));
+        }
+
+        if (reader.has_failed())
+        {
+            return false;
+        }
+
+        m_modules = std::move(modules);
+        return true;
+    }
+
+    auto ScanResultCache::load() -> bool
+    {
+        std::ifstream file{m_file_path, std::ios::binary};
+        if (!file)
+        {
+            return false;
+        }
+
+        std::vector<uint8_t> data{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+        return deserialize(data);
+    }
+
+    auto ScanResultCache::save() -> void
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if (!m_is_dirty)
+            {
+                return;
+            }
+            m_is_dirty = false;
+        }
+
+        auto data = serialize();
+
+        std::error_code ec{};
+        std::filesystem::create_directories(m_file_path.parent_path(), ec);
+
+        // Written to a temporary file first so that a crash while saving can't leave a truncated cache behind
+        auto temporary_path = m_file_path;
+        temporary_path += ".tmp";
+        {
+            std::ofstream file{temporary_path, std::ios::binary | std::ios::trunc};
+            if (!file)
+            {
+                return;
+            }
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!file)
+            {
+                return;
+            }
+        }
+        std::filesystem::rename(temporary_path, m_file_path, ec);
+    }
+
+    auto ScanResultCache::find(const ModuleIdentity& module, uint64_t signatures_hash) const -> std::optional<std::vector<CachedMatch>>
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        auto module_it = m_modules.find(module.path);
+        if (module_it == m_modules.end() || module_it->second.identity != module)
+        {
+            return std::nullopt;
+        }
+
+        auto entry_it = module_it->second.matches_by_signatures.find(signatures_hash);
+        if (entry_it == module_it->second.matches_by_signatures.end())
+        {
+            return std::nullopt;
+        }
+
+        return entry_it->second;
+    }
+
+    auto ScanResultCache::store(const ModuleIdentity& module, uint64_t signatures_hash, std::vector<CachedMatch> matches) -> void
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        auto& module_entries = m_modules[module.path];
+        if (module_entries.identity != module)
+        {
+            // A different build of the module, nothing that was cached for the old build can be trusted
+            module_entries.identity = module;
+            module_entries.matches_by_signatures.clear();
+        }
+
+        module_entries.matches_by_signatures.insert_or_assign(signatures_hash, std::move(matches));
+        m_is_dirty = true;
+    }
+
+    auto ScanResultCache::invalidate(const ModuleIdentity& module, uint64_t signatures_hash) -> void
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        auto module_it = m_modules.find(module.path);
+        if (module_it != m_modules.end() && module_it->second.matches_by_signatures.erase(signatures_hash) > 0)
+        {
+            m_is_dirty = true;
+        }
+    }
+} // namespace RC
@@ -0,0 +1,113 @@
+#include <SigScanner/ScannerWorkerPool.hpp>
+
+namespace RC
+{
+    auto ScannerWorkerPool::get() -> ScannerWorkerPool&
+    {
+        static auto* pool = new ScannerWorkerPool{};
+        return *pool;
+    }
+
+    auto ScannerWorkerPool::run(uint32_t num_workers, const Job& job) -> void
+    {
+        std::lock_guard<std::mutex> run_guard(m_run_mutex);
+
+        if (num_workers <= 1)
+        {
+            job(0);
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> state_lock(m_state_mutex);
+            while (m_threads.size() < num_workers - 1)
+            {
+                // Pool threads are numbered from 1 because the calling thread is always worker 0
+                m_threads.emplace_back(&ScannerWorkerPool::worker_loop, this, static_cast<uint32_t>(m_threads.size() + 1));
+            }
+
+            m_job = &job;
+            m_num_participants = num_workers - 1;
+            m_num_running = num_workers - 1;
+            m_first_exception = nullptr;
+            ++m_generation;
+        }
+        m_job_available.notify_all();
+
+        std::exception_ptr exception{};
+        try
+        {
+            job(0);
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+
+        std::unique_lock<std::mutex> state_lock(m_state_mutex);
+        m_job_finished.wait(state_lock, [&] {
+            return m_num_running == 0;
+        });
+        m_job = nullptr;
+
+        if (!exception)
+        {
+            exception = m_first_exception;
+        }
+        m_first_exception = nullptr;
+        state_lock.unlock();
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    auto ScannerWorkerPool::worker_loop(uint32_t worker_index) -> void
+    {
+        uint64_t last_seen_generation{};
+        {
+            std::lock_guard<std::mutex> state_lock(m_state_mutex);
+            last_seen_generation = m_generation - 1;
+        }
+
+        while (true)
+        {
+            const Job* job{};
+            {
+                std::unique_lock<std::mutex> state_lock(m_state_mutex);
+                m_job_available.wait(state_lock, [&] {
+                    return m_generation != last_seen_generation;
+                });
+                last_seen_generation = m_generation;
+
+                // Threads that aren't needed for this job go back to sleep
+                if (worker_index > m_num_participants)
+                {
+                    continue;
+                }
+                job = m_job;
+            }
+
+            std::exception_ptr exception{};
+            try
+            {
+                (*job)(worker_index);
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> state_lock(m_state_mutex);
+                if (exception && !m_first_exception)
+                {
+                    m_first_exception = exception;
+                }
+                --m_num_running;
+            }
+            m_job_finished.notify_one();
+        }
+    }
+} // namespace RC
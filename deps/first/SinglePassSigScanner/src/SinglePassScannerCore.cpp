@@ -0,0 +1,577 @@
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <tuple>
+
+//#include <Profiler/Profiler.hpp>
+#include <SigScanner/MultiPatternMatcher.hpp>
+#include <SigScanner/PatternMatcher.hpp>
+#include <SigScanner/PeImage.hpp>
+#include <SigScanner/ScannerWorkerPool.hpp>
+#include <SigScanner/SinglePassSigScanner.hpp>
+#include <SigScanner/WideStringSearcher.hpp>
+
+// The parts of the scanner that only touch memory through a MemorySource, this file has no dependency on Windows
+// Scanning a file on disk, or on another platform, only requires pointing the scanner at a different MemorySource
+
+namespace RC
+{
+    uint32_t SinglePassScanner::m_num_threads = 8;
+    SinglePassScanner::ScanMethod SinglePassScanner::m_scan_method = ScanMethod::Vectorized;
+    uint32_t SinglePassScanner::m_multithreading_module_size_threshold = 0x200000;
+    uint32_t SinglePassScanner::m_chunk_size = 0x100000;
+    std::unique_ptr<ScanResultCache> SinglePassScanner::m_result_cache{};
+    const MemorySource* SinglePassScanner::m_memory_source{};
+
+    auto SinglePassScanner::set_memory_source(const MemorySource* memory_source) -> void
+    {
+        m_memory_source = memory_source;
+    }
+
+    auto SinglePassScanner::get_memory_source() -> const MemorySource&
+    {
+        if (m_memory_source)
+        {
+            return *m_memory_source;
+        }
+
+#ifdef _WIN32
+        return ProcessMemorySource::get();
+#else
+        throw std::runtime_error{"[SinglePassScanner::get_memory_source] There's no process memory source on this platform, call set_memory_source first"};
+#endif
+    }
+
+    // Returns the end of the readable memory region that contains 'address'
+    static auto get_readable_end(const MemorySource& memory_source, uint8_t* address) -> uint8_t*
+    {
+        const auto memory_region = memory_source.query(address);
+        if (!memory_region || !memory_region->is_readable)
+        {
+            return address + 1;
+        }
+        return memory_region->base + memory_region->size;
+    }
+
+    auto SinglePassScanner::scanner_work_thread(uint8_t* start_address,
+                                                uint8_t* end_address,
+                                                std::vector<SignatureContainer>& signature_containers,
+                                                std::vector<ScanMatch>& matches) -> void
+    {
+        // ProfilerSetThreadName("UE4SS-ScannerWorkThread");
+        // ProfilerScope();
+
+        switch (m_scan_method)
+        {
+        case ScanMethod::Scalar:
+            scanner_work_thread_scalar(start_address, end_address, signature_containers, matches);
+            break;
+        case ScanMethod::StdFind:
+            scanner_work_thread_stdfind(start_address, end_address, signature_containers, matches);
+            break;
+        case ScanMethod::Vectorized:
+            scanner_work_thread_vectorized(start_address, end_address, signature_containers, matches);
+            break;
+        case ScanMethod::MultiPattern:
+            scanner_work_thread_multi_pattern(start_address, end_address, signature_containers, matches);
+            break;
+        }
+    }
+
+    auto SinglePassScanner::scanner_work_thread_scalar(uint8_t* start_address,
+                                                       uint8_t* end_address,
+                                                       std::vector<SignatureContainer>& signature_containers,
+                                                       std::vector<ScanMatch>& matches) -> void
+    {
+        // ProfilerScope();
+
+        const auto& memory_source = get_memory_source();
+        for (auto memory_region = memory_source.query(start_address); memory_region && memory_region->base < end_address;
+             memory_region = memory_source.query(memory_region->base + memory_region->size))
+        {
+            // If the region isn't readable then skip to the next one
+            if (!memory_region->is_readable)
+            {
+                continue;
+            }
+
+            uint8_t* region_end = memory_region->base + memory_region->size;
+
+            // Signatures are allowed to extend past 'end_address' but they can't start before 'start_address' or at 'end_address'
+            // Otherwise the same match would be reported by two adjacent ranges
+            for (uint8_t* region_start = std::max(memory_region->base, start_address); region_start < region_end && region_start < end_address; ++region_start)
+            {
+                for (size_t container_index = 0; container_index < signature_containers.size(); ++container_index)
+                {
+                    const auto& signature_container = signature_containers[container_index];
+
+                    // If the container is refusing more calls then skip to the next container
+                    if (signature_container.ignore)
+                    {
+                        continue;
+                    }
+
+                    for (size_t signature_index = 0; const auto& pattern : signature_container.compiled_signatures)
+                    {
+                        // Skip if we're about to dereference memory past the end of the region
+                        if (region_start + pattern.length <= region_end && PatternMatcher::matches_at(region_start, pattern))
+                        {
+                            matches.emplace_back(ScanMatch{region_start, static_cast<uint32_t>(container_index), static_cast<uint32_t>(signature_index)});
+                        }
+
+                        ++signature_index;
+                    }
+                }
+            }
+        }
+    }
+
+    auto SinglePassScanner::scanner_work_thread_stdfind(uint8_t* start_address,
+                                                        uint8_t* end_address,
+                                                        std::vector<SignatureContainer>& signature_containers,
+                                                        std::vector<ScanMatch>& matches) -> void
+    {
+        // ProfilerScope();
+
+
+        uint8_t* readable_end = get_readable_end(get_memory_source(), end_address - 1);
+
+        // Loop everything
+        for (size_t container_index = 0; container_index < signature_containers.size(); ++container_index)
+        {
+            const auto& signature_container = signature_containers[container_index];
+
+            for (size_t signature_index = 0; const auto& pattern : signature_container.compiled_signatures)
+            {
+                // If the container is refusing more calls then skip to the next container
+                if (signature_container.ignore)
+                {
+                    break;
+                }
+
+                // Matches must start before 'end_address' but are allowed to extend past it as long as that memory is readable
+                uint8_t* search_end = std::min(readable_end, end_address + pattern.length - 1);
+                if (search_end < start_address + pattern.length)
+                {
+                    ++signature_index;
+                    continue;
+                }
+
+                // The search is for the first fully specified byte, the signature itself may start with wildcards
+                auto it = start_address + pattern.first_anchor;
+                auto end = search_end - pattern.length + 1 + pattern.first_anchor;
+                uint8_t needle = pattern.bytes[pattern.first_anchor];
+
+                while (end != (it = std::find(it, end, needle)))
+                {
+                    uint8_t* match_address = it - pattern.first_anchor;
+                    if (PatternMatcher::matches_at(match_address, pattern))
+                    {
+                        matches.emplace_back(ScanMatch{match_address, static_cast<uint32_t>(container_index), static_cast<uint32_t>(signature_index)});
+                    }
+
+                    it++;
+                }
+
+                ++signature_index;
+            }
+        }
+    }
+
+    auto SinglePassScanner::scanner_work_thread_vectorized(uint8_t* start_address,
+                                                           uint8_t* end_address,
+                                                           std::vector<SignatureContainer>& signature_containers,
+                                                           std::vector<ScanMatch>& matches) -> void
+    {
+        // ProfilerScope();
+
+        const auto& memory_source = get_memory_source();
+        for (auto memory_region = memory_source.query(start_address); memory_region && memory_region->base < end_address;
+             memory_region = memory_source.query(memory_region->base + memory_region->size))
+        {
+            if (!memory_region->is_readable)
+            {
+                continue;
+            }
+
+            uint8_t* region_start = std::max(memory_region->base, start_address);
+            uint8_t* region_end = memory_region->base + memory_region->size;
+
+            for (size_t container_index = 0; container_index < signature_containers.size(); ++container_index)
+            {
+                const auto& signature_container = signature_containers[container_index];
+
+                for (size_t signature_index = 0; signature_index < signature_container.compiled_signatures.size(); ++signature_index)
+                {
+                    // If the container is refusing more calls then skip to the next container
+                    if (signature_container.ignore)
+                    {
+                        break;
+                    }
+
+                    // Reading up to 'pattern.length - 1' bytes past 'end_address' means that every match starts inside the requested range
+                    const auto& pattern = signature_container.compiled_signatures[signature_index];
+                    uint8_t* search_end = std::min(region_end, end_address + pattern.length - 1);
+                    if (search_end <= region_start)
+                    {
+                        continue;
+                    }
+
+                    std::span<const uint8_t> region{region_start, static_cast<size_t>(search_end - region_start)};
+                    PatternMatcher::find_all(region, pattern, [&](const uint8_t* match_address) -> bool {
+                        matches.emplace_back(
+                                ScanMatch{const_cast<uint8_t*>(match_address), static_cast<uint32_t>(container_index), static_cast<uint32_t>(signature_index)});
+                        return false;
+                    });
+                }
+            }
+        }
+    }
+
+    auto SinglePassScanner::make_multi_pattern_scan(const std::vector<SignatureContainer>& signature_containers) -> std::unique_ptr<MultiPatternScan>
+    {
+        auto multi_pattern_scan = std::make_unique<MultiPatternScan>();
+        for (size_t container_index = 0; container_index < signature_containers.size(); ++container_index)
+        {
+            const auto& signature_container = signature_containers[container_index];
+            if (signature_container.ignore)
+            {
+                continue;
+            }
+
+            const auto& compiled_signatures = signature_container.compiled_signatures;
+            for (size_t signature_index = 0; signature_index < compiled_signatures.size(); ++signature_index)
+            {
+                multi_pattern_scan->matcher.add_pattern(compiled_signatures[signature_index]);
+                multi_pattern_scan->pattern_owners.emplace_back(ScanMatch{nullptr, static_cast<uint32_t>(container_index), static_cast<uint32_t>(signature_index)});
+                multi_pattern_scan->longest_pattern_length = std::max(multi_pattern_scan->longest_pattern_length, compiled_signatures[signature_index].length);
+            }
+        }
+        multi_pattern_scan->matcher.build();
+        return multi_pattern_scan;
+    }
+
+    auto SinglePassScanner::scanner_work_thread_multi_pattern(uint8_t* start_address,
+                                                              uint8_t* end_address,
+                                                              std::vector<SignatureContainer>& signature_containers,
+                                                              std::vector<ScanMatch>& matches) -> void
+    {
+        scanner_work_thread_multi_pattern(start_address, end_address, signature_containers, *make_multi_pattern_scan(signature_containers), matches);
+    }
+
+    auto SinglePassScanner::scanner_work_thread_multi_pattern(uint8_t* start_address,
+                                                              uint8_t* end_address,
+                                                              std::vector<SignatureContainer>& signature_containers,
+                                                              const MultiPatternScan& multi_pattern_scan,
+                                                              std::vector<ScanMatch>& matches) -> void
+    {
+        // ProfilerScope();
+
+        if (multi_pattern_scan.pattern_owners.empty())
+        {
+            return;
+        }
+
+        const auto& memory_source = get_memory_source();
+        for (auto memory_region = memory_source.query(start_address); memory_region && memory_region->base < end_address;
+             memory_region = memory_source.query(memory_region->base + memory_region->size))
+        {
+            if (!memory_region->is_readable)
+            {
+                continue;
+            }
+
+            // Matches are allowed to extend past 'end_address' but matches that start there belong to the next range
+            uint8_t* region_start = std::max(memory_region->base, start_address);
+            uint8_t* region_end = std::min(memory_region->base + memory_region->size, end_address + multi_pattern_scan.longest_pattern_length - 1);
+            if (region_end <= region_start)
+            {
+                continue;
+            }
+            std::span<const uint8_t> region{region_start, static_cast<size_t>(region_end - region_start)};
+
+            // Containers that started ignoring matches after the matcher was built are filtered out here
+            multi_pattern_scan.matcher.find_all(region, [&](const uint8_t* match_address, size_t pattern_index) -> bool {
+                const auto& owner = multi_pattern_scan.pattern_owners[pattern_index];
+                if (match_address < end_address && !signature_containers[owner.container_index].ignore)
+                {
+                    matches.emplace_back(ScanMatch{const_cast<uint8_t*>(match_address), owner.container_index, owner.signature_index});
+                }
+                return false;
+            });
+        }
+    }
+
+    auto SinglePassScanner::dispatch_match(SignatureContainer& signature_container, size_t signature_index, uint8_t* match_address, size_t match_signature_size)
+            -> bool
+    {
+        signature_container.index_into_signatures = signature_index;
+        signature_container.match_address = match_address;
+        signature_container.match_signature_size = match_signature_size;
+
+        signature_container.ignore = signature_container.on_match_found(signature_container);
+
+        // Store results if the container at the containers request
+        if (signature_container.store_results)
+        {
+            signature_container.result_store.emplace_back(SignatureContainerLight{.index_into_signatures = signature_index, .match_address = match_address});
+        }
+
+        if (m_result_cache)
+        {
+            signature_container.dispatched_matches.emplace_back(SignatureContainerLight{.index_into_signatures = signature_index, .match_address = match_address});
+        }
+
+        return signature_container.ignore;
+    }
+
+    auto SinglePassScanner::dispatch_matches(std::vector<SignatureContainer>& signature_containers, std::span<const ScanMatch> matches) -> void
+    {
+        for (const auto& match : matches)
+        {
+            auto& signature_container = signature_containers[match.container_index];
+            if (signature_container.ignore)
+            {
+                continue;
+            }
+
+            dispatch_match(signature_container,
+                           match.signature_index,
+                           match.match_address,
+                           signature_container.compiled_signatures[match.signature_index].length);
+        }
+    }
+
+    auto SinglePassScanner::enable_result_cache(std::filesystem::path cache_file, uint64_t owner_tag) -> void
+    {
+        m_result_cache = std::make_unique<ScanResultCache>(std::move(cache_file), owner_tag);
+        m_result_cache->load();
+    }
+
+    auto SinglePassScanner::disable_result_cache() -> void
+    {
+        m_result_cache.reset();
+    }
+
+    auto SinglePassScanner::scan_modules(std::span<ModuleScan> module_scans) -> void
+    {
+        // Every module is split into fixed-size chunks and the chunks of all modules are scanned by the same threads
+        // A thread that lands on sparse or uncommitted memory simply moves on to the next chunk instead of finishing early and idling
+        // Chunks don't need to overlap explicitly, each worker reads past the end of its chunk for matches that start inside it
+        const size_t chunk_size = std::max<size_t>(m_chunk_size, 0x1000);
+
+        struct ChunkTask
+        {
+            ModuleScan* module_scan{};
+            size_t chunk{};
+            size_t size{};
+        };
+
+        // The largest modules are scheduled first so that the threads don't end up waiting on one big module at the end
+        std::vector<ModuleScan*> modules_by_size{};
+        size_t total_size{};
+        for (auto& module_scan : module_scans)
+        {
+            if (!module_scan.is_scan_required)
+            {
+                continue;
+            }
+
+            module_scan.num_chunks = (module_scan.module_size + chunk_size - 1) / chunk_size;
+            module_scan.matches_per_chunk.resize(module_scan.num_chunks);
+            module_scan.is_chunk_scanned = std::make_unique<std::atomic<bool>[]>(module_scan.num_chunks);
+            if (m_scan_method == ScanMethod::MultiPattern)
+            {
+                module_scan.multi_pattern_scan = make_multi_pattern_scan(*module_scan.signature_containers);
+            }
+            modules_by_size.emplace_back(&module_scan);
+            total_size += module_scan.module_size;
+        }
+        std::ranges::stable_sort(modules_by_size, std::greater{}, &ModuleScan::module_size);
+
+        std::vector<ChunkTask> tasks{};
+        for (auto* module_scan : modules_by_size)
+        {
+            for (size_t chunk = 0; chunk < module_scan->num_chunks; ++chunk)
+            {
+                tasks.emplace_back(ChunkTask{module_scan, chunk, std::min(chunk_size, module_scan->module_size - chunk * chunk_size)});
+            }
+        }
+
+        // Consecutive tasks are batched into roughly chunk-sized pieces of work, so small modules are handed out several at a time
+        std::vector<size_t> batch_starts{};
+        for (size_t task_index = 0, batch_size = chunk_size; task_index < tasks.size(); ++task_index)
+        {
+            if (batch_size + tasks[task_index].size > chunk_size)
+            {
+                batch_starts.emplace_back(task_index);
+                batch_size = 0;
+            }
+            batch_size += tasks[task_index].size;
+        }
+        const size_t num_batches = batch_starts.size();
+        batch_starts.emplace_back(tasks.size());
+        std::atomic<size_t> next_batch{};
+
+        // Matches are forwarded by whichever thread gets here first, the others go back to scanning instead of waiting for it
+        // This also means that callbacks never run concurrently, even when they belong to different modules
+        std::atomic_flag is_dispatching{};
+        auto has_undispatched_chunk = [&] {
+            return std::ranges::any_of(modules_by_size, [](ModuleScan* module_scan) {
+                const size_t chunk = module_scan->next_chunk_to_dispatch;
+                return chunk < module_scan->num_chunks && module_scan->is_chunk_scanned[chunk];
+            });
+        };
+        auto dispatch_scanned_chunks = [&] {
+            while (!is_dispatching.test_and_set())
+            {
+                for (auto* module_scan : modules_by_size)
+                {
+                    for (size_t chunk = module_scan->next_chunk_to_dispatch; chunk < module_scan->num_chunks && module_scan->is_chunk_scanned[chunk];
+                         chunk = ++module_scan->next_chunk_to_dispatch)
+                    {
+                        dispatch_matches(*module_scan->signature_containers, module_scan->matches_per_chunk[chunk]);
+                        module_scan->matches_per_chunk[chunk] = {};
+                    }
+                }
+                is_dispatching.clear();
+
+                // A chunk that was finished after the loop above checked it, but before the flag was cleared, would otherwise never be forwarded
+                if (!has_undispatched_chunk())
+                {
+                    break;
+                }
+            }
+        };
+
+        auto scan_batches = [&](uint32_t) {
+            for (size_t batch = next_batch++; batch < num_batches; batch = next_batch++)
+            {
+                for (size_t task_index = batch_starts[batch]; task_index < batch_starts[batch + 1]; ++task_index)
+                {
+                    auto& [module_scan, chunk, size] = tasks[task_index];
+                    uint8_t* chunk_start_address = module_scan->module_start_address + chunk * chunk_size;
+
+                    auto& matches = module_scan->matches_per_chunk[chunk];
+                    if (module_scan->multi_pattern_scan)
+                    {
+                        scanner_work_thread_multi_pattern(chunk_start_address,
+                                                          chunk_start_address + size,
+                                                          *module_scan->signature_containers,
+                                                          *module_scan->multi_pattern_scan,
+                                                          matches);
+                    }
+                    else
+                    {
+                        scanner_work_thread(chunk_start_address, chunk_start_address + size, *module_scan->signature_containers, matches);
+                    }
+                    std::ranges::sort(matches, [](const ScanMatch& a, const ScanMatch& b) {
+                        return std::tie(a.match_address, a.container_index, a.signature_index) < std::tie(b.match_address, b.container_index, b.signature_index);
+                    });
+
+                    module_scan->is_chunk_scanned[chunk] = true;
+                }
+                dispatch_scanned_chunks();
+            }
+        };
+
+        if (total_size < m_multithreading_module_size_threshold || m_num_threads <= 1 || num_batches <= 1)
+        {
+            // Too little to scan to make it overall faster to scan with multiple threads
+            scan_batches(0);
+        }
+        else
+        {
+            ScannerWorkerPool::get().run(static_cast<uint32_t>(std::min<size_t>(m_num_threads, num_batches)), scan_batches);
+        }
+
+        dispatch_scanned_chunks();
+    }
+
+    auto SinglePassScanner::scan_range(uint8_t* start_address, size_t size, std::vector<SignatureContainer>& signature_containers) -> void
+    {
+        std::vector<ModuleScan> module_scans(1);
+        module_scans[0].module_start_address = start_address;
+        module_scans[0].module_size = size;
+        module_scans[0].signature_containers = &signature_containers;
+        module_scans[0].is_scan_required = start_address && size > 0;
+
+        scan_modules(module_scans);
+
+        for (auto& container : signature_containers)
+        {
+            container.on_scan_finished(container);
+        }
+    }
+
+    // Searches the readable parts of [start_address, end_address) in address order until every string has been found
+    static auto search_readable_memory(const WideStringSearcher& searcher, uint8_t* start_address, uint8_t* end_address, std::span<const uint8_t*> first_matches)
+            -> bool
+    {
+        const auto& memory_source = SinglePassScanner::get_memory_source();
+        for (auto memory_region = memory_source.query(start_address); memory_region && memory_region->base < end_address;
+             memory_region = memory_source.query(memory_region->base + memory_region->size))
+        {
+            if (!memory_region->is_readable)
+            {
+                continue;
+            }
+
+            uint8_t* region_start = std::max(memory_region->base, start_address);
+            uint8_t* region_end = std::min(memory_region->base + memory_region->size, end_address);
+            if (searcher.search({region_start, static_cast<size_t>(region_end - region_start)}, first_matches))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    auto SinglePassScanner::string_scan_range(uint8_t* start_address, size_t size, std::span<const std::wstring_view> strings_to_scan_for) -> std::vector<void*>
+    {
+        auto end_address = start_address + size;
+
+        WideStringSearcher searcher{strings_to_scan_for};
+        std::vector<const uint8_t*> first_matches(strings_to_scan_for.size());
+
+        // String literals live in .rdata, so that's searched first and the rest of the module is only searched for strings that weren't found there
+        bool is_done{};
+        uint8_t* rdata_start{};
+        uint8_t* rdata_end{};
+        if (start_address)
+        {
+            const auto image = PeImage::parse({start_address, std::min<size_t>(size, 0x1000)});
+            if (const auto rdata = image ? image->find_section(".rdata") : nullptr;
+                rdata && rdata->virtual_address < size && rdata->virtual_size <= size - rdata->virtual_address)
+            {
+                rdata_start = start_address + rdata->virtual_address;
+                rdata_end = rdata_start + rdata->virtual_size;
+                is_done = search_readable_memory(searcher, rdata_start, rdata_end, first_matches);
+            }
+        }
+
+        if (!is_done)
+        {
+            if (rdata_start)
+            {
+                if (!search_readable_memory(searcher, start_address, rdata_start, first_matches))
+                {
+                    search_readable_memory(searcher, rdata_end, end_address, first_matches);
+                }
+            }
+            else
+            {
+                search_readable_memory(searcher, start_address, end_address, first_matches);
+            }
+        }
+
+        std::vector<void*> addresses_found{};
+        addresses_found.reserve(first_matches.size());
+        for (const auto match : first_matches)
+        {
+            addresses_found.emplace_back(const_cast<uint8_t*>(match));
+        }
+        return addresses_found;
+    }
+} // namespace RC
@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <format>
-#include <future>
+#include <atomic>
 #include <regex>
+#include <tuple>
 
 #define NOMINMAX
 #include <Windows.h>
@@ -8,6 +10,7 @@
 
 #include <fmt/core.h>
 //#include <Profiler/Profiler.hpp>
+#include <SigScanner/PatternMatcher.hpp>
 #include <SigScanner/SinglePassSigScanner.hpp>
 
 namespace RC
@@ -15,11 +18,6 @@ namespace RC
     ScanTargetArray SigScannerStaticData::m_modules_info;
     bool SigScannerStaticData::m_is_modular;
 
-    uint32_t SinglePassScanner::m_num_threads = 8;
-    SinglePassScanner::ScanMethod SinglePassScanner::m_scan_method = ScanMethod::Scalar;
-    uint32_t SinglePassScanner::m_multithreading_module_size_threshold = 0x1000000;
-    std::mutex SinglePassScanner::m_scanner_mutex{};
-
     auto WIN_MODULEINFO::operator=(MODULEINFO other) -> WIN_MODULEINFO&
     {
         lpBaseOfDll = other.lpBaseOfDll;
@@ -317,488 +315,171 @@ namespace RC
         return ScanTargetToString(static_cast<ScanTarget>(scan_target));
     }
 
-    static auto ConvertHexCharToInt(char ch) -> int
+    auto SinglePassScanner::string_scan(std::wstring_view string_to_scan_for, ScanTarget scan_target) -> void*
     {
-        if (ch >= '0' && ch <= '9') return ch - '0';
-        if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
-        if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
-        return -1;
+        const std::wstring_view strings_to_scan_for[]{string_to_scan_for};
+        return string_scan(strings_to_scan_for, scan_target)[0];
     }
 
-    auto SinglePassScanner::string_to_vector(std::string_view signature) -> std::vector<int>
+    auto SinglePassScanner::string_scan(std::span<const std::wstring_view> strings_to_scan_for, ScanTarget scan_target) -> std::vector<void*>
     {
-        std::vector<int> bytes;
-        char* const start = const_cast<char*>(signature.data());
-        char* const end = const_cast<char*>(signature.data()) + strlen(signature.data());
-
-        for (char* current = start; current < end; current++)
-        {
-            if (*current == '?')
-            {
-                bytes.push_back(-1);
-            }
-            else if (std::isxdigit(*current))
-            {
-                bytes.push_back(ConvertHexCharToInt(*current));
-            }
-        }
-
-        return bytes;
+        auto module = SigScannerStaticData::m_modules_info[scan_target];
+        return string_scan_range(static_cast<uint8_t*>(module.lpBaseOfDll), module.SizeOfImage, strings_to_scan_for);
     }
 
-    auto SinglePassScanner::string_to_vector(const std::vector<SignatureData>& signatures) -> std::vector<std::vector<int>>
+    static auto get_module_identity(uint8_t* module_start_address, size_t module_size) -> ModuleIdentity
     {
-        std::vector<std::vector<int>> vector_of_signatures;
-        vector_of_signatures.reserve(signatures.size());
+        ModuleIdentity identity{};
+        identity.size_of_image = static_cast<uint32_t>(module_size);
 
-        for (const auto& signature_data : signatures)
+        const auto dos_header = std::bit_cast<PIMAGE_DOS_HEADER>(module_start_address);
+        if (dos_header->e_magic == IMAGE_DOS_SIGNATURE)
         {
-            vector_of_signatures.emplace_back(string_to_vector(signature_data.signature));
-        }
-
-        return vector_of_signatures;
-    }
-
-    auto SinglePassScanner::string_scan(std::wstring_view string_to_scan_for, ScanTarget scan_target) -> void*
-    {
-        auto module = SigScannerStaticData::m_modules_info[scan_target];
-
-        auto start_address = static_cast<uint8_t*>(module.lpBaseOfDll);
-        auto end_address = static_cast<uint8_t*>(module.lpBaseOfDll) + module.SizeOfImage;
-
-        MEMORY_BASIC_INFORMATION memory_info{};
-        DWORD protect_flags = PAGE_GUARD | PAGE_NOCACHE | PAGE_NOACCESS;
-
-        void* address_found{};
-
-        for (uint8_t* i = start_address; i < end_address; ++i)
-        {
-            if (VirtualQuery(i, &memory_info, sizeof(memory_info)))
+            const auto nt_headers = std::bit_cast<PIMAGE_NT_HEADERS>(module_start_address + dos_header->e_lfanew);
+            if (nt_headers->Signature == IMAGE_NT_SIGNATURE)
             {
-                if (memory_info.Protect & protect_flags || !(memory_info.State & MEM_COMMIT))
-                {
-                    i += memory_info.RegionSize;
-                    continue;
-                }
-
-                uint8_t* region_end = static_cast<uint8_t*>(memory_info.BaseAddress) + memory_info.RegionSize;
-
-                for (uint8_t* region_start = static_cast<uint8_t*>(memory_info.BaseAddress); region_start < region_end; ++region_start)
-                {
-                    if (region_start > end_address || region_start + string_to_scan_for.size() > end_address)
-                    {
-                        break;
-                    }
-
-                    std::wstring_view maybe_string = std::wstring_view((const wchar_t*)region_start, string_to_scan_for.size());
-                    if (maybe_string == string_to_scan_for)
-                    {
-                        address_found = region_start;
-                        break;
-                    }
-                }
-
-                if (address_found)
-                {
-                    break;
-                }
-                i = static_cast<uint8_t*>(memory_info.BaseAddress) + memory_info.RegionSize;
+                identity.time_date_stamp = nt_headers->FileHeader.TimeDateStamp;
+                identity.size_of_image = nt_headers->OptionalHeader.SizeOfImage;
             }
         }
 
-        return address_found;
-    }
-
-    struct PatternData
-    {
-        std::vector<uint8_t> pattern{};
-        std::vector<uint8_t> mask{};
-        SignatureContainer* signature_container{};
-    };
-
-    static auto CharToByte(char symbol) -> uint8_t
-    {
-        if (symbol >= 'a' && symbol <= 'z')
+        wchar_t module_path[MAX_PATH]{};
+        const auto module_path_length = GetModuleFileNameW(std::bit_cast<HMODULE>(module_start_address), module_path, MAX_PATH);
+        if (module_path_length > 0)
         {
-            return symbol - 'a' + 0xA;
-        }
-        else if (symbol >= 'A' && symbol <= 'Z')
-        {
-            return symbol - 'A' + 0xA;
-        }
-        else if (symbol >= '0' && symbol <= '9')
-        {
-            return symbol - '0';
-        }
-        else
-        {
-            return 0;
+            const auto path_size = WideCharToMultiByte(CP_UTF8, 0, module_path, static_cast<int>(module_path_length), nullptr, 0, nullptr, nullptr);
+            identity.path.resize(path_size);
+            WideCharToMultiByte(CP_UTF8, 0, module_path, static_cast<int>(module_path_length), identity.path.data(), path_size, nullptr, nullptr);
         }
+
+        return identity;
     }
 
-    static auto make_mask(std::string_view pattern, SignatureContainer& signature_container, const size_t data_size) -> PatternData
+    // A cached match is only trusted if the bytes at its address still match the signature, this catches executables that were patched in place
+    static auto are_cached_matches_valid(const std::vector<BytePattern>& patterns,
+                                         const std::vector<CachedMatch>& cached_matches,
+                                         uint8_t* module_start_address,
+                                         size_t module_size) -> bool
     {
-        PatternData pattern_data{};
-
-        if (pattern.length() < 1 || pattern[0] == '?')
+        for (const auto& cached_match : cached_matches)
         {
-            throw std::runtime_error{fmt::format("[make_mask] A pattern cannot start with a wildcard.\nPattern: {}", pattern)};
-        }
-
-        for (size_t i = 0; i < pattern.length(); i++)
-        {
-            char symbol = pattern[i];
-            char next_symbol = ((i + 1) < pattern.length()) ? pattern[i + 1] : 0;
-            if (symbol == ' ')
+            if (cached_match.index_into_signatures >= patterns.size())
             {
-                continue;
+                return false;
             }
 
-            if (symbol == '?')
+            const auto& pattern = patterns[cached_match.index_into_signatures];
+            if (cached_match.rva > module_size || module_size - cached_match.rva < pattern.length ||
+                !PatternMatcher::matches_at(module_start_address + cached_match.rva, pattern))
             {
-                pattern_data.pattern.push_back(0x00);
-                pattern_data.mask.push_back(0x00);
-
-                if (next_symbol == '?')
-                {
-                    ++i;
-                }
-                continue;
+                return false;
             }
-
-            uint8_t byte = CharToByte(symbol) << 4 | CharToByte(next_symbol);
-
-            pattern_data.pattern.push_back(byte);
-            pattern_data.mask.push_back(0xff);
-
-            ++i;
-        }
-
-        static constexpr size_t Alignment = 32;
-        size_t count = (size_t)std::ceil((float)data_size / Alignment);
-        size_t padding_size = count * Alignment - data_size;
-
-        for (size_t i = 0; i < padding_size; i++)
-        {
-            pattern_data.pattern.push_back(0x00);
-            pattern_data.mask.push_back(0x00);
         }
-
-        pattern_data.signature_container = &signature_container;
-        return pattern_data;
+        return true;
     }
 
-    auto SinglePassScanner::scanner_work_thread(uint8_t* start_address, uint8_t* end_address, SYSTEM_INFO& info, std::vector<SignatureContainer>& signature_containers)
-            -> void
+    auto SinglePassScanner::prepare_module_scan(ModuleScan& module_scan) -> void
     {
-        // ProfilerSetThreadName("UE4SS-ScannerWorkThread");
-        // ProfilerScope();
+        auto& signature_containers = *module_scan.signature_containers;
 
-        switch (m_scan_method)
+        // Modules that aren't loaded have no base address, there's nothing to scan
+        if (!module_scan.module_start_address || module_scan.module_size == 0)
         {
-        case ScanMethod::Scalar:
-            scanner_work_thread_scalar(start_address, end_address, info, signature_containers);
-            break;
-        case ScanMethod::StdFind:
-            scanner_work_thread_stdfind(start_address, end_address, info, signature_containers);
-            break;
+            return;
         }
-    }
 
-    auto SinglePassScanner::scanner_work_thread_scalar(uint8_t* start_address,
-                                                       uint8_t* end_address,
-                                                       SYSTEM_INFO& info,
-                                                       std::vector<SignatureContainer>& signature_containers) -> void
-    {
-        // ProfilerScope();
-        if (!start_address)
+        if (!m_result_cache)
         {
-            start_address = static_cast<uint8_t*>(info.lpMinimumApplicationAddress);
-        }
-        if (!end_address)
-        {
-            start_address = static_cast<uint8_t*>(info.lpMaximumApplicationAddress);
+            module_scan.is_scan_required = true;
+            return;
         }
 
-        MEMORY_BASIC_INFORMATION memory_info{};
-        DWORD protect_flags = PAGE_GUARD | PAGE_NOCACHE | PAGE_NOACCESS;
-
-        // TODO: Nasty nasty nasty. Come up with a better solution... wtf
-        // It should ideally be able to work with the char* directly instead of converting to to vectors of ints
-        // The reason why working directly with the char* is a problem is that it's expensive to convert a hex char to an int
-        // Also look at the comments below
-        std::vector<std::vector<std::vector<int>>> vector_of_sigs;
+        module_scan.module_identity = get_module_identity(module_scan.module_start_address, module_scan.module_size);
+        module_scan.signatures_hashes.reserve(signature_containers.size());
+        module_scan.needs_scan.reserve(signature_containers.size());
 
-        // const std::regex signature_validity_regex(R"(^([0-9A-F\?] )([0-9A-F\?]\/[0-9A-F\?] )*([0-9A-F\?])$)");
-
-        // Making a vector here to be identical to the SignatureContainer vector
-        // The difference is that it stores the sigs converted from char* to std::vector<int>
-        // This makes it easier to work with even if it's wasteful
-        // This should not be done in the nested loops below because this operation is very slow
-        vector_of_sigs.reserve(signature_containers.size());
-        for (const auto& container : signature_containers)
+        for (auto& signature_container : signature_containers)
         {
-            // Only continue if the signature is properly formatted
-            // Bring this code back when both:
-            // A. The regex has been updated to take into consideration.
-            // B. The threads have been synced before the scan to verify that all threads are scanning for valid signatures.
-            // for (const auto& signature_data : container.signatures)
-            //{
-            //    if (!std::regex_search(signature_data.signature, signature_validity_regex))
-            //    {
-            //        throw std::runtime_error{fmt::format("[SinglePassSigScanner::start_scan] A signature is improperly formatted. Signature: {}", signature_data.signature)};
-            //    }
-            //}
-
-            // Signatures for this container
-            vector_of_sigs.emplace_back(string_to_vector(container.signatures));
-        }
+            const auto signatures_hash = ScanResultCache::hash_signatures(signature_container.signatures);
+            module_scan.signatures_hashes.emplace_back(signatures_hash);
 
-        // Loop everything
-        for (uint8_t* i = start_address; i < end_address; ++i)
-        {
-            // Populate memory_info if VirtualQuery doesn't fail
-            if (VirtualQuery(i, &memory_info, sizeof(memory_info)))
+            auto cached_matches = m_result_cache->find(module_scan.module_identity, signatures_hash);
+            if (cached_matches)
             {
-                // If the "protect flags" or state are undesired for this region then skip to the next iteration of the loop
-                if (memory_info.Protect & protect_flags || !(memory_info.State & MEM_COMMIT))
-                {
-                    i += memory_info.RegionSize;
-                    continue;
-                }
-
-                uint8_t* region_end = static_cast<uint8_t*>(memory_info.BaseAddress) + memory_info.RegionSize;
-
-                for (uint8_t* region_start = static_cast<uint8_t*>(memory_info.BaseAddress); region_start < region_end; ++region_start)
+                const auto& patterns = signature_container.compiled_signatures;
+                if (are_cached_matches_valid(patterns, *cached_matches, module_scan.module_start_address, module_scan.module_size))
                 {
-                    if (region_start > end_address)
-                    {
-                        break;
-                    }
-
-                    bool skip_to_next_container{};
-
-                    for (size_t container_index = 0; const auto& int_container : vector_of_sigs)
+                    for (const auto& cached_match : *cached_matches)
                     {
-                        for (size_t signature_index = 0; const auto& sig : int_container)
+                        if (dispatch_match(signature_container,
+                                           cached_match.index_into_signatures,
+                                           module_scan.module_start_address + cached_match.rva,
+                                           patterns[cached_match.index_into_signatures].length))
                         {
-                            // If the container is refusing more calls then skip to the next container
-                            if (signature_containers[container_index].ignore)
-                            {
-                                break;
-                            }
-
-                            // Skip if we're about to dereference uninitialized memory
-                            if (region_start + sig.size() > region_end)
-                            {
-                                break;
-                            }
-
-                            for (size_t sig_i = 0; sig_i < sig.size(); sig_i += 2)
-                            {
-                                if (sig.at(sig_i) != -1 && sig.at(sig_i) != HI_NIBBLE(*(byte*)(region_start + (sig_i / 2))) ||
-                                    sig.at(sig_i + 1) != -1 && sig.at(sig_i + 1) != LO_NIBBLE(*(byte*)(region_start + (sig_i / 2))))
-                                {
-                                    break;
-                                }
-
-                                if (sig_i + 2 == sig.size())
-                                {
-                                    {
-                                        std::lock_guard<std::mutex> safe_scope(m_scanner_mutex);
-
-                                        // Checking for the second time if the container is refusing more calls
-                                        // This is required when multi-threading is enabled
-                                        if (signature_containers[container_index].ignore)
-                                        {
-                                            skip_to_next_container = true;
-                                            break;
-                                        }
-
-                                        // One of the signatures have found a full match so lets forward the details to the callable
-                                        signature_containers[container_index].index_into_signatures = signature_index;
-                                        signature_containers[container_index].match_address = region_start;
-                                        signature_containers[container_index].match_signature_size = sig.size() / 2;
-
-                                        skip_to_next_container = signature_containers[container_index].on_match_found(signature_containers[container_index]);
-                                        signature_containers[container_index].ignore = skip_to_next_container;
-
-                                        // Store results if the container at the containers request
-                                        if (signature_containers[container_index].store_results)
-                                        {
-                                            signature_containers[container_index].result_store.emplace_back(
-                                                    SignatureContainerLight{.index_into_signatures = signature_index, .match_address = region_start});
-                                        }
-                                    }
-
-                                    break;
-                                }
-                            }
-
-                            if (skip_to_next_container)
-                            {
-                                // A match was found and signaled to skip to the next container
-                                break;
-                            }
-
-                            ++signature_index;
+                            break;
                         }
-
-                        ++container_index;
                     }
+
+                    // The container has everything it asked for, keep the scan from forwarding the same matches again
+                    signature_container.ignore = true;
+                    module_scan.needs_scan.emplace_back(false);
+                    continue;
                 }
 
-                i = static_cast<uint8_t*>(memory_info.BaseAddress) + memory_info.RegionSize;
+                m_result_cache->invalidate(module_scan.module_identity, signatures_hash);
             }
-        }
-    }
 
-    static auto format_aob_string(std::string& str) -> void
-    {
-        if (str.size() < 4)
-        {
-            return;
-        }
-        if (str[3] != '/')
-        {
-            return;
+            signature_container.dispatched_matches.clear();
+            module_scan.needs_scan.emplace_back(true);
+            module_scan.is_scan_required = true;
         }
-
-        std::erase_if(str, [&](const char c) {
-            return c == ' ';
-        });
-
-        std::ranges::transform(str, str.begin(), [&str](const char c) {
-            return c == '/' ? ' ' : c;
-        });
     }
 
-    auto SinglePassScanner::format_aob_strings(std::vector<SignatureContainer>& signature_containers) -> void
+    auto SinglePassScanner::finish_module_scan(ModuleScan& module_scan) -> void
     {
-        std::lock_guard<std::mutex> safe_scope(m_scanner_mutex);
-        for (auto& signature_container : signature_containers)
-        {
-            for (auto& signature : signature_container.signatures)
-            {
-                format_aob_string(signature.signature);
-            }
-        }
-    }
+        auto& signature_containers = *module_scan.signature_containers;
 
-    auto SinglePassScanner::scanner_work_thread_stdfind(uint8_t* start_address,
-                                                        uint8_t* end_address,
-                                                        SYSTEM_INFO& info,
-                                                        std::vector<SignatureContainer>& signature_containers) -> void
-    {
-        // ProfilerScope();
-
-        if (!start_address)
-        {
-            start_address = static_cast<uint8_t*>(info.lpMinimumApplicationAddress);
-        }
-        if (!end_address)
+        if (m_result_cache && module_scan.is_scan_required)
         {
-            start_address = static_cast<uint8_t*>(info.lpMaximumApplicationAddress);
-        }
-
-        format_aob_strings(signature_containers);
-
-        std::vector<std::vector<PatternData>> pattern_datas{};
-        for (auto& signature_container : signature_containers)
-        {
-            auto& pattern_data = pattern_datas.emplace_back();
-            for (auto& signature : signature_container.signatures)
+            for (size_t container_index = 0; container_index < signature_containers.size(); ++container_index)
             {
-                pattern_data.emplace_back(make_mask(signature.signature, signature_container, end_address - start_address));
-            }
-        }
-
-        // Loop everything
-        for (size_t container_index = 0; const auto& patterns : pattern_datas)
-        {
-            for (size_t signature_index = 0; const auto& pattern_data : patterns)
-            {
-                // If the container is refusing more calls then skip to the next container
-                if (pattern_data.signature_container->ignore)
-                {
-                    break;
-                }
-
-                auto it = start_address;
-                auto end = it + (end_address - start_address) - (pattern_data.pattern.size()) + 1;
-                uint8_t needle = pattern_data.pattern[0];
-
-                bool skip_to_next_container{};
-                while (end != (it = std::find(it, end, needle)))
+                // A scan that found nothing isn't cached, the memory may simply not have been ready yet (e.g. a packed executable)
+                if (!module_scan.needs_scan[container_index] || signature_containers[container_index].dispatched_matches.empty())
                 {
-                    bool found = true;
-                    for (size_t pattern_offset = 0; pattern_offset < pattern_data.pattern.size(); ++pattern_offset)
-                    {
-                        if ((it[pattern_offset] & pattern_data.mask[pattern_offset]) != pattern_data.pattern[pattern_offset])
-                        {
-                            found = false;
-                            break;
-                        }
-                    }
-
-                    if (found)
-                    {
-                        {
-                            std::lock_guard<std::mutex> safe_scope(m_scanner_mutex);
-
-                            // Checking for the second time if the container is refusing more calls
-                            // This is required when multi-threading is enabled
-                            if (pattern_data.signature_container->ignore)
-                            {
-                                skip_to_next_container = true;
-                                break;
-                            }
-
-                            // One of the signatures have found a full match so lets forward the details to the callable
-                            pattern_data.signature_container->index_into_signatures = signature_index;
-                            pattern_data.signature_container->match_address = it;
-                            pattern_data.signature_container->match_signature_size = pattern_data.pattern.size();
-
-                            skip_to_next_container = pattern_data.signature_container->on_match_found(*pattern_data.signature_container);
-                            pattern_data.signature_container->ignore = skip_to_next_container;
-
-                            // Store results if the container at the containers request
-                            if (pattern_data.signature_container->store_results)
-                            {
-                                pattern_data.signature_container->result_store.emplace_back(
-                                        SignatureContainerLight{.index_into_signatures = signature_index, .match_address = it});
-                            }
-                        }
-                    }
-
-                    it++;
+                    continue;
                 }
 
-                if (skip_to_next_container)
+                // Matches are stored in the order they were forwarded so that a warm start forwards them in the same order
+                std::vector<CachedMatch> matches{};
+                for (const auto& dispatched_match : signature_containers[container_index].dispatched_matches)
                 {
-                    // A match was found and signaled to skip to the next container
-                    break;
+                    matches.emplace_back(CachedMatch{
+                            .index_into_signatures = static_cast<uint32_t>(dispatched_match.index_into_signatures),
+                            .rva = static_cast<uint64_t>(dispatched_match.match_address - module_scan.module_start_address),
+                    });
                 }
-
-                ++signature_index;
+                m_result_cache->store(module_scan.module_identity, module_scan.signatures_hashes[container_index], std::move(matches));
             }
-            ++container_index;
+        }
+
+        for (auto& container : signature_containers)
+        {
+            container.on_scan_finished(container);
         }
     }
 
     auto SinglePassScanner::start_scan(SignatureContainerMap& signature_containers) -> void
     {
-        SYSTEM_INFO info{};
-        GetSystemInfo(&info);
-
         // If not modular then the containers get merged into one scan target
         // That way there are no extra scans
-        // If modular then loop the containers and retrieve the scan target for each and pass everything to the do_scan() lambda
+        // If modular then every scan target is scanned at the same time, each with its own containers
+
+        std::vector<SignatureContainer> merged_containers;
+        std::vector<ModuleScan> module_scans{};
 
         if (!SigScannerStaticData::m_is_modular)
         {
             MODULEINFO merged_module_info{};
-            std::vector<SignatureContainer> merged_containers;
 
             for (const auto& [scan_target, outer_container] : signature_containers)
             {
@@ -815,65 +496,40 @@ namespace RC
                                          "an internal error."};
             }
 
-            uint8_t* module_start_address = static_cast<uint8_t*>(merged_module_info.lpBaseOfDll);
-
-            if (merged_module_info.SizeOfImage >= m_multithreading_module_size_threshold)
-            {
-                // Module is large enough to make it overall faster to scan with multiple threads
-                std::vector<std::future<void>> scan_threads;
-
-                // Higher values are better for debugging
-                // You will get a bigger diminishing returns the faster your computer is (especially in release mode)
-                uint32_t range = merged_module_info.SizeOfImage / m_num_threads;
-
-                // Calculating the ranges for each thread to scan and starting the scan
-                uint32_t last_range{};
-                for (uint32_t thread_id = 0; thread_id < m_num_threads; ++thread_id)
-                {
-                    scan_threads.emplace_back(std::async(std::launch::async,
-                                                         &scanner_work_thread,
-                                                         module_start_address + last_range,
-                                                         module_start_address + last_range + range,
-                                                         std::ref(info),
-                                                         std::ref(merged_containers)));
-
-                    last_range += range;
-                }
-
-                for (const auto& scan_thread : scan_threads)
-                {
-                    scan_thread.wait();
-                }
-            }
-            else
-            {
-                // Module is too small to make it overall faster to scan with multiple threads
-                uint8_t* module_end_address = static_cast<uint8_t*>(module_start_address + merged_module_info.SizeOfImage);
-                scanner_work_thread(module_start_address, module_end_address, info, merged_containers);
-            }
-
-            for (auto& container : merged_containers)
-            {
-                container.on_scan_finished(container);
-            }
+            module_scans = std::vector<ModuleScan>(1);
+            module_scans[0].module_start_address = static_cast<uint8_t*>(merged_module_info.lpBaseOfDll);
+            module_scans[0].module_size = merged_module_info.SizeOfImage;
+            module_scans[0].signature_containers = &merged_containers;
         }
         else
         {
-            // This ranged for loop is performing a copy of unordered_map<ScanTarget, vector<SignatureContainer>>
-            // Is this required ? Would it be worth trying to avoid copying here ?
-            // Right now it can't be auto& or const auto& because the do_scan function takes a non-const since it needs to mutate the values inside the vector
-            for (auto& [scan_target, signature_container] : signature_containers)
+            module_scans = std::vector<ModuleScan>(signature_containers.size());
+            for (size_t module_index = 0; auto& [scan_target, signature_container] : signature_containers)
             {
-                uint8_t* module_start_address = static_cast<uint8_t*>(SigScannerStaticData::m_modules_info[scan_target].lpBaseOfDll);
-                uint8_t* module_end_address = static_cast<uint8_t*>(module_start_address + SigScannerStaticData::m_modules_info[scan_target].SizeOfImage);
+                auto& module_info = SigScannerStaticData::m_modules_info[scan_target];
+                module_scans[module_index].module_start_address = static_cast<uint8_t*>(module_info.lpBaseOfDll);
+                module_scans[module_index].module_size = module_info.SizeOfImage;
+                module_scans[module_index].signature_containers = &signature_container;
+                ++module_index;
+            }
+        }
 
-                scanner_work_thread(module_start_address, module_end_address, info, signature_container);
+        for (auto& module_scan : module_scans)
+        {
+            prepare_module_scan(module_scan);
+        }
 
-                for (auto& container : signature_container)
-                {
-                    container.on_scan_finished(container);
-                }
-            }
+        scan_modules(module_scans);
+
+        for (auto& module_scan : module_scans)
+        {
+            finish_module_scan(module_scan);
+        }
+
+        if (m_result_cache)
+        {
+            m_result_cache->save();
         }
     }
-} // namespace RC
\ No newline at end of file
+
+} // namespace RC
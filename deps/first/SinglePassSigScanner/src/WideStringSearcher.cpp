@@ -0,0 +1,131 @@
+#include <algorithm>
+
+#include <SigScanner/WideStringSearcher.hpp>
+
+namespace RC
+{
+    WideStringSearcher::WideStringSearcher(std::span<const std::wstring_view> strings)
+    {
+        m_patterns.reserve(strings.size());
+        for (const auto string : strings)
+        {
+            // Empty strings get an empty pattern that the search skips, so that indices still line up with 'strings'
+            m_patterns.emplace_back(string.empty() ? BytePattern{} : PatternMatcher::from_bytes(to_utf16le(string)));
+        }
+
+        for (const auto& pattern : m_patterns)
+        {
+            if (pattern.length > 0)
+            {
+                m_matcher.add_pattern(pattern);
+            }
+        }
+        m_matcher.build();
+    }
+
+    auto WideStringSearcher::to_utf16le(std::wstring_view string) -> std::vector<uint8_t>
+    {
+        std::vector<uint8_t> bytes{};
+        bytes.reserve(string.size() * 2);
+
+        auto append_code_unit = [&](uint32_t code_unit) {
+            bytes.emplace_back(static_cast<uint8_t>(code_unit & 0xFF));
+            bytes.emplace_back(static_cast<uint8_t>((code_unit >> 8) & 0xFF));
+        };
+
+        for (const auto character : string)
+        {
+            const auto code_point = static_cast<uint32_t>(character);
+            if (code_point > 0xFFFF)
+            {
+                // Only reachable where wchar_t is 32 bits, Windows strings are already UTF-16
+                append_code_unit(0xD800 + ((code_point - 0x10000) >> 10));
+                append_code_unit(0xDC00 + ((code_point - 0x10000) & 0x3FF));
+            }
+            else
+            {
+                append_code_unit(code_point);
+            }
+        }
+
+        return bytes;
+    }
+
+    auto WideStringSearcher::search(std::span<const uint8_t> data, std::span<const uint8_t*> first_matches) const -> bool
+    {
+        auto is_done = [&] {
+            for (size_t string_index = 0; string_index < m_patterns.size(); ++string_index)
+            {
+                if (m_patterns[string_index].length > 0 && !first_matches[string_index])
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        size_t num_unresolved{};
+        size_t last_unresolved{};
+        for (size_t string_index = 0; string_index < m_patterns.size(); ++string_index)
+        {
+            if (m_patterns[string_index].length > 0 && !first_matches[string_index])
+            {
+                ++num_unresolved;
+                last_unresolved = string_index;
+            }
+        }
+
+        if (num_unresolved == 0)
+        {
+            return is_done();
+        }
+
+        if (num_unresolved == 1)
+        {
+            // Matches are found in address order so the first one is also the lowest
+            if (auto match = PatternMatcher::find_first(data, m_patterns[last_unresolved]))
+            {
+                first_matches[last_unresolved] = match;
+            }
+            return is_done();
+        }
+
+        // The multi-pattern matcher reports matches in anchor order rather than address order, so it can't stop at the first match
+        // The matcher indices skip empty strings, so they're mapped back to string indices
+        std::vector<size_t> string_indices{};
+        string_indices.reserve(m_matcher.get_pattern_count());
+        for (size_t string_index = 0; string_index < m_patterns.size(); ++string_index)
+        {
+            if (m_patterns[string_index].length > 0)
+            {
+                string_indices.emplace_back(string_index);
+            }
+        }
+
+        // The matcher searches for every string, the matches of strings that were already found are dropped
+        std::vector<const uint8_t*> matches_in_data(m_patterns.size());
+        m_matcher.find_all(data, [&](const uint8_t* match_address, size_t pattern_index) {
+            const auto string_index = string_indices[pattern_index];
+            if (first_matches[string_index])
+            {
+                return false;
+            }
+            auto& match = matches_in_data[string_index];
+            if (!match || match_address < match)
+            {
+                match = match_address;
+            }
+            return false;
+        });
+
+        for (size_t string_index = 0; string_index < m_patterns.size(); ++string_index)
+        {
+            if (matches_in_data[string_index])
+            {
+                first_matches[string_index] = matches_in_data[string_index];
+            }
+        }
+
+        return is_done();
+    }
+} // namespace RC
@@ -0,0 +1,240 @@
+// Tests for the on-disk format of the scan result cache and the cases where cached results must not be used
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <SigScanner/ScanResultCache.hpp>
+#include <SigScanner/SinglePassSigScanner.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+
+static constexpr uint64_t s_owner_tag = 0x1234'5678'9ABC'DEF0;
+
+// Offsets into the serialized data, see ScanResultCache::serialize
+static constexpr size_t s_version_offset = 8;
+static constexpr size_t s_checksum_size = sizeof(uint64_t);
+
+static const ModuleIdentity s_main_exe{.path = "Game/Binaries/Win64/Game-Win64-Shipping.exe", .time_date_stamp = 0x6500'0000, .size_of_image = 0x0800'0000};
+static const ModuleIdentity s_other_module{.path = "Game/Binaries/Win64/Other.dll", .time_date_stamp = 0x6400'0000, .size_of_image = 0x0010'0000};
+
+static auto fill_cache(ScanResultCache& cache) -> void
+{
+    cache.store(s_main_exe, 1, {CachedMatch{0, 0x1000}, CachedMatch{2, 0x7FFF'FFF0}});
+    cache.store(s_main_exe, 2, {});
+    cache.store(s_other_module, 1, {CachedMatch{1, 0x0010'0000'0000}});
+}
+
+static auto make_filled_data() -> std::vector<uint8_t>
+{
+    ScanResultCache cache{"unused", s_owner_tag};
+    fill_cache(cache);
+    return cache.serialize();
+}
+
+static auto write_u32(std::vector<uint8_t>& data, size_t offset, uint32_t value) -> void
+{
+    for (size_t i = 0; i < sizeof(value); ++i)
+    {
+        data[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+}
+
+// Recomputes the checksum after the data was edited, so that only the edited field can make the data invalid
+static auto fix_checksum(std::vector<uint8_t>& data) -> void
+{
+    const auto checksum = ScanResultCache::hash_bytes({data.data(), data.size() - s_checksum_size});
+    for (size_t i = 0; i < s_checksum_size; ++i)
+    {
+        data[data.size() - s_checksum_size + i] = static_cast<uint8_t>(checksum >> (i * 8));
+    }
+}
+
+static auto write_file(const std::filesystem::path& path, const std::vector<uint8_t>& data) -> void
+{
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+static auto test_round_trip() -> void
+{
+    const auto data = make_filled_data();
+
+    ScanResultCache loaded{"unused", s_owner_tag};
+    CHECK(loaded.deserialize(data));
+    CHECK(loaded.find(s_main_exe, 1) == (std::vector<CachedMatch>{CachedMatch{0, 0x1000}, CachedMatch{2, 0x7FFF'FFF0}}));
+    CHECK(loaded.find(s_main_exe, 2) == std::vector<CachedMatch>{});
+    CHECK(loaded.find(s_other_module, 1) == std::vector<CachedMatch>{CachedMatch{1, 0x0010'0000'0000}});
+    CHECK(!loaded.find(s_other_module, 2));
+
+    // Serializing what was loaded gives the same contents, compared through a third cache since the order of the entries isn't fixed
+    ScanResultCache reloaded{"unused", s_owner_tag};
+    CHECK(reloaded.deserialize(loaded.serialize()));
+    CHECK(reloaded.find(s_main_exe, 1) == loaded.find(s_main_exe, 1));
+    CHECK(reloaded.find(s_other_module, 1) == loaded.find(s_other_module, 1));
+
+    // An empty cache is valid too
+    ScanResultCache empty{"unused", s_owner_tag};
+    CHECK(loaded.deserialize(empty.serialize()));
+    CHECK(!loaded.find(s_main_exe, 1));
+}
+
+static auto test_file_round_trip(const std::filesystem::path& directory) -> void
+{
+    const auto cache_file = directory / "nested" / "ScanResults.bin";
+
+    ScanResultCache cache{cache_file, s_owner_tag};
+    CHECK(!cache.load());
+    cache.store(s_main_exe, 7, {CachedMatch{3, 0x42}});
+    cache.save();
+    CHECK(std::filesystem::exists(cache_file));
+    CHECK(!std::filesystem::exists(std::filesystem::path{cache_file} += ".tmp"));
+
+    ScanResultCache loaded{cache_file, s_owner_tag};
+    CHECK(loaded.load());
+    CHECK(loaded.find(s_main_exe, 7) == std::vector<CachedMatch>{CachedMatch{3, 0x42}});
+
+    // Nothing changed since the file was loaded, so saving must not rewrite it
+    std::filesystem::remove(cache_file);
+    loaded.save();
+    CHECK(!std::filesystem::exists(cache_file));
+
+    loaded.invalidate(s_main_exe, 7);
+    loaded.save();
+    ScanResultCache after_invalidate{cache_file, s_owner_tag};
+    CHECK(after_invalidate.load());
+    CHECK(!after_invalidate.find(s_main_exe, 7));
+}
+
+static auto test_version_mismatch() -> void
+{
+    auto data = make_filled_data();
+    write_u32(data, s_version_offset, ScanResultCache::file_version + 1);
+    fix_checksum(data);
+
+    ScanResultCache loaded{"unused", s_owner_tag};
+    CHECK(!loaded.deserialize(data));
+    CHECK(!loaded.find(s_main_exe, 1));
+
+    // The unmodified data is accepted, so it was the version that made the difference
+    CHECK(loaded.deserialize(make_filled_data()));
+}
+
+static auto test_owner_tag_mismatch() -> void
+{
+    ScanResultCache loaded{"unused", s_owner_tag + 1};
+    CHECK(!loaded.deserialize(make_filled_data()));
+    CHECK(!loaded.find(s_main_exe, 1));
+}
+
+static auto test_module_identity_mismatch() -> void
+{
+    ScanResultCache cache{"unused", s_owner_tag};
+    fill_cache(cache);
+
+    auto rebuilt_main_exe = s_main_exe;
+    rebuilt_main_exe.time_date_stamp += 1;
+    CHECK(!cache.find(rebuilt_main_exe, 1));
+
+    auto resized_main_exe = s_main_exe;
+    resized_main_exe.size_of_image += 0x1000;
+    CHECK(!cache.find(resized_main_exe, 1));
+
+    auto moved_main_exe = s_main_exe;
+    moved_main_exe.path = "Other/Game-Win64-Shipping.exe";
+    CHECK(!cache.find(moved_main_exe, 1));
+
+    // Storing for a different build of the module drops everything that was stored for the old build, the other module keeps its entries
+    cache.store(rebuilt_main_exe, 2, {CachedMatch{0, 0x10}});
+    CHECK(!cache.find(s_main_exe, 1));
+    CHECK(!cache.find(s_main_exe, 2));
+    CHECK(!cache.find(rebuilt_main_exe, 1));
+    CHECK(cache.find(rebuilt_main_exe, 2) == std::vector<CachedMatch>{CachedMatch{0, 0x10}});
+    CHECK(cache.find(s_other_module, 1).has_value());
+
+    // The identity survives serialization, so a rebuilt module is still detected after a restart
+    ScanResultCache loaded{"unused", s_owner_tag};
+    CHECK(loaded.deserialize(cache.serialize()));
+    CHECK(!loaded.find(s_main_exe, 2));
+    CHECK(loaded.find(rebuilt_main_exe, 2).has_value());
+}
+
+static auto test_truncated(const std::filesystem::path& directory) -> void
+{
+    const auto data = make_filled_data();
+
+    // Every prefix fails, and a failed load leaves nothing from an earlier load behind
+    ScanResultCache loaded{"unused", s_owner_tag};
+    for (size_t size = 0; size < data.size(); ++size)
+    {
+        CHECK(loaded.deserialize(data));
+        CHECK(!loaded.deserialize({data.data(), size}));
+        CHECK(!loaded.find(s_main_exe, 1));
+    }
+
+    // Truncated in the middle but with a valid checksum, so that the reader itself runs out of data
+    auto truncated = data;
+    truncated.erase(truncated.begin() + static_cast<ptrdiff_t>(data.size() / 2), truncated.end() - s_checksum_size);
+    fix_checksum(truncated);
+    CHECK(!loaded.deserialize(truncated));
+
+    // A count that claims more entries than there is data for
+    auto overlong = std::vector<uint8_t>(data.begin(), data.begin() + 20);
+    overlong.insert(overlong.end(), {0xFF, 0xFF, 0xFF, 0xFF});
+    overlong.resize(overlong.size() + s_checksum_size);
+    fix_checksum(overlong);
+    CHECK(!loaded.deserialize(overlong));
+
+    const auto cache_file = directory / "Truncated.bin";
+    write_file(cache_file, {data.begin(), data.begin() + static_cast<ptrdiff_t>(data.size() - 1)});
+    ScanResultCache from_file{cache_file, s_owner_tag};
+    CHECK(!from_file.load());
+    CHECK(!from_file.find(s_main_exe, 1));
+}
+
+static auto test_corrupted() -> void
+{
+    const auto data = make_filled_data();
+
+    ScanResultCache loaded{"unused", s_owner_tag};
+    for (size_t offset = 0; offset < data.size(); ++offset)
+    {
+        auto corrupted = data;
+        corrupted[offset] ^= 0x01;
+        CHECK(!loaded.deserialize(corrupted));
+    }
+}
+
+static auto test_signature_hashes() -> void
+{
+    const std::vector<SignatureData> split_one{{.signature = "AB"}, {.signature = "CD"}};
+    const std::vector<SignatureData> split_two{{.signature = "ABC"}, {.signature = "D"}};
+    const std::vector<SignatureData> reordered{{.signature = "CD"}, {.signature = "AB"}};
+    CHECK(ScanResultCache::hash_signatures(split_one) == ScanResultCache::hash_signatures(std::vector<SignatureData>(split_one)));
+    CHECK(ScanResultCache::hash_signatures(split_one) != ScanResultCache::hash_signatures(split_two));
+    CHECK(ScanResultCache::hash_signatures(split_one) != ScanResultCache::hash_signatures(reordered));
+}
+
+auto main() -> int
+{
+    const auto directory = std::filesystem::temp_directory_path() /
+                           ("ScanResultCacheTest-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(directory);
+
+    test_round_trip();
+    test_file_round_trip(directory);
+    test_version_mismatch();
+    test_owner_tag_mismatch();
+    test_module_identity_mismatch();
+    test_truncated(directory);
+    test_corrupted();
+    test_signature_hashes();
+
+    std::error_code ec{};
+    std::filesystem::remove_all(directory, ec);
+
+    return Test::report_results();
+}
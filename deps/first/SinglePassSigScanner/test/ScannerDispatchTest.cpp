@@ -0,0 +1,253 @@
+// Stress test for how the scanner forwards matches to the containers when many threads scan the same module
+// Every match has to reach its container exactly once, in address order, and callbacks must never run concurrently, even when they're slow
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <ranges>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <SigScanner/MemorySource.hpp>
+#include <SigScanner/SinglePassSigScanner.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+
+// Every byte of the buffer is readable
+class BufferMemorySource : public MemorySource
+{
+  private:
+    std::span<uint8_t> m_buffer;
+
+  public:
+    explicit BufferMemorySource(std::span<uint8_t> buffer) : m_buffer(buffer)
+    {
+    }
+
+  public:
+    auto query(const uint8_t* address) const -> std::optional<MemoryRegion> override
+    {
+        if (address < m_buffer.data() || address >= m_buffer.data() + m_buffer.size())
+        {
+            return std::nullopt;
+        }
+        return MemoryRegion{.base = m_buffer.data(), .size = m_buffer.size(), .is_readable = true};
+    }
+};
+
+// The offset into the buffer and the index of the signature of one match
+using Match = std::pair<size_t, size_t>;
+
+static constexpr size_t s_buffer_size = 0x200000;
+static constexpr uint32_t s_chunk_size = 0x1000;
+static constexpr size_t s_num_containers = 12;
+// How many matches the container that stops early accepts
+static constexpr size_t s_num_matches_before_stop = 5;
+
+struct TestCase
+{
+    std::vector<uint8_t> buffer{};
+    std::vector<std::vector<std::string>> signatures_per_container{};
+    // Sorted by offset and then by signature, which is the order the scanner has to forward them in
+    std::vector<std::vector<Match>> expected_matches_per_container{};
+};
+
+static auto to_signature(std::span<const uint8_t> bytes, std::mt19937& random) -> std::string
+{
+    std::string signature{};
+    for (size_t i = 0; i < bytes.size(); ++i)
+    {
+        char byte_text[4]{};
+        // The first and last bytes are always specified, wildcards in between make the scan methods take their slower paths
+        if (i > 0 && i + 1 < bytes.size() && random() % 5 == 0)
+        {
+            signature += "??";
+        }
+        else
+        {
+            std::snprintf(byte_text, sizeof(byte_text), "%02X", bytes[i]);
+            signature += byte_text;
+        }
+        if (i + 1 < bytes.size())
+        {
+            signature += ' ';
+        }
+    }
+    return signature;
+}
+
+static auto make_test_case(uint32_t seed) -> TestCase
+{
+    std::mt19937 random{seed};
+    TestCase test_case{};
+    test_case.buffer.resize(s_buffer_size);
+    for (auto& byte : test_case.buffer)
+    {
+        byte = static_cast<uint8_t>(random());
+    }
+
+    // Each signature is made from random bytes and planted many times, a lot of them right before the end of a chunk so that the match straddles two chunks
+    for (size_t container = 0; container < s_num_containers; ++container)
+    {
+        auto& signatures = test_case.signatures_per_container.emplace_back();
+        const size_t num_signatures = 1 + random() % 3;
+        for (size_t signature = 0; signature < num_signatures; ++signature)
+        {
+            std::vector<uint8_t> bytes(6 + random() % 12);
+            for (auto& byte : bytes)
+            {
+                byte = static_cast<uint8_t>(random());
+            }
+
+            const size_t num_copies = 20 + random() % 100;
+            for (size_t copy = 0; copy < num_copies; ++copy)
+            {
+                size_t offset = random() % (s_buffer_size - bytes.size());
+                if (copy % 3 == 0)
+                {
+                    offset = std::max(offset / s_chunk_size * s_chunk_size, size_t{s_chunk_size}) - 1 - random() % (bytes.size() - 1);
+                }
+                std::ranges::copy(bytes, test_case.buffer.begin() + static_cast<ptrdiff_t>(offset));
+            }
+            signatures.emplace_back(to_signature(bytes, random));
+        }
+    }
+
+    // Copies can overwrite each other, so the expected matches are found by brute force after every copy is in place
+    for (const auto& signatures : test_case.signatures_per_container)
+    {
+        auto& expected_matches = test_case.expected_matches_per_container.emplace_back();
+        for (size_t signature = 0; signature < signatures.size(); ++signature)
+        {
+            const auto pattern = PatternMatcher::compile(signatures[signature]);
+            for (size_t offset = 0; offset + pattern.length <= s_buffer_size; ++offset)
+            {
+                if (PatternMatcher::matches_at(test_case.buffer.data() + offset, pattern))
+                {
+                    expected_matches.emplace_back(offset, signature);
+                }
+            }
+        }
+        std::ranges::sort(expected_matches);
+    }
+    return test_case;
+}
+
+static auto run_scan(TestCase& test_case, SinglePassScanner::ScanMethod scan_method, uint32_t num_threads) -> void
+{
+    SinglePassScanner::m_scan_method = scan_method;
+    SinglePassScanner::m_num_threads = num_threads;
+
+    uint8_t* buffer_start = test_case.buffer.data();
+    std::vector<std::vector<Match>> matches_per_container(s_num_containers);
+    std::vector<int> num_scan_finished_calls(s_num_containers);
+    std::atomic<int> num_running_callbacks{};
+    std::atomic<bool> has_overlapping_callbacks{};
+    // Every callback of every container, which must be in address order too since the module is forwarded one chunk at a time
+    std::vector<size_t> callback_offsets{};
+
+    std::vector<SignatureContainer> signature_containers{};
+    for (size_t container = 0; container < s_num_containers; ++container)
+    {
+        std::vector<SignatureData> signature_data{};
+        for (const auto& signature : test_case.signatures_per_container[container])
+        {
+            signature_data.emplace_back(SignatureData{.signature = signature});
+        }
+
+        signature_containers.emplace_back(
+                std::move(signature_data),
+                [&, container](SignatureContainer& self) {
+                    if (num_running_callbacks.fetch_add(1) != 0)
+                    {
+                        has_overlapping_callbacks = true;
+                    }
+
+                    const size_t offset = static_cast<size_t>(self.get_match_address() - buffer_start);
+                    matches_per_container[container].emplace_back(offset, self.get_index_into_signatures());
+                    callback_offsets.emplace_back(offset);
+
+                    // The first container is slow, which keeps the dispatching thread busy while the other threads finish more chunks
+                    if (container == 0)
+                    {
+                        std::this_thread::sleep_for(std::chrono::microseconds{50});
+                    }
+
+                    num_running_callbacks.fetch_sub(1);
+
+                    // The second container only wants its first match and the third a few, the rest want every match
+                    if (container == 1)
+                    {
+                        return true;
+                    }
+                    return container == 2 && matches_per_container[container].size() == s_num_matches_before_stop;
+                },
+                [&, container](SignatureContainer&) {
+                    ++num_scan_finished_calls[container];
+                });
+    }
+
+    SinglePassScanner::scan_range(buffer_start, test_case.buffer.size(), signature_containers);
+
+    CHECK(!has_overlapping_callbacks);
+    CHECK(std::ranges::is_sorted(callback_offsets));
+    for (size_t container = 0; container < s_num_containers; ++container)
+    {
+        const auto& expected_matches = test_case.expected_matches_per_container[container];
+        const auto& matches = matches_per_container[container];
+        CHECK(num_scan_finished_calls[container] == 1);
+
+        // Comparing the whole list checks for duplicates, lost matches and the order in one go
+        if (container == 1)
+        {
+            CHECK(matches.size() == 1 && matches[0] == expected_matches[0]);
+        }
+        else if (container == 2)
+        {
+            CHECK(std::ranges::equal(matches, expected_matches | std::views::take(s_num_matches_before_stop)));
+        }
+        else if (matches != expected_matches)
+        {
+            std::fprintf(stderr,
+                         "Scan method %d with %u threads forwarded %zu matches to container %zu, expected %zu\n",
+                         static_cast<int>(scan_method),
+                         num_threads,
+                         matches.size(),
+                         container,
+                         expected_matches.size());
+            Test::fail();
+        }
+    }
+}
+
+auto main() -> int
+{
+    SinglePassScanner::m_chunk_size = s_chunk_size;
+    SinglePassScanner::m_multithreading_module_size_threshold = 0;
+
+    for (uint32_t seed = 1; seed <= 3; ++seed)
+    {
+        auto test_case = make_test_case(seed);
+        BufferMemorySource memory_source{test_case.buffer};
+        SinglePassScanner::set_memory_source(&memory_source);
+
+        for (auto scan_method : {SinglePassScanner::ScanMethod::Scalar,
+                                 SinglePassScanner::ScanMethod::StdFind,
+                                 SinglePassScanner::ScanMethod::Vectorized,
+                                 SinglePassScanner::ScanMethod::MultiPattern})
+        {
+            for (uint32_t num_threads : {1u, 2u, 8u, 32u})
+            {
+                run_scan(test_case, scan_method, num_threads);
+            }
+        }
+
+        SinglePassScanner::set_memory_source(nullptr);
+    }
+
+    return Test::report_results();
+}
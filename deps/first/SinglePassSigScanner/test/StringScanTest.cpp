@@ -0,0 +1,231 @@
+// Tests for searching a module for UTF-16 strings, on a synthetic image with a .text, an .rdata and a .data section
+// Searching for many strings at once must find the same address for every string as searching for it alone
+
+#include <algorithm>
+#include <cstdio>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <SigScanner/MemorySource.hpp>
+#include <SigScanner/SinglePassSigScanner.hpp>
+#include <SigScanner/WideStringSearcher.hpp>
+#include <Test/Check.hpp>
+
+using namespace RC;
+
+static constexpr size_t s_image_size = 0x10000;
+static constexpr size_t s_text_offset = 0x1000;
+static constexpr size_t s_text_size = 0x7000;
+static constexpr size_t s_rdata_offset = 0x8000;
+static constexpr size_t s_rdata_size = 0x4000;
+static constexpr size_t s_data_offset = 0xC000;
+static constexpr size_t s_data_size = 0x4000;
+// Part of .text that can't be read, strings in there are never found
+static constexpr size_t s_unreadable_offset = 0x4000;
+static constexpr size_t s_unreadable_size = 0x1000;
+
+// Every byte of the image is readable except for one page
+class ImageMemorySource : public MemorySource
+{
+  private:
+    std::span<uint8_t> m_image;
+
+  public:
+    explicit ImageMemorySource(std::span<uint8_t> image) : m_image(image)
+    {
+    }
+
+  public:
+    auto query(const uint8_t* address) const -> std::optional<MemoryRegion> override
+    {
+        if (address < m_image.data() || address >= m_image.data() + m_image.size())
+        {
+            return std::nullopt;
+        }
+
+        const auto offset = static_cast<size_t>(address - m_image.data());
+        if (offset < s_unreadable_offset)
+        {
+            return MemoryRegion{.base = m_image.data(), .size = s_unreadable_offset, .is_readable = true};
+        }
+        if (offset < s_unreadable_offset + s_unreadable_size)
+        {
+            return MemoryRegion{.base = m_image.data() + s_unreadable_offset, .size = s_unreadable_size, .is_readable = false};
+        }
+        const auto readable_offset = s_unreadable_offset + s_unreadable_size;
+        return MemoryRegion{.base = m_image.data() + readable_offset, .size = m_image.size() - readable_offset, .is_readable = true};
+    }
+};
+
+static auto write_u16(std::vector<uint8_t>& data, size_t offset, uint16_t value) -> void
+{
+    data[offset] = static_cast<uint8_t>(value);
+    data[offset + 1] = static_cast<uint8_t>(value >> 8);
+}
+
+static auto write_u32(std::vector<uint8_t>& data, size_t offset, uint32_t value) -> void
+{
+    write_u16(data, offset, static_cast<uint16_t>(value));
+    write_u16(data, offset + 2, static_cast<uint16_t>(value >> 16));
+}
+
+static auto write_section_header(std::vector<uint8_t>& image, size_t offset, std::string_view name, size_t section_offset, size_t section_size) -> void
+{
+    std::copy(name.begin(), name.end(), image.begin() + static_cast<ptrdiff_t>(offset));
+    write_u32(image, offset + 8, static_cast<uint32_t>(section_size));
+    write_u32(image, offset + 12, static_cast<uint32_t>(section_offset));
+}
+
+// Only the fields that PeImage reads are filled in
+static auto make_image() -> std::vector<uint8_t>
+{
+    std::vector<uint8_t> image(s_image_size);
+    static constexpr size_t nt_headers_offset = 0x80;
+    static constexpr size_t optional_header_offset = nt_headers_offset + 4 + 20;
+    static constexpr uint16_t size_of_optional_header = 0xF0;
+    static constexpr size_t section_table_offset = optional_header_offset + size_of_optional_header;
+
+    write_u16(image, 0, 0x5A4D);
+    write_u32(image, 0x3C, nt_headers_offset);
+    write_u32(image, nt_headers_offset, 0x00004550);
+    write_u16(image, nt_headers_offset + 4 + 2, 3);
+    write_u32(image, nt_headers_offset + 4 + 4, 0x12345678);
+    write_u16(image, nt_headers_offset + 4 + 16, size_of_optional_header);
+    write_u32(image, optional_header_offset + 56, s_image_size);
+    write_u32(image, optional_header_offset + 60, 0x1000);
+
+    write_section_header(image, section_table_offset, ".text", s_text_offset, s_text_size);
+    write_section_header(image, section_table_offset + 40, ".rdata", s_rdata_offset, s_rdata_size);
+    write_section_header(image, section_table_offset + 80, ".data", s_data_offset, s_data_size);
+    return image;
+}
+
+static auto plant(std::vector<uint8_t>& image, size_t offset, std::wstring_view string) -> void
+{
+    const auto bytes = WideStringSearcher::to_utf16le(string);
+    std::copy(bytes.begin(), bytes.end(), image.begin() + static_cast<ptrdiff_t>(offset));
+}
+
+struct ExpectedString
+{
+    std::wstring_view string{};
+    // Where the string has to be found, or nothing if it mustn't be found
+    std::optional<size_t> offset{};
+};
+
+static auto test_search_keeps_earlier_matches() -> void
+{
+    // A string that already has an address isn't moved to a lower one, whether the search looks for one string or for several
+    std::vector<uint8_t> data(0x100);
+    plant(data, 0x10, L"First");
+    plant(data, 0x40, L"Second");
+    plant(data, 0x80, L"First");
+    const uint8_t earlier_region[1]{};
+    const uint8_t* earlier_match = earlier_region + 0;
+
+    const std::wstring_view one_string[]{L"First"};
+    WideStringSearcher one_searcher{one_string};
+    std::vector<const uint8_t*> one_match{earlier_match};
+    CHECK(one_searcher.search(data, one_match));
+    CHECK(one_match[0] == earlier_match);
+
+    const std::wstring_view strings[]{L"First", L"Second", L"Third"};
+    WideStringSearcher searcher{strings};
+    std::vector<const uint8_t*> first_matches{earlier_match, nullptr, nullptr};
+    CHECK(!searcher.search(data, first_matches));
+    CHECK(first_matches[0] == earlier_match);
+    CHECK(first_matches[1] == data.data() + 0x40);
+    CHECK(!first_matches[2]);
+
+    std::vector<const uint8_t*> no_matches(3);
+    CHECK(!searcher.search(data, no_matches));
+    CHECK(no_matches[0] == data.data() + 0x10);
+    CHECK(no_matches[1] == data.data() + 0x40);
+}
+
+static auto test_string_scan_range() -> void
+{
+    auto image = make_image();
+    const std::vector<ExpectedString> expected_strings{
+            // In .rdata and at a lower address in .text, the .rdata match wins because .rdata is searched first
+            {L"InRdataAndText", s_rdata_offset + 0x1000},
+            // The lowest match inside .rdata
+            {L"TwiceInRdata", s_rdata_offset + 0x800},
+            // Not in .rdata, the lowest match in the rest of the module
+            {L"InTextAndData", s_text_offset + 0x2000},
+            {L"OnlyInData", s_data_offset + 0x800},
+            // Only in memory that can't be read
+            {L"Unreadable", std::nullopt},
+            {L"Missing", std::nullopt},
+    };
+    plant(image, s_rdata_offset + 0x1000, L"InRdataAndText");
+    plant(image, s_text_offset + 0x100, L"InRdataAndText");
+    plant(image, s_data_offset + 0x100, L"InRdataAndText");
+    plant(image, s_rdata_offset + 0x2000, L"TwiceInRdata");
+    plant(image, s_rdata_offset + 0x800, L"TwiceInRdata");
+    plant(image, s_data_offset + 0x400, L"InTextAndData");
+    plant(image, s_text_offset + 0x2000, L"InTextAndData");
+    plant(image, s_data_offset + 0x800, L"OnlyInData");
+    plant(image, s_unreadable_offset + 0x200, L"Unreadable");
+
+    ImageMemorySource memory_source{image};
+    SinglePassScanner::set_memory_source(&memory_source);
+
+    auto expected_address = [&](const ExpectedString& expected_string) -> void* {
+        return expected_string.offset ? image.data() + *expected_string.offset : nullptr;
+    };
+
+    // One at a time
+    for (const auto& expected_string : expected_strings)
+    {
+        const std::wstring_view strings[]{expected_string.string};
+        const auto addresses = SinglePassScanner::string_scan_range(image.data(), image.size(), strings);
+        CHECK(addresses.size() == 1);
+        if (addresses.size() == 1 && addresses[0] != expected_address(expected_string))
+        {
+            std::fprintf(stderr, "'%ls' alone was found at the wrong address\n", expected_string.string.data());
+            Test::fail();
+        }
+    }
+
+    // Every batch of two or more strings, the strings that are still missing after .rdata are searched for together with the rest of the module
+    for (uint32_t batch = 0; batch < (1u << expected_strings.size()); ++batch)
+    {
+        std::vector<std::wstring_view> strings{};
+        std::vector<const ExpectedString*> batch_expected_strings{};
+        for (size_t string_index = 0; string_index < expected_strings.size(); ++string_index)
+        {
+            if (batch & (1u << string_index))
+            {
+                strings.emplace_back(expected_strings[string_index].string);
+                batch_expected_strings.emplace_back(&expected_strings[string_index]);
+            }
+        }
+        if (strings.size() < 2)
+        {
+            continue;
+        }
+
+        const auto addresses = SinglePassScanner::string_scan_range(image.data(), image.size(), strings);
+        CHECK(addresses.size() == strings.size());
+        for (size_t string_index = 0; string_index < std::min(addresses.size(), strings.size()); ++string_index)
+        {
+            if (addresses[string_index] != expected_address(*batch_expected_strings[string_index]))
+            {
+                std::fprintf(stderr, "'%ls' was found at the wrong address in batch %u\n", strings[string_index].data(), batch);
+                Test::fail();
+            }
+        }
+    }
+
+    SinglePassScanner::set_memory_source(nullptr);
+}
+
+auto main() -> int
+{
+    test_search_keeps_earlier_matches();
+    test_string_scan_range();
+
+    return Test::report_results();
+}
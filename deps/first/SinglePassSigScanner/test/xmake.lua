@@ -0,0 +1,65 @@
+-- Standalone tests for the portable parts of the scanner
+-- They aren't part of the UE4SS build, which only targets Windows, and can be built and run on Linux with:
+--   cd deps/first/SinglePassSigScanner/test && xmake && xmake test
+set_xmakever("2.9.3")
+set_project("SinglePassSigScannerTest")
+
+add_rules("mode.debug", "mode.release")
+set_defaultmode("debug")
+
+add_requires("fmt")
+
+target("ScanResultCacheTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_SINGLE_PASS_SIG_SCANNER_BUILD_STATIC")
+    add_includedirs("../include", "../../../../tools/test/include")
+
+    add_files("ScanResultCacheTest.cpp")
+    add_files("../src/ScanResultCache.cpp")
+
+    add_tests("default")
+
+target("ScannerDispatchTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_SINGLE_PASS_SIG_SCANNER_BUILD_STATIC")
+    add_includedirs("../include", "../../../../tools/test/include")
+
+    add_files("ScannerDispatchTest.cpp")
+    add_files("../src/PatternMatcher.cpp", "../src/MultiPatternMatcher.cpp")
+    add_files("../src/ScannerWorkerPool.cpp", "../src/ScanResultCache.cpp", "../src/SinglePassScannerCore.cpp")
+    add_files("../src/PeImage.cpp", "../src/WideStringSearcher.cpp")
+
+    add_packages("fmt")
+
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
+    add_tests("default")
+
+target("StringScanTest")
+    set_kind("binary")
+    set_languages("cxx23")
+    set_exceptions("cxx")
+
+    add_defines("RC_SINGLE_PASS_SIG_SCANNER_BUILD_STATIC")
+    add_includedirs("../include", "../../../../tools/test/include")
+
+    add_files("StringScanTest.cpp")
+    add_files("../src/PatternMatcher.cpp", "../src/MultiPatternMatcher.cpp")
+    add_files("../src/ScannerWorkerPool.cpp", "../src/ScanResultCache.cpp", "../src/SinglePassScannerCore.cpp")
+    add_files("../src/PeImage.cpp", "../src/WideStringSearcher.cpp")
+
+    add_packages("fmt")
+
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
+    add_tests("default")
@@ -0,0 +1,39 @@
+#pragma once
+
+// Shared by the standalone tests in the test folders of UE4SSL and of the libraries in deps/first
+// A check that fails is printed and counted, and the test carries on so that one run shows every failure
+// 'main' runs the tests and returns 'report_results()'
+
+#include <cstdio>
+
+namespace RC::Test
+{
+    inline int num_failures{};
+
+    // Counts a failure that the test already printed a better message for than CHECK would
+    inline auto fail() -> void
+    {
+        ++num_failures;
+    }
+
+    inline auto report_results() -> int
+    {
+        if (num_failures > 0)
+        {
+            std::fprintf(stderr, "%d check(s) failed\n", num_failures);
+            return 1;
+        }
+        std::printf("All checks passed\n");
+        return 0;
+    }
+} // namespace RC::Test
+
+#define CHECK(...)                                                                                                                                             \
+    do                                                                                                                                                         \
+    {                                                                                                                                                          \
+        if (!(__VA_ARGS__))                                                                                                                                    \
+        {                                                                                                                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #__VA_ARGS__);                                                              \
+            RC::Test::fail();                                                                                                                                  \
+        }                                                                                                                                                      \
+    } while (false)